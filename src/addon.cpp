@@ -10,8 +10,12 @@ extern "C" __declspec(dllexport) const char* DESCRIPTION =
     "Forces a specific swapchain resolution and fullscreen mode (configurable) while maintaining application compatibility.\n\n"
     "Configuration via ReShade.ini:\n"
     "[SWAPCHAIN_OVERRIDE]\n"
-    "ForceSwapchainResolution=<width>x<height>  (e.g., 3840x2160 for 4K, or 0x0 to disable)\n"
+    "ForceSwapchainResolution=<width>x<height>  (e.g., 3840x2160 for 4K, 2x, 150%, fit-monitor, or 0x0 to disable)\n"
     "SwapchainScalingFilter=<0-2>  (0=Point, 1=Linear, 2=Anisotropic)\n"
     "FullscreenMode=<0-2>  (0=Unchanged, 1=Borderless, 2=Exclusive)\n"
     "BlockFullscreenChanges=<0-1>  (0=Allow, 1=Block Alt+Enter toggles)\n"
-    "TargetMonitor=<0+>  (0=Primary, 1+=Secondary monitors)";
+    "TargetMonitor=<0+>  (0=Primary, 1+=Secondary monitors)\n"
+    "WatchConfigFile=<0-1>  (1=Reload automatically when ReShade.ini changes)\n"
+    "ProfileDatabase=<path>  (Per-executable profiles, empty to disable)\n"
+    "TraceFile=<path>  (Binary trace of every hook, empty to disable)\n"
+    "ExportStats=<0-1>  (Publish live statistics in shared memory for stats_monitor)";
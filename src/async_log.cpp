@@ -0,0 +1,299 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "async_log.h"
+#include <cstdio>
+#include <cstring>
+
+AsyncLog& AsyncLog::get_instance()
+{
+    static AsyncLog instance;
+    return instance;
+}
+
+void AsyncLog::install()
+{
+    for (size_t i = 0; i < CAPACITY; ++i)
+        records_[i].turn.store(i, std::memory_order_relaxed);
+    write_position_.store(0, std::memory_order_relaxed);
+    read_position_ = 0;
+    partial_line_.clear();
+
+    // A signal left pending by the previous run would keep producers from waking the new consumer
+    signal_pending_.store(false, std::memory_order_relaxed);
+
+    records_event_ = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+    if (records_event_ == nullptr)
+        return;
+
+    // Drain on the thread pool instead of a dedicated thread, which could not be joined safely under the loader lock
+    if (!RegisterWaitForSingleObject(&wait_handle_, records_event_, on_records_available, this, INFINITE, WT_EXECUTEDEFAULT))
+    {
+        CloseHandle(records_event_);
+        records_event_ = nullptr;
+        wait_handle_ = nullptr;
+        return;
+    }
+
+    running_.store(true, std::memory_order_release);
+}
+
+void AsyncLog::uninstall(bool process_terminating)
+{
+    running_.store(false, std::memory_order_release);
+
+    if (process_terminating)
+    {
+        // The thread pool was terminated with the other threads and the loader lock is held, so the wait is
+        // neither unregistered nor waited for. A consumer killed inside drain() left the lock held, its records are lost.
+        std::unique_lock<std::mutex> lock(drain_mutex_, std::try_to_lock);
+        if (lock.owns_lock())
+            drain_records();
+        return;
+    }
+
+    if (wait_handle_ != nullptr)
+    {
+        // Blocks until a running callback has finished
+        UnregisterWaitEx(wait_handle_, INVALID_HANDLE_VALUE);
+        wait_handle_ = nullptr;
+    }
+
+    if (records_event_ != nullptr)
+    {
+        CloseHandle(records_event_);
+        records_event_ = nullptr;
+    }
+
+    // No consumer is left, flush what was queued before the switch
+    drain();
+}
+
+AsyncLog::Record* AsyncLog::begin_write(size_t count, uint64_t& out_position)
+{
+    uint64_t position = write_position_.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        // The consumer frees slots in order, so when the last slot of the run is free all of them are
+        const uint64_t last_position = position + count - 1;
+        const int64_t diff = static_cast<int64_t>(record_at(last_position).turn.load(std::memory_order_acquire) - last_position);
+
+        if (diff == 0)
+        {
+            if (write_position_.compare_exchange_weak(position, position + count, std::memory_order_relaxed))
+            {
+                out_position = position;
+                return &record_at(position);
+            }
+        }
+        else if (diff < 0)
+        {
+            // The consumer has not freed this slot yet, never block the game thread
+            return nullptr;
+        }
+        else
+        {
+            position = write_position_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void AsyncLog::end_write(uint64_t position, size_t count)
+{
+    // In order, the consumer never reads past an unpublished record of a line
+    for (size_t i = 0; i < count; ++i)
+        record_at(position + i).turn.store(position + i + 1, std::memory_order_release);
+
+    // One SetEvent per burst, the consumer clears the flag before it drains
+    if (!signal_pending_.exchange(true, std::memory_order_acq_rel))
+        SetEvent(records_event_);
+}
+
+void AsyncLog::write(reshade::log::level level, const char* text)
+{
+    if (!running_.load(std::memory_order_acquire))
+    {
+        reshade::log::message(level, text);
+        return;
+    }
+
+    // Lines past MAX_LINE_LENGTH keep room for the marker in their last record
+    size_t length = strnlen(text, MAX_LINE_LENGTH + 1);
+    const bool truncated = length > MAX_LINE_LENGTH;
+    if (truncated)
+        length = MAX_LINE_LENGTH - (sizeof(TRUNCATION_MARKER) - 1);
+
+    const size_t total_length = truncated ? MAX_LINE_LENGTH : length;
+    const size_t count = total_length == 0 ? 1 : (total_length + MAX_TEXT_LENGTH - 1) / MAX_TEXT_LENGTH;
+
+    uint64_t position = 0;
+    if (begin_write(count, position) == nullptr)
+    {
+        dropped_records_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    size_t offset = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        Record& record = record_at(position + i);
+        const size_t chunk = std::min(MAX_TEXT_LENGTH, length - std::min(length, offset));
+        std::memcpy(record.text, text + offset, chunk);
+        offset += chunk;
+
+        size_t record_length = chunk;
+        if (truncated && i == count - 1)
+        {
+            std::memcpy(record.text + record_length, TRUNCATION_MARKER, sizeof(TRUNCATION_MARKER) - 1);
+            record_length += sizeof(TRUNCATION_MARKER) - 1;
+        }
+
+        record.text[record_length] = '\0';
+        record.length = static_cast<uint16_t>(record_length);
+        record.level = level;
+        record.event_name = nullptr;
+        record.formatter = nullptr;
+        record.continued = i + 1 < count;
+    }
+
+    end_write(position, count);
+}
+
+void AsyncLog::write_payload(reshade::log::level level, PayloadFormatter formatter, const void* payload, size_t size)
+{
+    if (!running_.load(std::memory_order_acquire))
+    {
+        std::string line;
+        formatter(payload, line);
+        reshade::log::message(level, line.c_str());
+        return;
+    }
+
+    uint64_t position = 0;
+    Record* record = begin_write(1, position);
+    if (record == nullptr)
+    {
+        dropped_records_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    std::memcpy(record->text, payload, size);
+    record->length = static_cast<uint16_t>(size);
+    record->level = level;
+    record->event_name = nullptr;
+    record->formatter = formatter;
+    record->continued = false;
+
+    end_write(position, 1);
+}
+
+void AsyncLog::write_event(const char* event_name, uint32_t sequence, double timestamp)
+{
+    if (!running_.load(std::memory_order_acquire))
+    {
+        Record record;
+        record.event_name = event_name;
+        record.formatter = nullptr;
+        record.continued = false;
+        record.sequence = sequence;
+        record.timestamp = timestamp;
+
+        std::lock_guard<std::mutex> lock(drain_mutex_);
+        emit(record);
+        return;
+    }
+
+    uint64_t position = 0;
+    Record* record = begin_write(1, position);
+    if (record == nullptr)
+    {
+        dropped_records_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    record->event_name = event_name;
+    record->formatter = nullptr;
+    record->continued = false;
+    record->sequence = sequence;
+    record->timestamp = timestamp;
+    record->level = reshade::log::level::info;
+
+    end_write(position, 1);
+}
+
+void AsyncLog::drain()
+{
+    std::lock_guard<std::mutex> lock(drain_mutex_);
+    drain_records();
+}
+
+void AsyncLog::drain_records()
+{
+    // Note: Caller must hold drain_mutex_
+    for (;;)
+    {
+        Record& record = record_at(read_position_);
+        if (record.turn.load(std::memory_order_acquire) != read_position_ + 1)
+            break;
+
+        emit(record);
+
+        record.turn.store(read_position_ + CAPACITY, std::memory_order_release);
+        ++read_position_;
+    }
+
+    const uint32_t dropped = dropped_records_.exchange(0, std::memory_order_relaxed);
+    if (dropped != 0)
+    {
+        reshade::log::message(reshade::log::level::warning,
+            ("Log queue full, dropped " + std::to_string(dropped) + " records").c_str());
+    }
+}
+
+void AsyncLog::emit(const Record& record)
+{
+    // Note: Caller must hold drain_mutex_
+
+    if (record.formatter != nullptr)
+    {
+        std::string line;
+        record.formatter(record.text, line);
+        reshade::log::message(record.level, line.c_str());
+        return;
+    }
+
+    if (record.event_name == nullptr)
+    {
+        // Continued records are collected until the last record of the line
+        if (record.continued || !partial_line_.empty())
+        {
+            partial_line_.append(record.text, record.length);
+            if (record.continued)
+                return;
+
+            reshade::log::message(record.level, partial_line_.c_str());
+            partial_line_.clear();
+            return;
+        }
+
+        reshade::log::message(record.level, record.text);
+        return;
+    }
+
+    char header[256];
+    snprintf(header, sizeof(header), "[%08.3f] [%03u] === %s ===", record.timestamp, record.sequence, record.event_name);
+    reshade::log::message(reshade::log::level::info, header);
+}
+
+void CALLBACK AsyncLog::on_records_available(PVOID context, BOOLEAN timed_out)
+{
+    auto* log = static_cast<AsyncLog*>(context);
+
+    // Clear first, a producer publishing during the drain signals again
+    log->signal_pending_.store(false, std::memory_order_release);
+    if (!timed_out)
+        log->drain();
+}
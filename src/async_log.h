@@ -0,0 +1,115 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include "common.h"
+#include <array>
+#include <cstring>
+#include <type_traits>
+
+// Asynchronous log sink for hot paths (debug mode hooks).
+// Producers copy fixed-size binary records into a lock-free multi-producer ring
+// and return; a thread pool callback formats the records and hands them to ReShade.
+// A line longer than one record takes consecutive records and is reassembled by the consumer.
+class AsyncLog
+{
+public:
+    // Singleton access
+    static AsyncLog& get_instance();
+
+    // Start/stop the background consumer. Records written while stopped are logged synchronously.
+    // process_terminating: called from DllMain at process exit (lpReserved != nullptr), see uninstall()
+    void install();
+    void uninstall(bool process_terminating = false);
+
+    // Queue a line of text. Lines longer than MAX_LINE_LENGTH are cut and end with TRUNCATION_MARKER.
+    void write(reshade::log::level level, const char* text);
+    void write(reshade::log::level level, const std::string& text) { write(level, text.c_str()); }
+
+    // Queue the raw arguments of a line, Args::format(args, out) builds the text on the consumer.
+    // Args must be trivially copyable, pointers in it must stay valid forever (string literals).
+    template <typename Args>
+    void write_deferred(reshade::log::level level, const Args& args)
+    {
+        static_assert(std::is_trivially_copyable_v<Args>, "Deferred log arguments are copied as bytes");
+        static_assert(sizeof(Args) <= MAX_TEXT_LENGTH + 1, "Deferred log arguments must fit one record");
+        write_payload(level, &format_payload<Args>, &args, sizeof(Args));
+    }
+
+    // Queue an event header, formatted on the consumer as "[timestamp] [seq] === EVENT_NAME ==="
+    // Note: event_name must be a string literal, only the pointer is stored
+    void write_event(const char* event_name, uint32_t sequence, double timestamp);
+
+    static constexpr size_t CAPACITY = 1024;  // Power of two
+    static constexpr size_t MAX_TEXT_LENGTH = 463;  // Text per record
+    static constexpr size_t MAX_RECORDS_PER_LINE = 8;
+    static constexpr size_t MAX_LINE_LENGTH = MAX_TEXT_LENGTH * MAX_RECORDS_PER_LINE;
+    static constexpr char TRUNCATION_MARKER[] = " [truncated]";
+
+private:
+    AsyncLog() = default;
+    ~AsyncLog() = default;
+
+    // Delete copy/move constructors
+    AsyncLog(const AsyncLog&) = delete;
+    AsyncLog& operator=(const AsyncLog&) = delete;
+    AsyncLog(AsyncLog&&) = delete;
+    AsyncLog& operator=(AsyncLog&&) = delete;
+
+    // Builds the text of a deferred record from its payload
+    using PayloadFormatter = void (*)(const void* payload, std::string& out);
+
+    template <typename Args>
+    static void format_payload(const void* payload, std::string& out)
+    {
+        Args args;
+        std::memcpy(&args, payload, sizeof(Args));
+        Args::format(args, out);
+    }
+
+    // Fixed-size record, turn implements the bounded queue handshake:
+    // turn == position means free for that producer, position + 1 means published
+    struct alignas(64) Record
+    {
+        std::atomic<uint64_t> turn;
+        const char* event_name;      // Event header record when set
+        PayloadFormatter formatter;  // Deferred record when set, text holds the payload
+        double timestamp;
+        uint32_t sequence;
+        reshade::log::level level;
+        uint16_t length;
+        bool continued;              // The next record carries the rest of this line
+        char text[MAX_TEXT_LENGTH + 1];
+    };
+    static_assert(sizeof(Record) == 512, "Record should stay a multiple of the cache line size");
+
+    // Claim count consecutive slots, returns the first one or nullptr when the ring is full
+    Record* begin_write(size_t count, uint64_t& out_position);
+    Record& record_at(uint64_t position) { return records_[position & (CAPACITY - 1)]; }
+    void end_write(uint64_t position, size_t count);
+
+    void write_payload(reshade::log::level level, PayloadFormatter formatter, const void* payload, size_t size);
+
+    // Format and log all published records
+    void drain();
+    void drain_records();
+    void emit(const Record& record);
+
+    // Thread pool callback, signaled when records were published
+    static void CALLBACK on_records_available(PVOID context, BOOLEAN timed_out);
+
+    std::array<Record, CAPACITY> records_ = {};
+    alignas(64) std::atomic<uint64_t> write_position_ = 0;
+    alignas(64) uint64_t read_position_ = 0;
+    std::mutex drain_mutex_;  // Pool callbacks for one wait can overlap, only one may consume
+    std::string partial_line_;  // Continued records read so far (protected by drain_mutex_)
+    std::atomic<bool> signal_pending_ = false;
+    std::atomic<uint32_t> dropped_records_ = 0;
+    std::atomic<bool> running_ = false;
+    HANDLE records_event_ = nullptr;
+    HANDLE wait_handle_ = nullptr;
+};
@@ -14,11 +14,15 @@
 #include <dxgi.h>
 
 // Standard library
+#include <algorithm>
 #include <vector>
 #include <unordered_map>
 #include <cstdlib>
 #include <mutex>
+#include <atomic>
+#include <memory>
 #include <string>
+#include <span>
 
 // Type aliases for clarity
 using SwapchainNativeHandle = uint64_t;  // Native swapchain handle (IDXGISwapChain*, VkSwapchainKHR, etc.)
@@ -26,6 +30,7 @@ using WindowHandle = void*;              // Window handle (HWND, etc.)
 
 // Forward declarations
 class Config;
+class ConfigSnapshot;
 class WindowHooks;
 class SwapchainManager;
 class OverlayManager;
@@ -5,112 +5,387 @@
  */
 
 #include "config.h"
+#include "core/config_parse.h"
+#include "core/profile_database.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
 
 namespace
 {
     constexpr const char* CONFIG_SECTION = "SWAPCHAIN_OVERRIDE";
-}
 
-Config& Config::get_instance()
-{
-    static Config instance;
-    return instance;
+    const char* filter_mode_to_string(reshade::api::filter_mode mode)
+    {
+        switch (mode)
+        {
+        case reshade::api::filter_mode::min_mag_mip_point:
+            return "Point";
+        case reshade::api::filter_mode::min_mag_mip_linear:
+            return "Linear";
+        case reshade::api::filter_mode::min_mag_linear_mip_point:
+            return "Anisotropic";
+        default:
+            return "Unknown";
+        }
+    }
+
+    const char* fullscreen_mode_to_string(FullscreenMode mode)
+    {
+        switch (mode)
+        {
+        case FullscreenMode::Unchanged:
+            return "Unchanged";
+        case FullscreenMode::Borderless:
+            return "Borderless";
+        case FullscreenMode::Exclusive:
+            return "Exclusive";
+        default:
+            return "Unknown";
+        }
+    }
 }
 
-void Config::load()
+// Parsers and formatters referenced by the key schema (friend of ConfigSnapshot)
+struct ConfigSchema
 {
-    // Read forced resolution
-    char resolution_string[32] = {};
-    size_t resolution_string_size = sizeof(resolution_string);
+    // ForceSwapchainResolution=<width>x<height> | <factor>x | <percent>% | fit-monitor, 0x0 disables the override
+    static bool parse_resolution(const ConfigKey&, const char* text, ConfigSnapshot& out)
+    {
+        return parse_resolution_spec(text, out.forced_resolution_);
+    }
 
-    if (reshade::get_config_value(nullptr, CONFIG_SECTION, "ForceSwapchainResolution", resolution_string, &resolution_string_size))
+    static void format_resolution(const ConfigSnapshot& snapshot, char* buffer, size_t buffer_size)
     {
-        char* resolution_p = resolution_string;
-        const unsigned long width = std::strtoul(resolution_p, &resolution_p, 10);
-        const char width_terminator = *resolution_p++;
-        const unsigned long height = std::strtoul(resolution_p, &resolution_p, 10);
+        format_resolution_spec(snapshot.forced_resolution_, buffer, buffer_size);
+    }
 
-        if (width != 0 && height != 0 && width_terminator == 'x')
-        {
-            force_width_ = static_cast<uint32_t>(width);
-            force_height_ = static_cast<uint32_t>(height);
-        }
+    // SwapchainScalingFilter=<0-2>
+    static bool parse_scaling_filter(const ConfigKey& key, const char* text, ConfigSnapshot& out)
+    {
+        constexpr reshade::api::filter_mode filters[] = {
+            reshade::api::filter_mode::min_mag_mip_point,
+            reshade::api::filter_mode::min_mag_mip_linear,
+            reshade::api::filter_mode::min_mag_linear_mip_point,
+        };
+
+        int value = 0;
+        if (!parse_ranged_integer(text, key.min_value, key.max_value, value))
+            return false;
+
+        out.scaling_filter_ = filters[value];
+        return true;
     }
-    else
+
+    static void format_scaling_filter(const ConfigSnapshot& snapshot, char* buffer, size_t buffer_size)
     {
-        // Set default config value
-        reshade::set_config_value(nullptr, CONFIG_SECTION, "ForceSwapchainResolution", "3840x2160");
-        force_width_ = 3840;
-        force_height_ = 2160;
+        snprintf(buffer, buffer_size, "%s", filter_mode_to_string(snapshot.scaling_filter_));
     }
 
-    // Read scaling filter
-    int filter_value = 1; // Default to linear
-    if (reshade::get_config_value(nullptr, CONFIG_SECTION, "SwapchainScalingFilter", filter_value))
+    // FullscreenMode=<0-2>
+    static bool parse_fullscreen_mode(const ConfigKey& key, const char* text, ConfigSnapshot& out)
     {
-        switch (filter_value)
-        {
-        case 0:
-            scaling_filter_ = reshade::api::filter_mode::min_mag_mip_point;
-            break;
-        case 1:
-            scaling_filter_ = reshade::api::filter_mode::min_mag_mip_linear;
-            break;
-        case 2:
-            scaling_filter_ = reshade::api::filter_mode::min_mag_linear_mip_point;
-            break;
-        default:
-            scaling_filter_ = reshade::api::filter_mode::min_mag_mip_linear;
-            break;
-        }
+        int value = 0;
+        if (!parse_ranged_integer(text, key.min_value, key.max_value, value))
+            return false;
+
+        out.fullscreen_mode_ = static_cast<FullscreenMode>(value);
+        return true;
     }
-    else
+
+    static void format_fullscreen_mode(const ConfigSnapshot& snapshot, char* buffer, size_t buffer_size)
     {
-        reshade::set_config_value(nullptr, CONFIG_SECTION, "SwapchainScalingFilter", 1);
+        snprintf(buffer, buffer_size, "%s", fullscreen_mode_to_string(snapshot.fullscreen_mode_));
     }
 
-    // Read fullscreen mode
-    int fullscreen_mode_value = 0; // Default to Unchanged
-    if (reshade::get_config_value(nullptr, CONFIG_SECTION, "FullscreenMode", fullscreen_mode_value))
+    // BlockFullscreenChanges=<0-1>
+    static bool parse_block_fullscreen_changes(const ConfigKey&, const char* text, ConfigSnapshot& out)
     {
-        switch (fullscreen_mode_value)
-        {
-        case 0:
-            fullscreen_mode_ = FullscreenMode::Unchanged;
-            break;
-        case 1:
-            fullscreen_mode_ = FullscreenMode::Borderless;
-            break;
-        case 2:
-            fullscreen_mode_ = FullscreenMode::Exclusive;
-            break;
-        default:
-            fullscreen_mode_ = FullscreenMode::Unchanged;
-            break;
-        }
+        return parse_boolean(text, out.block_fullscreen_changes_);
+    }
+
+    static void format_block_fullscreen_changes(const ConfigSnapshot& snapshot, char* buffer, size_t buffer_size)
+    {
+        snprintf(buffer, buffer_size, "%s", snapshot.block_fullscreen_changes_ ? "Yes" : "No");
+    }
+
+    // TargetMonitor=<0+>
+    static bool parse_target_monitor(const ConfigKey& key, const char* text, ConfigSnapshot& out)
+    {
+        return parse_ranged_integer(text, key.min_value, key.max_value, out.target_monitor_);
+    }
+
+    static void format_target_monitor(const ConfigSnapshot& snapshot, char* buffer, size_t buffer_size)
+    {
+        snprintf(buffer, buffer_size, "%d %s", snapshot.target_monitor_, snapshot.target_monitor_ == 0 ? "(Primary)" : "");
+    }
+
+    // ProxyFallback=<step>[,<step>...] | none
+    static bool parse_proxy_fallback(const ConfigKey&, const char* text, ConfigSnapshot& out)
+    {
+        return parse_proxy_fallback_steps(text, out.proxy_fallback_steps_);
+    }
+
+    static void format_proxy_fallback(const ConfigSnapshot& snapshot, char* buffer, size_t buffer_size)
+    {
+        format_proxy_fallback_steps(snapshot.proxy_fallback_steps_, buffer, buffer_size);
+    }
+
+    // ResizeDebounce=off | <n>ms | <n>frames
+    static bool parse_resize_debounce_spec(const ConfigKey&, const char* text, ConfigSnapshot& out)
+    {
+        return parse_resize_debounce(text, out.resize_debounce_);
+    }
+
+    static void format_resize_debounce_spec(const ConfigSnapshot& snapshot, char* buffer, size_t buffer_size)
+    {
+        format_resize_debounce(snapshot.resize_debounce_, buffer, buffer_size);
+    }
+
+    // DebugMode=<0-1>
+    static bool parse_debug_mode(const ConfigKey&, const char* text, ConfigSnapshot& out)
+    {
+        return parse_boolean(text, out.debug_mode_);
+    }
+
+    static void format_debug_mode(const ConfigSnapshot& snapshot, char* buffer, size_t buffer_size)
+    {
+        snprintf(buffer, buffer_size, "%s", snapshot.debug_mode_ ? "Yes" : "No");
+    }
+
+    // DebugLogRate=<0-1000>
+    static bool parse_debug_log_rate(const ConfigKey& key, const char* text, ConfigSnapshot& out)
+    {
+        return parse_ranged_integer(text, key.min_value, key.max_value, out.debug_log_rate_);
+    }
+
+    static void format_debug_log_rate(const ConfigSnapshot& snapshot, char* buffer, size_t buffer_size)
+    {
+        if (snapshot.debug_log_rate_ == 0)
+            snprintf(buffer, buffer_size, "Unlimited");
+        else
+            snprintf(buffer, buffer_size, "%d/s per hook", snapshot.debug_log_rate_);
+    }
+
+    // DebugLogSummaryFrames=<0-1000000>
+    static bool parse_debug_log_summary_frames(const ConfigKey& key, const char* text, ConfigSnapshot& out)
+    {
+        return parse_ranged_integer(text, key.min_value, key.max_value, out.debug_log_summary_frames_);
+    }
+
+    static void format_debug_log_summary_frames(const ConfigSnapshot& snapshot, char* buffer, size_t buffer_size)
+    {
+        if (snapshot.debug_log_summary_frames_ == 0)
+            snprintf(buffer, buffer_size, "Disabled");
+        else
+            snprintf(buffer, buffer_size, "Every %d frames", snapshot.debug_log_summary_frames_);
     }
-    else
+
+    // WatchConfigFile=<0-1>
+    static bool parse_watch_config_file(const ConfigKey&, const char* text, ConfigSnapshot& out)
+    {
+        return parse_boolean(text, out.watch_config_file_);
+    }
+
+    static void format_watch_config_file(const ConfigSnapshot& snapshot, char* buffer, size_t buffer_size)
+    {
+        snprintf(buffer, buffer_size, "%s", snapshot.watch_config_file_ ? "Yes" : "No");
+    }
+
+    // ProfileDatabase=<path>, relative paths are resolved against the executable directory
+    static bool parse_profile_database(const ConfigKey&, const char* text, ConfigSnapshot& out)
+    {
+        out.profile_database_ = text;
+        return true;
+    }
+
+    static void format_profile_database(const ConfigSnapshot& snapshot, char* buffer, size_t buffer_size)
     {
-        reshade::set_config_value(nullptr, CONFIG_SECTION, "FullscreenMode", 0);
+        if (snapshot.active_profile_.empty())
+            snprintf(buffer, buffer_size, "%s", snapshot.profile_database_.empty() ? "None" : "No matching profile");
+        else
+            snprintf(buffer, buffer_size, "%s", snapshot.active_profile_.c_str());
     }
 
-    // Read block fullscreen changes
-    if (!reshade::get_config_value(nullptr, CONFIG_SECTION, "BlockFullscreenChanges", block_fullscreen_changes_))
+    // TraceFile=<path>, relative paths are resolved against the executable directory
+    static bool parse_trace_file(const ConfigKey&, const char* text, ConfigSnapshot& out)
     {
-        reshade::set_config_value(nullptr, CONFIG_SECTION, "BlockFullscreenChanges", false);
+        out.trace_file_ = text;
+        return true;
     }
 
-    // Read target monitor
-    if (!reshade::get_config_value(nullptr, CONFIG_SECTION, "TargetMonitor", target_monitor_))
+    static void format_trace_file(const ConfigSnapshot& snapshot, char* buffer, size_t buffer_size)
     {
-        reshade::set_config_value(nullptr, CONFIG_SECTION, "TargetMonitor", 0);
-        target_monitor_ = 0;
+        snprintf(buffer, buffer_size, "%s", snapshot.trace_file_.empty() ? "Disabled" : snapshot.trace_file_.c_str());
     }
 
-    // Read debug mode
-    if (!reshade::get_config_value(nullptr, CONFIG_SECTION, "DebugMode", debug_mode_))
+    // ExportStats=<0-1>
+    static bool parse_export_stats(const ConfigKey&, const char* text, ConfigSnapshot& out)
     {
-        reshade::set_config_value(nullptr, CONFIG_SECTION, "DebugMode", false);
-        debug_mode_ = false;
+        return parse_boolean(text, out.export_stats_);
     }
+
+    static void format_export_stats(const ConfigSnapshot& snapshot, char* buffer, size_t buffer_size)
+    {
+        snprintf(buffer, buffer_size, "%s", snapshot.export_stats_ ? "Yes" : "No");
+    }
+
+    // All supported keys, in the order they are loaded and displayed
+    static constexpr ConfigKey keys[] = {
+        { "ForceSwapchainResolution", "Resolution Override", "3840x2160",
+          "<width>x<height> (max 16384), <factor>x, <percent>% (25-800%), fit-monitor or 0x0", 0, 0, parse_resolution, format_resolution },
+        { "SwapchainScalingFilter", "Scaling Filter", "1", "0-2", 0, 2, parse_scaling_filter, format_scaling_filter },
+        { "FullscreenMode", "Fullscreen Mode", "0", "0-2", 0, 2, parse_fullscreen_mode, format_fullscreen_mode },
+        { "BlockFullscreenChanges", "Block Fullscreen Changes", "0", "0 or 1", 0, 1, parse_block_fullscreen_changes, format_block_fullscreen_changes },
+        { "TargetMonitor", "Target Monitor", "0", "0-64", 0, 64, parse_target_monitor, format_target_monitor },
+        { "ProxyFallback", "Proxy Fallback", "fewer-proxies,lower-precision,lower-size",
+          "none or a list of fewer-proxies, lower-precision, lower-size", 0, 0, parse_proxy_fallback, format_proxy_fallback },
+        { "ResizeDebounce", "Resize Debounce", "off", "off, <n>ms or <n>frames (1-10000)", 0, 0, parse_resize_debounce_spec, format_resize_debounce_spec },
+        { "DebugMode", nullptr, "0", "0 or 1", 0, 1, parse_debug_mode, format_debug_mode },
+        { "DebugLogRate", nullptr, "10", "0-1000", 0, 1000, parse_debug_log_rate, format_debug_log_rate },
+        { "DebugLogSummaryFrames", nullptr, "1000", "0-1000000", 0, 1000000, parse_debug_log_summary_frames, format_debug_log_summary_frames },
+        { "WatchConfigFile", "Watch Config File", "1", "0 or 1", 0, 1, parse_watch_config_file, format_watch_config_file },
+        { "ProfileDatabase", "Profile", "", "<path>", 0, 0, parse_profile_database, format_profile_database },
+        { "TraceFile", "Trace File", "", "<path>", 0, 0, parse_trace_file, format_trace_file },
+        { "ExportStats", "Export Stats", "0", "0 or 1", 0, 1, parse_export_stats, format_export_stats },
+    };
+};
+
+Config& Config::get_instance()
+{
+    static Config instance;
+    return instance;
+}
+
+Config::Config()
+{
+    // Start with defaults so the snapshot is valid before load() runs
+    published_ = std::make_unique<ConfigSnapshot>();
+    current_.store(published_.get(), std::memory_order_release);
+}
+
+size_t Config::get_retained_snapshot_count() const
+{
+    std::lock_guard<std::mutex> lock(load_mutex_);
+    return retired_.size() + 1;
+}
+
+std::span<const ConfigKey> Config::get_schema()
+{
+    return ConfigSchema::keys;
+}
+
+void Config::publish(std::unique_ptr<const ConfigSnapshot> snapshot)
+{
+    // Note: Caller must hold load_mutex_
+    current_.store(snapshot.get(), std::memory_order_release);
+    retired_.push_back(std::move(published_));
+    published_ = std::move(snapshot);
+}
+
+void Config::load()
+{
+    std::lock_guard<std::mutex> lock(load_mutex_);
+
+    // Build a fresh snapshot, readers keep using the current one until it is published
+    auto snapshot = std::make_unique<ConfigSnapshot>();
+
+    // Single pass over the schema: read, write back missing defaults, parse and validate
+    for (const ConfigKey& key : ConfigSchema::keys)
+    {
+        char value[MAX_PATH] = {};
+        size_t value_size = sizeof(value);
+        const char* text = value;
+
+        if (!reshade::get_config_value(nullptr, CONFIG_SECTION, key.name, value, &value_size))
+        {
+            reshade::set_config_value(nullptr, CONFIG_SECTION, key.name, key.default_value);
+            text = key.default_value;
+        }
+
+        // Invalid values keep the built-in default of the snapshot
+        if (!key.parse(key, text, *snapshot))
+        {
+            reshade::log::message(reshade::log::level::warning,
+                ("Ignoring invalid value '" + std::string(text) + "' for " + key.name + ", expected " + key.syntax).c_str());
+        }
+    }
+
+    apply_executable_profile(*snapshot);
+
+    // ReShade rewrites its ini for unrelated reasons, an unchanged configuration keeps the current snapshot
+    if (*snapshot == *published_)
+        return;
+
+    // Toggling between configurations reuses their earlier snapshots instead of retiring a new one each time
+    const auto earlier = std::find_if(retired_.begin(), retired_.end(),
+        [&snapshot](const std::unique_ptr<const ConfigSnapshot>& retired) { return *retired == *snapshot; });
+    if (earlier != retired_.end())
+    {
+        std::unique_ptr<const ConfigSnapshot> reused = std::move(*earlier);
+        retired_.erase(earlier);
+        publish(std::move(reused));
+        return;
+    }
+
+    publish(std::move(snapshot));
+}
+
+void Config::apply_executable_profile(ConfigSnapshot& values)
+{
+    if (values.profile_database_.empty())
+        return;
+
+    wchar_t module_path[MAX_PATH] = {};
+    const DWORD length = GetModuleFileNameW(nullptr, module_path, MAX_PATH);
+    if (length == 0 || length == MAX_PATH)
+        return;
+
+    const std::filesystem::path executable_path(module_path);
+    std::filesystem::path source_path(reinterpret_cast<const char8_t*>(values.profile_database_.c_str()));
+    if (source_path.is_relative())
+        source_path = executable_path.parent_path() / source_path;
+
+    // Only recompiles the index when the text source changed
+    std::string error;
+    if (!ProfileDatabase::update_index(source_path, GetCurrentProcessId(), error))
+    {
+        reshade::log::message(reshade::log::level::warning, ("Profile database unavailable: " + error).c_str());
+        return;
+    }
+
+    const std::u8string executable_name = executable_path.filename().u8string();
+    const std::string_view name(reinterpret_cast<const char*>(executable_name.data()), executable_name.size());
+
+    std::vector<ProfileSetting> settings;
+    if (!ProfileDatabase::find_profile(ProfileDatabase::index_path_for(source_path), name, settings))
+        return;
+
+    // Profile values go through the same parsers as ReShade.ini values
+    for (const ProfileSetting& setting : settings)
+    {
+        const ConfigKey* key = nullptr;
+        for (const ConfigKey& candidate : ConfigSchema::keys)
+        {
+            if (_stricmp(candidate.name, setting.key.c_str()) == 0)
+                key = &candidate;
+        }
+
+        if (key == nullptr || key->parse == ConfigSchema::parse_profile_database)
+        {
+            reshade::log::message(reshade::log::level::warning,
+                ("Ignoring unsupported profile key " + setting.key).c_str());
+            continue;
+        }
+
+        if (!key->parse(*key, setting.value.c_str(), values))
+        {
+            reshade::log::message(reshade::log::level::warning,
+                ("Ignoring invalid profile value '" + setting.value + "' for " + setting.key + ", expected " + key->syntax).c_str());
+        }
+    }
+
+    values.active_profile_ = name;
+    reshade::log::message(reshade::log::level::info,
+        ("Applied profile for " + values.active_profile_ + " (" + std::to_string(settings.size()) + " settings)").c_str());
 }
@@ -7,40 +7,104 @@
 #pragma once
 
 #include "common.h"
+#include "core/fullscreen_policy.h"
+#include "core/proxy_fallback.h"
+#include "core/resize_debounce.h"
+#include "core/resolution.h"
 
-enum class FullscreenMode
+class ConfigSnapshot;
+
+// Description of a single ReShade.ini key in the [SWAPCHAIN_OVERRIDE] section.
+// One constexpr table of these drives loading, validation, default write-back and the overlay.
+struct ConfigKey
 {
-    Unchanged = 0,   // Don't modify fullscreen behavior (default)
-    Borderless = 1,  // Force borderless fullscreen (windowed)
-    Exclusive = 2    // Force exclusive fullscreen
+    const char* name;           // Key name in ReShade.ini
+    const char* label;          // Label shown in the overlay (nullptr = not shown)
+    const char* default_value;  // Written back when the key is missing
+    const char* syntax;         // Accepted values, reported when parsing fails
+    int min_value;              // Accepted range for integer keys
+    int max_value;
+
+    // Parse text into the snapshot, returns false for malformed or out of range values
+    bool (*parse)(const ConfigKey& key, const char* text, ConfigSnapshot& out);
+
+    // Format the current value for display
+    void (*format)(const ConfigSnapshot& snapshot, char* buffer, size_t buffer_size);
 };
 
-class Config
+// Immutable set of configuration values.
+// Published by Config through an atomic pointer; hooks grab one snapshot per call.
+class ConfigSnapshot
 {
 public:
-    // Singleton access
-    static Config& get_instance();
-
-    // Load configuration from ReShade.ini
-    void load();
-
     // Getters
-    uint32_t get_force_width() const { return force_width_; }
-    uint32_t get_force_height() const { return force_height_; }
+    const ResolutionSpec& get_forced_resolution() const { return forced_resolution_; }
     reshade::api::filter_mode get_scaling_filter() const { return scaling_filter_; }
     FullscreenMode get_fullscreen_mode() const { return fullscreen_mode_; }
     bool get_block_fullscreen_changes() const { return block_fullscreen_changes_; }
     int get_target_monitor() const { return target_monitor_; }
+    uint32_t get_proxy_fallback_steps() const { return proxy_fallback_steps_; }
+    const ResizeDebounceSpec& get_resize_debounce() const { return resize_debounce_; }
 
     // Convenience methods
-    bool is_resolution_override_enabled() const { return force_width_ != 0 && force_height_ != 0; }
+    bool is_resolution_override_enabled() const { return forced_resolution_.mode != ResolutionMode::Disabled; }
     bool is_exclusive_fullscreen_enabled() const { return fullscreen_mode_ == FullscreenMode::Exclusive; }
     bool is_borderless_fullscreen_enabled() const { return fullscreen_mode_ == FullscreenMode::Borderless; }
     bool is_fullscreen_mode_overridden() const { return fullscreen_mode_ != FullscreenMode::Unchanged; }
     bool is_debug_mode_enabled() const { return debug_mode_; }
+    int get_debug_log_rate() const { return debug_log_rate_; }
+    int get_debug_log_summary_frames() const { return debug_log_summary_frames_; }
+    bool is_config_watch_enabled() const { return watch_config_file_; }
+    const std::string& get_profile_database() const { return profile_database_; }
+    const std::string& get_active_profile() const { return active_profile_; }
+    const std::string& get_trace_file() const { return trace_file_; }
+    bool is_stats_export_enabled() const { return export_stats_; }
+
+    bool operator==(const ConfigSnapshot& other) const = default;
 
 private:
-    Config() = default;
+    friend class Config;
+    friend struct ConfigSchema;
+
+    // Configuration values
+    ResolutionSpec forced_resolution_;
+    reshade::api::filter_mode scaling_filter_ = reshade::api::filter_mode::min_mag_mip_linear;
+    FullscreenMode fullscreen_mode_ = FullscreenMode::Unchanged;
+    bool block_fullscreen_changes_ = false;
+    int target_monitor_ = 0; // 0 = primary, 1+ = secondary monitors
+    uint32_t proxy_fallback_steps_ = PROXY_FALLBACK_DEFAULT; // ProxyFallbackStep bits tried when proxies cannot be created
+    ResizeDebounceSpec resize_debounce_; // Quiet period before proxies are rebuilt after a resize (off = at once)
+    bool debug_mode_ = false; // When enabled, log all events without modifying behavior
+    int debug_log_rate_ = 10; // Logged calls per second and hook in debug mode (0 = unlimited)
+    int debug_log_summary_frames_ = 1000; // Frames between hook counter summaries in debug mode (0 = disabled)
+    bool watch_config_file_ = true; // Reload automatically when ReShade.ini changes
+    std::string profile_database_; // Per-executable profile source (empty = disabled)
+    std::string active_profile_; // Executable whose profile was applied (empty = none)
+    std::string trace_file_; // Binary event trace output (empty = disabled)
+    bool export_stats_ = false; // Publish live statistics in shared memory
+};
+
+class Config
+{
+public:
+    // Singleton access
+    static Config& get_instance();
+
+    // Load configuration from ReShade.ini and publish it as a new snapshot
+    void load();
+
+    // Current configuration (lock-free). The returned snapshot is never freed while the addon is loaded,
+    // but a reload may replace it, so read it once per hook call, overlay frame or reload.
+    const ConfigSnapshot& snapshot() const { return *current_.load(std::memory_order_acquire); }
+
+    // Snapshots kept alive for readers, the current one included
+    size_t get_retained_snapshot_count() const;
+
+    // Table of all supported keys
+    static std::span<const ConfigKey> get_schema();
+
+private:
+    Config();
     ~Config() = default;
 
     // Delete copy/move constructors
@@ -49,12 +113,21 @@ private:
     Config(Config&&) = delete;
     Config& operator=(Config&&) = delete;
 
-    // Configuration values
-    uint32_t force_width_ = 0;
-    uint32_t force_height_ = 0;
-    reshade::api::filter_mode scaling_filter_ = reshade::api::filter_mode::min_mag_mip_linear;
-    FullscreenMode fullscreen_mode_ = FullscreenMode::Unchanged;
-    bool block_fullscreen_changes_ = false;
-    int target_monitor_ = 0; // 0 = primary, 1+ = secondary monitors
-    bool debug_mode_ = false; // When enabled, log all events without modifying behavior
+    // Make a snapshot visible to all threads
+    void publish(std::unique_ptr<const ConfigSnapshot> snapshot);
+
+    // Override values with the profile for the running executable, if any
+    static void apply_executable_profile(ConfigSnapshot& values);
+
+    // Currently published snapshot, owned by published_
+    std::atomic<const ConfigSnapshot*> current_;
+
+    // Guarded by load_mutex_
+    std::unique_ptr<const ConfigSnapshot> published_;
+
+    // Replaced snapshots. A hook on another thread may still read one, and there is no point after
+    // which that is known not to happen, so they are only freed with the Config at unload. A reload
+    // back to one of them publishes it again, which bounds them by the distinct configurations loaded.
+    std::vector<std::unique_ptr<const ConfigSnapshot>> retired_;
+    mutable std::mutex load_mutex_;
 };
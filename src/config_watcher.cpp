@@ -0,0 +1,127 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "config_watcher.h"
+#include "config.h"
+#include "swapchain_manager.h"
+#include "window_hooks.h"
+
+ConfigWatcher& ConfigWatcher::get_instance()
+{
+    static ConfigWatcher instance;
+    return instance;
+}
+
+void ConfigWatcher::install()
+{
+    if (!Config::get_instance().snapshot().is_config_watch_enabled())
+        return;
+
+    // ReShade.ini lives next to the application executable
+    wchar_t module_path[MAX_PATH] = {};
+    const DWORD length = GetModuleFileNameW(nullptr, module_path, MAX_PATH);
+    if (length == 0 || length == MAX_PATH)
+        return;
+
+    std::wstring directory(module_path, length);
+    directory.erase(directory.find_last_of(L"\\/") + 1);
+    ini_path_ = directory + L"ReShade.ini";
+    has_ini_changed(); // Record the current write time
+
+    change_handle_ = FindFirstChangeNotificationW(directory.c_str(), FALSE, FILE_NOTIFY_CHANGE_LAST_WRITE);
+    if (change_handle_ == INVALID_HANDLE_VALUE)
+    {
+        reshade::log::message(reshade::log::level::warning, "Failed to watch ReShade.ini for changes, hot reload only available from the overlay");
+        return;
+    }
+
+    // Wait on the thread pool instead of a dedicated thread, which could not be joined safely under the loader lock
+    if (!RegisterWaitForSingleObject(&wait_handle_, change_handle_, on_directory_changed, this, INFINITE, WT_EXECUTEDEFAULT))
+    {
+        FindCloseChangeNotification(change_handle_);
+        change_handle_ = INVALID_HANDLE_VALUE;
+        wait_handle_ = nullptr;
+        return;
+    }
+
+    watching_.store(true, std::memory_order_release);
+    reshade::log::message(reshade::log::level::info, "Watching ReShade.ini for configuration changes");
+}
+
+void ConfigWatcher::uninstall(bool process_terminating)
+{
+    // Waiting for the pool under the loader lock at process exit could hang on a callback that was cut off
+    if (process_terminating)
+        return;
+
+    // On FreeLibrary the wait below runs under the loader lock. A reload loads the profile index and may
+    // install hooks, so a notification arriving now must not start one.
+    watching_.store(false, std::memory_order_release);
+
+    if (wait_handle_ != nullptr)
+    {
+        // Blocks until a running callback has finished
+        UnregisterWaitEx(wait_handle_, INVALID_HANDLE_VALUE);
+        wait_handle_ = nullptr;
+    }
+
+    if (change_handle_ != INVALID_HANDLE_VALUE)
+    {
+        FindCloseChangeNotification(change_handle_);
+        change_handle_ = INVALID_HANDLE_VALUE;
+    }
+}
+
+void CALLBACK ConfigWatcher::on_directory_changed(PVOID context, BOOLEAN timed_out)
+{
+    auto* watcher = static_cast<ConfigWatcher*>(context);
+
+    if (!watcher->watching_.load(std::memory_order_acquire))
+        return;
+
+    // Other files in the directory trigger the notification too
+    if (!timed_out && watcher->has_ini_changed())
+        watcher->reload();
+
+    FindNextChangeNotification(watcher->change_handle_);
+}
+
+bool ConfigWatcher::has_ini_changed()
+{
+    WIN32_FILE_ATTRIBUTE_DATA attributes = {};
+    if (!GetFileAttributesExW(ini_path_.c_str(), GetFileExInfoStandard, &attributes))
+        return false;
+
+    if (CompareFileTime(&attributes.ftLastWriteTime, &last_write_time_) == 0)
+        return false;
+
+    last_write_time_ = attributes.ftLastWriteTime;
+    return true;
+}
+
+void ConfigWatcher::reload()
+{
+    std::lock_guard<std::mutex> lock(reload_mutex_);
+
+    Config& config = Config::get_instance();
+    const ConfigSnapshot& previous = config.snapshot();
+    config.load();
+    const ConfigSnapshot& current = config.snapshot();
+
+    // ReShade rewrites its ini for unrelated reasons, ignore those
+    if (previous == current)
+        return;
+
+    reshade::log::message(reshade::log::level::info, "Configuration reloaded");
+
+    if (previous.get_fullscreen_mode() != current.get_fullscreen_mode() ||
+        previous.is_debug_mode_enabled() != current.is_debug_mode_enabled())
+    {
+        WindowHooks::get_instance().refresh();
+    }
+
+    SwapchainManager::get_instance().apply_config_change(previous, current);
+}
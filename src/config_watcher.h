@@ -0,0 +1,48 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include "common.h"
+
+// Reloads ReShade.ini at runtime and applies only what changed
+class ConfigWatcher
+{
+public:
+    // Singleton access
+    static ConfigWatcher& get_instance();
+
+    // Start/stop watching ReShade.ini for changes. At process exit (process_terminating) the thread
+    // pool is gone and the handles are closed by the system, so uninstall does nothing.
+    void install();
+    void uninstall(bool process_terminating = false);
+
+    // Reload the configuration now (overlay button or file change)
+    void reload();
+
+private:
+    ConfigWatcher() = default;
+    ~ConfigWatcher() = default;
+
+    // Delete copy/move constructors
+    ConfigWatcher(const ConfigWatcher&) = delete;
+    ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+    ConfigWatcher(ConfigWatcher&&) = delete;
+    ConfigWatcher& operator=(ConfigWatcher&&) = delete;
+
+    // Thread pool callback, signaled when the watched directory changes
+    static void CALLBACK on_directory_changed(PVOID context, BOOLEAN timed_out);
+
+    // Check whether ReShade.ini was written since the last check
+    bool has_ini_changed();
+
+    std::wstring ini_path_;
+    FILETIME last_write_time_ = {};
+    HANDLE change_handle_ = INVALID_HANDLE_VALUE;
+    HANDLE wait_handle_ = nullptr;
+    std::atomic<bool> watching_ = false;  // Cleared before uninstall waits, a late notification then skips the reload
+    std::mutex reload_mutex_;
+};
@@ -0,0 +1,53 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "core/config_parse.h"
+#include <charconv>
+#include <cstring>
+
+bool parse_integer(const char* text, long& out_value)
+{
+    if (text == nullptr || *text == '\0')
+        return false;
+
+    // std::from_chars takes no leading whitespace or '+' and reports overflow instead of clamping
+    const char* const text_end = text + std::strlen(text);
+    long value = 0;
+    const auto [end, error] = std::from_chars(text, text_end, value);
+    if (error != std::errc() || end != text_end)
+        return false;
+
+    out_value = value;
+    return true;
+}
+
+bool parse_ranged_integer(const char* text, int min_value, int max_value, int& out_value)
+{
+    long value = 0;
+    if (!parse_integer(text, value) || value < min_value || value > max_value)
+        return false;
+
+    out_value = static_cast<int>(value);
+    return true;
+}
+
+bool parse_boolean(const char* text, bool& out_value)
+{
+    if (text == nullptr)
+        return false;
+
+    if (std::strcmp(text, "1") == 0 || std::strcmp(text, "true") == 0)
+    {
+        out_value = true;
+        return true;
+    }
+    if (std::strcmp(text, "0") == 0 || std::strcmp(text, "false") == 0)
+    {
+        out_value = false;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,18 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+// Standard library only (portable core)
+
+// Parse a decimal integer, the whole string must be consumed (no whitespace or '+', no overflow)
+bool parse_integer(const char* text, long& out_value);
+
+// Parse an integer and check it against [min_value, max_value]
+bool parse_ranged_integer(const char* text, int min_value, int max_value, int& out_value);
+
+// Accepts 0/1 and false/true
+bool parse_boolean(const char* text, bool& out_value);
@@ -0,0 +1,330 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+// Standard library only (portable core). The Win32 and DXGI values are repeated here
+// so the tables can be constexpr and checked without Windows headers.
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+// Lookup tables for window styles, SetWindowPos flags, HRESULTs and DXGI formats, and a
+// formatter that writes into a caller-provided buffer instead of allocating.
+namespace decode
+{
+    // Large enough for every flag of the biggest table plus the hex value
+    constexpr size_t TEXT_BUFFER_SIZE = 512;
+
+    // Appends to a fixed buffer and keeps it null-terminated. Text that does not fit is cut off.
+    class TextWriter
+    {
+    public:
+        constexpr TextWriter(std::span<char> buffer) : buffer_(buffer)
+        {
+            if (!buffer_.empty())
+                buffer_[0] = '\0';
+        }
+
+        constexpr TextWriter& append(std::string_view text)
+        {
+            for (const char c : text)
+            {
+                if (length_ + 1 >= buffer_.size())
+                    break;
+                buffer_[length_++] = c;
+            }
+            if (!buffer_.empty())
+                buffer_[length_] = '\0';
+            return *this;
+        }
+
+        // Upper-case hex with a 0x prefix and no leading zeros
+        constexpr TextWriter& append_hex(uint32_t value)
+        {
+            char digits[10] = { '0', 'x' };
+            int shift = 28;
+            while (shift > 0 && ((value >> shift) & 0xF) == 0)
+                shift -= 4;
+
+            size_t count = 2;
+            for (; shift >= 0; shift -= 4)
+                digits[count++] = "0123456789ABCDEF"[(value >> shift) & 0xF];
+            return append(std::string_view(digits, count));
+        }
+
+        constexpr const char* c_str() const { return buffer_.empty() ? "" : buffer_.data(); }
+        constexpr size_t length() const { return length_; }
+
+    private:
+        std::span<char> buffer_;
+        size_t length_ = 0;
+    };
+
+    struct FlagName
+    {
+        uint32_t mask;      // Matches when all of its bits are set
+        const char* name;
+    };
+
+    struct ValueName
+    {
+        uint32_t value;
+        const char* name;
+    };
+
+    // Combined masks come before their parts, so WS_CAPTION hides WS_BORDER | WS_DLGFRAME.
+    // The low 16 bits are class specific and are printed as a remainder.
+    constexpr FlagName WINDOW_STYLES[] = {
+        { 0x80000000, "WS_POPUP" },
+        { 0x40000000, "WS_CHILD" },
+        { 0x20000000, "WS_MINIMIZE" },
+        { 0x10000000, "WS_VISIBLE" },
+        { 0x08000000, "WS_DISABLED" },
+        { 0x04000000, "WS_CLIPSIBLINGS" },
+        { 0x02000000, "WS_CLIPCHILDREN" },
+        { 0x01000000, "WS_MAXIMIZE" },
+        { 0x00C00000, "WS_CAPTION" },
+        { 0x00800000, "WS_BORDER" },
+        { 0x00400000, "WS_DLGFRAME" },
+        { 0x00200000, "WS_VSCROLL" },
+        { 0x00100000, "WS_HSCROLL" },
+        { 0x00080000, "WS_SYSMENU" },
+        { 0x00040000, "WS_THICKFRAME" },
+        { 0x00020000, "WS_MINIMIZEBOX" },  // WS_GROUP on child windows
+        { 0x00010000, "WS_MAXIMIZEBOX" },  // WS_TABSTOP on child windows
+    };
+
+    constexpr FlagName WINDOW_EX_STYLES[] = {
+        { 0x00000001, "WS_EX_DLGMODALFRAME" },
+        { 0x00000004, "WS_EX_NOPARENTNOTIFY" },
+        { 0x00000008, "WS_EX_TOPMOST" },
+        { 0x00000010, "WS_EX_ACCEPTFILES" },
+        { 0x00000020, "WS_EX_TRANSPARENT" },
+        { 0x00000040, "WS_EX_MDICHILD" },
+        { 0x00000080, "WS_EX_TOOLWINDOW" },
+        { 0x00000100, "WS_EX_WINDOWEDGE" },
+        { 0x00000200, "WS_EX_CLIENTEDGE" },
+        { 0x00000400, "WS_EX_CONTEXTHELP" },
+        { 0x00001000, "WS_EX_RIGHT" },
+        { 0x00002000, "WS_EX_RTLREADING" },
+        { 0x00004000, "WS_EX_LEFTSCROLLBAR" },
+        { 0x00010000, "WS_EX_CONTROLPARENT" },
+        { 0x00020000, "WS_EX_STATICEDGE" },
+        { 0x00040000, "WS_EX_APPWINDOW" },
+        { 0x00080000, "WS_EX_LAYERED" },
+        { 0x00100000, "WS_EX_NOINHERITLAYOUT" },
+        { 0x00200000, "WS_EX_NOREDIRECTIONBITMAP" },
+        { 0x00400000, "WS_EX_LAYOUTRTL" },
+        { 0x02000000, "WS_EX_COMPOSITED" },
+        { 0x08000000, "WS_EX_NOACTIVATE" },
+    };
+
+    constexpr FlagName SET_WINDOW_POS_FLAGS[] = {
+        { 0x0001, "SWP_NOSIZE" },
+        { 0x0002, "SWP_NOMOVE" },
+        { 0x0004, "SWP_NOZORDER" },
+        { 0x0008, "SWP_NOREDRAW" },
+        { 0x0010, "SWP_NOACTIVATE" },
+        { 0x0020, "SWP_FRAMECHANGED" },
+        { 0x0040, "SWP_SHOWWINDOW" },
+        { 0x0080, "SWP_HIDEWINDOW" },
+        { 0x0100, "SWP_NOCOPYBITS" },
+        { 0x0200, "SWP_NOOWNERZORDER" },
+        { 0x0400, "SWP_NOSENDCHANGING" },
+        { 0x2000, "SWP_DEFERERASE" },
+        { 0x4000, "SWP_ASYNCWINDOWPOS" },
+    };
+
+    // Sorted by value for binary search
+    constexpr ValueName HRESULTS[] = {
+        { 0x00000000, "S_OK" },
+        { 0x00000001, "S_FALSE" },
+        { 0x087A0001, "DXGI_STATUS_OCCLUDED" },
+        { 0x087A0002, "DXGI_STATUS_CLIPPED" },
+        { 0x087A0004, "DXGI_STATUS_NO_REDIRECTION" },
+        { 0x087A0005, "DXGI_STATUS_NO_DESKTOP_ACCESS" },
+        { 0x087A0006, "DXGI_STATUS_GRAPHICS_VIDPN_SOURCE_IN_USE" },
+        { 0x087A0007, "DXGI_STATUS_MODE_CHANGED" },
+        { 0x087A0008, "DXGI_STATUS_MODE_CHANGE_IN_PROGRESS" },
+        { 0x087A0009, "DXGI_STATUS_UNOCCLUDED" },
+        { 0x087A000A, "DXGI_STATUS_DDA_WAS_STILL_DRAWING" },
+        { 0x087A002F, "DXGI_STATUS_PRESENT_REQUIRED" },
+        { 0x80004001, "E_NOTIMPL" },
+        { 0x80004002, "E_NOINTERFACE" },
+        { 0x80004003, "E_POINTER" },
+        { 0x80004004, "E_ABORT" },
+        { 0x80004005, "E_FAIL" },
+        { 0x8000FFFF, "E_UNEXPECTED" },
+        { 0x80070005, "E_ACCESSDENIED" },
+        { 0x80070006, "E_HANDLE" },
+        { 0x8007000E, "E_OUTOFMEMORY" },
+        { 0x80070057, "E_INVALIDARG" },
+        { 0x887A0001, "DXGI_ERROR_INVALID_CALL" },
+        { 0x887A0002, "DXGI_ERROR_NOT_FOUND" },
+        { 0x887A0003, "DXGI_ERROR_MORE_DATA" },
+        { 0x887A0004, "DXGI_ERROR_UNSUPPORTED" },
+        { 0x887A0005, "DXGI_ERROR_DEVICE_REMOVED" },
+        { 0x887A0006, "DXGI_ERROR_DEVICE_HUNG" },
+        { 0x887A0007, "DXGI_ERROR_DEVICE_RESET" },
+        { 0x887A000A, "DXGI_ERROR_WAS_STILL_DRAWING" },
+        { 0x887A000B, "DXGI_ERROR_FRAME_STATISTICS_DISJOINT" },
+        { 0x887A000C, "DXGI_ERROR_GRAPHICS_VIDPN_SOURCE_IN_USE" },
+        { 0x887A0020, "DXGI_ERROR_DRIVER_INTERNAL_ERROR" },
+        { 0x887A0021, "DXGI_ERROR_NONEXCLUSIVE" },
+        { 0x887A0022, "DXGI_ERROR_NOT_CURRENTLY_AVAILABLE" },
+        { 0x887A0023, "DXGI_ERROR_REMOTE_CLIENT_DISCONNECTED" },
+        { 0x887A0024, "DXGI_ERROR_REMOTE_OUTOFMEMORY" },
+        { 0x887A0025, "DXGI_ERROR_MODE_CHANGE_IN_PROGRESS" },
+        { 0x887A0026, "DXGI_ERROR_ACCESS_LOST" },
+        { 0x887A0027, "DXGI_ERROR_WAIT_TIMEOUT" },
+        { 0x887A0028, "DXGI_ERROR_SESSION_DISCONNECTED" },
+        { 0x887A0029, "DXGI_ERROR_RESTRICT_TO_OUTPUT_STALE" },
+        { 0x887A002A, "DXGI_ERROR_CANNOT_PROTECT_CONTENT" },
+        { 0x887A002B, "DXGI_ERROR_ACCESS_DENIED" },
+        { 0x887A002C, "DXGI_ERROR_NAME_ALREADY_EXISTS" },
+        { 0x887A002D, "DXGI_ERROR_SDK_COMPONENT_MISSING" },
+        { 0x887A002E, "DXGI_ERROR_NOT_CURRENT" },
+        { 0x887A0030, "DXGI_ERROR_HW_PROTECTION_OUTOFMEMORY" },
+        { 0x887A0031, "DXGI_ERROR_DYNAMIC_CODE_POLICY_VIOLATION" },
+        { 0x887A0032, "DXGI_ERROR_NON_COMPOSITED_UI" },
+        { 0x887A0033, "DXGI_ERROR_CACHE_CORRUPT" },
+        { 0x887A0034, "DXGI_ERROR_CACHE_FULL" },
+        { 0x887A0035, "DXGI_ERROR_CACHE_HASH_COLLISION" },
+        { 0x887A0036, "DXGI_ERROR_ALREADY_EXISTS" },
+        { 0x887C0001, "D3D11_ERROR_TOO_MANY_UNIQUE_STATE_OBJECTS" },
+        { 0x887C0002, "D3D11_ERROR_FILE_NOT_FOUND" },
+        { 0x887C0003, "D3D11_ERROR_TOO_MANY_UNIQUE_VIEW_OBJECTS" },
+        { 0x887C0004, "D3D11_ERROR_DEFERRED_CONTEXT_MAP_WITHOUT_INITIAL_DISCARD" },
+        { 0x887E0001, "D3D12_ERROR_ADAPTER_NOT_FOUND" },
+        { 0x887E0002, "D3D12_ERROR_DRIVER_VERSION_MISMATCH" },
+    };
+
+    // DXGI_FORMAT names without the prefix, indexed by value (reshade::api::format uses the same values).
+    // nullptr marks values that DXGI leaves unassigned.
+    constexpr const char* DXGI_FORMATS[] = {
+        "UNKNOWN",
+        "R32G32B32A32_TYPELESS", "R32G32B32A32_FLOAT", "R32G32B32A32_UINT", "R32G32B32A32_SINT",
+        "R32G32B32_TYPELESS", "R32G32B32_FLOAT", "R32G32B32_UINT", "R32G32B32_SINT",
+        "R16G16B16A16_TYPELESS", "R16G16B16A16_FLOAT", "R16G16B16A16_UNORM", "R16G16B16A16_UINT", "R16G16B16A16_SNORM", "R16G16B16A16_SINT",
+        "R32G32_TYPELESS", "R32G32_FLOAT", "R32G32_UINT", "R32G32_SINT",
+        "R32G8X24_TYPELESS", "D32_FLOAT_S8X24_UINT", "R32_FLOAT_X8X24_TYPELESS", "X32_TYPELESS_G8X24_UINT",
+        "R10G10B10A2_TYPELESS", "R10G10B10A2_UNORM", "R10G10B10A2_UINT", "R11G11B10_FLOAT",
+        "R8G8B8A8_TYPELESS", "R8G8B8A8_UNORM", "R8G8B8A8_UNORM_SRGB", "R8G8B8A8_UINT", "R8G8B8A8_SNORM", "R8G8B8A8_SINT",
+        "R16G16_TYPELESS", "R16G16_FLOAT", "R16G16_UNORM", "R16G16_UINT", "R16G16_SNORM", "R16G16_SINT",
+        "R32_TYPELESS", "D32_FLOAT", "R32_FLOAT", "R32_UINT", "R32_SINT",
+        "R24G8_TYPELESS", "D24_UNORM_S8_UINT", "R24_UNORM_X8_TYPELESS", "X24_TYPELESS_G8_UINT",
+        "R8G8_TYPELESS", "R8G8_UNORM", "R8G8_UINT", "R8G8_SNORM", "R8G8_SINT",
+        "R16_TYPELESS", "R16_FLOAT", "D16_UNORM", "R16_UNORM", "R16_UINT", "R16_SNORM", "R16_SINT",
+        "R8_TYPELESS", "R8_UNORM", "R8_UINT", "R8_SNORM", "R8_SINT", "A8_UNORM", "R1_UNORM",
+        "R9G9B9E5_SHAREDEXP", "R8G8_B8G8_UNORM", "G8R8_G8B8_UNORM",
+        "BC1_TYPELESS", "BC1_UNORM", "BC1_UNORM_SRGB", "BC2_TYPELESS", "BC2_UNORM", "BC2_UNORM_SRGB",
+        "BC3_TYPELESS", "BC3_UNORM", "BC3_UNORM_SRGB", "BC4_TYPELESS", "BC4_UNORM", "BC4_SNORM",
+        "BC5_TYPELESS", "BC5_UNORM", "BC5_SNORM",
+        "B5G6R5_UNORM", "B5G5R5A1_UNORM", "B8G8R8A8_UNORM", "B8G8R8X8_UNORM", "R10G10B10_XR_BIAS_A2_UNORM",
+        "B8G8R8A8_TYPELESS", "B8G8R8A8_UNORM_SRGB", "B8G8R8X8_TYPELESS", "B8G8R8X8_UNORM_SRGB",
+        "BC6H_TYPELESS", "BC6H_UF16", "BC6H_SF16", "BC7_TYPELESS", "BC7_UNORM", "BC7_UNORM_SRGB",
+        "AYUV", "Y410", "Y416", "NV12", "P010", "P016", "420_OPAQUE", "YUY2", "Y210", "Y216", "NV11", "AI44", "IA44", "P8", "A8P8",
+        "B4G4R4A4_UNORM",
+        nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr,
+        "P208", "V208", "V408",
+    };
+
+    // Formats after the dense range
+    constexpr ValueName DXGI_FORMATS_EXTENDED[] = {
+        { 189, "SAMPLER_FEEDBACK_MIN_MIP_OPAQUE" },
+        { 190, "SAMPLER_FEEDBACK_MIP_REGION_USED_OPAQUE" },
+        { 191, "A4B4G4R4_UNORM" },
+    };
+
+    static_assert(std::size(DXGI_FORMATS) == 133, "DXGI_FORMATS must be indexed by DXGI_FORMAT value");
+    static_assert([] {
+        for (size_t i = 1; i < std::size(HRESULTS); ++i)
+        {
+            if (HRESULTS[i - 1].value >= HRESULTS[i].value)
+                return false;
+        }
+        return true;
+    }(), "HRESULTS must be sorted by value");
+
+    // Name of a DXGI format, nullptr if unknown
+    constexpr const char* dxgi_format_name(uint32_t format)
+    {
+        if (format < std::size(DXGI_FORMATS))
+            return DXGI_FORMATS[format];
+        for (const ValueName& entry : DXGI_FORMATS_EXTENDED)
+        {
+            if (entry.value == format)
+                return entry.name;
+        }
+        return nullptr;
+    }
+
+    // Name of an HRESULT, nullptr if unknown
+    constexpr const char* hresult_name(uint32_t hr)
+    {
+        size_t first = 0;
+        size_t last = std::size(HRESULTS);
+        while (first < last)
+        {
+            const size_t middle = first + (last - first) / 2;
+            if (HRESULTS[middle].value < hr)
+                first = middle + 1;
+            else
+                last = middle;
+        }
+        return first < std::size(HRESULTS) && HRESULTS[first].value == hr ? HRESULTS[first].name : nullptr;
+    }
+
+    // "0x<value> (NAME | NAME | 0x<unknown bits>)", or "0x0 (none)"
+    constexpr const char* write_flags(TextWriter& writer, uint32_t value, std::span<const FlagName> flags)
+    {
+        writer.append_hex(value).append(" (");
+
+        uint32_t remaining = value;
+        bool first = true;
+        for (const FlagName& flag : flags)
+        {
+            if ((remaining & flag.mask) != flag.mask)
+                continue;
+
+            writer.append(first ? "" : " | ").append(flag.name);
+            remaining &= ~flag.mask;
+            first = false;
+        }
+
+        if (remaining != 0)
+            writer.append(first ? "" : " | ").append_hex(remaining);
+        else if (first)
+            writer.append("none");
+
+        return writer.append(")").c_str();
+    }
+
+    // "0x<value> (NAME)", the name is left out if unknown
+    constexpr const char* write_hresult(TextWriter& writer, uint32_t hr)
+    {
+        writer.append_hex(hr);
+        if (const char* name = hresult_name(hr))
+            writer.append(" (").append(name).append(")");
+        return writer.c_str();
+    }
+
+    // "NAME", or "0x<value>" for formats outside the DXGI set
+    constexpr const char* write_dxgi_format(TextWriter& writer, uint32_t format)
+    {
+        if (const char* name = dxgi_format_name(format))
+            return writer.append(name).c_str();
+        return writer.append_hex(format).c_str();
+    }
+
+    static_assert([] {
+        char buffer[64] = {};
+        TextWriter writer(buffer);
+        return std::string_view(write_flags(writer, 0x10C00001, WINDOW_STYLES)) == "0x10C00001 (WS_VISIBLE | WS_CAPTION | 0x1)";
+    }());
+}
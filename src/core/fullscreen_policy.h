@@ -0,0 +1,42 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+// Standard library only (portable core)
+#include <cstdint>
+
+enum class FullscreenMode
+{
+    Unchanged = 0,   // Don't modify fullscreen behavior (default)
+    Borderless = 1,  // Force borderless fullscreen (windowed)
+    Exclusive = 2    // Force exclusive fullscreen
+};
+
+// Outcome of an application's fullscreen state change request
+enum class FullscreenDecision
+{
+    Allow,
+    BlockWindowed,    // Exclusive mode is forced, keep fullscreen
+    BlockFullscreen,  // Borderless mode is forced, keep windowed
+    BlockByConfig     // BlockFullscreenChanges is set
+};
+
+// Decide whether a set_fullscreen_state request may go through.
+// Exclusive mode still allows transitions to fullscreen, including the addon's own.
+constexpr FullscreenDecision decide_fullscreen_change(FullscreenMode mode, bool block_fullscreen_changes, bool requested_fullscreen)
+{
+    switch (mode)
+    {
+    case FullscreenMode::Exclusive:
+        return requested_fullscreen ? FullscreenDecision::Allow : FullscreenDecision::BlockWindowed;
+    case FullscreenMode::Borderless:
+        return requested_fullscreen ? FullscreenDecision::BlockFullscreen : FullscreenDecision::Allow;
+    case FullscreenMode::Unchanged:
+    default:
+        return block_fullscreen_changes ? FullscreenDecision::BlockByConfig : FullscreenDecision::Allow;
+    }
+}
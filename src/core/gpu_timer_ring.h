@@ -0,0 +1,91 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+// Standard library only (portable core)
+#include <cstdint>
+
+// Bookkeeping for GPU timestamp pairs written into a query heap with FRAMES_IN_FLIGHT slots.
+// Every timed frame writes a begin and an end timestamp into the next slot. Results are read back
+// frames later, once the GPU is done with them, so reading never waits on the GPU. While all slots
+// are still pending, frames are left untimed instead.
+// Not thread-safe, the owner serializes access (the scale pass runs under the swapchain lock).
+class GpuTimerRing
+{
+public:
+    static constexpr uint32_t FRAMES_IN_FLIGHT = 4;
+    static constexpr uint32_t QUERIES_PER_FRAME = 2;
+    static constexpr uint32_t QUERY_COUNT = FRAMES_IN_FLIGHT * QUERIES_PER_FRAME;
+
+    // Reserve a slot for this frame, returns false if every slot is still waiting for the GPU.
+    // The frame's begin and end timestamps go into queries out_first_query and out_first_query + 1.
+    constexpr bool begin_frame(uint32_t& out_first_query)
+    {
+        if (pending_ == FRAMES_IN_FLIGHT)
+        {
+            ++skipped_frames_;
+            return false;
+        }
+
+        out_first_query = write_slot_ * QUERIES_PER_FRAME;
+        return true;
+    }
+
+    // Both timestamps of the slot reserved by begin_frame() were recorded
+    constexpr void end_frame()
+    {
+        write_slot_ = (write_slot_ + 1) % FRAMES_IN_FLIGHT;
+        ++pending_;
+    }
+
+    // Read back finished slots, oldest first, and stop at the first one the GPU has not written yet.
+    // read(first_query, count, out_timestamps) returns false while results are not available.
+    // Returns the number of frames read back.
+    template <typename ReadFn>
+    constexpr uint32_t collect(ReadFn&& read)
+    {
+        uint32_t collected = 0;
+        while (pending_ != 0)
+        {
+            const uint32_t slot = (write_slot_ + FRAMES_IN_FLIGHT - pending_) % FRAMES_IN_FLIGHT;
+            uint64_t timestamps[QUERIES_PER_FRAME] = {};
+            if (!read(slot * QUERIES_PER_FRAME, QUERIES_PER_FRAME, timestamps))
+                break;
+
+            --pending_;
+            ++collected;
+            // A disjoint or reset counter can run backwards, such a frame has no meaningful duration
+            if (timestamps[1] >= timestamps[0])
+            {
+                last_ticks_ = timestamps[1] - timestamps[0];
+                ++timed_frames_;
+            }
+        }
+        return collected;
+    }
+
+    // Forget all pending slots, for when the query heap is destroyed or recreated
+    constexpr void reset()
+    {
+        write_slot_ = 0;
+        pending_ = 0;
+    }
+
+    // Duration of the most recently read back frame in timestamp ticks (0 if none yet)
+    constexpr uint64_t last_ticks() const { return last_ticks_; }
+
+    // Frames with a valid duration, and frames left untimed because all slots were pending
+    constexpr uint64_t timed_frames() const { return timed_frames_; }
+    constexpr uint64_t skipped_frames() const { return skipped_frames_; }
+
+private:
+    uint32_t write_slot_ = 0;
+    uint32_t pending_ = 0;
+    uint64_t last_ticks_ = 0;
+    uint64_t timed_frames_ = 0;
+    uint64_t skipped_frames_ = 0;
+};
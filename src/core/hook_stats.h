@@ -0,0 +1,109 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+// Standard library only (portable core)
+#include "core/trace_format.h"
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+// What a hook did with a call, every call ends in exactly one outcome
+enum class HookOutcome : uint8_t
+{
+    Passed = 0,      // Looked at, left unchanged
+    EarlyOut = 1,    // Nothing to do for this object (no override, invalid arguments)
+    Redirected = 2,  // Bound back buffer, viewport or scissor rect redirected to the proxy, or proxy scaled on present
+    Rewritten = 3    // Application parameters changed (swapchain descriptor, window style or position, blocked fullscreen change)
+};
+
+constexpr size_t HOOK_OUTCOME_COUNT = 4;
+
+// Latency histogram with power-of-two buckets: bucket 0 counts 0 ticks,
+// bucket n counts [2^(n-1), 2^n) ticks and the last bucket everything above
+constexpr size_t HOOK_LATENCY_BUCKETS = 32;
+
+constexpr size_t latency_bucket(uint64_t ticks)
+{
+    const size_t bucket = static_cast<size_t>(std::bit_width(ticks));
+    return bucket < HOOK_LATENCY_BUCKETS ? bucket : HOOK_LATENCY_BUCKETS - 1;
+}
+
+// Every hooked event, in a dense order for counter tables
+constexpr trace_format::EventId HOOK_EVENTS[] = {
+    trace_format::EventId::InitDevice,
+    trace_format::EventId::CreateSwapchain,
+    trace_format::EventId::InitSwapchain,
+    trace_format::EventId::DestroySwapchain,
+    trace_format::EventId::BindRenderTargets,
+    trace_format::EventId::BindViewports,
+    trace_format::EventId::BindScissorRects,
+    trace_format::EventId::Present,
+    trace_format::EventId::FinishPresent,
+    trace_format::EventId::SetFullscreenState,
+    trace_format::EventId::CreateWindowExA,
+    trace_format::EventId::CreateWindowExW,
+    trace_format::EventId::SetWindowLongA,
+    trace_format::EventId::SetWindowLongW,
+    trace_format::EventId::SetWindowLongPtrA,
+    trace_format::EventId::SetWindowLongPtrW,
+    trace_format::EventId::SetWindowPos,
+    trace_format::EventId::AdjustWindowRect,
+    trace_format::EventId::AdjustWindowRectEx,
+};
+
+constexpr size_t HOOK_COUNT = std::size(HOOK_EVENTS);
+
+// Index into HOOK_EVENTS (ReShade events first, then the WinAPI hooks)
+constexpr size_t hook_index(trace_format::EventId event)
+{
+    const auto value = static_cast<uint16_t>(event);
+    if (value >= static_cast<uint16_t>(trace_format::EventId::CreateWindowExA))
+        return 10 + (value - static_cast<uint16_t>(trace_format::EventId::CreateWindowExA));
+    return value - static_cast<uint16_t>(trace_format::EventId::InitDevice);
+}
+
+static_assert(hook_index(trace_format::EventId::SetFullscreenState) == 9);
+static_assert(HOOK_EVENTS[hook_index(trace_format::EventId::AdjustWindowRectEx)] == trace_format::EventId::AdjustWindowRectEx);
+
+// Aggregated counters of one hook
+struct HookTotals
+{
+    std::array<uint64_t, HOOK_OUTCOME_COUNT> outcomes = {};
+    std::array<uint64_t, HOOK_LATENCY_BUCKETS> latency = {};
+
+    uint64_t calls() const
+    {
+        uint64_t total = 0;
+        for (uint64_t count : outcomes)
+            total += count;
+        return total;
+    }
+
+    uint64_t count(HookOutcome outcome) const { return outcomes[static_cast<size_t>(outcome)]; }
+
+    // Upper bound (exclusive, in ticks) of the bucket holding the given fraction of calls
+    uint64_t latency_percentile(double fraction) const
+    {
+        uint64_t total = 0;
+        for (uint64_t count : latency)
+            total += count;
+        if (total == 0)
+            return 0;
+
+        const uint64_t rank = static_cast<uint64_t>(fraction * static_cast<double>(total - 1)) + 1;
+        uint64_t seen = 0;
+        for (size_t bucket = 0; bucket < HOOK_LATENCY_BUCKETS; ++bucket)
+        {
+            seen += latency[bucket];
+            if (seen >= rank)
+                return uint64_t(1) << bucket;
+        }
+        return uint64_t(1) << (HOOK_LATENCY_BUCKETS - 1);
+    }
+};
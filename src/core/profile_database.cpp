@@ -0,0 +1,291 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "core/profile_database.h"
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <system_error>
+
+namespace
+{
+    char to_lower_ascii(char c)
+    {
+        return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+    }
+
+    std::string_view trim(std::string_view text)
+    {
+        const size_t first = text.find_first_not_of(" \t\r\n");
+        if (first == std::string_view::npos)
+            return {};
+        const size_t last = text.find_last_not_of(" \t\r\n");
+        return text.substr(first, last - first + 1);
+    }
+
+    std::string to_lower(std::string_view text)
+    {
+        std::string result(text);
+        for (char& c : result)
+            c = to_lower_ascii(c);
+        return result;
+    }
+
+    // Read a POD value at an absolute file offset
+    template <typename T>
+    bool read_at(std::ifstream& file, uint64_t offset, T& out_value)
+    {
+        file.seekg(static_cast<std::streamoff>(offset));
+        file.read(reinterpret_cast<char*>(&out_value), sizeof(T));
+        return file.good();
+    }
+
+    // Read a NUL-terminated string from the string table
+    bool read_string_at(std::ifstream& file, const profile_index::Header& header, uint32_t offset, std::string& out_value)
+    {
+        if (offset >= header.strings_size)
+            return false;
+
+        file.seekg(static_cast<std::streamoff>(header.strings_offset) + offset);
+        std::getline(file, out_value, '\0');
+        return !file.fail();
+    }
+}
+
+uint64_t ProfileDatabase::hash_name(std::string_view name)
+{
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (const char c : name)
+    {
+        hash ^= static_cast<uint8_t>(to_lower_ascii(c));
+        hash *= 0x100000001B3ull;
+    }
+
+    // 0 marks an empty bucket
+    return hash != 0 ? hash : 1;
+}
+
+bool ProfileDatabase::build_index(std::string_view source_text, std::vector<uint8_t>& out_index, std::string& out_error)
+{
+    using namespace profile_index;
+
+    // Parse the text source, later sections/keys override earlier ones
+    std::map<std::string, std::map<std::string, std::string>> profiles;
+    std::map<std::string, std::string>* current_profile = nullptr;
+
+    size_t line_number = 0;
+    while (!source_text.empty())
+    {
+        const size_t line_end = source_text.find('\n');
+        const std::string_view line = trim(source_text.substr(0, line_end));
+        source_text = line_end == std::string_view::npos ? std::string_view() : source_text.substr(line_end + 1);
+        ++line_number;
+
+        if (line.empty() || line.front() == ';' || line.front() == '#')
+            continue;
+
+        if (line.front() == '[')
+        {
+            if (line.back() != ']' || line.size() < 3)
+            {
+                out_error = "Malformed section header on line " + std::to_string(line_number);
+                return false;
+            }
+
+            current_profile = &profiles[to_lower(trim(line.substr(1, line.size() - 2)))];
+            continue;
+        }
+
+        const size_t separator = line.find('=');
+        if (separator == std::string_view::npos || separator == 0)
+        {
+            out_error = "Expected key=value on line " + std::to_string(line_number);
+            return false;
+        }
+        if (current_profile == nullptr)
+        {
+            out_error = "Setting outside of an executable section on line " + std::to_string(line_number);
+            return false;
+        }
+
+        (*current_profile)[std::string(trim(line.substr(0, separator)))] = std::string(trim(line.substr(separator + 1)));
+    }
+
+    // Size the table to at most 50% load so probe sequences stay short
+    uint32_t bucket_count = 2;
+    while (bucket_count < profiles.size() * 2)
+        bucket_count *= 2;
+
+    std::vector<Bucket> buckets(bucket_count, Bucket {});
+    std::vector<Entry> entries;
+    std::string strings;
+
+    auto add_string = [&strings](const std::string& value) {
+        const uint32_t offset = static_cast<uint32_t>(strings.size());
+        strings.append(value);
+        strings.push_back('\0');
+        return offset;
+    };
+
+    for (const auto& [name, settings] : profiles)
+    {
+        const uint64_t hash = hash_name(name);
+        uint32_t index = static_cast<uint32_t>(hash) & (bucket_count - 1);
+        while (buckets[index].name_hash != 0)
+            index = (index + 1) & (bucket_count - 1);
+
+        Bucket& bucket = buckets[index];
+        bucket.name_hash = hash;
+        bucket.name_offset = add_string(name);
+        bucket.first_entry = static_cast<uint32_t>(entries.size());
+        bucket.entry_count = static_cast<uint32_t>(settings.size());
+
+        for (const auto& [key, value] : settings)
+            entries.push_back({ add_string(key), add_string(value) });
+    }
+
+    Header header = {};
+    header.magic = MAGIC;
+    header.version = VERSION;
+    header.bucket_count = bucket_count;
+    header.profile_count = static_cast<uint32_t>(profiles.size());
+    header.buckets_offset = sizeof(Header);
+    header.entries_offset = header.buckets_offset + bucket_count * static_cast<uint32_t>(sizeof(Bucket));
+    header.strings_offset = header.entries_offset + static_cast<uint32_t>(entries.size() * sizeof(Entry));
+    header.strings_size = static_cast<uint32_t>(strings.size());
+
+    out_index.resize(header.strings_offset + strings.size());
+    std::memcpy(out_index.data(), &header, sizeof(header));
+    std::memcpy(out_index.data() + header.buckets_offset, buckets.data(), buckets.size() * sizeof(Bucket));
+    if (!entries.empty())
+        std::memcpy(out_index.data() + header.entries_offset, entries.data(), entries.size() * sizeof(Entry));
+    if (!strings.empty())
+        std::memcpy(out_index.data() + header.strings_offset, strings.data(), strings.size());
+
+    return true;
+}
+
+std::filesystem::path ProfileDatabase::index_path_for(const std::filesystem::path& source_path)
+{
+    std::filesystem::path index_path = source_path;
+    index_path += ".idx";
+    return index_path;
+}
+
+bool ProfileDatabase::update_index(const std::filesystem::path& source_path, uint32_t process_id, std::string& out_error)
+{
+    std::error_code ec;
+    const std::filesystem::path index_path = index_path_for(source_path);
+
+    const auto source_time = std::filesystem::last_write_time(source_path, ec);
+    const uint64_t source_size = ec ? 0 : std::filesystem::file_size(source_path, ec);
+    if (ec)
+    {
+        out_error = "Profile source not found: " + source_path.string();
+        return false;
+    }
+    const int64_t source_write_time = static_cast<int64_t>(source_time.time_since_epoch().count());
+
+    // Up to date, nothing to do (the common startup path). Comparing the stamp instead of the
+    // index time also catches a source restored with an older time or edited within the
+    // file system's time resolution.
+    {
+        std::ifstream existing_file(index_path, std::ios::binary);
+        profile_index::Header header = {};
+        if (existing_file && read_at(existing_file, 0, header) &&
+            header.magic == profile_index::MAGIC && header.version == profile_index::VERSION &&
+            header.source_size == source_size && header.source_write_time == source_write_time)
+            return true;
+    }
+
+    std::ifstream source_file(source_path, std::ios::binary);
+    const std::string source_text((std::istreambuf_iterator<char>(source_file)), std::istreambuf_iterator<char>());
+
+    std::vector<uint8_t> index;
+    if (!build_index(source_text, index, out_error))
+        return false;
+
+    // Stamp the source the index was built from
+    profile_index::Header header = {};
+    std::memcpy(&header, index.data(), sizeof(header));
+    header.source_size = source_size;
+    header.source_write_time = source_write_time;
+    std::memcpy(index.data(), &header, sizeof(header));
+
+    // Write to a temporary file first so a concurrently starting instance never sees a partial index,
+    // each instance has its own so two of them never write into the same file
+    std::filesystem::path temp_path = index_path;
+    temp_path += "." + std::to_string(process_id) + ".tmp";
+    {
+        std::ofstream index_file(temp_path, std::ios::binary | std::ios::trunc);
+        index_file.write(reinterpret_cast<const char*>(index.data()), static_cast<std::streamsize>(index.size()));
+        if (!index_file.good())
+        {
+            out_error = "Failed to write profile index: " + temp_path.string();
+            return false;
+        }
+    }
+
+    std::filesystem::rename(temp_path, index_path, ec);
+    if (ec)
+    {
+        std::filesystem::remove(temp_path, ec);
+        out_error = "Failed to replace profile index: " + index_path.string();
+        return false;
+    }
+
+    return true;
+}
+
+bool ProfileDatabase::find_profile(const std::filesystem::path& index_path, std::string_view executable_name,
+                                   std::vector<ProfileSetting>& out_settings)
+{
+    using namespace profile_index;
+
+    std::ifstream file(index_path, std::ios::binary);
+    if (!file)
+        return false;
+
+    Header header = {};
+    if (!read_at(file, 0, header) || header.magic != MAGIC || header.version != VERSION ||
+        header.bucket_count == 0 || (header.bucket_count & (header.bucket_count - 1)) != 0)
+        return false;
+
+    const uint64_t hash = hash_name(executable_name);
+    const std::string name = to_lower(executable_name);
+
+    // Linear probing, the table is at most half full
+    uint32_t index = static_cast<uint32_t>(hash) & (header.bucket_count - 1);
+    for (uint32_t probe = 0; probe < header.bucket_count; ++probe, index = (index + 1) & (header.bucket_count - 1))
+    {
+        Bucket bucket = {};
+        if (!read_at(file, header.buckets_offset + uint64_t(index) * sizeof(Bucket), bucket) || bucket.name_hash == 0)
+            return false;
+        if (bucket.name_hash != hash)
+            continue;
+
+        // Guard against hash collisions
+        std::string bucket_name;
+        if (!read_string_at(file, header, bucket.name_offset, bucket_name) || bucket_name != name)
+            continue;
+
+        out_settings.clear();
+        for (uint32_t i = 0; i < bucket.entry_count; ++i)
+        {
+            Entry entry = {};
+            ProfileSetting setting;
+            if (!read_at(file, header.entries_offset + uint64_t(bucket.first_entry + i) * sizeof(Entry), entry) ||
+                !read_string_at(file, header, entry.key_offset, setting.key) ||
+                !read_string_at(file, header, entry.value_offset, setting.value))
+                return false;
+
+            out_settings.push_back(std::move(setting));
+        }
+        return true;
+    }
+
+    return false;
+}
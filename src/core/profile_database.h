@@ -0,0 +1,89 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+// Standard library only, so the index builder and lookup can run outside the game process
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Per-executable profiles.
+// The text source is an ini-style file with one section per executable name:
+//
+//   [game.exe]
+//   ForceSwapchainResolution=2560x1440
+//   FullscreenMode=1
+//
+// It is compiled into a compact binary index (<source>.idx) holding an open-addressing
+// hash table keyed by the executable name, so a startup lookup reads a header, a few
+// buckets and the matching settings regardless of how many profiles exist.
+
+// A single key/value pair from a profile
+struct ProfileSetting
+{
+    std::string key;
+    std::string value;
+};
+
+// Binary index layout (little-endian)
+namespace profile_index
+{
+    constexpr uint32_t MAGIC = 0x49504F53; // "SOPI"
+    constexpr uint32_t VERSION = 2;  // Version 1 has no source stamp
+
+    struct Header
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t bucket_count;    // Power of two
+        uint32_t profile_count;
+        uint32_t buckets_offset;  // Array of Bucket
+        uint32_t entries_offset;  // Array of Entry
+        uint32_t strings_offset;  // NUL-terminated strings
+        uint32_t strings_size;
+        uint64_t source_size;        // Of the text source the index was built from,
+        int64_t source_write_time;   // compared on every update (0 = not built by update_index)
+    };
+
+    struct Bucket
+    {
+        uint64_t name_hash;    // 0 = empty bucket
+        uint32_t name_offset;  // Lowercase executable name in the string table
+        uint32_t first_entry;
+        uint32_t entry_count;
+        uint32_t reserved;
+    };
+
+    struct Entry
+    {
+        uint32_t key_offset;
+        uint32_t value_offset;
+    };
+}
+
+class ProfileDatabase
+{
+public:
+    // Case-insensitive FNV-1a hash of an executable name (never returns 0)
+    static uint64_t hash_name(std::string_view name);
+
+    // Compile the text source into a binary index
+    static bool build_index(std::string_view source_text, std::vector<uint8_t>& out_index, std::string& out_error);
+
+    // Path of the binary index that belongs to a text source
+    static std::filesystem::path index_path_for(const std::filesystem::path& source_path);
+
+    // Rebuild the binary index if it is missing or was built from a different text source
+    // (size or write time). The process id keeps the temporary file of each instance apart.
+    static bool update_index(const std::filesystem::path& source_path, uint32_t process_id, std::string& out_error);
+
+    // Find the settings for an executable (case-insensitive), returns false if there is no profile
+    static bool find_profile(const std::filesystem::path& index_path, std::string_view executable_name,
+                             std::vector<ProfileSetting>& out_settings);
+};
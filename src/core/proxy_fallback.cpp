@@ -0,0 +1,85 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "core/proxy_fallback.h"
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+    constexpr const char* STEP_NAMES[PROXY_FALLBACK_STEP_COUNT] = {
+        "fewer-proxies",
+        "lower-precision",
+        "lower-size",
+        "disable",
+    };
+
+    // Steps that can be listed in ProxyFallback
+    constexpr size_t CONFIGURABLE_STEP_COUNT = static_cast<size_t>(ProxyFallbackStep::DisableOverride);
+}
+
+const char* proxy_fallback_step_name(ProxyFallbackStep step)
+{
+    const size_t index = static_cast<size_t>(step);
+    return index < PROXY_FALLBACK_STEP_COUNT ? STEP_NAMES[index] : "unknown";
+}
+
+bool parse_proxy_fallback_steps(const char* text, uint32_t& out_steps)
+{
+    if (text == nullptr)
+        return false;
+
+    if (std::strcmp(text, "none") == 0)
+    {
+        out_steps = 0;
+        return true;
+    }
+
+    uint32_t steps = 0;
+    const char* name = text;
+    while (true)
+    {
+        const char* const separator = std::strchr(name, ',');
+        const size_t length = separator != nullptr ? static_cast<size_t>(separator - name) : std::strlen(name);
+
+        size_t step = 0;
+        while (step < CONFIGURABLE_STEP_COUNT &&
+               (std::strlen(STEP_NAMES[step]) != length || std::strncmp(STEP_NAMES[step], name, length) != 0))
+            ++step;
+        if (step == CONFIGURABLE_STEP_COUNT)
+            return false;
+
+        steps |= proxy_fallback_bit(static_cast<ProxyFallbackStep>(step));
+        if (separator == nullptr)
+            break;
+        name = separator + 1;
+    }
+
+    out_steps = steps;
+    return true;
+}
+
+void format_proxy_fallback_steps(uint32_t steps, char* buffer, size_t buffer_size)
+{
+    if (buffer_size == 0)
+        return;
+
+    buffer[0] = '\0';
+    size_t length = 0;
+    for (size_t step = 0; step < CONFIGURABLE_STEP_COUNT; ++step)
+    {
+        if ((steps & proxy_fallback_bit(static_cast<ProxyFallbackStep>(step))) == 0 || length >= buffer_size)
+            continue;
+
+        const int written = snprintf(buffer + length, buffer_size - length, "%s%s", length != 0 ? "," : "", STEP_NAMES[step]);
+        if (written < 0)
+            break;
+        length += static_cast<size_t>(written);
+    }
+
+    if (length == 0)
+        snprintf(buffer, buffer_size, "none");
+}
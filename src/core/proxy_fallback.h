@@ -0,0 +1,49 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+// Standard library only (portable core)
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+// Steps tried, in this order, when the proxy textures of a swapchain cannot be created.
+// Disabling the override is the last resort and always enabled, the others are set by ProxyFallback.
+enum class ProxyFallbackStep : uint8_t
+{
+    FewerProxies = 0,    // One proxy shared by all back buffers
+    LowerPrecision = 1,  // Proxies in a smaller format, where pipelines do not fix the render target format
+    LowerSize = 2,       // Halve the forced size the next time the swapchain is created or resized
+    DisableOverride = 3  // Leave the back buffers alone, the application renders at the forced size
+};
+
+constexpr size_t PROXY_FALLBACK_STEP_COUNT = 4;
+
+constexpr uint32_t proxy_fallback_bit(ProxyFallbackStep step)
+{
+    return 1u << static_cast<uint32_t>(step);
+}
+
+constexpr uint32_t PROXY_FALLBACK_DEFAULT = proxy_fallback_bit(ProxyFallbackStep::FewerProxies) |
+    proxy_fallback_bit(ProxyFallbackStep::LowerPrecision) | proxy_fallback_bit(ProxyFallbackStep::LowerSize);
+
+// Name used in ReShade.ini and the log ("fewer-proxies", ...)
+const char* proxy_fallback_step_name(ProxyFallbackStep step);
+
+// ProxyFallback=<step>[,<step>...] | none, the order of the names does not matter
+bool parse_proxy_fallback_steps(const char* text, uint32_t& out_steps);
+
+void format_proxy_fallback_steps(uint32_t steps, char* buffer, size_t buffer_size);
+
+// Forced size after halving it halvings times, never below the size the application requested
+constexpr void lower_forced_size(uint32_t requested_width, uint32_t requested_height, uint32_t halvings,
+                                 uint32_t& forced_width, uint32_t& forced_height)
+{
+    const uint32_t shift = std::min<uint32_t>(halvings, 31);
+    forced_width = std::max(forced_width >> shift, std::min(requested_width, forced_width));
+    forced_height = std::max(forced_height >> shift, std::min(requested_height, forced_height));
+}
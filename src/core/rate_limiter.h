@@ -0,0 +1,59 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+// Standard library only (portable core)
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+// Token bucket in its "generic cell rate" form: instead of a token count and a refill time, the
+// bucket keeps the time at which it would be full again. An event is admitted while that time is
+// at most burst - 1 intervals ahead of now, and admitting it moves the time one interval further.
+constexpr bool rate_limit_admit(uint64_t full_at, uint64_t now, uint64_t interval, uint32_t burst, uint64_t& out_full_at)
+{
+    const uint64_t start = std::max(full_at, now);
+    const uint64_t tolerance = interval * (burst > 0 ? burst - 1 : 0);
+    if (start - now > tolerance)
+        return false;
+
+    out_full_at = start + interval;
+    return true;
+}
+
+// One bucket, safe to share between threads: the state is a single word updated with compare-exchange
+class RateLimiter
+{
+public:
+    // Admit up to rate events per second with bursts of up to burst events.
+    // now_us is any monotonic clock in microseconds; a rate of 0 admits everything.
+    bool try_acquire(uint64_t now_us, uint32_t rate, uint32_t burst)
+    {
+        if (rate == 0)
+            return true;
+
+        const uint64_t interval = 1000000 / rate;
+        uint64_t full_at = full_at_.load(std::memory_order_relaxed);
+        uint64_t next = 0;
+        do
+        {
+            if (!rate_limit_admit(full_at, now_us, interval, burst, next))
+            {
+                rejected_.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        } while (!full_at_.compare_exchange_weak(full_at, next, std::memory_order_relaxed));
+        return true;
+    }
+
+    // Number of events rejected since the last call
+    uint64_t take_rejected() { return rejected_.exchange(0, std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> full_at_ = 0;
+    std::atomic<uint64_t> rejected_ = 0;
+};
@@ -0,0 +1,55 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "core/resize_debounce.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+bool parse_resize_debounce(const char* text, ResizeDebounceSpec& out_spec)
+{
+    if (text == nullptr)
+        return false;
+
+    if (std::strcmp(text, "off") == 0 || std::strcmp(text, "0") == 0)
+    {
+        out_spec = {};
+        return true;
+    }
+
+    char* end = nullptr;
+    const long amount = std::strtol(text, &end, 10);
+    if (end == text || amount < 1 || amount > static_cast<long>(MAX_RESIZE_DEBOUNCE))
+        return false;
+
+    ResizeDebounceUnit unit = ResizeDebounceUnit::Disabled;
+    if (std::strcmp(end, "ms") == 0)
+        unit = ResizeDebounceUnit::Milliseconds;
+    else if (std::strcmp(end, "frames") == 0)
+        unit = ResizeDebounceUnit::Frames;
+    else
+        return false;
+
+    out_spec.unit = unit;
+    out_spec.amount = static_cast<uint32_t>(amount);
+    return true;
+}
+
+void format_resize_debounce(const ResizeDebounceSpec& spec, char* buffer, size_t buffer_size)
+{
+    switch (spec.unit)
+    {
+    case ResizeDebounceUnit::Milliseconds:
+        snprintf(buffer, buffer_size, "%u ms", spec.amount);
+        break;
+    case ResizeDebounceUnit::Frames:
+        snprintf(buffer, buffer_size, "%u frames", spec.amount);
+        break;
+    default:
+        snprintf(buffer, buffer_size, "Off");
+        break;
+    }
+}
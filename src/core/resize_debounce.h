@@ -0,0 +1,85 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+// Standard library only (portable core)
+#include <cstddef>
+#include <cstdint>
+
+// What ResizeDebounce waits for before the proxies are rebuilt after a resize
+enum class ResizeDebounceUnit : uint8_t
+{
+    Disabled = 0,      // off, every resize rebuilds the proxies at once
+    Milliseconds = 1,  // <n>ms without another resize
+    Frames = 2         // <n>frames presented without another resize
+};
+
+// Parsed ResizeDebounce value
+struct ResizeDebounceSpec
+{
+    ResizeDebounceUnit unit = ResizeDebounceUnit::Disabled;
+    uint32_t amount = 0;
+
+    bool operator==(const ResizeDebounceSpec& other) const = default;
+};
+
+// Accepted range for the amount of ResizeDebounce
+constexpr uint32_t MAX_RESIZE_DEBOUNCE = 10000;
+
+// Parse "off", "<n>ms" or "<n>frames" (n = 1-MAX_RESIZE_DEBOUNCE)
+bool parse_resize_debounce(const char* text, ResizeDebounceSpec& out_spec);
+
+void format_resize_debounce(const ResizeDebounceSpec& spec, char* buffer, size_t buffer_size);
+
+// Quiet period after the resizes of one swapchain. Every absorbed resize starts it over,
+// presents count towards it, and the proxies are rebuilt once when it has passed.
+// Not thread-safe, the owner serializes access (swapchains are only touched under the swapchain lock).
+class ResizeDebouncer
+{
+public:
+    // A resize was absorbed, the old proxies keep being presented until the quiet period has passed
+    constexpr void note_resize(uint64_t now_ms)
+    {
+        pending_ = true;
+        last_resize_ms_ = now_ms;
+        presents_since_resize_ = 0;
+    }
+
+    // A frame was presented from the old proxies. Returns true, once, when the size has been
+    // stable long enough to rebuild. A disabled spec rebuilds on the next present.
+    constexpr bool note_present(const ResizeDebounceSpec& spec, uint64_t now_ms)
+    {
+        if (!pending_)
+            return false;
+
+        ++presents_since_resize_;
+        bool stable = true;
+        if (spec.unit == ResizeDebounceUnit::Milliseconds)
+            stable = now_ms - last_resize_ms_ >= spec.amount;
+        else if (spec.unit == ResizeDebounceUnit::Frames)
+            stable = presents_since_resize_ >= spec.amount;
+
+        if (stable)
+            pending_ = false;
+        return stable;
+    }
+
+    // Proxies were rebuilt or released for another reason
+    constexpr void reset()
+    {
+        pending_ = false;
+        presents_since_resize_ = 0;
+    }
+
+    constexpr bool is_pending() const { return pending_; }
+
+private:
+    bool pending_ = false;
+    uint64_t last_resize_ms_ = 0;
+    uint32_t presents_since_resize_ = 0;
+};
+
@@ -0,0 +1,157 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "core/resolution.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+    bool is_digit(char c)
+    {
+        return c >= '0' && c <= '9';
+    }
+
+    // ASCII case-insensitive comparison (no locale, no platform extensions)
+    bool equals_ignore_case(const char* a, const char* b)
+    {
+        for (; *a != '\0' && *b != '\0'; ++a, ++b)
+        {
+            const char lower_a = (*a >= 'A' && *a <= 'Z') ? static_cast<char>(*a - 'A' + 'a') : *a;
+            const char lower_b = (*b >= 'A' && *b <= 'Z') ? static_cast<char>(*b - 'A' + 'a') : *b;
+            if (lower_a != lower_b)
+                return false;
+        }
+        return *a == *b;
+    }
+}
+
+bool parse_resolution_spec(const char* text, ResolutionSpec& out_spec)
+{
+    if (text == nullptr)
+        return false;
+
+    ResolutionSpec spec;
+
+    if (equals_ignore_case(text, "fit-monitor"))
+    {
+        spec.mode = ResolutionMode::FitMonitor;
+        out_spec = spec;
+        return true;
+    }
+
+    // std::from_chars takes no leading whitespace, sign, hex or exponent (fixed format) but does take inf/nan,
+    // every accepted form starts with a digit
+    if (!is_digit(text[0]))
+        return false;
+
+    const char* const text_end = text + std::strlen(text);
+
+    double first = 0.0;
+    const auto [first_end, first_error] = std::from_chars(text, text_end, first, std::chars_format::fixed);
+    if (first_error != std::errc())
+        return false;
+
+    // <factor>x or <percent>%, relative to the size the application requests
+    if ((first_end[0] == 'x' || first_end[0] == '%') && first_end + 1 == text_end)
+    {
+        const double percent = first_end[0] == '%' ? first : first * 100.0;
+
+        if (!(percent >= MIN_SCALE_PERCENT && percent <= MAX_SCALE_PERCENT))
+            return false;
+
+        spec.mode = ResolutionMode::Scale;
+        spec.scale_percent = static_cast<uint32_t>(percent + 0.5);
+        out_spec = spec;
+        return true;
+    }
+
+    // <width>x<height>, both parts must be whole numbers
+    uint32_t width = 0;
+    const auto [width_end, width_error] = std::from_chars(text, text_end, width);
+    if (width_error != std::errc() || width_end == text_end || *width_end != 'x')
+        return false;
+
+    const char* const height_text = width_end + 1;
+    if (!is_digit(*height_text))
+        return false;
+
+    uint32_t height = 0;
+    const auto [height_end, height_error] = std::from_chars(height_text, text_end, height);
+    if (height_error != std::errc() || height_end != text_end)
+        return false;
+
+    if (width > MAX_FORCED_DIMENSION || height > MAX_FORCED_DIMENSION)
+        return false;
+
+    // Treat a single zero dimension the same as 0x0
+    if (width != 0 && height != 0)
+    {
+        spec.mode = ResolutionMode::Absolute;
+        spec.width = width;
+        spec.height = height;
+    }
+
+    out_spec = spec;
+    return true;
+}
+
+void format_resolution_spec(const ResolutionSpec& spec, char* buffer, size_t buffer_size)
+{
+    switch (spec.mode)
+    {
+    case ResolutionMode::Absolute:
+        snprintf(buffer, buffer_size, "%ux%u", spec.width, spec.height);
+        break;
+    case ResolutionMode::Scale:
+        snprintf(buffer, buffer_size, "%u%% of requested", spec.scale_percent);
+        break;
+    case ResolutionMode::FitMonitor:
+        snprintf(buffer, buffer_size, "Fit monitor");
+        break;
+    default:
+        snprintf(buffer, buffer_size, "Disabled");
+        break;
+    }
+}
+
+ResolveStatus resolve_forced_size(const ResolutionSpec& spec, uint32_t requested_width, uint32_t requested_height,
+                                  uint32_t monitor_width, uint32_t monitor_height,
+                                  uint32_t& out_width, uint32_t& out_height)
+{
+    uint64_t width = 0;
+    uint64_t height = 0;
+
+    switch (spec.mode)
+    {
+    case ResolutionMode::Absolute:
+        width = spec.width;
+        height = spec.height;
+        break;
+    case ResolutionMode::Scale:
+        // A zero size means "use the window client area", there is nothing to scale
+        if (requested_width == 0 || requested_height == 0)
+            return ResolveStatus::RequestedSizeUnknown;
+        width = (uint64_t(requested_width) * spec.scale_percent + 50) / 100;
+        height = (uint64_t(requested_height) * spec.scale_percent + 50) / 100;
+        break;
+    case ResolutionMode::FitMonitor:
+        if (monitor_width == 0 || monitor_height == 0)
+            return ResolveStatus::MonitorSizeUnknown;
+        width = monitor_width;
+        height = monitor_height;
+        break;
+    default:
+        return ResolveStatus::Disabled;
+    }
+
+    out_width = static_cast<uint32_t>(std::clamp<uint64_t>(width, 1, MAX_FORCED_DIMENSION));
+    out_height = static_cast<uint32_t>(std::clamp<uint64_t>(height, 1, MAX_FORCED_DIMENSION));
+
+    return (out_width != width || out_height != height) ? ResolveStatus::Clamped : ResolveStatus::Resolved;
+}
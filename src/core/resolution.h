@@ -0,0 +1,57 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+// Standard library only (portable core)
+#include <cstddef>
+#include <cstdint>
+
+// How ForceSwapchainResolution derives the forced size
+enum class ResolutionMode
+{
+    Disabled = 0,    // 0x0, no override
+    Absolute = 1,    // <width>x<height>
+    Scale = 2,       // <factor>x or <percent>%, relative to the requested size
+    FitMonitor = 3   // fit-monitor, size of the monitor the window is on
+};
+
+// Parsed ForceSwapchainResolution value, resolved per swapchain in handle_create_swapchain
+struct ResolutionSpec
+{
+    ResolutionMode mode = ResolutionMode::Disabled;
+    uint32_t width = 0;          // Absolute mode
+    uint32_t height = 0;
+    uint32_t scale_percent = 0;  // Scale mode (200 = 2x)
+
+    bool operator==(const ResolutionSpec& other) const = default;
+};
+
+// Accepted range for ForceSwapchainResolution
+constexpr uint32_t MIN_SCALE_PERCENT = 25;
+constexpr uint32_t MAX_SCALE_PERCENT = 800;
+constexpr uint32_t MAX_FORCED_DIMENSION = 16384;
+
+// Parse "<width>x<height>", "<factor>x", "<percent>%", "fit-monitor" or "0x0"
+bool parse_resolution_spec(const char* text, ResolutionSpec& out_spec);
+
+// Human-readable form of a ResolutionSpec ("2560x1440", "150% of requested", ...)
+void format_resolution_spec(const ResolutionSpec& spec, char* buffer, size_t buffer_size);
+
+enum class ResolveStatus
+{
+    Resolved,              // out size is valid
+    Clamped,               // out size is valid but was limited to 1..MAX_FORCED_DIMENSION
+    Disabled,              // no override configured
+    RequestedSizeUnknown,  // relative mode with a 0x0 request (size follows the window)
+    MonitorSizeUnknown     // fit-monitor without a monitor size
+};
+
+// Resolve a spec against the size the application requested.
+// monitor_width/monitor_height are only used by FitMonitor (0 = unknown).
+ResolveStatus resolve_forced_size(const ResolutionSpec& spec, uint32_t requested_width, uint32_t requested_height,
+                                  uint32_t monitor_width, uint32_t monitor_height,
+                                  uint32_t& out_width, uint32_t& out_height);
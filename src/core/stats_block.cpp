@@ -0,0 +1,67 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "core/stats_block.h"
+#include <cstring>
+#include <thread>
+
+namespace stats_block
+{
+    void initialize(Block& block, uint32_t process_id)
+    {
+        block.version = VERSION;
+        block.block_size = sizeof(Block);
+        block.process_id = process_id;
+        block.sequence.store(0, std::memory_order_relaxed);
+
+        // Readers check the magic first, publish the header with it
+        block.magic.store(MAGIC, std::memory_order_release);
+    }
+
+    void publish(Block& block, const Stats& stats)
+    {
+        uint64_t words[STATS_WORDS];
+        std::memcpy(words, &stats, sizeof(stats));
+
+        const uint64_t sequence = block.sequence.load(std::memory_order_relaxed);
+        block.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        for (size_t i = 0; i < STATS_WORDS; ++i)
+            block.words[i].store(words[i], std::memory_order_relaxed);
+
+        block.sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    bool read(const Block& block, Stats& out_stats, int max_attempts)
+    {
+        if (block.magic.load(std::memory_order_acquire) != MAGIC ||
+            block.version != VERSION || block.block_size != sizeof(Block))
+            return false;
+
+        uint64_t words[STATS_WORDS];
+        for (int attempt = 0; attempt < max_attempts; ++attempt)
+        {
+            const uint64_t before = block.sequence.load(std::memory_order_acquire);
+            if ((before & 1) != 0)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            for (size_t i = 0; i < STATS_WORDS; ++i)
+                words[i] = block.words[i].load(std::memory_order_relaxed);
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (block.sequence.load(std::memory_order_relaxed) == before)
+            {
+                std::memcpy(&out_stats, words, sizeof(out_stats));
+                return true;
+            }
+        }
+        return false;
+    }
+}
@@ -0,0 +1,96 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+// Standard library only, the layout is shared with external readers
+#include "core/hook_stats.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// Live statistics published in a named shared-memory mapping (ExportStats=1).
+// The mapping is called "<platform prefix>SwapchainOverrideStats.<process id>" and holds one Block.
+// The addon rewrites the Stats payload periodically under a sequence lock, readers retry
+// until they copied it without a concurrent write.
+namespace stats_block
+{
+    constexpr uint32_t MAGIC = 0x53544F53; // "SOTS"
+    constexpr uint32_t VERSION = 3;
+    constexpr const char* NAME_PREFIX = "SwapchainOverrideStats.";
+
+    constexpr size_t MAX_SWAPCHAINS = 8;
+
+    struct SwapchainStats
+    {
+        uint64_t handle;
+        uint32_t requested_width;
+        uint32_t requested_height;
+        uint32_t actual_width;
+        uint32_t actual_height;
+        uint32_t override_active;
+        uint32_t scale_pass_gpu_ns;     // GPU time of the latest scale pass, 0 if not measured
+        uint64_t proxy_memory;  // Bytes of proxy textures, estimated from format and size
+    };
+
+    struct HookStats
+    {
+        uint64_t outcomes[HOOK_OUTCOME_COUNT];  // Indexed by HookOutcome
+        uint32_t latency_p50_ns;                // Histogram bucket upper bounds, 0 if unknown
+        uint32_t latency_p99_ns;
+    };
+
+    // Most recent present-to-present intervals (the overlay's frame timing window), 0 until two frames were presented
+    struct FrameStats
+    {
+        uint32_t sample_count;          // Frames the values below cover
+        uint32_t frame_time_avg_us;
+        uint32_t frame_time_p50_us;
+        uint32_t frame_time_p99_us;
+        uint32_t frame_time_p999_us;
+        uint32_t frame_time_max_us;
+        uint32_t addon_time_avg_ns;     // Time spent in the addon's hooks per frame
+        uint32_t addon_time_p99_ns;
+    };
+
+    struct Stats
+    {
+        uint64_t publish_count;
+        uint64_t uptime_ms;             // Since the addon was loaded
+        uint64_t present_count;
+        uint32_t present_rate_mhz;      // Presents per second * 1000, over the last publish interval
+        uint32_t swapchain_count;       // Valid entries in swapchains
+        FrameStats frames;
+        SwapchainStats swapchains[MAX_SWAPCHAINS];
+        HookStats hooks[HOOK_COUNT];    // Indexed like HOOK_EVENTS
+    };
+    static_assert(sizeof(Stats) % sizeof(uint64_t) == 0, "Stats is copied in 64-bit words");
+
+    constexpr size_t STATS_WORDS = sizeof(Stats) / sizeof(uint64_t);
+
+    static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<uint64_t>::is_always_lock_free,
+        "Atomics in shared memory must not rely on a process-local lock");
+
+    struct Block
+    {
+        std::atomic<uint32_t> magic;    // Written last by initialize(), 0 until the block is usable
+        uint32_t version;
+        uint32_t block_size;            // sizeof(Block)
+        uint32_t process_id;
+        std::atomic<uint64_t> sequence; // Odd while a write is in progress
+        std::atomic<uint64_t> words[STATS_WORDS];
+    };
+
+    // Fill in the header of a zeroed block
+    void initialize(Block& block, uint32_t process_id);
+
+    // Writer side, only one writer per block
+    void publish(Block& block, const Stats& stats);
+
+    // Reader side, returns false if the header does not match or no stable copy was
+    // obtained within max_attempts
+    bool read(const Block& block, Stats& out_stats, int max_attempts = 1000);
+}
@@ -0,0 +1,49 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "core/surface_scaling.h"
+
+bool redirect_viewport(const SurfaceScale& scale, float& x, float& y, float& width, float& height)
+{
+    // Check if viewport dimensions match the forced size (or close to it)
+    // We use a tolerance because viewport might be slightly different
+    const bool matches_forced_width = (width >= scale.actual_width * REDIRECT_COVERAGE_THRESHOLD);
+    const bool matches_forced_height = (height >= scale.actual_height * REDIRECT_COVERAGE_THRESHOLD);
+    if (!matches_forced_width || !matches_forced_height)
+        return false;
+
+    const float scale_x = static_cast<float>(scale.original_width) / static_cast<float>(scale.actual_width);
+    const float scale_y = static_cast<float>(scale.original_height) / static_cast<float>(scale.actual_height);
+
+    // Scale viewport to original size
+    x *= scale_x;
+    y *= scale_y;
+    width *= scale_x;
+    height *= scale_y;
+    return true;
+}
+
+bool redirect_scissor_rect(const SurfaceScale& scale, int32_t& left, int32_t& top, int32_t& right, int32_t& bottom)
+{
+    const int32_t width = right - left;
+    const int32_t height = bottom - top;
+
+    // Check if scissor rect dimensions match the forced size (or close to it)
+    const bool matches_forced_width = (width >= static_cast<int32_t>(scale.actual_width * REDIRECT_COVERAGE_THRESHOLD));
+    const bool matches_forced_height = (height >= static_cast<int32_t>(scale.actual_height * REDIRECT_COVERAGE_THRESHOLD));
+    if (!matches_forced_width || !matches_forced_height)
+        return false;
+
+    const float scale_x = static_cast<float>(scale.original_width) / static_cast<float>(scale.actual_width);
+    const float scale_y = static_cast<float>(scale.original_height) / static_cast<float>(scale.actual_height);
+
+    // Scale scissor rect to original size
+    left = static_cast<int32_t>(left * scale_x);
+    top = static_cast<int32_t>(top * scale_y);
+    right = static_cast<int32_t>(right * scale_x);
+    bottom = static_cast<int32_t>(bottom * scale_y);
+    return true;
+}
@@ -0,0 +1,29 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+// Standard library only (portable core)
+#include <cstdint>
+
+// Size the application asked for vs. the size of the real back buffer
+struct SurfaceScale
+{
+    uint32_t original_width = 0;
+    uint32_t original_height = 0;
+    uint32_t actual_width = 0;
+    uint32_t actual_height = 0;
+};
+
+// Viewports and scissor rects covering (most of) the back buffer are rescaled,
+// smaller ones (shadow maps, UI sub-regions) are left alone
+constexpr float REDIRECT_COVERAGE_THRESHOLD = 0.9f;
+
+// Rescale a viewport in place, returns false if it does not need redirecting
+bool redirect_viewport(const SurfaceScale& scale, float& x, float& y, float& width, float& height);
+
+// Rescale a scissor rect in place, returns false if it does not need redirecting
+bool redirect_scissor_rect(const SurfaceScale& scale, int32_t& left, int32_t& top, int32_t& right, int32_t& bottom);
@@ -0,0 +1,21 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "core/swapchain_lifecycle.h"
+
+const char* swapchain_state_name(SwapchainState state)
+{
+    constexpr const char* names[SWAPCHAIN_STATE_COUNT] = { "Pending", "Initialized", "Active", "Passthrough", "Resizing", "Destroyed" };
+    const size_t index = static_cast<size_t>(state);
+    return index < SWAPCHAIN_STATE_COUNT ? names[index] : "Unknown";
+}
+
+const char* swapchain_event_name(SwapchainEvent event)
+{
+    constexpr const char* names[SWAPCHAIN_EVENT_COUNT] = { "Init", "EnableProxies", "Bypass", "BeginResize", "Destroy" };
+    const size_t index = static_cast<size_t>(event);
+    return index < SWAPCHAIN_EVENT_COUNT ? names[index] : "Unknown";
+}
@@ -0,0 +1,83 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+// Standard library only (portable core)
+#include <cstddef>
+#include <cstdint>
+
+// Lifecycle of one swapchain as seen through the ReShade events:
+//   Pending -> Initialized                 init_swapchain (create_swapchain made the pending entry)
+//   Initialized -> Active                  proxies created
+//   Initialized -> Passthrough             no scaling needed, or the proxy fallbacks ran out
+//   Active / Passthrough -> Resizing       destroy_swapchain with is_resize
+//   Resizing -> Initialized                init_swapchain after the resize
+//   any -> Destroyed                       destroy_swapchain, or the override was turned off
+enum class SwapchainState : uint8_t
+{
+    Pending = 0,      // create_swapchain seen, the back buffers do not exist yet
+    Initialized = 1,  // Back buffers known, proxies being set up
+    Active = 2,       // Proxies in use, binds and presents are redirected
+    Passthrough = 3,  // Tracked without proxies, nothing is redirected
+    Resizing = 4,     // Back buffers are being resized, proxies are kept until init_swapchain
+    Destroyed = 5     // Terminal
+};
+
+constexpr size_t SWAPCHAIN_STATE_COUNT = 6;
+
+enum class SwapchainEvent : uint8_t
+{
+    Init = 0,         // init_swapchain, also after a resize
+    EnableProxies = 1,
+    Bypass = 2,       // No proxies: sizes match or proxy creation failed
+    BeginResize = 3,  // destroy_swapchain with is_resize
+    Destroy = 4
+};
+
+constexpr size_t SWAPCHAIN_EVENT_COUNT = 5;
+
+// State after event, returns false if the event is not valid in that state
+constexpr bool next_swapchain_state(SwapchainState state, SwapchainEvent event, SwapchainState& out_state)
+{
+    if (state == SwapchainState::Destroyed)
+        return false;
+
+    switch (event)
+    {
+    case SwapchainEvent::Init:
+        // Active and Passthrough also accept init without a resize, in case the
+        // destroy_swapchain of a resize was missed
+        if (state == SwapchainState::Initialized)
+            return false;
+        out_state = SwapchainState::Initialized;
+        return true;
+    case SwapchainEvent::EnableProxies:
+        if (state != SwapchainState::Initialized)
+            return false;
+        out_state = SwapchainState::Active;
+        return true;
+    case SwapchainEvent::Bypass:
+        if (state != SwapchainState::Initialized)
+            return false;
+        out_state = SwapchainState::Passthrough;
+        return true;
+    case SwapchainEvent::BeginResize:
+        if (state != SwapchainState::Active && state != SwapchainState::Passthrough)
+            return false;
+        out_state = SwapchainState::Resizing;
+        return true;
+    case SwapchainEvent::Destroy:
+        out_state = SwapchainState::Destroyed;
+        return true;
+    default:
+        return false;
+    }
+}
+
+// Names for logs and the overlay
+const char* swapchain_state_name(SwapchainState state);
+const char* swapchain_event_name(SwapchainEvent event);
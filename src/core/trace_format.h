@@ -0,0 +1,115 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+// Standard library only, so trace files can be read by tools outside the game process
+#include <bit>
+#include <cstdint>
+
+// Binary event trace layout (little-endian).
+// A trace file is a Header followed by fixed-size Records. Records from one thread
+// are in order, records from different threads are interleaved in blocks and
+// have to be sorted by timestamp to get a global order.
+namespace trace_format
+{
+    constexpr uint32_t MAGIC = 0x52544F53; // "SOTR"
+    constexpr uint32_t VERSION = 3;
+    constexpr uint32_t MIN_READABLE_VERSION = 2;  // Version 2 has no outcome, it reads as 0 (passed)
+
+    struct Header
+    {
+        uint32_t magic;
+        uint32_t version;
+        uint32_t record_size;       // sizeof(Record), lets readers skip unknown trailing fields
+        uint32_t process_id;
+        uint64_t ticks_per_second;  // Timestamp frequency
+        uint64_t start_timestamp;   // Timestamp when recording started
+    };
+
+    // Event identifiers and the meaning of Record::args for each of them.
+    // Handles and pointers are stored as their integer value.
+    enum class EventId : uint16_t
+    {
+        InitDevice = 1,          // device
+        CreateSwapchain = 2,     // api, requested (width, height), hwnd, resulting (width, height); result = descriptor modified
+        InitSwapchain = 3,       // native swapchain, is_resize, total proxy memory afterwards
+        DestroySwapchain = 4,    // native swapchain, is_resize, total proxy memory afterwards
+        BindRenderTargets = 5,   // command list, count, first RTV, DSV
+        BindViewports = 6,       // command list, (first, count), first viewport (x, y), first viewport (width, height) as floats
+        BindScissorRects = 7,    // command list, (first, count), first rect (left, top), first rect (right, bottom)
+        Present = 8,             // command queue, native swapchain
+        FinishPresent = 9,       // command queue, native swapchain
+        SetFullscreenState = 10, // native swapchain, fullscreen, monitor; result = change blocked
+
+        CreateWindowExA = 32,    // style, ex style, (x, y), (width, height)
+        CreateWindowExW = 33,    // style, ex style, (x, y), (width, height)
+        SetWindowLongA = 34,     // hwnd, index, value
+        SetWindowLongW = 35,     // hwnd, index, value
+        SetWindowLongPtrA = 36,  // hwnd, index, value
+        SetWindowLongPtrW = 37,  // hwnd, index, value
+        SetWindowPos = 38,       // hwnd, (x, y), (cx, cy), flags
+        AdjustWindowRect = 39,   // style, menu
+        AdjustWindowRectEx = 40, // style, ex style, menu
+    };
+
+    struct Record
+    {
+        uint64_t timestamp;  // Ticks at hook entry, see Header::ticks_per_second
+        uint32_t duration;   // Ticks spent in the hook (WinAPI hooks include the original call), saturated at UINT32_MAX
+        uint32_t thread_id;
+        EventId event;
+        uint16_t result;     // Event specific outcome, 0 if unused
+        uint8_t outcome;     // HookOutcome (see core/hook_stats.h)
+        uint8_t reserved[3];
+        uint64_t args[4];
+    };
+    static_assert(sizeof(Record) == 56, "Record layout is part of the file format");
+
+    // Pairs of 32-bit values are stored as (high, low) in one argument
+    constexpr uint64_t pack(uint32_t high, uint32_t low)
+    {
+        return (static_cast<uint64_t>(high) << 32) | low;
+    }
+    constexpr uint64_t pack(int32_t high, int32_t low)
+    {
+        return pack(static_cast<uint32_t>(high), static_cast<uint32_t>(low));
+    }
+    constexpr uint64_t pack(float high, float low)
+    {
+        return pack(std::bit_cast<uint32_t>(high), std::bit_cast<uint32_t>(low));
+    }
+
+    constexpr uint32_t unpack_high(uint64_t value) { return static_cast<uint32_t>(value >> 32); }
+    constexpr uint32_t unpack_low(uint64_t value) { return static_cast<uint32_t>(value); }
+
+    constexpr const char* event_name(EventId event)
+    {
+        switch (event)
+        {
+        case EventId::InitDevice: return "init_device";
+        case EventId::CreateSwapchain: return "create_swapchain";
+        case EventId::InitSwapchain: return "init_swapchain";
+        case EventId::DestroySwapchain: return "destroy_swapchain";
+        case EventId::BindRenderTargets: return "bind_render_targets";
+        case EventId::BindViewports: return "bind_viewports";
+        case EventId::BindScissorRects: return "bind_scissor_rects";
+        case EventId::Present: return "present";
+        case EventId::FinishPresent: return "finish_present";
+        case EventId::SetFullscreenState: return "set_fullscreen_state";
+        case EventId::CreateWindowExA: return "CreateWindowExA";
+        case EventId::CreateWindowExW: return "CreateWindowExW";
+        case EventId::SetWindowLongA: return "SetWindowLongA";
+        case EventId::SetWindowLongW: return "SetWindowLongW";
+        case EventId::SetWindowLongPtrA: return "SetWindowLongPtrA";
+        case EventId::SetWindowLongPtrW: return "SetWindowLongPtrW";
+        case EventId::SetWindowPos: return "SetWindowPos";
+        case EventId::AdjustWindowRect: return "AdjustWindowRect";
+        case EventId::AdjustWindowRectEx: return "AdjustWindowRectEx";
+        default: return "unknown";
+        }
+    }
+}
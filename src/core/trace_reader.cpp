@@ -0,0 +1,75 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "core/trace_reader.h"
+#include <algorithm>
+#include <cstring>
+
+bool TraceReader::open(const char* path)
+{
+    file_.open(path, std::ios::binary);
+    if (!file_)
+    {
+        error_ = std::string("cannot open ") + path;
+        return false;
+    }
+
+    if (!file_.read(reinterpret_cast<char*>(&header_), sizeof(header_)) ||
+        header_.magic != trace_format::MAGIC)
+    {
+        error_ = std::string(path) + " is not an event trace";
+        return false;
+    }
+    if (header_.version < trace_format::MIN_READABLE_VERSION || header_.version > trace_format::VERSION ||
+        header_.record_size < sizeof(trace_format::Record) || header_.ticks_per_second == 0)
+    {
+        error_ = "unsupported trace version " + std::to_string(header_.version) + " (expected " +
+            std::to_string(trace_format::MIN_READABLE_VERSION) + "-" + std::to_string(trace_format::VERSION) + ")";
+        return false;
+    }
+
+    record_data_.resize(header_.record_size);
+    return true;
+}
+
+bool TraceReader::next(trace_format::Record& out_record)
+{
+    if (!file_.read(record_data_.data(), static_cast<std::streamsize>(record_data_.size())))
+    {
+        truncated_ = file_.gcount() != 0;
+        return false;
+    }
+
+    std::memcpy(&out_record, record_data_.data(), sizeof(out_record));
+
+    // Older versions used the outcome bytes as reserved padding
+    if (header_.version < 3)
+        out_record.outcome = 0;
+    return true;
+}
+
+bool load_trace(const char* path, Trace& out_trace, std::string& out_error)
+{
+    TraceReader reader;
+    if (!reader.open(path))
+    {
+        out_error = reader.error();
+        return false;
+    }
+
+    out_trace.header = reader.header();
+
+    trace_format::Record record;
+    while (reader.next(record))
+        out_trace.records.push_back(record);
+    if (reader.truncated())
+        out_error = "ignoring truncated record at the end of the trace";
+
+    // Blocks from different threads are interleaved, restore the global order
+    std::stable_sort(out_trace.records.begin(), out_trace.records.end(),
+        [](const trace_format::Record& a, const trace_format::Record& b) { return a.timestamp < b.timestamp; });
+    return true;
+}
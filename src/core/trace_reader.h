@@ -0,0 +1,45 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+// Standard library only, shared by the offline tools and the replay
+#include "core/trace_format.h"
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Sequential reader for trace files, records come in file order
+// (per thread in order, threads interleaved in blocks)
+class TraceReader
+{
+public:
+    // Check the header, error() describes why a file was rejected
+    bool open(const char* path);
+
+    // Next record, false at the end of the file. A truncated last record is skipped and noted in truncated().
+    bool next(trace_format::Record& out_record);
+
+    const trace_format::Header& header() const { return header_; }
+    const std::string& error() const { return error_; }
+    bool truncated() const { return truncated_; }
+
+private:
+    std::ifstream file_;
+    trace_format::Header header_ = {};
+    std::vector<char> record_data_;
+    std::string error_;
+    bool truncated_ = false;
+};
+
+struct Trace
+{
+    trace_format::Header header = {};
+    std::vector<trace_format::Record> records;
+};
+
+// Read a whole trace and sort it by timestamp, so records of all threads are in global order
+bool load_trace(const char* path, Trace& out_trace, std::string& out_error);
@@ -5,9 +5,26 @@
  */
 
 #include "debug_logger.h"
-#include <iomanip>
+#include "async_log.h"
+#include "config.h"
+#include "hook_probe.h"
 #include <dxgi.h>
 
+namespace
+{
+    // Burst allowance of each hook, in seconds of DebugLogRate
+    constexpr uint32_t RATE_LIMIT_BURST_SECONDS = 2;
+
+    // 12345678 -> "12,345,678"
+    std::string format_count(uint64_t value)
+    {
+        std::string digits = std::to_string(value);
+        for (size_t i = digits.size(); i > 3; i -= 3)
+            digits.insert(i - 3, 1, ',');
+        return digits;
+    }
+}
+
 DebugLogger& DebugLogger::get_instance()
 {
     static DebugLogger instance;
@@ -17,7 +34,13 @@ DebugLogger& DebugLogger::get_instance()
 void DebugLogger::initialize()
 {
     start_time_ = std::chrono::high_resolution_clock::now();
-    sequence_counter_ = 0;
+    sequence_counter_.store(0, std::memory_order_relaxed);
+}
+
+uint64_t DebugLogger::get_elapsed_microseconds() const
+{
+    const auto duration = std::chrono::high_resolution_clock::now() - start_time_;
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
 }
 
 double DebugLogger::get_timestamp() const
@@ -29,50 +52,92 @@ double DebugLogger::get_timestamp() const
 
 uint32_t DebugLogger::get_next_sequence()
 {
-    std::lock_guard<std::mutex> lock(sequence_mutex_);
-    return ++sequence_counter_;
+    return sequence_counter_.fetch_add(1, std::memory_order_relaxed) + 1;
 }
 
-std::string DebugLogger::format_event_header(const char* event_name) const
+void DebugLogger::log_event(const char* event_name)
 {
-    std::ostringstream oss;
-    oss << std::fixed << std::setprecision(3);
-    oss << "[" << std::setw(8) << std::setfill('0') << get_timestamp() << "] ";
-    oss << "[" << std::setw(3) << std::setfill('0') << sequence_counter_ << "] ";
-    oss << "=== " << event_name << " ===";
-    return oss.str();
+    // Formatting happens on the log consumer, the hook only pays for a record copy
+    AsyncLog::get_instance().write_event(event_name, get_next_sequence(), get_timestamp());
 }
 
-std::string DebugLogger::format_hresult(HRESULT hr) const
+void DebugLogger::log(const std::string& text) const
 {
-    std::ostringstream oss;
-    oss << "0x" << std::hex << std::uppercase << hr;
+    AsyncLog::get_instance().write(reshade::log::level::info, text);
+}
+
+void DebugLogger::log(const char* text) const
+{
+    AsyncLog::get_instance().write(reshade::log::level::info, text);
+}
+
+bool DebugLogger::admit(trace_format::EventId event)
+{
+    const uint32_t rate = static_cast<uint32_t>(Config::get_instance().snapshot().get_debug_log_rate());
+
+    RateLimiter& limiter = rate_limiters_[hook_index(event)];
+    if (!limiter.try_acquire(get_elapsed_microseconds(), rate, rate * RATE_LIMIT_BURST_SECONDS))
+        return false;
 
-    // Add common DXGI error names
-    switch (hr)
+    const uint64_t skipped = limiter.take_rejected();
+    if (skipped != 0)
+        log(std::string(trace_format::event_name(event)) + ": " + format_count(skipped) + " calls not logged (DebugLogRate)");
+    return true;
+}
+
+void DebugLogger::on_frame()
+{
+    const uint32_t interval = static_cast<uint32_t>(Config::get_instance().snapshot().get_debug_log_summary_frames());
+    const uint64_t frame = frame_count_.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (interval == 0 || frame % interval != 0)
+        return;
+
+    std::lock_guard<std::mutex> lock(summary_mutex_);
+
+    std::array<HookTotals, HOOK_COUNT> totals;
+    HookProbe::get_instance().collect(totals);
+
+    const double timestamp = get_timestamp();
+    const double seconds = timestamp - summary_timestamp_;
+    const uint64_t frames = frame - summary_frame_;
+
+    log_event("FRAME_SUMMARY");
+
+    char line[128];
+    snprintf(line, sizeof(line), "  Frames: %s in %.1f s (%.1f fps)", format_count(frames).c_str(), seconds,
+        seconds > 0.0 ? static_cast<double>(frames) / seconds : 0.0);
+    log(line);
+
+    // One line per hook called since the last summary, with the outcomes that occurred
+    for (size_t hook = 0; hook < HOOK_COUNT; ++hook)
     {
-    case 0x887A0001: oss << " (DXGI_ERROR_INVALID_CALL)"; break;
-    case 0x887A0002: oss << " (DXGI_ERROR_NOT_FOUND)"; break;
-    case 0x887A0003: oss << " (DXGI_ERROR_MORE_DATA)"; break;
-    case 0x887A0004: oss << " (DXGI_ERROR_UNSUPPORTED)"; break;
-    case 0x887A0005: oss << " (DXGI_ERROR_DEVICE_REMOVED)"; break;
-    case 0x887A0006: oss << " (DXGI_ERROR_DEVICE_HUNG)"; break;
-    case 0x887A0007: oss << " (DXGI_ERROR_DEVICE_RESET)"; break;
-    case 0x887A000A: oss << " (DXGI_ERROR_WAS_STILL_DRAWING)"; break;
-    case 0x887A000B: oss << " (DXGI_ERROR_FRAME_STATISTICS_DISJOINT)"; break;
-    case 0x887A000C: oss << " (DXGI_ERROR_GRAPHICS_VIDPN_SOURCE_IN_USE)"; break;
-    case 0x887A0020: oss << " (DXGI_ERROR_DRIVER_INTERNAL_ERROR)"; break;
-    case 0x887A0021: oss << " (DXGI_ERROR_NONEXCLUSIVE)"; break;
-    case 0x887A0022: oss << " (DXGI_ERROR_NOT_CURRENTLY_AVAILABLE)"; break;
-    case 0x887A0026: oss << " (DXGI_ERROR_REMOTE_CLIENT_DISCONNECTED)"; break;
-    case 0x887A0027: oss << " (DXGI_ERROR_REMOTE_OUTOFMEMORY)"; break;
-    case S_OK: oss << " (S_OK)"; break;
-    case E_INVALIDARG: oss << " (E_INVALIDARG)"; break;
-    case E_OUTOFMEMORY: oss << " (E_OUTOFMEMORY)"; break;
-    default: break;
+        HookTotals delta;
+        for (size_t i = 0; i < HOOK_OUTCOME_COUNT; ++i)
+            delta.outcomes[i] = totals[hook].outcomes[i] - summary_totals_[hook].outcomes[i];
+
+        const uint64_t calls = delta.calls();
+        if (calls == 0)
+            continue;
+
+        std::string text = "  " + std::string(trace_format::event_name(HOOK_EVENTS[hook])) + ": " + format_count(calls) + " calls";
+        if (delta.count(HookOutcome::Redirected) != 0)
+            text += ", " + format_count(delta.count(HookOutcome::Redirected)) + " redirects";
+        if (delta.count(HookOutcome::Rewritten) != 0)
+            text += ", " + format_count(delta.count(HookOutcome::Rewritten)) + " rewrites";
+        if (delta.count(HookOutcome::EarlyOut) != 0)
+            text += ", " + format_count(delta.count(HookOutcome::EarlyOut)) + " early-outs";
+        log(text);
     }
 
-    return oss.str();
+    summary_totals_ = totals;
+    summary_frame_ = frame;
+    summary_timestamp_ = timestamp;
+}
+
+const char* DebugLogger::format_hresult(HRESULT hr, std::span<char> buffer) const
+{
+    decode::TextWriter writer(buffer);
+    return decode::write_hresult(writer, static_cast<uint32_t>(hr));
 }
 
 const char* DebugLogger::device_api_to_string(reshade::api::device_api api) const
@@ -90,19 +155,10 @@ const char* DebugLogger::device_api_to_string(reshade::api::device_api api) cons
     }
 }
 
-const char* DebugLogger::format_to_string(reshade::api::format format) const
+const char* DebugLogger::format_to_string(reshade::api::format format, std::span<char> buffer) const
 {
-    using namespace reshade::api;
-    switch (format)
-    {
-    case format::r8g8b8a8_unorm: return "R8G8B8A8_UNORM";
-    case format::r8g8b8a8_unorm_srgb: return "R8G8B8A8_UNORM_SRGB";
-    case format::b8g8r8a8_unorm: return "B8G8R8A8_UNORM";
-    case format::b8g8r8a8_unorm_srgb: return "B8G8R8A8_UNORM_SRGB";
-    case format::r10g10b10a2_unorm: return "R10G10B10A2_UNORM";
-    case format::r16g16b16a16_float: return "R16G16B16A16_FLOAT";
-    default: return "Other";
-    }
+    decode::TextWriter writer(buffer);
+    return decode::write_dxgi_format(writer, static_cast<uint32_t>(format));
 }
 
 std::string DebugLogger::resource_usage_to_string(reshade::api::resource_usage usage) const
@@ -141,79 +197,40 @@ void DebugLogger::log_device_info(reshade::api::device* device) const
         return;
 
     const reshade::api::device_api api = device->get_api();
-    reshade::log::message(reshade::log::level::info,
-        ("  Device API: " + std::string(device_api_to_string(api))).c_str());
+    log("  Device API: " + std::string(device_api_to_string(api)));
 }
 
 void DebugLogger::log_swapchain_desc(const reshade::api::swapchain_desc& desc, void* hwnd) const
 {
     std::ostringstream info;
     info << "  Resolution: " << desc.back_buffer.texture.width << "x" << desc.back_buffer.texture.height << "\n";
-    info << "  Format: " << format_to_string(desc.back_buffer.texture.format) << "\n";
+    char format_text[decode::TEXT_BUFFER_SIZE];
+    info << "  Format: " << format_to_string(desc.back_buffer.texture.format, format_text) << "\n";
     info << "  Fullscreen State: " << (desc.fullscreen_state ? "true (exclusive)" : "false (windowed)") << "\n";
     info << "  Present Flags: 0x" << std::hex << std::uppercase << desc.present_flags << std::dec << "\n";
     info << "  Back Buffer Count: " << desc.back_buffer_count << "\n";
     if (hwnd != nullptr)
         info << "  HWND: 0x" << std::hex << std::uppercase << reinterpret_cast<uintptr_t>(hwnd);
 
-    reshade::log::message(reshade::log::level::info, info.str().c_str());
+    log(info.str());
 }
 
-std::string DebugLogger::decode_window_style(DWORD style) const
+const char* DebugLogger::decode_window_style(DWORD style, std::span<char> buffer) const
 {
-    std::ostringstream oss;
-    oss << "0x" << std::hex << std::uppercase << style << " (";
-
-    bool first = true;
-    auto append_flag = [&](const char* name) {
-        if (!first) oss << " | ";
-        oss << name;
-        first = false;
-    };
-
-    if (style & WS_POPUP) append_flag("WS_POPUP");
-    if (style & WS_CHILD) append_flag("WS_CHILD");
-    if (style & WS_MINIMIZE) append_flag("WS_MINIMIZE");
-    if (style & WS_VISIBLE) append_flag("WS_VISIBLE");
-    if (style & WS_DISABLED) append_flag("WS_DISABLED");
-    if (style & WS_CLIPSIBLINGS) append_flag("WS_CLIPSIBLINGS");
-    if (style & WS_CLIPCHILDREN) append_flag("WS_CLIPCHILDREN");
-    if (style & WS_MAXIMIZE) append_flag("WS_MAXIMIZE");
-    if (style & WS_CAPTION) append_flag("WS_CAPTION");
-    if (style & WS_BORDER) append_flag("WS_BORDER");
-    if (style & WS_DLGFRAME) append_flag("WS_DLGFRAME");
-    if (style & WS_VSCROLL) append_flag("WS_VSCROLL");
-    if (style & WS_HSCROLL) append_flag("WS_HSCROLL");
-    if (style & WS_SYSMENU) append_flag("WS_SYSMENU");
-    if (style & WS_THICKFRAME) append_flag("WS_THICKFRAME");
-    if (style & WS_MINIMIZEBOX) append_flag("WS_MINIMIZEBOX");
-    if (style & WS_MAXIMIZEBOX) append_flag("WS_MAXIMIZEBOX");
-
-    oss << ")";
-    return oss.str();
+    decode::TextWriter writer(buffer);
+    return decode::write_flags(writer, style, decode::WINDOW_STYLES);
 }
 
-std::string DebugLogger::decode_window_ex_style(DWORD ex_style) const
+const char* DebugLogger::decode_window_ex_style(DWORD ex_style, std::span<char> buffer) const
 {
-    std::ostringstream oss;
-    oss << "0x" << std::hex << std::uppercase << ex_style << " (";
-
-    bool first = true;
-    auto append_flag = [&](const char* name) {
-        if (!first) oss << " | ";
-        oss << name;
-        first = false;
-    };
-
-    if (ex_style & WS_EX_TOPMOST) append_flag("WS_EX_TOPMOST");
-    if (ex_style & WS_EX_APPWINDOW) append_flag("WS_EX_APPWINDOW");
-    if (ex_style & WS_EX_TOOLWINDOW) append_flag("WS_EX_TOOLWINDOW");
-    if (ex_style & WS_EX_WINDOWEDGE) append_flag("WS_EX_WINDOWEDGE");
-    if (ex_style & WS_EX_CLIENTEDGE) append_flag("WS_EX_CLIENTEDGE");
-    if (ex_style & WS_EX_LAYERED) append_flag("WS_EX_LAYERED");
+    decode::TextWriter writer(buffer);
+    return decode::write_flags(writer, ex_style, decode::WINDOW_EX_STYLES);
+}
 
-    oss << ")";
-    return oss.str();
+const char* DebugLogger::decode_set_window_pos_flags(UINT flags, std::span<char> buffer) const
+{
+    decode::TextWriter writer(buffer);
+    return decode::write_flags(writer, flags, decode::SET_WINDOW_POS_FLAGS);
 }
 
 void DebugLogger::log_window_state(HWND hwnd) const
@@ -226,13 +243,15 @@ void DebugLogger::log_window_state(HWND hwnd) const
     RECT rect;
     GetWindowRect(hwnd, &rect);
 
+    char flags_text[decode::TEXT_BUFFER_SIZE];
+
     std::ostringstream info;
     info << "  HWND: 0x" << std::hex << std::uppercase << reinterpret_cast<uintptr_t>(hwnd) << std::dec << "\n";
-    info << "  Window Style: " << decode_window_style(style) << "\n";
-    info << "  Window Ex Style: " << decode_window_ex_style(ex_style) << "\n";
+    info << "  Window Style: " << decode_window_style(style, flags_text) << "\n";
+    info << "  Window Ex Style: " << decode_window_ex_style(ex_style, flags_text) << "\n";
     info << "  Window Rect: (" << rect.left << "," << rect.top << ")-(" << rect.right << "," << rect.bottom << ")";
 
-    reshade::log::message(reshade::log::level::info, info.str().c_str());
+    log(info.str());
 }
 
 void DebugLogger::log_dxgi_state(void* swapchain_native, reshade::api::device_api api) const
@@ -274,10 +293,11 @@ void DebugLogger::log_dxgi_state(void* swapchain_native, reshade::api::device_ap
     }
     else
     {
-        info << "  DXGI Fullscreen State: Query failed (" << format_hresult(hr) << ")";
+        char hr_text[decode::TEXT_BUFFER_SIZE];
+        info << "  DXGI Fullscreen State: Query failed (" << format_hresult(hr, hr_text) << ")";
     }
 
-    reshade::log::message(reshade::log::level::info, info.str().c_str());
+    log(info.str());
 }
 
 void DebugLogger::log_monitor_info(HMONITOR hmonitor) const
@@ -297,6 +317,6 @@ void DebugLogger::log_monitor_info(HMONITOR hmonitor) const
         info << (rect.right - rect.left) << "x" << (rect.bottom - rect.top) << ") at (";
         info << rect.left << "," << rect.top << ")";
 
-        reshade::log::message(reshade::log::level::info, info.str().c_str());
+        log(info.str());
     }
 }
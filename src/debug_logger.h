@@ -7,6 +7,10 @@
 #pragma once
 
 #include "common.h"
+#include "async_log.h"
+#include "core/decode_tables.h"
+#include "core/hook_stats.h"
+#include "core/rate_limiter.h"
 #include <string>
 #include <chrono>
 #include <sstream>
@@ -26,17 +30,37 @@ public:
     // Get and increment sequence number
     uint32_t get_next_sequence();
 
-    // Format event header: [timestamp] [seq] === EVENT_NAME ===
-    std::string format_event_header(const char* event_name) const;
+    // Log event header: [timestamp] [seq] === EVENT_NAME === (event_name must be a string literal)
+    void log_event(const char* event_name);
 
-    // Format HRESULT with common DXGI error code names
-    std::string format_hresult(HRESULT hr) const;
+    // Queue a detail line on the asynchronous log
+    void log(const std::string& text) const;
+    void log(const char* text) const;
+
+    // Queue the raw arguments of a detail line, Args::format builds the text on the log consumer
+    template <typename Args>
+    void log_deferred(const Args& args) const
+    {
+        AsyncLog::get_instance().write_deferred(reshade::log::level::info, args);
+    }
+
+    // Rate limit for per-call debug output of one hook (DebugLogRate). Returns false if this call
+    // should not be logged; the first admitted call after a rejected one reports how many were skipped.
+    bool admit(trace_format::EventId event);
+
+    // Count a presented frame and log the hook counters of the last DebugLogSummaryFrames frames
+    void on_frame();
+
+    // The formatters below write into buffer (decode::TEXT_BUFFER_SIZE is always enough) and return it
+
+    // Format HRESULT with its DXGI, D3D or COM error name
+    const char* format_hresult(HRESULT hr, std::span<char> buffer) const;
 
     // Format device API enum to string
     const char* device_api_to_string(reshade::api::device_api api) const;
 
-    // Format format enum to string
-    const char* format_to_string(reshade::api::format format) const;
+    // Format format enum as its DXGI_FORMAT name, or in hex for ReShade's own formats
+    const char* format_to_string(reshade::api::format format, std::span<char> buffer) const;
 
     // Format resource usage flags to string
     std::string resource_usage_to_string(reshade::api::resource_usage usage) const;
@@ -57,10 +81,13 @@ public:
     void log_monitor_info(HMONITOR hmonitor) const;
 
     // Decode window style flags
-    std::string decode_window_style(DWORD style) const;
+    const char* decode_window_style(DWORD style, std::span<char> buffer) const;
 
     // Decode window ex style flags
-    std::string decode_window_ex_style(DWORD ex_style) const;
+    const char* decode_window_ex_style(DWORD ex_style, std::span<char> buffer) const;
+
+    // Decode SetWindowPos flags
+    const char* decode_set_window_pos_flags(UINT flags, std::span<char> buffer) const;
 
 private:
     DebugLogger() = default;
@@ -72,7 +99,17 @@ private:
     DebugLogger(DebugLogger&&) = delete;
     DebugLogger& operator=(DebugLogger&&) = delete;
 
+    // Microseconds since initialize(), the rate limiter clock
+    uint64_t get_elapsed_microseconds() const;
+
     std::chrono::high_resolution_clock::time_point start_time_;
-    uint32_t sequence_counter_ = 0;
-    mutable std::mutex sequence_mutex_;
+    std::atomic<uint32_t> sequence_counter_ = 0;
+
+    std::array<RateLimiter, HOOK_COUNT> rate_limiters_;  // Indexed like HOOK_EVENTS
+
+    std::atomic<uint64_t> frame_count_ = 0;
+    std::mutex summary_mutex_;                             // Protects the summary state below
+    std::array<HookTotals, HOOK_COUNT> summary_totals_ = {};  // HookProbe totals at the last summary
+    uint64_t summary_frame_ = 0;
+    double summary_timestamp_ = 0.0;
 };
@@ -0,0 +1,148 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "flight_recorder.h"
+#include "hook_probe.h"
+#include <cstring>
+
+FlightRecorder& FlightRecorder::get_instance()
+{
+    static FlightRecorder instance;
+    return instance;
+}
+
+void FlightRecorder::install()
+{
+    if (installed_)
+        return;
+
+    // The dump goes next to the executable, like relative TraceFile paths
+    const DWORD length = GetModuleFileNameW(nullptr, dump_path_, MAX_PATH);
+    if (length == 0 || length == MAX_PATH)
+    {
+        reshade::log::message(reshade::log::level::warning, "Flight recorder disabled, executable path unavailable");
+        return;
+    }
+
+    wchar_t* file_name = dump_path_;
+    for (wchar_t* c = dump_path_; *c != L'\0'; ++c)
+    {
+        if (*c == L'\\' || *c == L'/')
+            file_name = c + 1;
+    }
+    const size_t available = static_cast<size_t>(dump_path_ + MAX_PATH - file_name);
+    if (wcslen(DUMP_FILE_NAME) >= available)
+    {
+        reshade::log::message(reshade::log::level::warning, "Flight recorder disabled, executable path too long");
+        return;
+    }
+    wcscpy_s(file_name, available, DUMP_FILE_NAME);
+
+    previous_filter_ = SetUnhandledExceptionFilter(on_unhandled_exception);
+    previous_abort_handler_ = signal(SIGABRT, on_abort);
+    installed_ = true;
+}
+
+void FlightRecorder::uninstall()
+{
+    if (!installed_)
+        return;
+
+    // Note: Handlers installed after ours chain to code that is about to be unloaded either way
+    SetUnhandledExceptionFilter(previous_filter_);
+    signal(SIGABRT, previous_abort_handler_ != SIG_ERR ? previous_abort_handler_ : SIG_DFL);
+    installed_ = false;
+}
+
+void FlightRecorder::record(trace_format::EventId event, uint16_t result, HookOutcome outcome, uint64_t start_ticks, uint64_t end_ticks, const uint64_t (&args)[4])
+{
+    const uint64_t position = head_.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = slots_[position % CAPACITY];
+
+    // Sequence lock per slot, dump() skips slots that are being written
+    slot.sequence.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    trace_format::Record& record = slot.record;
+    record.timestamp = start_ticks;
+    record.duration = static_cast<uint32_t>(std::min<uint64_t>(end_ticks - start_ticks, UINT32_MAX));
+    record.thread_id = GetCurrentThreadId();
+    record.event = event;
+    record.result = result;
+    record.outcome = static_cast<uint8_t>(outcome);
+    std::memset(record.reserved, 0, sizeof(record.reserved));
+    std::memcpy(record.args, args, sizeof(record.args));
+
+    slot.sequence.store(position + 1, std::memory_order_release);
+}
+
+void FlightRecorder::dump()
+{
+    if (!installed_ || dumped_.exchange(true, std::memory_order_acq_rel))
+        return;
+
+    // Oldest to newest; other threads may still be recording, their slots are skipped or overwritten
+    const uint64_t head = head_.load(std::memory_order_acquire);
+    const uint64_t first = head > CAPACITY ? head - CAPACITY : 0;
+
+    size_t count = 0;
+    for (uint64_t position = first; position < head; ++position)
+    {
+        const Slot& slot = slots_[position % CAPACITY];
+        if (slot.sequence.load(std::memory_order_acquire) != position + 1)
+            continue;
+
+        dump_records_[count] = slot.record;
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.sequence.load(std::memory_order_relaxed) == position + 1)
+            ++count;
+    }
+
+    // Less than a millisecond after load there is no calibration yet, assume a 1 GHz counter
+    const double ticks_per_microsecond = HookProbe::get_instance().ticks_per_microsecond();
+
+    trace_format::Header header = {};
+    header.magic = trace_format::MAGIC;
+    header.version = trace_format::VERSION;
+    header.record_size = sizeof(trace_format::Record);
+    header.process_id = GetCurrentProcessId();
+    header.ticks_per_second = ticks_per_microsecond > 0.0 ? static_cast<uint64_t>(ticks_per_microsecond * 1000000.0) : 1000000000;
+    header.start_timestamp = HookProbe::get_instance().install_ticks();
+
+    const HANDLE file = CreateFileW(dump_path_, GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return;
+
+    DWORD bytes_written = 0;
+    if (WriteFile(file, &header, sizeof(header), &bytes_written, nullptr) && count != 0)
+        WriteFile(file, dump_records_.data(), static_cast<DWORD>(count * sizeof(trace_format::Record)), &bytes_written, nullptr);
+
+    FlushFileBuffers(file);
+    CloseHandle(file);
+}
+
+LONG WINAPI FlightRecorder::on_unhandled_exception(EXCEPTION_POINTERS* exception)
+{
+    FlightRecorder& recorder = get_instance();
+    recorder.dump();
+
+    if (recorder.previous_filter_ != nullptr)
+        return recorder.previous_filter_(exception);
+    return EXCEPTION_CONTINUE_SEARCH;
+}
+
+void __cdecl FlightRecorder::on_abort(int signal)
+{
+    // std::terminate ends in abort(), which raises SIGABRT for every thread of the process.
+    // std::set_terminate would only cover the thread that called it with the MSVC runtime.
+    FlightRecorder& recorder = get_instance();
+    recorder.dump();
+
+    // The runtime resets the handler before calling it, hand the signal on to the previous one
+    ::signal(SIGABRT, recorder.previous_abort_handler_ != SIG_ERR ? recorder.previous_abort_handler_ : SIG_DFL);
+    raise(signal);
+}
@@ -0,0 +1,71 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include "common.h"
+#include "core/hook_stats.h"
+#include "core/trace_format.h"
+#include <array>
+#include <csignal>
+
+// Always-on ring of the last CAPACITY hook calls, written to a trace file (see core/trace_format.h)
+// when the process crashes. Recording costs one locked increment and a 64-byte slot write;
+// the dump runs inside the crash handlers and neither allocates nor takes locks.
+class FlightRecorder
+{
+public:
+    // Singleton access
+    static FlightRecorder& get_instance();
+
+    // Resolve the dump path and install the unhandled exception and abort handlers
+    void install();
+
+    // Restore the previous handlers
+    void uninstall();
+
+    // Store a finished hook call, timestamps are HookProbe ticks
+    void record(trace_format::EventId event, uint16_t result, HookOutcome outcome, uint64_t start_ticks, uint64_t end_ticks, const uint64_t (&args)[4]);
+
+    // Write the ring to the dump file, only the first call does anything
+    void dump();
+
+    static constexpr size_t CAPACITY = 8192;
+    static constexpr const wchar_t* DUMP_FILE_NAME = L"swapchain_override_crash.sotr";
+
+private:
+    FlightRecorder() = default;
+    ~FlightRecorder() = default;
+
+    // Delete copy/move constructors
+    FlightRecorder(const FlightRecorder&) = delete;
+    FlightRecorder& operator=(const FlightRecorder&) = delete;
+    FlightRecorder(FlightRecorder&&) = delete;
+    FlightRecorder& operator=(FlightRecorder&&) = delete;
+
+    struct alignas(64) Slot
+    {
+        trace_format::Record record;
+        std::atomic<uint64_t> sequence;  // Ring position + 1 once the record is complete, 0 while it is written
+    };
+    static_assert(sizeof(Slot) == 64, "One slot per cache line");
+
+    static LONG WINAPI on_unhandled_exception(EXCEPTION_POINTERS* exception);
+    static void __cdecl on_abort(int signal);
+
+    // std::atomic value-initializes, every slot starts out empty
+    std::array<Slot, CAPACITY> slots_;
+    std::atomic<uint64_t> head_ = 0;
+
+    // Complete records in ring order, filled by dump() so the crash path needs no allocation
+    std::array<trace_format::Record, CAPACITY> dump_records_;
+    std::atomic<bool> dumped_ = false;
+    wchar_t dump_path_[MAX_PATH] = {};
+
+    bool installed_ = false;
+    LPTOP_LEVEL_EXCEPTION_FILTER previous_filter_ = nullptr;
+    void (__cdecl* previous_abort_handler_)(int) = SIG_DFL;
+};
@@ -0,0 +1,56 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "frame_timer.h"
+#include "hook_probe.h"
+
+namespace
+{
+    uint32_t saturate(uint64_t ticks)
+    {
+        return static_cast<uint32_t>(std::min<uint64_t>(ticks, UINT32_MAX));
+    }
+}
+
+FrameTimer& FrameTimer::get_instance()
+{
+    static FrameTimer instance;
+    return instance;
+}
+
+void FrameTimer::record_present()
+{
+    const HookProbe& probe = HookProbe::get_instance();
+    const uint64_t now = HookProbe::ticks();
+    const uint64_t busy = probe.total_busy_ticks();
+
+    const uint64_t previous_present = last_present_ticks_.exchange(now, std::memory_order_relaxed);
+    const uint64_t previous_busy = last_busy_ticks_.exchange(busy, std::memory_order_relaxed);
+    present_count_.fetch_add(1, std::memory_order_relaxed);
+    if (previous_present == 0)
+        return;
+
+    const uint64_t packed = (static_cast<uint64_t>(saturate(now - previous_present)) << 32) |
+        saturate(busy >= previous_busy ? busy - previous_busy : 0);
+
+    const uint64_t position = sample_count_.fetch_add(1, std::memory_order_relaxed);
+    samples_[position % CAPACITY].store(packed, std::memory_order_relaxed);
+}
+
+size_t FrameTimer::copy_samples(std::span<FrameSample> out_samples) const
+{
+    // A slot can be overwritten while copying, which only replaces an old frame with a newer one
+    const uint64_t count = sample_count_.load(std::memory_order_relaxed);
+    const size_t copied = static_cast<size_t>(std::min<uint64_t>({ count, CAPACITY, out_samples.size() }));
+
+    for (size_t i = 0; i < copied; ++i)
+    {
+        const uint64_t packed = samples_[(count - copied + i) % CAPACITY].load(std::memory_order_relaxed);
+        out_samples[i].interval_ticks = static_cast<uint32_t>(packed >> 32);
+        out_samples[i].addon_ticks = static_cast<uint32_t>(packed);
+    }
+    return copied;
+}
@@ -0,0 +1,58 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include "common.h"
+#include <array>
+
+// Present-to-present intervals and the time the addon's hooks spent in each frame,
+// in HookProbe ticks, saturated at UINT32_MAX
+struct FrameSample
+{
+    uint32_t interval_ticks;
+    uint32_t addon_ticks;
+};
+
+// Lock-free ring of the most recent frames, written by the finish_present hook (always registered)
+// and read by the overlay and the stats export.
+// A sample is packed into one 64-bit atomic, so readers never see a torn one.
+class FrameTimer
+{
+public:
+    // Singleton access
+    static FrameTimer& get_instance();
+
+    // Record the end of a present
+    void record_present();
+
+    // Presents recorded since load, one more than the samples once frames are flowing
+    uint64_t get_present_count() const { return present_count_.load(std::memory_order_relaxed); }
+
+    // Copy up to out_samples.size() of the most recent samples, oldest first. Returns the number copied.
+    size_t copy_samples(std::span<FrameSample> out_samples) const;
+
+    static constexpr size_t CAPACITY = 512;
+
+private:
+    FrameTimer() = default;
+    ~FrameTimer() = default;
+
+    // Delete copy/move constructors
+    FrameTimer(const FrameTimer&) = delete;
+    FrameTimer& operator=(const FrameTimer&) = delete;
+    FrameTimer(FrameTimer&&) = delete;
+    FrameTimer& operator=(FrameTimer&&) = delete;
+
+    // std::atomic value-initializes, the ring starts out empty
+    std::array<std::atomic<uint64_t>, CAPACITY> samples_;
+    std::atomic<uint64_t> sample_count_ = 0;
+    std::atomic<uint64_t> present_count_ = 0;
+
+    // Previous present, exchanged so presents from several threads still pair up
+    std::atomic<uint64_t> last_present_ticks_ = 0;
+    std::atomic<uint64_t> last_busy_ticks_ = 0;
+};
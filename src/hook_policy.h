@@ -0,0 +1,83 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include "config.h"
+#include <cstdint>
+
+// Compile-time feature set for hook handlers.
+// Handlers are instantiated once per policy and the hooks pick the instantiation of the
+// active configuration, so the per-call path carries no config branches.
+template <bool Debug, bool ResolutionOverride, FullscreenMode Mode>
+struct HookPolicy
+{
+    // Debug mode only observes and disables every override
+    static constexpr bool debug = Debug;
+    static constexpr bool resolution_override = !Debug && ResolutionOverride;
+    static constexpr bool borderless = !Debug && Mode == FullscreenMode::Borderless;
+    static constexpr bool exclusive = !Debug && Mode == FullscreenMode::Exclusive;
+    static constexpr bool fullscreen_overridden = borderless || exclusive;
+    static constexpr FullscreenMode fullscreen_mode = Debug ? FullscreenMode::Unchanged : Mode;
+};
+
+using DebugHookPolicy = HookPolicy<true, false, FullscreenMode::Unchanged>;
+
+// One value per policy instantiation. Hooks are registered once and read the index from an atomic
+// on each call, so a reload switches the handlers without touching ReShade's callback lists.
+enum class HookPolicyIndex : uint8_t
+{
+    Unchanged = 0,
+    UnchangedOverride = 1,
+    Borderless = 2,
+    BorderlessOverride = 3,
+    Exclusive = 4,
+    ExclusiveOverride = 5,
+    Debug = 6
+};
+
+inline HookPolicyIndex hook_policy_index(const ConfigSnapshot& config)
+{
+    if (config.is_debug_mode_enabled())
+        return HookPolicyIndex::Debug;
+
+    const bool resolution_override = config.is_resolution_override_enabled();
+
+    switch (config.get_fullscreen_mode())
+    {
+    case FullscreenMode::Borderless:
+        return resolution_override ? HookPolicyIndex::BorderlessOverride : HookPolicyIndex::Borderless;
+    case FullscreenMode::Exclusive:
+        return resolution_override ? HookPolicyIndex::ExclusiveOverride : HookPolicyIndex::Exclusive;
+    case FullscreenMode::Unchanged:
+    default:
+        return resolution_override ? HookPolicyIndex::UnchangedOverride : HookPolicyIndex::Unchanged;
+    }
+}
+
+// Call func.template operator()<Policy>() with the policy of the index
+template <typename Func>
+decltype(auto) dispatch_hook_policy(HookPolicyIndex index, Func&& func)
+{
+    switch (index)
+    {
+    case HookPolicyIndex::Debug:
+        return func.template operator()<DebugHookPolicy>();
+    case HookPolicyIndex::BorderlessOverride:
+        return func.template operator()<HookPolicy<false, true, FullscreenMode::Borderless>>();
+    case HookPolicyIndex::Borderless:
+        return func.template operator()<HookPolicy<false, false, FullscreenMode::Borderless>>();
+    case HookPolicyIndex::ExclusiveOverride:
+        return func.template operator()<HookPolicy<false, true, FullscreenMode::Exclusive>>();
+    case HookPolicyIndex::Exclusive:
+        return func.template operator()<HookPolicy<false, false, FullscreenMode::Exclusive>>();
+    case HookPolicyIndex::UnchangedOverride:
+        return func.template operator()<HookPolicy<false, true, FullscreenMode::Unchanged>>();
+    case HookPolicyIndex::Unchanged:
+    default:
+        return func.template operator()<HookPolicy<false, false, FullscreenMode::Unchanged>>();
+    }
+}
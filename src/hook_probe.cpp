@@ -0,0 +1,157 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "hook_probe.h"
+
+namespace
+{
+    thread_local void* t_hook_counters = nullptr;
+
+    // Releases the calling thread's block when the thread exits
+    struct ThreadCountersOwner
+    {
+        std::atomic<bool>* in_use = nullptr;
+
+        ~ThreadCountersOwner()
+        {
+            // Release, the next owner must see the last counts before it adds to them
+            if (in_use != nullptr)
+                in_use->store(false, std::memory_order_release);
+            t_hook_counters = nullptr;
+        }
+    };
+
+    thread_local ThreadCountersOwner t_hook_counters_owner;
+
+    // Only the owning thread writes a counter, so a relaxed load and store is enough
+    void increment(std::atomic<uint64_t>& counter)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+}
+
+HookProbe& HookProbe::get_instance()
+{
+    static HookProbe instance;
+    return instance;
+}
+
+HookProbe::~HookProbe()
+{
+    // Note: Runs at unload, after every hook and callback has been removed
+    ThreadCounters* counters = threads_.exchange(nullptr, std::memory_order_acquire);
+    while (counters != nullptr)
+    {
+        ThreadCounters* next = counters->next;
+        delete counters;
+        counters = next;
+    }
+}
+
+void HookProbe::install()
+{
+    LARGE_INTEGER counter;
+    LARGE_INTEGER frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+
+    install_ticks_ = ticks();
+    install_counter_ = counter.QuadPart;
+    counter_frequency_ = frequency.QuadPart;
+}
+
+void HookProbe::record(trace_format::EventId event, HookOutcome outcome, uint64_t elapsed_ticks)
+{
+    ThreadCounters* counters = get_thread_counters();
+    const size_t hook = hook_index(event);
+
+    increment(counters->outcomes[hook][static_cast<size_t>(outcome)]);
+    increment(counters->latency[hook][latency_bucket(elapsed_ticks)]);
+    counters->busy_ticks.store(counters->busy_ticks.load(std::memory_order_relaxed) + elapsed_ticks, std::memory_order_relaxed);
+}
+
+HookProbe::ThreadCounters* HookProbe::get_thread_counters()
+{
+    if (t_hook_counters != nullptr)
+        return static_cast<ThreadCounters*>(t_hook_counters);
+
+    // Take over the block of a thread that has exited, acquire pairs with the release in ~ThreadCountersOwner
+    ThreadCounters* counters = nullptr;
+    for (ThreadCounters* candidate = threads_.load(std::memory_order_acquire); candidate != nullptr; candidate = candidate->next)
+    {
+        bool in_use = false;
+        if (candidate->in_use.compare_exchange_strong(in_use, true, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            counters = candidate;
+            break;
+        }
+    }
+
+    if (counters == nullptr)
+    {
+        counters = new ThreadCounters();
+        counters->in_use.store(true, std::memory_order_relaxed);
+
+        // Publish with release so collect() sees the zeroed counters before the pointer
+        ThreadCounters* head = threads_.load(std::memory_order_relaxed);
+        do
+        {
+            counters->next = head;
+        } while (!threads_.compare_exchange_weak(head, counters, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    t_hook_counters = counters;
+    t_hook_counters_owner.in_use = &counters->in_use;
+    return counters;
+}
+
+size_t HookProbe::get_thread_block_count() const
+{
+    size_t count = 0;
+    for (const ThreadCounters* counters = threads_.load(std::memory_order_acquire); counters != nullptr; counters = counters->next)
+        ++count;
+    return count;
+}
+
+void HookProbe::collect(std::array<HookTotals, HOOK_COUNT>& out_totals) const
+{
+    out_totals = {};
+
+    for (const ThreadCounters* counters = threads_.load(std::memory_order_acquire); counters != nullptr; counters = counters->next)
+    {
+        for (size_t hook = 0; hook < HOOK_COUNT; ++hook)
+        {
+            HookTotals& totals = out_totals[hook];
+            for (size_t i = 0; i < HOOK_OUTCOME_COUNT; ++i)
+                totals.outcomes[i] += counters->outcomes[hook][i].load(std::memory_order_relaxed);
+            for (size_t i = 0; i < HOOK_LATENCY_BUCKETS; ++i)
+                totals.latency[i] += counters->latency[hook][i].load(std::memory_order_relaxed);
+        }
+    }
+}
+
+uint64_t HookProbe::total_busy_ticks() const
+{
+    uint64_t total = 0;
+    for (const ThreadCounters* counters = threads_.load(std::memory_order_acquire); counters != nullptr; counters = counters->next)
+        total += counters->busy_ticks.load(std::memory_order_relaxed);
+    return total;
+}
+
+double HookProbe::ticks_per_microsecond() const
+{
+    if (counter_frequency_ == 0)
+        return 0.0;
+
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+
+    const double elapsed_microseconds = static_cast<double>(counter.QuadPart - install_counter_) * 1000000.0 / static_cast<double>(counter_frequency_);
+    if (elapsed_microseconds < 1000.0)
+        return 0.0;
+
+    return static_cast<double>(ticks() - install_ticks_) / elapsed_microseconds;
+}
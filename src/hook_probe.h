@@ -0,0 +1,78 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include "common.h"
+#include "core/hook_stats.h"
+#include <intrin.h>
+
+// Always-on per-hook counters and latency histograms (see core/hook_stats.h).
+// Each thread counts into its own block with plain relaxed stores, no locked instructions
+// and no shared cache lines; collect() sums all blocks without stopping the writers.
+// A thread hands its block back when it exits and the next new thread keeps counting into it,
+// so games that keep replacing worker threads do not grow the list.
+class HookProbe
+{
+public:
+    // Singleton access
+    static HookProbe& get_instance();
+
+    // Remember the start point used to calibrate ticks against QueryPerformanceCounter
+    void install();
+
+    // Count one finished call on the calling thread
+    void record(trace_format::EventId event, HookOutcome outcome, uint64_t elapsed_ticks);
+
+    // Sum the counters of all threads. Lock-free, counts of hooks running concurrently may be one behind.
+    void collect(std::array<HookTotals, HOOK_COUNT>& out_totals) const;
+
+    // Ticks spent inside hooks by all threads since load. Lock-free like collect().
+    uint64_t total_busy_ticks() const;
+
+    // Tick rate measured since install() (0 if not enough time has passed yet)
+    double ticks_per_microsecond() const;
+
+    // Blocks allocated so far, at most one per thread alive at the same time
+    size_t get_thread_block_count() const;
+
+    // Tick count when install() ran
+    uint64_t install_ticks() const { return install_ticks_; }
+
+    // Latency clock, the CPU time stamp counter
+    static uint64_t ticks() { return __rdtsc(); }
+
+private:
+    HookProbe() = default;
+    ~HookProbe();
+
+    // Delete copy/move constructors
+    HookProbe(const HookProbe&) = delete;
+    HookProbe& operator=(const HookProbe&) = delete;
+    HookProbe(HookProbe&&) = delete;
+    HookProbe& operator=(HookProbe&&) = delete;
+
+    // std::atomic value-initializes, a new block starts at zero. A reused block keeps the counts
+    // of its previous owners, the totals are sums so they stay correct.
+    struct ThreadCounters
+    {
+        std::atomic<uint64_t> outcomes[HOOK_COUNT][HOOK_OUTCOME_COUNT];
+        std::atomic<uint64_t> latency[HOOK_COUNT][HOOK_LATENCY_BUCKETS];
+        std::atomic<uint64_t> busy_ticks;
+        std::atomic<bool> in_use;  // Owned by a live thread, cleared when that thread exits
+        ThreadCounters* next = nullptr;
+    };
+
+    // Counters of the calling thread, claimed from an exited thread or created and published on first use
+    ThreadCounters* get_thread_counters();
+
+    // Intrusive list of every block, blocks are reused but never unlinked until the addon unloads
+    std::atomic<ThreadCounters*> threads_ = nullptr;
+
+    uint64_t install_ticks_ = 0;
+    int64_t install_counter_ = 0;
+    int64_t counter_frequency_ = 0;
+};
@@ -11,16 +11,22 @@
 
 #include "common.h"
 #include "config.h"
+#include "async_log.h"
+#include "config_watcher.h"
 #include "debug_logger.h"
+#include "flight_recorder.h"
+#include "hook_probe.h"
 #include "window_hooks.h"
 #include "swapchain_manager.h"
 #include "overlay.h"
+#include "stats_exporter.h"
+#include "trace_recorder.h"
 
 // ============================================================================
 // DLL Entry Point
 // ============================================================================
 
-BOOL APIENTRY DllMain(HMODULE hModule, DWORD fdwReason, LPVOID)
+BOOL APIENTRY DllMain(HMODULE hModule, DWORD fdwReason, LPVOID lpReserved)
 {
     switch (fdwReason)
     {
@@ -29,12 +35,24 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD fdwReason, LPVOID)
         if (!reshade::register_addon(hModule))
             return FALSE;
 
+        // Start the asynchronous log consumer before anything can log from a hook
+        AsyncLog::get_instance().install();
+
         // Initialize debug logger
         DebugLogger::get_instance().initialize();
 
         // Load configuration
         Config::get_instance().load();
 
+        // Open the event trace before any hook can fire
+        TraceRecorder::get_instance().install();
+
+        // Start the tick rate calibration for the hook statistics
+        HookProbe::get_instance().install();
+
+        // Dump the last hook calls to a file if the process crashes
+        FlightRecorder::get_instance().install();
+
         // Install WinAPI hooks if borderless fullscreen mode is enabled
         WindowHooks::get_instance().install();
 
@@ -44,10 +62,27 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD fdwReason, LPVOID)
         // Register debug overlay
         OverlayManager::get_instance().install();
 
+        // Watch ReShade.ini for live config changes
+        ConfigWatcher::get_instance().install();
+
+        // Publish live statistics for external monitoring
+        StatsExporter::get_instance().install();
+
         reshade::log::message(reshade::log::level::info, "Swapchain Override addon loaded");
         break;
 
     case DLL_PROCESS_DETACH:
+    {
+        // lpReserved is set when the process exits instead of a FreeLibrary. The other threads, thread pool
+        // included, are terminated by then, so the components skip waiting for their callbacks and only flush.
+        const bool process_terminating = lpReserved != nullptr;
+
+        // Stop publishing statistics, the timer reads swapchain data
+        StatsExporter::get_instance().uninstall(process_terminating);
+
+        // Stop watching ReShade.ini
+        ConfigWatcher::get_instance().uninstall(process_terminating);
+
         // Unregister debug overlay
         OverlayManager::get_instance().uninstall();
 
@@ -60,10 +95,20 @@ BOOL APIENTRY DllMain(HMODULE hModule, DWORD fdwReason, LPVOID)
         // Unregister event callbacks
         SwapchainManager::get_instance().uninstall();
 
+        // Complete the event trace, no hooks or callbacks can produce new records now
+        TraceRecorder::get_instance().uninstall(process_terminating);
+
+        // Flush queued log records, no hooks or callbacks can produce new ones now
+        AsyncLog::get_instance().uninstall(process_terminating);
+
+        // Restore the crash handlers, they must not outlive this module
+        FlightRecorder::get_instance().uninstall();
+
         // Unregister the addon
         reshade::unregister_addon(hModule);
         break;
     }
+    }
 
     return TRUE;
 }
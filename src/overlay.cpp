@@ -12,6 +12,8 @@
 // Now safe to include headers that pull in ReShade/ImGui
 #include "overlay.h"
 #include "config.h"
+#include "config_watcher.h"
+#include "hook_probe.h"
 #include "swapchain_manager.h"
 
 using namespace reshade::api;
@@ -41,67 +43,37 @@ void OverlayManager::on_overlay(effect_runtime* runtime)
     get_instance().render_overlay(runtime);
 }
 
-// Helper function to convert filter mode to string
-static const char* filter_mode_to_string(filter_mode mode)
-{
-    switch (mode)
-    {
-    case filter_mode::min_mag_mip_point:
-        return "Point";
-    case filter_mode::min_mag_mip_linear:
-        return "Linear";
-    case filter_mode::min_mag_linear_mip_point:
-        return "Anisotropic";
-    default:
-        return "Unknown";
-    }
-}
-
-// Helper function to convert fullscreen mode to string
-static const char* fullscreen_mode_to_string(FullscreenMode mode)
-{
-    switch (mode)
-    {
-    case FullscreenMode::Unchanged:
-        return "Unchanged";
-    case FullscreenMode::Borderless:
-        return "Borderless";
-    case FullscreenMode::Exclusive:
-        return "Exclusive";
-    default:
-        return "Unknown";
-    }
-}
-
 // Render overlay implementation
 void OverlayManager::render_overlay(effect_runtime* runtime)
 {
     // Get configuration
-    const Config& config = Config::get_instance();
+    const ConfigSnapshot& config = Config::get_instance().snapshot();
 
-    // Copy swapchain data FIRST to avoid holding mutex during ImGui calls
-    struct SwapchainSnapshot
+    // Copy swapchain data FIRST to avoid holding mutex during ImGui calls.
+    // The copy is only refreshed when a swapchain changed, so an open overlay does not
+    // compete with the render thread's hooks for the lock every frame.
+    SwapchainManager& swapchain_manager = SwapchainManager::get_instance();
+    const uint64_t swapchain_generation = swapchain_manager.get_swapchain_generation();
+    if (swapchain_generation != swapchain_generation_)
     {
-        SwapchainNativeHandle handle;
-        uint32_t original_width;
-        uint32_t original_height;
-        uint32_t actual_width;
-        uint32_t actual_height;
-        bool override_active;
-    };
-
-    std::vector<SwapchainSnapshot> swapchains;
-    SwapchainManager::get_instance().for_each_swapchain(
-        [&swapchains](SwapchainNativeHandle handle, const SwapchainData& data) {
-            swapchains.push_back({
-                handle,
-                data.original_width,
-                data.original_height,
-                data.actual_width,
-                data.actual_height,
-                data.override_active
+        swapchains_.clear();
+        swapchain_manager.for_each_swapchain(
+            [this](SwapchainNativeHandle handle, const SwapchainData& data) {
+                swapchains_.push_back({
+                    handle,
+                    data.original_width,
+                    data.original_height,
+                    data.actual_width,
+                    data.actual_height,
+                    data.state,
+                    data.generation,
+                    data.resize_debounce.is_pending(),
+                    data.resized_width,
+                    data.resized_height
+                });
             });
-        });
+        swapchain_generation_ = swapchain_generation;
+    }
 
     // NOW we can safely call ImGui functions without holding any locks
 
@@ -118,44 +90,26 @@ void OverlayManager::render_overlay(effect_runtime* runtime)
         ImGui::Separator();
     }
 
-    // Resolution override
-    if (config.is_resolution_override_enabled())
+    // Config values, driven by the same key schema that loads them
+    for (const ConfigKey& key : Config::get_schema())
     {
-        char res_buffer[64];
-        snprintf(res_buffer, sizeof(res_buffer), "  Resolution Override: %ux%u",
-                 config.get_force_width(), config.get_force_height());
-        ImGui::TextUnformatted(res_buffer, nullptr);
+        if (key.label == nullptr)
+            continue;
+
+        char value_buffer[64];
+        key.format(config, value_buffer, sizeof(value_buffer));
+
+        char line_buffer[128];
+        snprintf(line_buffer, sizeof(line_buffer), "  %s: %s", key.label, value_buffer);
+        ImGui::TextUnformatted(line_buffer, nullptr);
     }
-    else
+
+    // Reload ReShade.ini without restarting the application
+    if (ImGui::Button("Reload Configuration"))
     {
-        ImGui::TextUnformatted("  Resolution Override: Disabled", nullptr);
+        ConfigWatcher::get_instance().reload();
     }
 
-    // Scaling filter
-    char filter_buffer[64];
-    snprintf(filter_buffer, sizeof(filter_buffer), "  Scaling Filter: %s",
-             filter_mode_to_string(config.get_scaling_filter()));
-    ImGui::TextUnformatted(filter_buffer, nullptr);
-
-    // Fullscreen mode
-    char fs_mode_buffer[64];
-    snprintf(fs_mode_buffer, sizeof(fs_mode_buffer), "  Fullscreen Mode: %s",
-             fullscreen_mode_to_string(config.get_fullscreen_mode()));
-    ImGui::TextUnformatted(fs_mode_buffer, nullptr);
-
-    // Block fullscreen changes
-    char block_fs_buffer[64];
-    snprintf(block_fs_buffer, sizeof(block_fs_buffer), "  Block Fullscreen Changes: %s",
-             config.get_block_fullscreen_changes() ? "Yes" : "No");
-    ImGui::TextUnformatted(block_fs_buffer, nullptr);
-
-    // Target monitor
-    char monitor_buffer[64];
-    snprintf(monitor_buffer, sizeof(monitor_buffer), "  Target Monitor: %d %s",
-             config.get_target_monitor(),
-             config.get_target_monitor() == 0 ? "(Primary)" : "");
-    ImGui::TextUnformatted(monitor_buffer, nullptr);
-
     // Add spacing
     ImGui::NewLine();
 
@@ -163,14 +117,14 @@ void OverlayManager::render_overlay(effect_runtime* runtime)
     ImGui::TextUnformatted("Active Swapchains:", nullptr);
     ImGui::Separator();
 
-    if (swapchains.empty())
+    if (swapchains_.empty())
     {
         ImGui::TextUnformatted("  No active swapchains", nullptr);
     }
     else
     {
         int index = 1;
-        for (const auto& sc : swapchains)
+        for (const auto& sc : swapchains_)
         {
             char header_buffer[128];
             snprintf(header_buffer, sizeof(header_buffer),
@@ -190,13 +144,191 @@ void OverlayManager::render_overlay(effect_runtime* runtime)
                      sc.actual_width, sc.actual_height);
             ImGui::TextUnformatted(actual_buffer, nullptr);
 
-            char override_buffer[64];
-            snprintf(override_buffer, sizeof(override_buffer),
-                     "    Override Active: %s",
-                     sc.override_active ? "Yes" : "No");
-            ImGui::TextUnformatted(override_buffer, nullptr);
+            char state_buffer[64];
+            snprintf(state_buffer, sizeof(state_buffer),
+                     "    State: %s (generation %llu)",
+                     swapchain_state_name(sc.state), static_cast<unsigned long long>(sc.generation));
+            ImGui::TextUnformatted(state_buffer, nullptr);
+
+            if (sc.resize_pending)
+            {
+                char resize_buffer[64];
+                snprintf(resize_buffer, sizeof(resize_buffer),
+                         "    Resize pending: %ux%u",
+                         sc.resized_width, sc.resized_height);
+                ImGui::TextUnformatted(resize_buffer, nullptr);
+            }
 
             index++;
         }
     }
+
+    // Proxy fallbacks taken since load, only shown once proxy creation failed
+    uint64_t fallback_total = 0;
+    for (size_t step = 0; step < PROXY_FALLBACK_STEP_COUNT; ++step)
+        fallback_total += swapchain_manager.get_proxy_fallback_count(static_cast<ProxyFallbackStep>(step));
+    if (fallback_total != 0)
+    {
+        ImGui::TextUnformatted("  Proxy fallbacks:", nullptr);
+        for (size_t step = 0; step < PROXY_FALLBACK_STEP_COUNT; ++step)
+        {
+            char fallback_buffer[64];
+            snprintf(fallback_buffer, sizeof(fallback_buffer), "    %s: %llu",
+                     proxy_fallback_step_name(static_cast<ProxyFallbackStep>(step)),
+                     static_cast<unsigned long long>(swapchain_manager.get_proxy_fallback_count(static_cast<ProxyFallbackStep>(step))));
+            ImGui::TextUnformatted(fallback_buffer, nullptr);
+        }
+    }
+
+    // Resizes absorbed by ResizeDebounce, only shown once it kept proxies through a resize
+    const uint64_t debounced_resizes = swapchain_manager.get_debounced_resize_count();
+    if (debounced_resizes != 0)
+    {
+        char debounce_buffer[96];
+        snprintf(debounce_buffer, sizeof(debounce_buffer), "  Debounced resizes: %llu (%llu proxy rebuilds)",
+                 static_cast<unsigned long long>(debounced_resizes),
+                 static_cast<unsigned long long>(swapchain_manager.get_debounced_rebuild_count()));
+        ImGui::TextUnformatted(debounce_buffer, nullptr);
+    }
+
+    // Resizes that left size, format and back buffer count alone and kept the proxies
+    const uint64_t avoided_rebuilds = swapchain_manager.get_avoided_rebuild_count();
+    if (avoided_rebuilds != 0)
+    {
+        char avoided_buffer[64];
+        snprintf(avoided_buffer, sizeof(avoided_buffer), "  Unchanged resizes (proxies reused): %llu",
+                 static_cast<unsigned long long>(avoided_rebuilds));
+        ImGui::TextUnformatted(avoided_buffer, nullptr);
+    }
+    ImGui::NewLine();
+    render_frame_timing();
+    ImGui::NewLine();
+    render_hook_statistics();
+}
+
+namespace
+{
+    // Value below which the given fraction of values falls; reorders values
+    float percentile(std::span<float> values, double fraction)
+    {
+        const size_t index = std::min(values.size() - 1, static_cast<size_t>(fraction * static_cast<double>(values.size())));
+        std::nth_element(values.begin(), values.begin() + index, values.end());
+        return values[index];
+    }
+}
+
+void OverlayManager::render_frame_timing()
+{
+    const size_t count = FrameTimer::get_instance().copy_samples(frame_samples_);
+    const double ticks_per_microsecond = HookProbe::get_instance().ticks_per_microsecond();
+
+    ImGui::TextUnformatted("Frame Timing:", nullptr);
+    ImGui::Separator();
+
+    if (count == 0 || ticks_per_microsecond <= 0.0)
+    {
+        ImGui::TextUnformatted("No frames presented yet", nullptr);
+        return;
+    }
+
+    const double ticks_per_millisecond = ticks_per_microsecond * 1000.0;
+    double total_frame_ms = 0.0;
+    double total_addon_us = 0.0;
+    float max_frame_ms = 0.0f;
+    for (size_t i = 0; i < count; ++i)
+    {
+        frame_times_ms_[i] = static_cast<float>(frame_samples_[i].interval_ticks / ticks_per_millisecond);
+        total_frame_ms += frame_times_ms_[i];
+        total_addon_us += frame_samples_[i].addon_ticks / ticks_per_microsecond;
+        max_frame_ms = std::max(max_frame_ms, frame_times_ms_[i]);
+    }
+
+    char buffer[128];
+    snprintf(buffer, sizeof(buffer), "Last %zu frames, max %.2f ms", count, max_frame_ms);
+    ImGui::PlotLines("##frame_times", frame_times_ms_.data(), static_cast<int>(count), 0, buffer, 0.0f, max_frame_ms * 1.1f, ImVec2(0.0f, 80.0f));
+
+    const std::span<float> sorted(sorted_values_.data(), count);
+    std::copy_n(frame_times_ms_.begin(), count, sorted.begin());
+    snprintf(buffer, sizeof(buffer), "Frame time: avg %.2f ms, p50 %.2f ms, p99 %.2f ms, p99.9 %.2f ms",
+             total_frame_ms / static_cast<double>(count), percentile(sorted, 0.5), percentile(sorted, 0.99), percentile(sorted, 0.999));
+    ImGui::TextUnformatted(buffer, nullptr);
+
+    // Time spent inside the addon's own hooks between two presents
+    for (size_t i = 0; i < count; ++i)
+        sorted[i] = static_cast<float>(frame_samples_[i].addon_ticks / ticks_per_microsecond);
+    snprintf(buffer, sizeof(buffer), "Addon CPU: avg %.1f us, p99 %.1f us per frame (%.3f%% of frame time)",
+             total_addon_us / static_cast<double>(count), percentile(sorted, 0.99),
+             total_frame_ms > 0.0 ? total_addon_us / (total_frame_ms * 10.0) : 0.0);
+    ImGui::TextUnformatted(buffer, nullptr);
+
+    // Measured with timestamp queries a few frames behind, so it is missing while no override is active
+    if (const uint32_t scale_pass_ns = SwapchainManager::get_instance().get_scale_pass_gpu_ns(); scale_pass_ns != 0)
+    {
+        snprintf(buffer, sizeof(buffer), "Scale pass GPU: %.1f us per frame", static_cast<double>(scale_pass_ns) / 1000.0);
+        ImGui::TextUnformatted(buffer, nullptr);
+    }
+}
+
+void OverlayManager::render_hook_statistics()
+{
+    const HookProbe& probe = HookProbe::get_instance();
+
+    std::array<HookTotals, HOOK_COUNT> totals;
+    probe.collect(totals);
+    const double ticks_per_microsecond = probe.ticks_per_microsecond();
+
+    ImGui::TextUnformatted("Hook Statistics:", nullptr);
+    ImGui::Separator();
+
+    if (!ImGui::BeginTable("hook_statistics", 7, ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit))
+        return;
+
+    ImGui::TableSetupColumn("Hook");
+    ImGui::TableSetupColumn("Calls");
+    ImGui::TableSetupColumn("Redirected");
+    ImGui::TableSetupColumn("Rewritten");
+    ImGui::TableSetupColumn("Early-out");
+    ImGui::TableSetupColumn("p50 (us)");
+    ImGui::TableSetupColumn("p99 (us)");
+    ImGui::TableHeadersRow();
+
+    for (size_t hook = 0; hook < HOOK_COUNT; ++hook)
+    {
+        const HookTotals& hook_totals = totals[hook];
+        const uint64_t calls = hook_totals.calls();
+        if (calls == 0)
+            continue;
+
+        char buffer[32];
+        ImGui::TableNextRow();
+
+        ImGui::TableNextColumn();
+        ImGui::TextUnformatted(trace_format::event_name(HOOK_EVENTS[hook]), nullptr);
+
+        const uint64_t counts[] = {
+            calls,
+            hook_totals.count(HookOutcome::Redirected),
+            hook_totals.count(HookOutcome::Rewritten),
+            hook_totals.count(HookOutcome::EarlyOut)
+        };
+        for (uint64_t count : counts)
+        {
+            ImGui::TableNextColumn();
+            snprintf(buffer, sizeof(buffer), "%llu", static_cast<unsigned long long>(count));
+            ImGui::TextUnformatted(buffer, nullptr);
+        }
+
+        // Bucket upper bounds, so these are "below" values
+        for (double fraction : { 0.5, 0.99 })
+        {
+            ImGui::TableNextColumn();
+            if (ticks_per_microsecond > 0.0)
+                snprintf(buffer, sizeof(buffer), "< %.3f", static_cast<double>(hook_totals.latency_percentile(fraction)) / ticks_per_microsecond);
+            else
+                snprintf(buffer, sizeof(buffer), "-");
+            ImGui::TextUnformatted(buffer, nullptr);
+        }
+    }
+
+    ImGui::EndTable();
 }
@@ -7,6 +7,9 @@
 #pragma once
 
 #include "common.h"
+#include "core/swapchain_lifecycle.h"
+#include "frame_timer.h"
+#include <array>
 
 // Overlay manager class for displaying debug information
 class OverlayManager
@@ -34,4 +37,32 @@ private:
 
     // Actual overlay rendering implementation
     void render_overlay(reshade::api::effect_runtime* runtime);
+
+    // Frame time graph, percentiles and the addon's own CPU cost per frame from the FrameTimer
+    void render_frame_timing();
+
+    // Per-hook call counts and latency percentiles from the HookProbe
+    void render_hook_statistics();
+
+    // Swapchain fields shown by the overlay, copied so no lock is held during ImGui calls
+    struct SwapchainSnapshot
+    {
+        SwapchainNativeHandle handle;
+        uint32_t original_width;
+        uint32_t original_height;
+        uint32_t actual_width;
+        uint32_t actual_height;
+        SwapchainState state;
+        uint64_t generation;
+        bool resize_pending;  // Old proxies stretched until the ResizeDebounce quiet period passes
+        uint32_t resized_width;
+        uint32_t resized_height;
+    };
+
+    // Note: Only used from the overlay callback, kept here so drawing a frame does not allocate
+    std::vector<SwapchainSnapshot> swapchains_;
+    uint64_t swapchain_generation_ = UINT64_MAX;  // Generation swapchains_ was copied at, none yet
+    std::array<FrameSample, FrameTimer::CAPACITY> frame_samples_ = {};
+    std::array<float, FrameTimer::CAPACITY> frame_times_ms_ = {};
+    std::array<float, FrameTimer::CAPACITY> sorted_values_ = {};
 };
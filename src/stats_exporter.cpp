@@ -0,0 +1,203 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "stats_exporter.h"
+#include "config.h"
+#include "hook_probe.h"
+#include "swapchain_manager.h"
+#include <algorithm>
+
+namespace
+{
+    // Value below which the given fraction of values falls, like the overlay's frame timing; reorders values
+    uint32_t percentile(std::span<uint32_t> values, double fraction)
+    {
+        const size_t index = std::min(values.size() - 1, static_cast<size_t>(fraction * static_cast<double>(values.size())));
+        std::nth_element(values.begin(), values.begin() + index, values.end());
+        return values[index];
+    }
+
+    uint32_t ticks_to_units(double ticks, double ticks_per_unit)
+    {
+        return static_cast<uint32_t>(std::min(static_cast<double>(UINT32_MAX), ticks / ticks_per_unit));
+    }
+}
+
+StatsExporter& StatsExporter::get_instance()
+{
+    static StatsExporter instance;
+    return instance;
+}
+
+void StatsExporter::install()
+{
+    if (!Config::get_instance().snapshot().is_stats_export_enabled())
+        return;
+
+    const std::string name = std::string("Local\\") + stats_block::NAME_PREFIX + std::to_string(GetCurrentProcessId());
+
+    mapping_ = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, sizeof(stats_block::Block), name.c_str());
+    if (mapping_ == nullptr)
+    {
+        reshade::log::message(reshade::log::level::warning, ("Failed to create stats mapping " + name).c_str());
+        return;
+    }
+
+    block_ = static_cast<stats_block::Block*>(MapViewOfFile(mapping_, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(stats_block::Block)));
+    if (block_ == nullptr)
+    {
+        CloseHandle(mapping_);
+        mapping_ = nullptr;
+        reshade::log::message(reshade::log::level::warning, ("Failed to map stats mapping " + name).c_str());
+        return;
+    }
+
+    // New mappings are zero-filled
+    stats_block::initialize(*block_, GetCurrentProcessId());
+
+    stats_ = {};
+    install_tick_ = GetTickCount64();
+    last_publish_tick_ = install_tick_;
+
+    // Timer thread callbacks never overlap, and a thread pool timer needs no thread of our own under the loader lock
+    if (!CreateTimerQueueTimer(&timer_, nullptr, on_publish_timer, this, PUBLISH_INTERVAL_MS, PUBLISH_INTERVAL_MS, WT_EXECUTEINTIMERTHREAD))
+    {
+        timer_ = nullptr;
+        uninstall();
+        reshade::log::message(reshade::log::level::warning, "Failed to start the stats publish timer");
+        return;
+    }
+
+    reshade::log::message(reshade::log::level::info, ("Publishing stats in shared memory " + name).c_str());
+}
+
+void StatsExporter::uninstall(bool process_terminating)
+{
+    // DeleteTimerQueueTimer would wait under the loader lock for a callback that will never finish
+    if (process_terminating)
+        return;
+
+    if (timer_ != nullptr)
+    {
+        // Blocks until a running callback has finished
+        DeleteTimerQueueTimer(nullptr, timer_, INVALID_HANDLE_VALUE);
+        timer_ = nullptr;
+    }
+
+    if (block_ != nullptr)
+    {
+        UnmapViewOfFile(block_);
+        block_ = nullptr;
+    }
+
+    if (mapping_ != nullptr)
+    {
+        CloseHandle(mapping_);
+        mapping_ = nullptr;
+    }
+}
+
+void CALLBACK StatsExporter::on_publish_timer(PVOID context, BOOLEAN)
+{
+    static_cast<StatsExporter*>(context)->publish();
+}
+
+void StatsExporter::publish()
+{
+    const ULONGLONG now = GetTickCount64();
+
+    // Swapchains, copied under the SwapchainManager lock
+    stats_.swapchain_count = 0;
+    SwapchainManager::get_instance().for_each_swapchain(
+        [this](SwapchainNativeHandle handle, const SwapchainData& data) {
+            if (stats_.swapchain_count == stats_block::MAX_SWAPCHAINS)
+                return;
+
+            stats_block::SwapchainStats& swapchain = stats_.swapchains[stats_.swapchain_count++];
+            swapchain.handle = handle;
+            swapchain.requested_width = data.original_width;
+            swapchain.requested_height = data.original_height;
+            swapchain.actual_width = data.actual_width;
+            swapchain.actual_height = data.actual_height;
+            swapchain.override_active = data.is_override_active();
+            swapchain.scale_pass_gpu_ns = data.scale_pass_gpu_ns;
+            swapchain.proxy_memory = data.proxy_memory;
+        });
+    for (size_t i = stats_.swapchain_count; i < stats_block::MAX_SWAPCHAINS; ++i)
+        stats_.swapchains[i] = {};
+
+    // Hook counters and latency percentiles
+    std::array<HookTotals, HOOK_COUNT> totals;
+    HookProbe::get_instance().collect(totals);
+    const double ticks_per_microsecond = HookProbe::get_instance().ticks_per_microsecond();
+
+    for (size_t hook = 0; hook < HOOK_COUNT; ++hook)
+    {
+        stats_block::HookStats& hook_stats = stats_.hooks[hook];
+        for (size_t i = 0; i < HOOK_OUTCOME_COUNT; ++i)
+            hook_stats.outcomes[i] = totals[hook].outcomes[i];
+
+        hook_stats.latency_p50_ns = 0;
+        hook_stats.latency_p99_ns = 0;
+        if (ticks_per_microsecond > 0.0)
+        {
+            const double ticks_per_nanosecond = ticks_per_microsecond / 1000.0;
+            hook_stats.latency_p50_ns = ticks_to_units(static_cast<double>(totals[hook].latency_percentile(0.5)), ticks_per_nanosecond);
+            hook_stats.latency_p99_ns = ticks_to_units(static_cast<double>(totals[hook].latency_percentile(0.99)), ticks_per_nanosecond);
+        }
+    }
+
+    collect_frame_stats(ticks_per_microsecond);
+
+    // Present rate over the last interval. FrameTimer counts in finish_present, which is registered
+    // in every mode, while the present hook is only registered when an override needs it.
+    const uint64_t present_count = FrameTimer::get_instance().get_present_count();
+    const ULONGLONG elapsed_ms = now - last_publish_tick_;
+    stats_.present_rate_mhz = elapsed_ms != 0
+        ? static_cast<uint32_t>((present_count - stats_.present_count) * 1000000 / elapsed_ms)
+        : 0;
+    stats_.present_count = present_count;
+
+    stats_.uptime_ms = now - install_tick_;
+    stats_.publish_count++;
+    last_publish_tick_ = now;
+
+    stats_block::publish(*block_, stats_);
+}
+
+void StatsExporter::collect_frame_stats(double ticks_per_microsecond)
+{
+    stats_.frames = {};
+
+    const size_t count = FrameTimer::get_instance().copy_samples(frame_samples_);
+    if (count == 0 || ticks_per_microsecond <= 0.0)
+        return;
+
+    const double ticks_per_nanosecond = ticks_per_microsecond / 1000.0;
+    const std::span<uint32_t> sorted(sorted_ticks_.data(), count);
+    stats_block::FrameStats& frames = stats_.frames;
+    frames.sample_count = static_cast<uint32_t>(count);
+
+    double total_interval_ticks = 0.0;
+    double total_addon_ticks = 0.0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        sorted[i] = frame_samples_[i].interval_ticks;
+        total_interval_ticks += frame_samples_[i].interval_ticks;
+        total_addon_ticks += frame_samples_[i].addon_ticks;
+    }
+
+    frames.frame_time_avg_us = ticks_to_units(total_interval_ticks / static_cast<double>(count), ticks_per_microsecond);
+    frames.frame_time_p50_us = ticks_to_units(percentile(sorted, 0.5), ticks_per_microsecond);
+    frames.frame_time_p99_us = ticks_to_units(percentile(sorted, 0.99), ticks_per_microsecond);
+    frames.frame_time_p999_us = ticks_to_units(percentile(sorted, 0.999), ticks_per_microsecond);
+    frames.frame_time_max_us = ticks_to_units(*std::max_element(sorted.begin(), sorted.end()), ticks_per_microsecond);
+
+    for (size_t i = 0; i < count; ++i)
+        sorted[i] = frame_samples_[i].addon_ticks;
+    frames.addon_time_avg_ns = ticks_to_units(total_addon_ticks / static_cast<double>(count), ticks_per_nanosecond);
+    frames.addon_time_p99_ns = ticks_to_units(percentile(sorted, 0.99), ticks_per_nanosecond);
+}
@@ -0,0 +1,59 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include "common.h"
+#include "core/stats_block.h"
+#include "frame_timer.h"
+
+// Publishes live statistics in the named mapping "Local\SwapchainOverrideStats.<pid>"
+// (see core/stats_block.h) for external monitoring, when ExportStats is enabled
+class StatsExporter
+{
+public:
+    // Singleton access
+    static StatsExporter& get_instance();
+
+    // Create the mapping and start publishing
+    void install();
+
+    // Stop publishing and close the mapping. Does nothing at process exit (process_terminating),
+    // the timer thread is gone and the system releases the mapping.
+    void uninstall(bool process_terminating = false);
+
+    static constexpr DWORD PUBLISH_INTERVAL_MS = 500;
+
+private:
+    StatsExporter() = default;
+    ~StatsExporter() = default;
+
+    // Delete copy/move constructors
+    StatsExporter(const StatsExporter&) = delete;
+    StatsExporter& operator=(const StatsExporter&) = delete;
+    StatsExporter(StatsExporter&&) = delete;
+    StatsExporter& operator=(StatsExporter&&) = delete;
+
+    // Thread pool timer callback
+    static void CALLBACK on_publish_timer(PVOID context, BOOLEAN timer_fired);
+
+    // Gather the current values and write them to the mapping
+    void publish();
+
+    // Frame time and addon time percentiles from FrameTimer
+    void collect_frame_stats(double ticks_per_microsecond);
+
+    HANDLE mapping_ = nullptr;
+    stats_block::Block* block_ = nullptr;
+    HANDLE timer_ = nullptr;
+
+    // Note: Only touched by the timer callback, which never overlaps itself (WT_EXECUTEINTIMERTHREAD)
+    stats_block::Stats stats_ = {};
+    std::array<FrameSample, FrameTimer::CAPACITY> frame_samples_ = {};
+    std::array<uint32_t, FrameTimer::CAPACITY> sorted_ticks_ = {};
+    ULONGLONG install_tick_ = 0;
+    ULONGLONG last_publish_tick_ = 0;
+};
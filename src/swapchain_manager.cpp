@@ -6,8 +6,13 @@
 
 #include "swapchain_manager.h"
 #include "config.h"
+#include "core/surface_scaling.h"
 #include "debug_logger.h"
+#include "frame_timer.h"
+#include "hook_policy.h"
 #include "shader_bytecode.h"
+#include "trace_recorder.h"
+#include "window_hooks.h"
 
 using namespace reshade::api;
 
@@ -17,7 +22,7 @@ int SwapchainData::find_proxy_index(resource actual_resource) const
     for (size_t i = 0; i < actual_back_buffers.size(); ++i)
     {
         if (actual_back_buffers[i].handle == actual_resource.handle)
-            return static_cast<int>(i);
+            return proxy_textures.empty() ? -1 : static_cast<int>(i % proxy_textures.size());
     }
     return -1;
 }
@@ -38,6 +43,8 @@ void SwapchainData::cleanup()
             device_ptr->destroy_pipeline_layout(copy_pipeline_layout);
         if (copy_sampler.handle != 0)
             device_ptr->destroy_sampler(copy_sampler);
+        if (timestamp_heap.handle != 0)
+            device_ptr->destroy_query_heap(timestamp_heap);
 
         // Destroy proxy resource views
         for (auto rtv : proxy_rtvs)
@@ -64,6 +71,10 @@ void SwapchainData::cleanup()
     copy_pipeline = {};
     copy_pipeline_layout = {};
     copy_sampler = {};
+    timestamp_heap = {};
+    scale_pass_timer.reset();
+    scale_pass_gpu_ns = 0;
+    proxy_memory = 0;
 
     proxy_rtvs.clear();
     proxy_srvs.clear();
@@ -80,27 +91,71 @@ SwapchainManager& SwapchainManager::get_instance()
 
 void SwapchainManager::store_pending_info(WindowHandle hwnd, uint32_t width, uint32_t height)
 {
-    std::lock_guard<std::mutex> lock(pending_mutex_);
-    PendingSwapchainInfo info;
-    info.original_width = width;
-    info.original_height = height;
-    pending_swapchains_[hwnd] = info;
+    // Note: Caller must hold swapchain_mutex_
+    // A window creating a swapchain again before the last one was initialized replaces its entry,
+    // otherwise a free slot is taken or the oldest entry evicted
+    PendingSwapchainInfo* slot = &pending_swapchains_[0];
+    for (PendingSwapchainInfo& entry : pending_swapchains_)
+    {
+        if (entry.generation != 0 && entry.hwnd == hwnd)
+        {
+            slot = &entry;
+            break;
+        }
+        if (entry.generation < slot->generation)
+            slot = &entry;
+    }
+
+    if (slot->generation != 0 && slot->hwnd != hwnd)
+    {
+        reshade::log::message(reshade::log::level::warning,
+            ("Dropped pending swapchain " + std::to_string(slot->original_width) + "x" + std::to_string(slot->original_height) +
+            " (generation " + std::to_string(slot->generation) + "), it was never initialized").c_str());
+    }
+
+    slot->hwnd = hwnd;
+    slot->original_width = width;
+    slot->original_height = height;
+    slot->generation = ++next_generation_;
 }
 
-bool SwapchainManager::retrieve_pending_info(WindowHandle hwnd, uint32_t& out_width, uint32_t& out_height)
+bool SwapchainManager::retrieve_pending_info(WindowHandle hwnd, PendingSwapchainInfo& out_info)
 {
-    std::lock_guard<std::mutex> lock(pending_mutex_);
-    auto it = pending_swapchains_.find(hwnd);
-    if (it != pending_swapchains_.end())
+    // Note: Caller must hold swapchain_mutex_
+    for (PendingSwapchainInfo& entry : pending_swapchains_)
     {
-        out_width = it->second.original_width;
-        out_height = it->second.original_height;
-        pending_swapchains_.erase(it);
-        return true;
+        if (entry.generation != 0 && entry.hwnd == hwnd)
+        {
+            out_info = entry;
+            entry = {};
+            return true;
+        }
     }
     return false;
 }
 
+bool SwapchainManager::transition(SwapchainData* data, SwapchainEvent event)
+{
+    // Note: Caller must hold swapchain_mutex_
+    SwapchainState next = data->state;
+    if (!next_swapchain_state(data->state, event, next))
+    {
+        reshade::log::message(reshade::log::level::warning,
+            ("Ignored swapchain event " + std::string(swapchain_event_name(event)) + " in state " +
+            swapchain_state_name(data->state) + " (generation " + std::to_string(data->generation) + ")").c_str());
+        return false;
+    }
+
+    if (data->is_override_active())
+        active_overrides_.fetch_sub(1, std::memory_order_relaxed);
+    data->state = next;
+    if (data->is_override_active())
+        active_overrides_.fetch_add(1, std::memory_order_relaxed);
+
+    swapchain_generation_.fetch_add(1, std::memory_order_release);
+    return true;
+}
+
 bool SwapchainManager::initialize_swapchain(swapchain* swapchain_ptr)
 {
     if (swapchain_ptr == nullptr)
@@ -128,9 +183,7 @@ bool SwapchainManager::initialize_swapchain(swapchain* swapchain_ptr)
     auto it = swapchain_data_.find(swapchain_handle);
     if (it != swapchain_data_.end())
     {
-        // Clean up existing resources on resize
         data = it->second.get();
-        data->cleanup();
     }
     else
     {
@@ -140,27 +193,78 @@ bool SwapchainManager::initialize_swapchain(swapchain* swapchain_ptr)
         swapchain_data_[swapchain_handle] = std::move(unique_data);
     }
 
+    const bool is_resize = data->state == SwapchainState::Resizing;
+    if (!transition(data, SwapchainEvent::Init))
+        return false;
+
     data->device_ptr = device_ptr;
     data->actual_width = actual_desc.texture.width;
     data->actual_height = actual_desc.texture.height;
-    data->override_active = true;
 
-    // Retrieve the original requested size from pending map
+    // Retrieve the original requested size from the pending entry of this window's latest create_swapchain
+    uint32_t requested_width = actual_desc.texture.width;
+    uint32_t requested_height = actual_desc.texture.height;
     WindowHandle hwnd = swapchain_ptr->get_hwnd();
-    if (!retrieve_pending_info(hwnd, data->original_width, data->original_height))
+    PendingSwapchainInfo pending = {};
+    if (retrieve_pending_info(hwnd, pending) && pending.generation > data->generation)
+    {
+        requested_width = pending.original_width;
+        requested_height = pending.original_height;
+        data->generation = pending.generation;
+    }
+    else
     {
         // Fallback: use actual swapchain dimensions (shouldn't happen in normal flow)
-        data->original_width = actual_desc.texture.width;
-        data->original_height = actual_desc.texture.height;
+        data->generation = ++next_generation_;
         reshade::log::message(reshade::log::level::warning,
             ("Could not retrieve original swapchain dimensions, using actual dimensions as fallback: " +
-            std::to_string(data->original_width) + "x" + std::to_string(data->original_height)).c_str());
+            std::to_string(requested_width) + "x" + std::to_string(requested_height)).c_str());
     }
 
+    data->resized_width = requested_width;
+    data->resized_height = requested_height;
+
+    // Games call ResizeBuffers with unchanged sizes on focus changes or vsync toggles, the proxies still fit then.
+    // Compared with the size the live proxies have, so a debounced drag back to it keeps them too. The scale
+    // pass stretches them onto back buffers of any size, as long as those still differ from the proxies.
+    if (is_resize && !data->proxy_textures.empty() && data->copy_pipeline.handle != 0 &&
+        data->original_width == requested_width && data->original_height == requested_height &&
+        (data->actual_width != requested_width || data->actual_height != requested_height) &&
+        data->back_buffer_format == actual_desc.texture.format && data->actual_back_buffers.size() == back_buffer_count)
+    {
+        refresh_back_buffers(data, swapchain_ptr);
+        data->resize_debounce.reset();
+        avoided_rebuilds_.fetch_add(1, std::memory_order_relaxed);
+        reshade::log::message(reshade::log::level::debug,
+            ("Resize kept " + std::to_string(requested_width) + "x" + std::to_string(requested_height) +
+            ", reusing proxy textures").c_str());
+
+        transition(data, SwapchainEvent::EnableProxies);
+        return true;
+    }
+
+    // While a window is dragged, keep presenting from the current proxies instead of rebuilding them for every size
+    if (is_resize && Config::get_instance().snapshot().get_resize_debounce().unit != ResizeDebounceUnit::Disabled &&
+        defer_resize_rebuild(data, swapchain_ptr, actual_desc))
+        return true;
+
+    // Clean up existing resources on resize
+    data->cleanup();
+    data->original_width = requested_width;
+    data->original_height = requested_height;
+    data->back_buffer_format = actual_desc.texture.format;
+    return build_proxies(data, swapchain_ptr);
+}
+
+bool SwapchainManager::build_proxies(SwapchainData* data, swapchain* swapchain_ptr)
+{
+    // Note: Caller must hold swapchain_mutex_, data is Initialized and has no proxies
+    data->resize_debounce.reset();
+
     // Skip proxy system if no scaling is needed
     if (data->original_width == data->actual_width && data->original_height == data->actual_height)
     {
-        data->override_active = false;
+        transition(data, SwapchainEvent::Bypass);
         reshade::log::message(reshade::log::level::info,
             ("Swapchain dimensions match (no scaling needed): " +
             std::to_string(data->original_width) + "x" + std::to_string(data->original_height) +
@@ -168,30 +272,119 @@ bool SwapchainManager::initialize_swapchain(swapchain* swapchain_ptr)
         return true;
     }
 
-    // Create proxy resources
-    if (!create_proxy_resources(data, swapchain_ptr))
-    {
-        reshade::log::message(reshade::log::level::error, "Failed to create proxy resources");
-        data->cleanup();
+    // Create proxy resources, stepping down the ProxyFallback ladder if that fails
+    if (!create_proxy_resources_with_fallback(data, swapchain_ptr))
         return false;
-    }
 
     // Create copy pipeline
-    if (!create_copy_pipeline(data, actual_desc.texture.format))
+    if (!create_copy_pipeline(data, data->back_buffer_format))
     {
         reshade::log::message(reshade::log::level::error, "Failed to create copy pipeline");
         data->cleanup();
+        transition(data, SwapchainEvent::Bypass);
+        take_proxy_fallback(ProxyFallbackStep::DisableOverride, "the application renders at the forced size");
         return false;
     }
 
+    // Timing the scale pass is optional, presenting works without it
+    if (!data->device_ptr->create_query_heap(query_type::timestamp, GpuTimerRing::QUERY_COUNT, &data->timestamp_heap))
+    {
+        data->timestamp_heap = {};
+        reshade::log::message(reshade::log::level::warning, "Failed to create timestamp query heap, scale pass GPU time unavailable");
+    }
+
     reshade::log::message(reshade::log::level::info,
-        ("Created " + std::to_string(back_buffer_count) + " proxy textures at " +
+        ("Created " + std::to_string(data->proxy_textures.size()) + " proxy textures at " +
         std::to_string(data->original_width) + "x" + std::to_string(data->original_height)).c_str());
 
+    transition(data, SwapchainEvent::EnableProxies);
     return true;
 }
 
-bool SwapchainManager::create_proxy_resources(SwapchainData* data, swapchain* swapchain_ptr)
+bool SwapchainManager::defer_resize_rebuild(SwapchainData* data, swapchain* swapchain_ptr, const resource_desc& back_buffer_desc)
+{
+    // Note: Caller must hold swapchain_mutex_
+    // Only proxies that can still be drawn to the new back buffers are kept, the copy pipeline
+    // is built for one render target format
+    if (data->proxy_textures.empty() || data->copy_pipeline.handle == 0 || data->back_buffer_format != back_buffer_desc.texture.format)
+        return false;
+
+    // The old back buffers are gone, binds of the new ones go to the old proxies. Viewports covering
+    // the back buffer or the resized size are scaled onto the proxies in the bind handlers, so the
+    // present pass stretching a proxy over the whole back buffer keeps the aspect ratio.
+    refresh_back_buffers(data, swapchain_ptr);
+
+    data->resize_debounce.note_resize(GetTickCount64());
+    resize_rebuild_pending_.store(true, std::memory_order_relaxed);
+    debounced_resizes_.fetch_add(1, std::memory_order_relaxed);
+    reshade::log::message(reshade::log::level::debug,
+        ("Deferred proxy rebuild for resize to " + std::to_string(data->resized_width) + "x" + std::to_string(data->resized_height) +
+        ", presenting from " + std::to_string(data->original_width) + "x" + std::to_string(data->original_height) + " proxies").c_str());
+
+    transition(data, SwapchainEvent::EnableProxies);
+    return true;
+}
+
+void SwapchainManager::refresh_back_buffers(SwapchainData* data, swapchain* swapchain_ptr)
+{
+    // Note: Caller must hold swapchain_mutex_
+    // Resizing replaces the back buffer resources even when their size stays the same
+    const uint32_t back_buffer_count = swapchain_ptr->get_back_buffer_count();
+    data->actual_back_buffers.resize(back_buffer_count);
+    for (uint32_t i = 0; i < back_buffer_count; ++i)
+        data->actual_back_buffers[i] = swapchain_ptr->get_back_buffer(i);
+}
+
+void SwapchainManager::finish_debounced_resize(command_queue* queue, swapchain* swapchain_ptr)
+{
+    // Called from finish_present, takes swapchain_mutex_ but not while waiting for the GPU
+    std::unique_lock<std::mutex> lock(swapchain_mutex_);
+
+    const SwapchainNativeHandle swapchain_handle = swapchain_ptr->get_native();
+    SwapchainData* data = get_data(swapchain_handle);
+    const bool stable = data != nullptr && data->is_override_active() &&
+        data->resize_debounce.note_present(Config::get_instance().snapshot().get_resize_debounce(), GetTickCount64());
+
+    if (stable)
+    {
+        const SwapchainData* const waited_for = data;
+        const uint64_t generation = data->generation;
+        const uint32_t resized_width = data->resized_width;
+        const uint32_t resized_height = data->resized_height;
+
+        // The frame just presented still reads from the old proxies. Binds on other threads take the
+        // same lock, so it is released for the wait.
+        lock.unlock();
+        queue->wait_idle();
+        lock.lock();
+
+        // A resize or destroy in the meantime replaced what was waited for, the next stable present rebuilds
+        data = get_data(swapchain_handle);
+        if (data != nullptr && data == waited_for && data->generation == generation &&
+            data->is_override_active() && !data->resize_debounce.is_pending() && data->resized_width == resized_width && data->resized_height == resized_height)
+        {
+            reshade::log::message(reshade::log::level::info,
+                ("Size stable at " + std::to_string(resized_width) + "x" + std::to_string(resized_height) +
+                ", rebuilding proxies").c_str());
+
+            transition(data, SwapchainEvent::Init);
+            data->cleanup();
+            data->original_width = resized_width;
+            data->original_height = resized_height;
+            debounced_rebuilds_.fetch_add(1, std::memory_order_relaxed);
+            build_proxies(data, swapchain_ptr);
+        }
+    }
+
+    // Presents only take the lock again while some swapchain still waits for its quiet period
+    bool any_pending = false;
+    for (const auto& [handle, entry] : swapchain_data_)
+        any_pending = any_pending || (entry != nullptr && entry->resize_debounce.is_pending());
+    resize_rebuild_pending_.store(any_pending, std::memory_order_relaxed);
+}
+
+bool SwapchainManager::create_proxy_resources(SwapchainData* data, swapchain* swapchain_ptr,
+                                              uint32_t proxy_count, format proxy_format)
 {
     device* device_ptr = data->device_ptr;
     const uint32_t back_buffer_count = swapchain_ptr->get_back_buffer_count();
@@ -201,14 +394,15 @@ bool SwapchainManager::create_proxy_resources(SwapchainData* data, swapchain* sw
     resource_desc actual_desc = device_ptr->get_resource_desc(actual_back_buffer);
 
     // Create proxy textures at original resolution
-    data->proxy_textures.resize(back_buffer_count);
-    data->proxy_rtvs.resize(back_buffer_count);
+    data->proxy_textures.resize(proxy_count);
+    data->proxy_rtvs.resize(proxy_count);
     data->actual_back_buffers.resize(back_buffer_count);
 
-    for (uint32_t i = 0; i < back_buffer_count; ++i)
+    for (uint32_t i = 0; i < proxy_count; ++i)
     {
-        // Create proxy texture descriptor (same format as actual back buffer)
+        // Create proxy texture descriptor (same format as actual back buffer, unless a fallback picked another one)
         resource_desc proxy_desc = actual_desc;
+        proxy_desc.texture.format = proxy_format;
         proxy_desc.texture.width = data->original_width;
         proxy_desc.texture.height = data->original_height;
         proxy_desc.usage = resource_usage::render_target | resource_usage::copy_source | resource_usage::shader_resource;
@@ -224,7 +418,7 @@ bool SwapchainManager::create_proxy_resources(SwapchainData* data, swapchain* sw
         // Create render target view for the proxy texture
         resource_view_desc rtv_desc = {};
         rtv_desc.type = resource_view_type::texture_2d;
-        rtv_desc.format = actual_desc.texture.format;
+        rtv_desc.format = proxy_format;
         rtv_desc.texture.first_level = 0;
         rtv_desc.texture.level_count = 1;
 
@@ -237,12 +431,12 @@ bool SwapchainManager::create_proxy_resources(SwapchainData* data, swapchain* sw
     }
 
     // Create shader resource views for proxy textures (for sampling during copy)
-    data->proxy_srvs.resize(back_buffer_count);
-    for (uint32_t i = 0; i < back_buffer_count; ++i)
+    data->proxy_srvs.resize(proxy_count);
+    for (uint32_t i = 0; i < proxy_count; ++i)
     {
         resource_view_desc srv_desc = {};
         srv_desc.type = resource_view_type::texture_2d;
-        srv_desc.format = actual_desc.texture.format;
+        srv_desc.format = proxy_format;
         srv_desc.texture.first_level = 0;
         srv_desc.texture.level_count = 1;
 
@@ -260,9 +454,95 @@ bool SwapchainManager::create_proxy_resources(SwapchainData* data, swapchain* sw
         data->actual_back_buffers[i] = swapchain_ptr->get_back_buffer(i);
     }
 
+    // Estimate from the format, drivers may pad or compress
+    const uint32_t row_pitch = format_row_pitch(proxy_format, data->original_width);
+    data->proxy_memory = uint64_t(format_slice_pitch(proxy_format, row_pitch, data->original_height)) * proxy_count;
+
     return true;
 }
 
+namespace
+{
+    // Next smaller render target format for the lower-precision fallback (unknown = none)
+    format lower_precision_format(format proxy_format)
+    {
+        switch (proxy_format)
+        {
+        case format::r32g32b32a32_float: return format::r16g16b16a16_float;
+        case format::r16g16b16a16_float: return format::r11g11b10_float;
+        case format::r10g10b10a2_unorm: return format::r8g8b8a8_unorm;
+        case format::b10g10r10a2_unorm: return format::b8g8r8a8_unorm;
+        default: return format::unknown;
+        }
+    }
+
+    // D3D12 and Vulkan pipelines are created for a render target format, so the application's
+    // pipelines would no longer match a proxy in a different format
+    bool supports_proxy_format_change(device_api api)
+    {
+        return api == device_api::d3d9 || api == device_api::d3d10 || api == device_api::d3d11 || api == device_api::opengl;
+    }
+}
+
+bool SwapchainManager::create_proxy_resources_with_fallback(SwapchainData* data, swapchain* swapchain_ptr)
+{
+    // Note: Caller must hold swapchain_mutex_
+    device* device_ptr = data->device_ptr;
+    const uint32_t back_buffer_count = swapchain_ptr->get_back_buffer_count();
+    const uint32_t fallback_steps = Config::get_instance().snapshot().get_proxy_fallback_steps();
+
+    uint32_t proxy_count = back_buffer_count;
+    format proxy_format = device_ptr->get_resource_desc(swapchain_ptr->get_back_buffer(0)).texture.format;
+    if (create_proxy_resources(data, swapchain_ptr, proxy_count, proxy_format))
+        return true;
+
+    // Presents run on one queue, so a single proxy is free again by the time the next frame draws into it
+    if ((fallback_steps & proxy_fallback_bit(ProxyFallbackStep::FewerProxies)) != 0 && proxy_count > 1)
+    {
+        data->cleanup();
+        proxy_count = 1;
+        take_proxy_fallback(ProxyFallbackStep::FewerProxies,
+            "retrying with 1 proxy texture for " + std::to_string(back_buffer_count) + " back buffers");
+        if (create_proxy_resources(data, swapchain_ptr, proxy_count, proxy_format))
+            return true;
+    }
+
+    if ((fallback_steps & proxy_fallback_bit(ProxyFallbackStep::LowerPrecision)) != 0 && supports_proxy_format_change(device_ptr->get_api()))
+    {
+        for (format lower_format = lower_precision_format(proxy_format); lower_format != format::unknown;
+             lower_format = lower_precision_format(lower_format))
+        {
+            data->cleanup();
+            char format_text[decode::TEXT_BUFFER_SIZE];
+            take_proxy_fallback(ProxyFallbackStep::LowerPrecision,
+                "retrying with proxy format " + std::string(DebugLogger::get_instance().format_to_string(lower_format, format_text)));
+            if (create_proxy_resources(data, swapchain_ptr, proxy_count, lower_format))
+                return true;
+        }
+    }
+
+    data->cleanup();
+
+    // The back buffers already exist at the forced size, a smaller one can only be requested for the next swapchain
+    if ((fallback_steps & proxy_fallback_bit(ProxyFallbackStep::LowerSize)) != 0)
+    {
+        const uint32_t halvings = ++forced_size_halvings_[swapchain_ptr->get_hwnd()];
+        take_proxy_fallback(ProxyFallbackStep::LowerSize,
+            "the forced size is divided by " + std::to_string(1u << std::min<uint32_t>(halvings, 31)) + " when this window's swapchain is created or resized again");
+    }
+
+    transition(data, SwapchainEvent::Bypass);
+    take_proxy_fallback(ProxyFallbackStep::DisableOverride, "the application renders at the forced size");
+    return false;
+}
+
+void SwapchainManager::take_proxy_fallback(ProxyFallbackStep step, const std::string& detail)
+{
+    proxy_fallback_counts_[static_cast<size_t>(step)].fetch_add(1, std::memory_order_relaxed);
+    reshade::log::message(reshade::log::level::warning,
+        ("Failed to create proxy resources, fallback " + std::string(proxy_fallback_step_name(step)) + ": " + detail).c_str());
+}
+
 bool SwapchainManager::create_copy_pipeline(SwapchainData* data, format format)
 {
     device* device_ptr = data->device_ptr;
@@ -295,33 +575,75 @@ bool SwapchainManager::create_copy_pipeline(SwapchainData* data, format format)
     }
 
     // Create sampler with the configured filter mode
+    return create_copy_sampler(data, Config::get_instance().snapshot().get_scaling_filter());
+}
+
+bool SwapchainManager::create_copy_sampler(SwapchainData* data, filter_mode filter)
+{
+    device* device_ptr = data->device_ptr;
+
     sampler_desc sampler_desc = {};
-    sampler_desc.filter = Config::get_instance().get_scaling_filter();
+    sampler_desc.filter = filter;
     sampler_desc.address_u = texture_address_mode::clamp;
     sampler_desc.address_v = texture_address_mode::clamp;
     sampler_desc.address_w = texture_address_mode::clamp;
 
-    if (!device_ptr->create_sampler(sampler_desc, &data->copy_sampler))
+    sampler new_sampler = {};
+    if (!device_ptr->create_sampler(sampler_desc, &new_sampler))
     {
         reshade::log::message(reshade::log::level::error, "Failed to create copy sampler");
         return false;
     }
 
+    // Replace the previous sampler (filter change on config reload)
+    if (data->copy_sampler.handle != 0)
+        device_ptr->destroy_sampler(data->copy_sampler);
+
+    data->copy_sampler = new_sampler;
+    data->copy_sampler_filter = filter;
     return true;
 }
 
-void SwapchainManager::destroy_swapchain(SwapchainNativeHandle swapchain_handle)
+void SwapchainManager::begin_resize(SwapchainNativeHandle swapchain_handle)
+{
+    std::lock_guard<std::mutex> lock(swapchain_mutex_);
+
+    // The proxies are kept, init_swapchain rebuilds them for the new back buffers
+    SwapchainData* data = get_data(swapchain_handle);
+    if (data != nullptr)
+        transition(data, SwapchainEvent::BeginResize);
+}
+
+void SwapchainManager::destroy_swapchain(SwapchainNativeHandle swapchain_handle, WindowHandle hwnd)
 {
     std::lock_guard<std::mutex> lock(swapchain_mutex_);
 
+    // A new swapchain of the window tries the full forced size again
+    forced_size_halvings_.erase(hwnd);
+
     auto it = swapchain_data_.find(swapchain_handle);
     if (it != swapchain_data_.end())
     {
+        transition(it->second.get(), SwapchainEvent::Destroy);
         swapchain_data_.erase(it);
+        scale_pass_gpu_ns_.store(0, std::memory_order_relaxed);
         reshade::log::message(reshade::log::level::info, "Cleaned up swapchain override data");
     }
 }
 
+uint64_t SwapchainManager::get_total_proxy_memory() const
+{
+    std::lock_guard<std::mutex> lock(swapchain_mutex_);
+
+    uint64_t total = 0;
+    for (const auto& [handle, data] : swapchain_data_)
+    {
+        if (data != nullptr)
+            total += data->proxy_memory;
+    }
+    return total;
+}
+
 SwapchainData* SwapchainManager::get_data(SwapchainNativeHandle swapchain_handle)
 {
     // Note: Caller must hold swapchain_mutex_
@@ -336,7 +658,7 @@ SwapchainData* SwapchainManager::find_active_data_for_device(device* device_ptr)
     // Note: Caller must hold swapchain_mutex_
     for (auto& pair : swapchain_data_)
     {
-        if (pair.second->override_active && pair.second->device_ptr == device_ptr)
+        if (pair.second->is_override_active() && pair.second->device_ptr == device_ptr)
         {
             return pair.second.get();
         }
@@ -348,21 +670,28 @@ void SwapchainManager::cleanup_all()
 {
     std::lock_guard<std::mutex> lock(swapchain_mutex_);
     swapchain_data_.clear();
+    active_overrides_.store(0, std::memory_order_relaxed);
+    swapchain_generation_.fetch_add(1, std::memory_order_release);
+    scale_pass_gpu_ns_.store(0, std::memory_order_relaxed);
 
-    std::lock_guard<std::mutex> pending_lock(pending_mutex_);
-    pending_swapchains_.clear();
+    pending_swapchains_ = {};
+    forced_size_halvings_.clear();
 }
 
-void SwapchainManager::handle_bind_render_targets(command_list* cmd_list, uint32_t count,
-                                                   const resource_view* rtvs, resource_view dsv)
+HookOutcome SwapchainManager::handle_bind_render_targets(command_list* cmd_list, uint32_t count,
+                                                         const resource_view* rtvs, resource_view dsv)
 {
     if (cmd_list == nullptr || rtvs == nullptr || count == 0)
-        return;
+        return HookOutcome::EarlyOut;
+
+    // Stays registered after a reload turns the override off, skip the lock while no swapchain has proxies
+    if (active_overrides_.load(std::memory_order_relaxed) == 0)
+        return HookOutcome::EarlyOut;
 
     // Get the device to lookup swapchain data
     device* device_ptr = cmd_list->get_device();
     if (device_ptr == nullptr)
-        return;
+        return HookOutcome::EarlyOut;
 
     std::lock_guard<std::mutex> lock(swapchain_mutex_);
 
@@ -403,161 +732,189 @@ void SwapchainManager::handle_bind_render_targets(command_list* cmd_list, uint32
     if (needs_rebind)
     {
         cmd_list->bind_render_targets_and_depth_stencil(count, modified_rtvs.data(), dsv);
+        return HookOutcome::Redirected;
     }
+
+    return HookOutcome::Passed;
 }
 
-void SwapchainManager::handle_bind_viewports(command_list* cmd_list, uint32_t first, uint32_t count,
-                                              const viewport* viewports)
+HookOutcome SwapchainManager::handle_bind_viewports(command_list* cmd_list, uint32_t first, uint32_t count,
+                                                    const viewport* viewports)
 {
     if (cmd_list == nullptr || viewports == nullptr || count == 0)
-        return;
+        return HookOutcome::EarlyOut;
 
-    // Skip if override is disabled
-    const Config& config = Config::get_instance();
-    if (!config.is_resolution_override_enabled())
-        return;
+    // Same early-out as handle_bind_render_targets
+    if (active_overrides_.load(std::memory_order_relaxed) == 0)
+        return HookOutcome::EarlyOut;
 
     // Get the device to lookup swapchain data
     device* device_ptr = cmd_list->get_device();
     if (device_ptr == nullptr)
-        return;
+        return HookOutcome::EarlyOut;
 
     std::lock_guard<std::mutex> lock(swapchain_mutex_);
 
     // Find if we have an active override for this device
     SwapchainData* active_data = find_active_data_for_device(device_ptr);
     if (active_data == nullptr)
-        return; // No active override for this device
+        return HookOutcome::EarlyOut; // No active override for this device
 
-    // Calculate scaling factors
-    const float scale_x = static_cast<float>(active_data->original_width) / static_cast<float>(active_data->actual_width);
-    const float scale_y = static_cast<float>(active_data->original_height) / static_cast<float>(active_data->actual_height);
+    const SurfaceScale scale = { active_data->original_width, active_data->original_height,
+                                 active_data->actual_width, active_data->actual_height };
+
+    // While a debounced rebuild is pending the proxies still have the old size, binds at the
+    // resized size are scaled onto them as well
+    const bool rebuild_pending = active_data->resize_debounce.is_pending();
+    const SurfaceScale resized_scale = { active_data->original_width, active_data->original_height,
+                                         active_data->resized_width, active_data->resized_height };
 
     bool needs_rebind = false;
 
     // Create a mutable copy
     std::vector<viewport> modified_viewports(viewports, viewports + count);
 
-    for (uint32_t i = 0; i < count; ++i)
+    for (viewport& vp : modified_viewports)
     {
-        // Check if viewport dimensions match the forced size (or close to it)
-        // We use a tolerance because viewport might be slightly different
-        const bool matches_forced_width = (modified_viewports[i].width >= active_data->actual_width * 0.9f);
-        const bool matches_forced_height = (modified_viewports[i].height >= active_data->actual_height * 0.9f);
-
-        if (matches_forced_width && matches_forced_height)
-        {
-            // Scale viewport to original size
-            modified_viewports[i].x *= scale_x;
-            modified_viewports[i].y *= scale_y;
-            modified_viewports[i].width *= scale_x;
-            modified_viewports[i].height *= scale_y;
+        if (redirect_viewport(scale, vp.x, vp.y, vp.width, vp.height) ||
+            (rebuild_pending && redirect_viewport(resized_scale, vp.x, vp.y, vp.width, vp.height)))
             needs_rebind = true;
-        }
     }
 
     if (needs_rebind)
     {
         // Rebind with the modified viewports
         cmd_list->bind_viewports(first, count, modified_viewports.data());
+        return HookOutcome::Redirected;
     }
+
+    return HookOutcome::Passed;
 }
 
-void SwapchainManager::handle_bind_scissor_rects(command_list* cmd_list, uint32_t first, uint32_t count,
-                                                  const rect* rects)
+HookOutcome SwapchainManager::handle_bind_scissor_rects(command_list* cmd_list, uint32_t first, uint32_t count,
+                                                        const rect* rects)
 {
     if (cmd_list == nullptr || rects == nullptr || count == 0)
-        return;
+        return HookOutcome::EarlyOut;
 
-    // Skip if override is disabled
-    const Config& config = Config::get_instance();
-    if (!config.is_resolution_override_enabled())
-        return;
+    // Same early-out as handle_bind_render_targets
+    if (active_overrides_.load(std::memory_order_relaxed) == 0)
+        return HookOutcome::EarlyOut;
 
     // Get the device to lookup swapchain data
     device* device_ptr = cmd_list->get_device();
     if (device_ptr == nullptr)
-        return;
+        return HookOutcome::EarlyOut;
 
     std::lock_guard<std::mutex> lock(swapchain_mutex_);
 
     // Find if we have an active override for this device
     SwapchainData* active_data = find_active_data_for_device(device_ptr);
     if (active_data == nullptr)
-        return; // No active override for this device
+        return HookOutcome::EarlyOut; // No active override for this device
+
+    const SurfaceScale scale = { active_data->original_width, active_data->original_height,
+                                 active_data->actual_width, active_data->actual_height };
 
-    // Calculate scaling factors
-    const float scale_x = static_cast<float>(active_data->original_width) / static_cast<float>(active_data->actual_width);
-    const float scale_y = static_cast<float>(active_data->original_height) / static_cast<float>(active_data->actual_height);
+    // While a debounced rebuild is pending the proxies still have the old size, binds at the
+    // resized size are scaled onto them as well
+    const bool rebuild_pending = active_data->resize_debounce.is_pending();
+    const SurfaceScale resized_scale = { active_data->original_width, active_data->original_height,
+                                         active_data->resized_width, active_data->resized_height };
 
     bool needs_rebind = false;
 
     // Create a mutable copy
     std::vector<rect> modified_rects(rects, rects + count);
 
-    for (uint32_t i = 0; i < count; ++i)
+    for (rect& r : modified_rects)
     {
-        const int32_t width = modified_rects[i].right - modified_rects[i].left;
-        const int32_t height = modified_rects[i].bottom - modified_rects[i].top;
-
-        // Check if scissor rect dimensions match the forced size (or close to it)
-        const bool matches_forced_width = (width >= static_cast<int32_t>(active_data->actual_width * 0.9f));
-        const bool matches_forced_height = (height >= static_cast<int32_t>(active_data->actual_height * 0.9f));
-
-        if (matches_forced_width && matches_forced_height)
-        {
-            // Scale scissor rect to original size
-            modified_rects[i].left = static_cast<int32_t>(modified_rects[i].left * scale_x);
-            modified_rects[i].top = static_cast<int32_t>(modified_rects[i].top * scale_y);
-            modified_rects[i].right = static_cast<int32_t>(modified_rects[i].right * scale_x);
-            modified_rects[i].bottom = static_cast<int32_t>(modified_rects[i].bottom * scale_y);
+        if (redirect_scissor_rect(scale, r.left, r.top, r.right, r.bottom) ||
+            (rebuild_pending && redirect_scissor_rect(resized_scale, r.left, r.top, r.right, r.bottom)))
             needs_rebind = true;
-        }
     }
 
     if (needs_rebind)
     {
         // Rebind with the modified scissor rects
         cmd_list->bind_scissor_rects(first, count, modified_rects.data());
+        return HookOutcome::Redirected;
     }
+
+    return HookOutcome::Passed;
 }
 
-void SwapchainManager::handle_present(command_queue* queue, swapchain* swapchain_ptr)
+void SwapchainManager::collect_scale_pass_timing(SwapchainData* data, command_queue* queue)
 {
-    if (swapchain_ptr == nullptr || queue == nullptr)
+    // Note: Caller must hold swapchain_mutex_
+    if (data->timestamp_heap.handle == 0)
         return;
 
+    device* const device_ptr = data->device_ptr;
+    const query_heap heap = data->timestamp_heap;
+    const uint32_t collected = data->scale_pass_timer.collect(
+        [device_ptr, heap](uint32_t first, uint32_t count, uint64_t* out_timestamps) {
+            return device_ptr->get_query_heap_results(heap, first, count, out_timestamps, sizeof(uint64_t));
+        });
+
+    const uint64_t frequency = queue->get_timestamp_frequency();
+    if (collected == 0 || frequency == 0)
+        return;
+
+    const double nanoseconds = static_cast<double>(data->scale_pass_timer.last_ticks()) * 1000000000.0 / static_cast<double>(frequency);
+    data->scale_pass_gpu_ns = static_cast<uint32_t>(std::min(nanoseconds, static_cast<double>(UINT32_MAX)));
+    scale_pass_gpu_ns_.store(data->scale_pass_gpu_ns, std::memory_order_relaxed);
+}
+
+HookOutcome SwapchainManager::handle_present(command_queue* queue, swapchain* swapchain_ptr)
+{
+    if (swapchain_ptr == nullptr || queue == nullptr)
+        return HookOutcome::EarlyOut;
+
+    // No swapchain runs through proxies
+    if (active_overrides_.load(std::memory_order_relaxed) == 0)
+        return HookOutcome::EarlyOut;
+
     std::lock_guard<std::mutex> lock(swapchain_mutex_);
 
     const SwapchainNativeHandle swapchain_handle = swapchain_ptr->get_native();
     SwapchainData* data = get_data(swapchain_handle);
 
-    if (data == nullptr || !data->override_active)
-        return; // No override for this swapchain
+    if (data == nullptr || !data->is_override_active())
+        return HookOutcome::EarlyOut; // No override for this swapchain
 
     device* device_ptr = swapchain_ptr->get_device();
     if (device_ptr == nullptr)
-        return;
+        return HookOutcome::EarlyOut;
+
+    // Pick up a scaling filter change from a config reload (only the sampler is rebuilt)
+    const filter_mode scaling_filter = Config::get_instance().snapshot().get_scaling_filter();
+    if (data->copy_sampler_filter != scaling_filter && create_copy_sampler(data, scaling_filter))
+    {
+        reshade::log::message(reshade::log::level::info, "Rebuilt copy sampler for new scaling filter");
+    }
 
     // Get current back buffer index
     const uint32_t current_index = swapchain_ptr->get_current_back_buffer_index();
-    if (current_index >= data->proxy_textures.size())
-        return;
+    if (data->proxy_textures.empty())
+        return HookOutcome::EarlyOut;
 
-    resource proxy_texture = data->proxy_textures[current_index];
+    // Back buffers share proxies round-robin after the fewer-proxies fallback
+    const size_t proxy_index = current_index % data->proxy_textures.size();
+    resource proxy_texture = data->proxy_textures[proxy_index];
     resource actual_back_buffer = swapchain_ptr->get_back_buffer(current_index);
 
     if (proxy_texture.handle == 0 || actual_back_buffer.handle == 0)
-        return;
+        return HookOutcome::EarlyOut;
 
     // Get an immediate command list to perform the scaled copy via fullscreen draw
     command_list* cmd_list = queue->get_immediate_command_list();
     if (cmd_list == nullptr)
-        return;
+        return HookOutcome::EarlyOut;
 
-    resource_view proxy_srv = data->proxy_srvs[current_index];
+    resource_view proxy_srv = data->proxy_srvs[proxy_index];
     if (proxy_srv.handle == 0)
-        return;
+        return HookOutcome::EarlyOut;
 
     // Create RTV for the actual back buffer (if not already created)
     resource_view actual_rtv = {};
@@ -571,9 +928,17 @@ void SwapchainManager::handle_present(command_queue* queue, swapchain* swapchain
     if (!device_ptr->create_resource_view(actual_back_buffer, resource_usage::render_target, rtv_desc, &actual_rtv))
     {
         reshade::log::message(reshade::log::level::error, "Failed to create back buffer RTV for present");
-        return;
+        return HookOutcome::EarlyOut;
     }
 
+    // Read back earlier frames before timing this one, so a free slot is available
+    collect_scale_pass_timing(data, queue);
+
+    uint32_t first_query = 0;
+    const bool timed = data->timestamp_heap.handle != 0 && data->scale_pass_timer.begin_frame(first_query);
+    if (timed)
+        cmd_list->end_query(data->timestamp_heap, query_type::timestamp, first_query);
+
     // Barrier: Transition proxy texture to shader resource
     resource_usage proxy_old_state = resource_usage::render_target;
     resource_usage proxy_new_state = resource_usage::shader_resource;
@@ -621,60 +986,81 @@ void SwapchainManager::handle_present(command_queue* queue, swapchain* swapchain
     dest_new_state = resource_usage::present;
     cmd_list->barrier(1, &actual_back_buffer, &dest_old_state, &dest_new_state);
 
+    if (timed)
+    {
+        cmd_list->end_query(data->timestamp_heap, query_type::timestamp, first_query + 1);
+        data->scale_pass_timer.end_frame();
+    }
+
     // Clean up temporary RTV
     device_ptr->destroy_resource_view(actual_rtv);
+
+    return HookOutcome::Redirected;
 }
 
+template <typename Policy>
 bool SwapchainManager::handle_create_swapchain(device_api api, swapchain_desc& desc, void* hwnd)
 {
-    const Config& config = Config::get_instance();
-    DebugLogger& logger = DebugLogger::get_instance();
     bool modified = false;
 
     // Debug logging
-    if (config.is_debug_mode_enabled())
+    if constexpr (Policy::debug)
     {
-        logger.get_next_sequence();
-        reshade::log::message(reshade::log::level::info, logger.format_event_header("CREATE_SWAPCHAIN (Debug Mode: No Override)").c_str());
+        DebugLogger& logger = DebugLogger::get_instance();
+        logger.log_event("CREATE_SWAPCHAIN (Debug Mode: No Override)");
         logger.log_swapchain_desc(desc, hwnd);
-        reshade::log::message(reshade::log::level::info, ("  Device API: " + std::string(logger.device_api_to_string(api))).c_str());
+        logger.log("  Device API: " + std::string(logger.device_api_to_string(api)));
 
         // In debug mode, don't modify anything
-        return false;
+        return modified;
     }
 
     // Handle resolution override
-    if (config.is_resolution_override_enabled())
+    if constexpr (Policy::resolution_override)
     {
+        const ConfigSnapshot& config = Config::get_instance().snapshot();
         const uint32_t requested_width = desc.back_buffer.texture.width;
         const uint32_t requested_height = desc.back_buffer.texture.height;
 
-        // Always store the original requested size when override is enabled
+        // Relative modes are resolved per swapchain, so each window gets its own forced size
+        uint32_t forced_width = 0;
+        uint32_t forced_height = 0;
+        const bool resolved = resolve_forced_size(config.get_forced_resolution(), Policy::fullscreen_overridden, hwnd,
+            requested_width, requested_height, forced_width, forced_height);
+
         if (hwnd != nullptr)
         {
+            std::lock_guard<std::mutex> lock(swapchain_mutex_);
+
+            // Always store the original requested size when override is enabled
             store_pending_info(
                 static_cast<WindowHandle>(hwnd),
                 requested_width,
                 requested_height);
+
+            // Proxies for this window could not be created at an earlier forced size (lower-size fallback)
+            const auto it = forced_size_halvings_.find(static_cast<WindowHandle>(hwnd));
+            if (resolved && it != forced_size_halvings_.end())
+                lower_forced_size(requested_width, requested_height, it->second, forced_width, forced_height);
         }
 
         // Only modify descriptor if sizes differ
-        if (requested_width != config.get_force_width() || requested_height != config.get_force_height())
+        if (resolved && (requested_width != forced_width || requested_height != forced_height))
         {
             // Override the swapchain description
-            desc.back_buffer.texture.width = config.get_force_width();
-            desc.back_buffer.texture.height = config.get_force_height();
+            desc.back_buffer.texture.width = forced_width;
+            desc.back_buffer.texture.height = forced_height;
 
             reshade::log::message(reshade::log::level::info,
                 ("Swapchain override: Requested size " + std::to_string(requested_width) + "x" + std::to_string(requested_height) +
-                " -> Forced size " + std::to_string(config.get_force_width()) + "x" + std::to_string(config.get_force_height())).c_str());
+                " -> Forced size " + std::to_string(forced_width) + "x" + std::to_string(forced_height)).c_str());
 
             modified = true;
         }
     }
 
     // Handle fullscreen mode override
-    if (config.is_exclusive_fullscreen_enabled())
+    if constexpr (Policy::exclusive)
     {
         // Don't force fullscreen during creation (causes DXGI_ERROR_INVALID_CALL due to 0/0 refresh rate)
         // Instead, we'll transition to fullscreen after creation in handle_init_swapchain
@@ -688,7 +1074,7 @@ bool SwapchainManager::handle_create_swapchain(device_api api, swapchain_desc& d
             modified = true;
         }
     }
-    else if (config.is_borderless_fullscreen_enabled())
+    else if constexpr (Policy::borderless)
     {
         if (desc.fullscreen_state)
         {
@@ -709,20 +1095,19 @@ bool SwapchainManager::handle_create_swapchain(device_api api, swapchain_desc& d
     return modified;
 }
 
+template <typename Policy>
 void SwapchainManager::handle_init_swapchain(swapchain* swapchain_ptr, bool is_resize)
 {
     if (swapchain_ptr == nullptr)
         return;
 
-    const Config& config = Config::get_instance();
-    DebugLogger& logger = DebugLogger::get_instance();
     device* device_ptr = swapchain_ptr->get_device();
 
     // Debug logging
-    if (config.is_debug_mode_enabled())
+    if constexpr (Policy::debug)
     {
-        logger.get_next_sequence();
-        reshade::log::message(reshade::log::level::info, logger.format_event_header("INIT_SWAPCHAIN").c_str());
+        DebugLogger& logger = DebugLogger::get_instance();
+        logger.log_event("INIT_SWAPCHAIN");
 
         // Get actual swapchain description
         if (device_ptr != nullptr)
@@ -741,253 +1126,489 @@ void SwapchainManager::handle_init_swapchain(swapchain* swapchain_ptr, bool is_r
             logger.log_window_state(static_cast<HWND>(hwnd));
         }
 
-        reshade::log::message(reshade::log::level::info, ("  Resize Event: " + std::string(is_resize ? "true" : "false")).c_str());
+        logger.log("  Resize Event: " + std::string(is_resize ? "true" : "false"));
 
         // In debug mode, don't initialize proxy system
-        return;
     }
-
     // Skip if override is disabled
-    if (!config.is_resolution_override_enabled())
-        return;
+    else if constexpr (Policy::resolution_override)
+    {
+        // Check if we have pending data for this swapchain's window
+        // This indicates we actually modified the swapchain in handle_create_swapchain
+        WindowHandle hwnd = swapchain_ptr->get_hwnd();
 
-    // Check if we have pending data for this swapchain's window
-    // This indicates we actually modified the swapchain in handle_create_swapchain
-    WindowHandle hwnd = swapchain_ptr->get_hwnd();
+        // If override is enabled, we assume the swapchain was potentially modified
+        // The SwapchainManager will handle whether to actually initialize based on pending info
+        if (hwnd == nullptr)
+            return;
 
-    // If override is enabled, we assume the swapchain was potentially modified
-    // The SwapchainManager will handle whether to actually initialize based on pending info
-    if (hwnd == nullptr)
-        return;
+        // Initialize the swapchain resources
+        initialize_swapchain(swapchain_ptr);
+
+        // Transition to exclusive fullscreen if configured (only on initial creation, not resize)
+        if constexpr (Policy::exclusive)
+            transition_to_exclusive_fullscreen(swapchain_ptr, is_resize);
+    }
+    else
+    {
+        // The override was disabled by a config reload, proxies from before the reload
+        // no longer match the recreated back buffers
+        destroy_swapchain(swapchain_ptr->get_native(), swapchain_ptr->get_hwnd());
+    }
+}
 
-    // Initialize the swapchain resources
-    initialize_swapchain(swapchain_ptr);
+bool SwapchainManager::resolve_forced_size(const ResolutionSpec& spec, bool use_target_monitor, void* hwnd,
+                                           uint32_t requested_width, uint32_t requested_height,
+                                           uint32_t& out_width, uint32_t& out_height)
+{
+    uint32_t monitor_width = 0;
+    uint32_t monitor_height = 0;
 
-    // Transition to exclusive fullscreen if configured (only on initial creation, not resize)
-    if (!is_resize && config.is_exclusive_fullscreen_enabled())
+    if (spec.mode == ResolutionMode::FitMonitor)
     {
-        if (device_ptr == nullptr)
-            return;
+        // Follow the window onto the target monitor when the fullscreen override moves it there
+        RECT rect = {};
+        bool found = use_target_monitor && WindowHooks::get_target_monitor_rect(&rect);
+        if (!found)
+        {
+            const HMONITOR monitor = hwnd != nullptr
+                ? MonitorFromWindow(static_cast<HWND>(hwnd), MONITOR_DEFAULTTOPRIMARY)
+                : MonitorFromPoint({ 0, 0 }, MONITOR_DEFAULTTOPRIMARY);
+
+            MONITORINFO mi = { sizeof(MONITORINFO) };
+            found = GetMonitorInfo(monitor, &mi) != FALSE;
+            rect = mi.rcMonitor;
+        }
+        if (found)
+        {
+            monitor_width = static_cast<uint32_t>(rect.right - rect.left);
+            monitor_height = static_cast<uint32_t>(rect.bottom - rect.top);
+        }
+    }
+
+    // Qualified, the member of the same name would hide the core function
+    switch (::resolve_forced_size(spec, requested_width, requested_height, monitor_width, monitor_height, out_width, out_height))
+    {
+    case ResolveStatus::Resolved:
+        return true;
+    case ResolveStatus::Clamped:
+        reshade::log::message(reshade::log::level::warning,
+            ("Swapchain override: Forced size clamped to " + std::to_string(out_width) + "x" + std::to_string(out_height)).c_str());
+        return true;
+    case ResolveStatus::RequestedSizeUnknown:
+        reshade::log::message(reshade::log::level::warning,
+            "Swapchain override: Requested size is 0x0, relative resolution cannot be applied");
+        return false;
+    case ResolveStatus::MonitorSizeUnknown:
+        reshade::log::message(reshade::log::level::warning,
+            "Swapchain override: Could not query the monitor size, fit-monitor ignored");
+        return false;
+    default:
+        return false;
+    }
+}
+
+void SwapchainManager::transition_to_exclusive_fullscreen(swapchain* swapchain_ptr, bool is_resize)
+{
+    device* device_ptr = swapchain_ptr->get_device();
+    if (is_resize || device_ptr == nullptr)
+        return;
 
-        const device_api api = device_ptr->get_api();
+    const device_api api = device_ptr->get_api();
 
-        // Only apply to DXGI-based APIs (D3D10, D3D11, D3D12)
-        if (api == device_api::d3d10 || api == device_api::d3d11 || api == device_api::d3d12)
+    // Only apply to DXGI-based APIs (D3D10, D3D11, D3D12)
+    if (api == device_api::d3d10 || api == device_api::d3d11 || api == device_api::d3d12)
+    {
+        // Get native DXGI swapchain handle
+        IDXGISwapChain* dxgi_swapchain = reinterpret_cast<IDXGISwapChain*>(swapchain_ptr->get_native());
+        if (dxgi_swapchain != nullptr)
         {
-            // Get native DXGI swapchain handle
-            IDXGISwapChain* dxgi_swapchain = reinterpret_cast<IDXGISwapChain*>(swapchain_ptr->get_native());
-            if (dxgi_swapchain != nullptr)
+            // Transition to exclusive fullscreen
+            HRESULT hr = dxgi_swapchain->SetFullscreenState(TRUE, nullptr);
+            if (SUCCEEDED(hr))
             {
-                // Transition to exclusive fullscreen
-                HRESULT hr = dxgi_swapchain->SetFullscreenState(TRUE, nullptr);
-                if (SUCCEEDED(hr))
-                {
-                    reshade::log::message(reshade::log::level::info, "Successfully transitioned to exclusive fullscreen mode");
-                }
-                else
-                {
-                    reshade::log::message(reshade::log::level::error,
-                        ("Failed to transition to exclusive fullscreen " + logger.format_hresult(hr)).c_str());
-                }
+                reshade::log::message(reshade::log::level::info, "Successfully transitioned to exclusive fullscreen mode");
+            }
+            else
+            {
+                char hr_text[decode::TEXT_BUFFER_SIZE];
+                reshade::log::message(reshade::log::level::error,
+                    ("Failed to transition to exclusive fullscreen " + std::string(DebugLogger::get_instance().format_hresult(hr, hr_text))).c_str());
             }
-        }
-        else
-        {
-            reshade::log::message(reshade::log::level::warning,
-                "Exclusive fullscreen mode is only supported for D3D10/D3D11/D3D12 APIs");
         }
     }
+    else
+    {
+        reshade::log::message(reshade::log::level::warning,
+            "Exclusive fullscreen mode is only supported for D3D10/D3D11/D3D12 APIs");
+    }
 }
 
+template <typename Policy>
 bool SwapchainManager::handle_set_fullscreen_state(swapchain* swapchain_ptr, bool fullscreen, void* hmonitor)
 {
     if (swapchain_ptr == nullptr)
         return false;
 
-    const Config& config = Config::get_instance();
-    DebugLogger& logger = DebugLogger::get_instance();
-
     // Debug logging
-    if (config.is_debug_mode_enabled())
+    if constexpr (Policy::debug)
     {
-        logger.get_next_sequence();
-        reshade::log::message(reshade::log::level::info, logger.format_event_header("SET_FULLSCREEN_STATE").c_str());
-        reshade::log::message(reshade::log::level::info, ("  Requested State: " + std::string(fullscreen ? "fullscreen" : "windowed")).c_str());
+        DebugLogger& logger = DebugLogger::get_instance();
+        logger.log_event("SET_FULLSCREEN_STATE");
+        logger.log("  Requested State: " + std::string(fullscreen ? "fullscreen" : "windowed"));
 
         if (hmonitor != nullptr)
         {
             logger.log_monitor_info(static_cast<HMONITOR>(hmonitor));
         }
 
-        reshade::log::message(reshade::log::level::info, "  Action: Allow (debug mode)");
+        logger.log("  Action: Allow (debug mode)");
 
         // In debug mode, don't block anything
         return false;
     }
-
-    // If exclusive mode is forced:
-    // - Allow transitions TO fullscreen (including our own internal transition)
-    // - Block transitions to windowed
-    if (config.is_exclusive_fullscreen_enabled())
+    else
     {
-        if (!fullscreen)
+        // BlockFullscreenChanges only applies while the fullscreen mode is left unchanged
+        bool block_changes = false;
+        if constexpr (!Policy::fullscreen_overridden)
+            block_changes = Config::get_instance().snapshot().get_block_fullscreen_changes();
+
+        switch (decide_fullscreen_change(Policy::fullscreen_mode, block_changes, fullscreen))
         {
+        case FullscreenDecision::BlockWindowed:
             reshade::log::message(reshade::log::level::debug,
                 "Blocking windowed transition to maintain exclusive fullscreen mode");
             return true; // Block the change to windowed
-        }
-        else
-        {
-            // Allow transition to fullscreen (this is what we want)
-            return false;
-        }
-    }
-
-    // If borderless mode is forced:
-    // - Allow transitions to windowed
-    // - Block transitions to fullscreen
-    if (config.is_borderless_fullscreen_enabled())
-    {
-        if (fullscreen)
-        {
+        case FullscreenDecision::BlockFullscreen:
             reshade::log::message(reshade::log::level::debug,
                 "Blocking fullscreen transition to maintain borderless fullscreen mode");
             return true; // Block the change to exclusive fullscreen
-        }
-        else
-        {
-            // Allow transition to windowed (this is what we want)
-            return false;
+        case FullscreenDecision::BlockByConfig:
+            reshade::log::message(reshade::log::level::debug,
+                ("Blocked fullscreen state change attempt (requested: " + std::string(fullscreen ? "fullscreen" : "windowed") + ")").c_str());
+            return true; // Return true to block the change
+        default:
+            return false; // Allow the change
         }
     }
-
-    // FullscreenMode::Unchanged - respect block_fullscreen_changes setting
-    if (config.get_block_fullscreen_changes())
-    {
-        reshade::log::message(reshade::log::level::debug,
-            ("Blocked fullscreen state change attempt (requested: " + std::string(fullscreen ? "fullscreen" : "windowed") + ")").c_str());
-        return true; // Return true to block the change
-    }
-
-    return false; // Allow the change
 }
 
 void SwapchainManager::handle_destroy_swapchain(swapchain* swapchain_ptr, bool is_resize)
 {
-    if (swapchain_ptr == nullptr || is_resize)
-        return; // Don't destroy on resize, only on actual destruction
+    if (swapchain_ptr == nullptr)
+        return;
 
+    // Don't destroy on resize, only on actual destruction
     const SwapchainNativeHandle swapchain_handle = swapchain_ptr->get_native();
-    destroy_swapchain(swapchain_handle);
+    if (is_resize)
+        begin_resize(swapchain_handle);
+    else
+        destroy_swapchain(swapchain_handle, swapchain_ptr->get_hwnd());
 }
 
 void SwapchainManager::handle_init_device(device* device)
 {
-    if (device == nullptr)
-        return;
-
-    const Config& config = Config::get_instance();
-    if (!config.is_debug_mode_enabled())
+    // Only registered in debug mode, and ignored once a reload turned it off
+    if (device == nullptr || policy_.load(std::memory_order_relaxed) != HookPolicyIndex::Debug)
         return;
 
     DebugLogger& logger = DebugLogger::get_instance();
-    logger.get_next_sequence();
-    reshade::log::message(reshade::log::level::info, logger.format_event_header("INIT_DEVICE").c_str());
+    logger.log_event("INIT_DEVICE");
     logger.log_device_info(device);
 }
 
 void SwapchainManager::handle_finish_present(command_queue* queue, swapchain* swapchain_ptr)
 {
+    // Always registered, for the frame timer and the debounced rebuilds
     if (swapchain_ptr == nullptr)
         return;
 
-    const Config& config = Config::get_instance();
-    if (!config.is_debug_mode_enabled())
-        return;
+    FrameTimer::get_instance().record_present();
+
+    // Rebuild proxies kept through a resize once the size is stable (ResizeDebounce)
+    if (resize_rebuild_pending_.load(std::memory_order_relaxed) && queue != nullptr)
+        finish_debounced_resize(queue, swapchain_ptr);
 
-    // Note: We don't log every frame to avoid spam - could add throttling here if needed
+    // Per-frame output would flood the log, frames are only counted for the periodic summary
+    if (Config::get_instance().snapshot().is_debug_mode_enabled())
+        DebugLogger::get_instance().on_frame();
 }
 
 // Install/uninstall methods
+namespace
+{
+    // One bit per ReShade event the addon can listen to
+    enum RegisteredEvent : uint32_t
+    {
+        EVENT_INIT_DEVICE = 1u << 0,
+        EVENT_CREATE_SWAPCHAIN = 1u << 1,
+        EVENT_INIT_SWAPCHAIN = 1u << 2,
+        EVENT_BIND_RENDER_TARGETS = 1u << 3,
+        EVENT_BIND_VIEWPORTS = 1u << 4,
+        EVENT_BIND_SCISSOR_RECTS = 1u << 5,
+        EVENT_PRESENT = 1u << 6,
+        EVENT_FINISH_PRESENT = 1u << 7,
+        EVENT_SET_FULLSCREEN_STATE = 1u << 8,
+        EVENT_DESTROY_SWAPCHAIN = 1u << 9,
+    };
+}
+
+uint32_t SwapchainManager::compute_required_events(const ConfigSnapshot& config)
+{
+    uint32_t required = 0;
+
+    if (config.is_debug_mode_enabled())
+    {
+        // Debug mode only observes, it never redirects anything
+        required |= EVENT_INIT_DEVICE | EVENT_CREATE_SWAPCHAIN | EVENT_INIT_SWAPCHAIN | EVENT_SET_FULLSCREEN_STATE;
+    }
+    else
+    {
+        const bool override_enabled = config.is_resolution_override_enabled();
+
+        if (override_enabled || config.is_fullscreen_mode_overridden())
+            required |= EVENT_CREATE_SWAPCHAIN;
+        // init_swapchain only sets up proxies, exclusive fullscreen on its own needs create_swapchain and set_fullscreen_state
+        if (override_enabled)
+            required |= EVENT_INIT_SWAPCHAIN | EVENT_BIND_RENDER_TARGETS | EVENT_BIND_VIEWPORTS | EVENT_BIND_SCISSOR_RECTS | EVENT_PRESENT;
+        if (config.is_fullscreen_mode_overridden() || config.get_block_fullscreen_changes())
+            required |= EVENT_SET_FULLSCREEN_STATE;
+    }
+
+    // What init_swapchain tracks is released in destroy_swapchain
+    if ((required & EVENT_INIT_SWAPCHAIN) != 0)
+        required |= EVENT_DESTROY_SWAPCHAIN;
+
+    // Once per frame, for the frame timer and the debounced rebuilds
+    required |= EVENT_FINISH_PRESENT;
+
+    return required;
+}
+
+void SwapchainManager::apply_config_change(const ConfigSnapshot& previous, const ConfigSnapshot& current)
+{
+    // Samplers are rebuilt lazily on the render thread in handle_present, everything else is kept
+    if (previous.get_scaling_filter() != current.get_scaling_filter())
+    {
+        reshade::log::message(reshade::log::level::info, "Scaling filter changed, copy samplers will be rebuilt on next present");
+    }
+
+    // Proxies are sized to the requested resolution, so they stay valid until the swapchain itself changes
+    if (previous.get_forced_resolution() != current.get_forced_resolution())
+    {
+        char resolution[64] = {};
+        format_resolution_spec(current.get_forced_resolution(), resolution, sizeof(resolution));
+
+        reshade::log::message(reshade::log::level::info,
+            ("Forced resolution changed to " + std::string(resolution) +
+            ", applies when the application next creates or resizes its swapchain").c_str());
+    }
+
+    // The registered callbacks pick the new policy on their next call. ReShade's callback lists are
+    // never changed after install, an event can be running on another thread at any time.
+    policy_.store(hook_policy_index(current), std::memory_order_release);
+
+    uint32_t registered_events = 0;
+    {
+        std::lock_guard<std::mutex> lock(registration_mutex_);
+        registered_events = registered_events_;
+    }
+
+    const uint32_t missing_events = compute_required_events(current) & ~registered_events;
+    if (registered_events != 0 && missing_events != 0)
+    {
+        char message[128];
+        snprintf(message, sizeof(message),
+            "Reloaded configuration needs events that were not registered at startup (mask 0x%03X), restart the application to apply it",
+            missing_events);
+        reshade::log::message(reshade::log::level::warning, message);
+    }
+}
+
 void SwapchainManager::install()
 {
-    reshade::register_event<reshade::addon_event::init_device>(on_init_device);
-    reshade::register_event<reshade::addon_event::create_swapchain>(on_create_swapchain);
-    reshade::register_event<reshade::addon_event::init_swapchain>(on_init_swapchain);
-    reshade::register_event<reshade::addon_event::bind_render_targets_and_depth_stencil>(on_bind_render_targets_and_depth_stencil);
-    reshade::register_event<reshade::addon_event::bind_viewports>(on_bind_viewports);
-    reshade::register_event<reshade::addon_event::bind_scissor_rects>(on_bind_scissor_rects);
-    reshade::register_event<reshade::addon_event::present>(on_present);
-    reshade::register_event<reshade::addon_event::finish_present>(on_finish_present);
-    reshade::register_event<reshade::addon_event::set_fullscreen_state>(on_set_fullscreen_state);
-    reshade::register_event<reshade::addon_event::destroy_swapchain>(on_destroy_swapchain);
+    using reshade::addon_event;
+    std::lock_guard<std::mutex> lock(registration_mutex_);
+
+    if (registered_events_ != 0)
+        return;
+
+    const ConfigSnapshot& config = Config::get_instance().snapshot();
+    policy_.store(hook_policy_index(config), std::memory_order_release);
+    registered_events_ = compute_required_events(config);
+
+    if (registered_events_ & EVENT_INIT_DEVICE)
+        reshade::register_event<addon_event::init_device>(on_init_device);
+    if (registered_events_ & EVENT_CREATE_SWAPCHAIN)
+        reshade::register_event<addon_event::create_swapchain>(on_create_swapchain);
+    if (registered_events_ & EVENT_INIT_SWAPCHAIN)
+        reshade::register_event<addon_event::init_swapchain>(on_init_swapchain);
+    if (registered_events_ & EVENT_BIND_RENDER_TARGETS)
+        reshade::register_event<addon_event::bind_render_targets_and_depth_stencil>(on_bind_render_targets_and_depth_stencil);
+    if (registered_events_ & EVENT_BIND_VIEWPORTS)
+        reshade::register_event<addon_event::bind_viewports>(on_bind_viewports);
+    if (registered_events_ & EVENT_BIND_SCISSOR_RECTS)
+        reshade::register_event<addon_event::bind_scissor_rects>(on_bind_scissor_rects);
+    if (registered_events_ & EVENT_PRESENT)
+        reshade::register_event<addon_event::present>(on_present);
+    if (registered_events_ & EVENT_FINISH_PRESENT)
+        reshade::register_event<addon_event::finish_present>(on_finish_present);
+    if (registered_events_ & EVENT_SET_FULLSCREEN_STATE)
+        reshade::register_event<addon_event::set_fullscreen_state>(on_set_fullscreen_state);
+    if (registered_events_ & EVENT_DESTROY_SWAPCHAIN)
+        reshade::register_event<addon_event::destroy_swapchain>(on_destroy_swapchain);
+
+    char message[64];
+    snprintf(message, sizeof(message), "Registered event callbacks (mask 0x%03X)", registered_events_);
+    reshade::log::message(reshade::log::level::info, message);
 }
 
 void SwapchainManager::uninstall()
 {
-    reshade::unregister_event<reshade::addon_event::init_device>(on_init_device);
-    reshade::unregister_event<reshade::addon_event::create_swapchain>(on_create_swapchain);
-    reshade::unregister_event<reshade::addon_event::init_swapchain>(on_init_swapchain);
-    reshade::unregister_event<reshade::addon_event::bind_render_targets_and_depth_stencil>(on_bind_render_targets_and_depth_stencil);
-    reshade::unregister_event<reshade::addon_event::bind_viewports>(on_bind_viewports);
-    reshade::unregister_event<reshade::addon_event::bind_scissor_rects>(on_bind_scissor_rects);
-    reshade::unregister_event<reshade::addon_event::present>(on_present);
-    reshade::unregister_event<reshade::addon_event::finish_present>(on_finish_present);
-    reshade::unregister_event<reshade::addon_event::set_fullscreen_state>(on_set_fullscreen_state);
-    reshade::unregister_event<reshade::addon_event::destroy_swapchain>(on_destroy_swapchain);
+    using reshade::addon_event;
+    std::lock_guard<std::mutex> lock(registration_mutex_);
+
+    if (registered_events_ & EVENT_INIT_DEVICE)
+        reshade::unregister_event<addon_event::init_device>(on_init_device);
+    if (registered_events_ & EVENT_CREATE_SWAPCHAIN)
+        reshade::unregister_event<addon_event::create_swapchain>(on_create_swapchain);
+    if (registered_events_ & EVENT_INIT_SWAPCHAIN)
+        reshade::unregister_event<addon_event::init_swapchain>(on_init_swapchain);
+    if (registered_events_ & EVENT_BIND_RENDER_TARGETS)
+        reshade::unregister_event<addon_event::bind_render_targets_and_depth_stencil>(on_bind_render_targets_and_depth_stencil);
+    if (registered_events_ & EVENT_BIND_VIEWPORTS)
+        reshade::unregister_event<addon_event::bind_viewports>(on_bind_viewports);
+    if (registered_events_ & EVENT_BIND_SCISSOR_RECTS)
+        reshade::unregister_event<addon_event::bind_scissor_rects>(on_bind_scissor_rects);
+    if (registered_events_ & EVENT_PRESENT)
+        reshade::unregister_event<addon_event::present>(on_present);
+    if (registered_events_ & EVENT_FINISH_PRESENT)
+        reshade::unregister_event<addon_event::finish_present>(on_finish_present);
+    if (registered_events_ & EVENT_SET_FULLSCREEN_STATE)
+        reshade::unregister_event<addon_event::set_fullscreen_state>(on_set_fullscreen_state);
+    if (registered_events_ & EVENT_DESTROY_SWAPCHAIN)
+        reshade::unregister_event<addon_event::destroy_swapchain>(on_destroy_swapchain);
+
+    registered_events_ = 0;
 }
 
 // Static callback wrappers
+namespace
+{
+    using trace_format::EventId;
+    using trace_format::pack;
+
+    uint64_t trace_pointer(const void* pointer)
+    {
+        return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(pointer));
+    }
+
+    uint64_t trace_native(const swapchain* swapchain_ptr)
+    {
+        return swapchain_ptr != nullptr ? swapchain_ptr->get_native() : 0;
+    }
+}
+
+template <typename Func>
+decltype(auto) SwapchainManager::dispatch_policy(Func&& func)
+{
+    return dispatch_hook_policy(get_instance().policy_.load(std::memory_order_acquire), std::forward<Func>(func));
+}
+
 void SwapchainManager::on_init_device(device* device)
 {
+    TraceScope trace(EventId::InitDevice, trace_pointer(device));
     get_instance().handle_init_device(device);
 }
 
 bool SwapchainManager::on_create_swapchain(device_api api, swapchain_desc& desc, void* hwnd)
 {
-    return get_instance().handle_create_swapchain(api, desc, hwnd);
+    TraceScope trace(EventId::CreateSwapchain, static_cast<uint64_t>(api),
+        pack(desc.back_buffer.texture.width, desc.back_buffer.texture.height), trace_pointer(hwnd));
+
+    const bool modified = dispatch_policy([&]<typename Policy>() {
+        return get_instance().handle_create_swapchain<Policy>(api, desc, hwnd);
+    });
+
+    trace.set_arg(3, pack(desc.back_buffer.texture.width, desc.back_buffer.texture.height));
+    trace.set_result(modified);
+    trace.set_outcome(modified ? HookOutcome::Rewritten : HookOutcome::Passed);
+    return modified;
 }
 
 void SwapchainManager::on_init_swapchain(swapchain* swapchain_ptr, bool is_resize)
 {
-    get_instance().handle_init_swapchain(swapchain_ptr, is_resize);
+    TraceScope trace(EventId::InitSwapchain, trace_native(swapchain_ptr), is_resize);
+    dispatch_policy([&]<typename Policy>() { get_instance().handle_init_swapchain<Policy>(swapchain_ptr, is_resize); });
+
+    if (trace.is_active())
+        trace.set_arg(2, get_instance().get_total_proxy_memory());
 }
 
 void SwapchainManager::on_bind_render_targets_and_depth_stencil(command_list* cmd_list, uint32_t count,
                                                                   const resource_view* rtvs, resource_view dsv)
 {
-    get_instance().handle_bind_render_targets(cmd_list, count, rtvs, dsv);
+    TraceScope trace(EventId::BindRenderTargets, trace_pointer(cmd_list), count,
+        (count != 0 && rtvs != nullptr) ? rtvs[0].handle : 0, dsv.handle);
+    trace.set_outcome(get_instance().handle_bind_render_targets(cmd_list, count, rtvs, dsv));
 }
 
 void SwapchainManager::on_bind_viewports(command_list* cmd_list, uint32_t first, uint32_t count,
                                           const viewport* viewports)
 {
-    get_instance().handle_bind_viewports(cmd_list, first, count, viewports);
+    TraceScope trace(EventId::BindViewports, trace_pointer(cmd_list), pack(first, count));
+    if (count != 0 && viewports != nullptr)
+    {
+        trace.set_arg(2, pack(viewports[0].x, viewports[0].y));
+        trace.set_arg(3, pack(viewports[0].width, viewports[0].height));
+    }
+    trace.set_outcome(get_instance().handle_bind_viewports(cmd_list, first, count, viewports));
 }
 
 void SwapchainManager::on_bind_scissor_rects(command_list* cmd_list, uint32_t first, uint32_t count,
                                                const rect* rects)
 {
-    get_instance().handle_bind_scissor_rects(cmd_list, first, count, rects);
+    TraceScope trace(EventId::BindScissorRects, trace_pointer(cmd_list), pack(first, count));
+    if (count != 0 && rects != nullptr)
+    {
+        trace.set_arg(2, pack(rects[0].left, rects[0].top));
+        trace.set_arg(3, pack(rects[0].right, rects[0].bottom));
+    }
+    trace.set_outcome(get_instance().handle_bind_scissor_rects(cmd_list, first, count, rects));
 }
 
 void SwapchainManager::on_present(command_queue* queue, swapchain* swapchain_ptr,
                                    const rect*, const rect*, uint32_t, const rect*)
 {
-    get_instance().handle_present(queue, swapchain_ptr);
+    TraceScope trace(EventId::Present, trace_pointer(queue), trace_native(swapchain_ptr));
+    trace.set_outcome(get_instance().handle_present(queue, swapchain_ptr));
 }
 
 void SwapchainManager::on_finish_present(command_queue* queue, swapchain* swapchain_ptr)
 {
+    TraceScope trace(EventId::FinishPresent, trace_pointer(queue), trace_native(swapchain_ptr));
     get_instance().handle_finish_present(queue, swapchain_ptr);
 }
 
 bool SwapchainManager::on_set_fullscreen_state(swapchain* swapchain_ptr, bool fullscreen, void* hmonitor)
 {
-    return get_instance().handle_set_fullscreen_state(swapchain_ptr, fullscreen, hmonitor);
+    TraceScope trace(EventId::SetFullscreenState, trace_native(swapchain_ptr), fullscreen, trace_pointer(hmonitor));
+
+    const bool blocked = dispatch_policy([&]<typename Policy>() {
+        return get_instance().handle_set_fullscreen_state<Policy>(swapchain_ptr, fullscreen, hmonitor);
+    });
+
+    trace.set_result(blocked);
+    trace.set_outcome(blocked ? HookOutcome::Rewritten : HookOutcome::Passed);
+    return blocked;
 }
 
 void SwapchainManager::on_destroy_swapchain(swapchain* swapchain_ptr, bool is_resize)
 {
+    TraceScope trace(EventId::DestroySwapchain, trace_native(swapchain_ptr), is_resize);
     get_instance().handle_destroy_swapchain(swapchain_ptr, is_resize);
+
+    if (trace.is_active())
+        trace.set_arg(2, get_instance().get_total_proxy_memory());
 }
@@ -7,14 +7,27 @@
 #pragma once
 
 #include "common.h"
+#include "hook_policy.h"
+#include "core/gpu_timer_ring.h"
+#include "core/hook_stats.h"
+#include "core/proxy_fallback.h"
+#include "core/resize_debounce.h"
+#include "core/resolution.h"
+#include "core/swapchain_lifecycle.h"
 
 // Pending swapchain info structure (used to pass data from create to init)
 struct PendingSwapchainInfo
 {
-    uint32_t original_width;
-    uint32_t original_height;
+    WindowHandle hwnd = nullptr;
+    uint32_t original_width = 0;
+    uint32_t original_height = 0;
+    uint64_t generation = 0;  // 0 = free slot
 };
 
+// Swapchains created but not initialized yet. Entries that never see init_swapchain
+// are evicted oldest first, so a failed creation cannot grow the table.
+constexpr size_t MAX_PENDING_SWAPCHAINS = 8;
+
 // Swapchain data structure (per-swapchain resource management)
 struct SwapchainData
 {
@@ -22,21 +35,41 @@ struct SwapchainData
     uint32_t original_height = 0;
     uint32_t actual_width = 0;
     uint32_t actual_height = 0;
-    bool override_active = false;
+    reshade::api::format back_buffer_format = reshade::api::format::unknown;  // Format the copy pipeline renders to
+
+    // While the ResizeDebounce quiet period runs, the proxies keep the size in original_width/height
+    // and are stretched over the resized back buffers. The requested size they get at the rebuild:
+    ResizeDebouncer resize_debounce;
+    uint32_t resized_width = 0;
+    uint32_t resized_height = 0;
+
+    // Lifecycle state, only changed through SwapchainManager::transition()
+    SwapchainState state = SwapchainState::Pending;
+    uint64_t generation = 0;  // Of the create_swapchain call the current back buffers came from
+
+    bool is_override_active() const { return state == SwapchainState::Active; }
 
     std::vector<reshade::api::resource> proxy_textures;
     std::vector<reshade::api::resource_view> proxy_rtvs;
     std::vector<reshade::api::resource_view> proxy_srvs;  // Shader resource views for proxy textures
     std::vector<reshade::api::resource> actual_back_buffers;  // Actual back buffer resources for comparison
+    uint64_t proxy_memory = 0;  // Estimated bytes of all proxy textures
 
     // Pipeline objects for fullscreen draw
     reshade::api::pipeline copy_pipeline = {};
     reshade::api::pipeline_layout copy_pipeline_layout = {};
     reshade::api::sampler copy_sampler = {};
+    reshade::api::filter_mode copy_sampler_filter = reshade::api::filter_mode::min_mag_mip_linear;
+
+    // GPU timestamps around the scale pass in on_present (heap handle 0 = not timed)
+    reshade::api::query_heap timestamp_heap = {};
+    GpuTimerRing scale_pass_timer;
+    uint32_t scale_pass_gpu_ns = 0;  // Most recent scale pass read back from the GPU
 
     reshade::api::device* device_ptr = nullptr;
 
-    // Helper: Find proxy RTV index from actual back buffer resource
+    // Helper: Find proxy RTV index from actual back buffer resource.
+    // With the fewer-proxies fallback several back buffers share one proxy.
     int find_proxy_index(reshade::api::resource actual_resource) const;
 
     ~SwapchainData();
@@ -50,14 +83,40 @@ public:
     // Singleton access
     static SwapchainManager& get_instance();
 
-    // Install/uninstall ReShade event callbacks
+    // Install/uninstall ReShade event callbacks. install() registers the events the configuration
+    // at that time needs, and they stay registered until uninstall(): a reload only switches the policy.
     void install();
     void uninstall();
 
+    // Apply a reloaded configuration, rebuilding only what changed and publishing its hook policy
+    void apply_config_change(const ConfigSnapshot& previous, const ConfigSnapshot& current);
+
     // Cleanup
     void cleanup_all();
 
     // Query methods for overlay/debugging (public, thread-safe)
+    uint64_t get_total_proxy_memory() const;
+
+    // Changes whenever a swapchain is added, rebuilt or removed. Lock-free, so readers can
+    // cache what for_each_swapchain() returned and only take the lock once this moves on.
+    uint64_t get_swapchain_generation() const { return swapchain_generation_.load(std::memory_order_acquire); }
+
+    // Number of times each proxy fallback step was taken since load. Lock-free.
+    uint64_t get_proxy_fallback_count(ProxyFallbackStep step) const
+    {
+        return proxy_fallback_counts_[static_cast<size_t>(step)].load(std::memory_order_relaxed);
+    }
+
+    // GPU time of the most recently measured scale pass of any swapchain in nanoseconds (0 if none). Lock-free.
+    uint32_t get_scale_pass_gpu_ns() const { return scale_pass_gpu_ns_.load(std::memory_order_relaxed); }
+
+    // Resizes that kept the old proxies because of ResizeDebounce, and the rebuilds done once a size was stable. Lock-free.
+    uint64_t get_debounced_resize_count() const { return debounced_resizes_.load(std::memory_order_relaxed); }
+    uint64_t get_debounced_rebuild_count() const { return debounced_rebuilds_.load(std::memory_order_relaxed); }
+
+    // Resizes to the size, format and back buffer count the proxies were built for, which kept them. Lock-free.
+    uint64_t get_avoided_rebuild_count() const { return avoided_rebuilds_.load(std::memory_order_relaxed); }
+
     template<typename Func>
     void for_each_swapchain(Func callback) const
     {
@@ -83,34 +142,63 @@ private:
 
     // Pending swapchain info management (internal)
     void store_pending_info(WindowHandle hwnd, uint32_t width, uint32_t height);
-    bool retrieve_pending_info(WindowHandle hwnd, uint32_t& out_width, uint32_t& out_height);
+    bool retrieve_pending_info(WindowHandle hwnd, PendingSwapchainInfo& out_info);
 
     // Swapchain resource management (internal)
     bool initialize_swapchain(reshade::api::swapchain* swapchain_ptr);
-    void destroy_swapchain(SwapchainNativeHandle swapchain_handle);
+    bool build_proxies(SwapchainData* data, reshade::api::swapchain* swapchain_ptr);
+    bool defer_resize_rebuild(SwapchainData* data, reshade::api::swapchain* swapchain_ptr, const reshade::api::resource_desc& back_buffer_desc);
+    void refresh_back_buffers(SwapchainData* data, reshade::api::swapchain* swapchain_ptr);
+    void finish_debounced_resize(reshade::api::command_queue* queue, reshade::api::swapchain* swapchain_ptr);
+    void begin_resize(SwapchainNativeHandle swapchain_handle);
+    void destroy_swapchain(SwapchainNativeHandle swapchain_handle, WindowHandle hwnd);
+
+    // Move a swapchain to its next lifecycle state, logs and returns false for an invalid event
+    bool transition(SwapchainData* data, SwapchainEvent event);
 
     // Query methods (internal)
     SwapchainData* get_data(SwapchainNativeHandle swapchain_handle);
     SwapchainData* find_active_data_for_device(reshade::api::device* device_ptr);
 
     // High-level event handlers (internal - called by static callback wrappers)
+    // Handlers templated on a HookPolicy are instantiated per feature combination (see hook_policy.h)
     void handle_init_device(reshade::api::device* device);
+    template <typename Policy>
     bool handle_create_swapchain(reshade::api::device_api api, reshade::api::swapchain_desc& desc, void* hwnd);
+    template <typename Policy>
     void handle_init_swapchain(reshade::api::swapchain* swapchain_ptr, bool is_resize);
-    void handle_bind_render_targets(reshade::api::command_list* cmd_list, uint32_t count,
-                                     const reshade::api::resource_view* rtvs, reshade::api::resource_view dsv);
-    void handle_bind_viewports(reshade::api::command_list* cmd_list, uint32_t first, uint32_t count,
-                               const reshade::api::viewport* viewports);
-    void handle_bind_scissor_rects(reshade::api::command_list* cmd_list, uint32_t first, uint32_t count,
-                                    const reshade::api::rect* rects);
-    void handle_present(reshade::api::command_queue* queue, reshade::api::swapchain* swapchain_ptr);
+    HookOutcome handle_bind_render_targets(reshade::api::command_list* cmd_list, uint32_t count,
+                                           const reshade::api::resource_view* rtvs, reshade::api::resource_view dsv);
+    HookOutcome handle_bind_viewports(reshade::api::command_list* cmd_list, uint32_t first, uint32_t count,
+                                      const reshade::api::viewport* viewports);
+    HookOutcome handle_bind_scissor_rects(reshade::api::command_list* cmd_list, uint32_t first, uint32_t count,
+                                          const reshade::api::rect* rects);
+    HookOutcome handle_present(reshade::api::command_queue* queue, reshade::api::swapchain* swapchain_ptr);
     void handle_finish_present(reshade::api::command_queue* queue, reshade::api::swapchain* swapchain_ptr);
+    template <typename Policy>
     bool handle_set_fullscreen_state(reshade::api::swapchain* swapchain_ptr, bool fullscreen, void* hmonitor);
     void handle_destroy_swapchain(reshade::api::swapchain* swapchain_ptr, bool is_resize);
 
+    // Events the configuration needs registered (a mask of RegisteredEvent bits)
+    static uint32_t compute_required_events(const ConfigSnapshot& config);
+
+    // Call func.template operator()<Policy>() with the policy published in policy_
+    template <typename Func>
+    static decltype(auto) dispatch_policy(Func&& func);
+
     // Helper methods
-    bool create_proxy_resources(SwapchainData* data, reshade::api::swapchain* swapchain_ptr);
+    // Resolve ForceSwapchainResolution against the requested size (false = leave the size alone)
+    static bool resolve_forced_size(const ResolutionSpec& spec, bool use_target_monitor, void* hwnd,
+                                    uint32_t requested_width, uint32_t requested_height,
+                                    uint32_t& out_width, uint32_t& out_height);
+    void transition_to_exclusive_fullscreen(reshade::api::swapchain* swapchain_ptr, bool is_resize);
+    bool create_proxy_resources(SwapchainData* data, reshade::api::swapchain* swapchain_ptr,
+                                uint32_t proxy_count, reshade::api::format proxy_format);
+    bool create_proxy_resources_with_fallback(SwapchainData* data, reshade::api::swapchain* swapchain_ptr);
+    void take_proxy_fallback(ProxyFallbackStep step, const std::string& detail);
     bool create_copy_pipeline(SwapchainData* data, reshade::api::format format);
+    bool create_copy_sampler(SwapchainData* data, reshade::api::filter_mode filter);
+    void collect_scale_pass_timing(SwapchainData* data, reshade::api::command_queue* queue);
 
     // ReShade event callback implementations (static wrappers)
     static void on_init_device(reshade::api::device* device);
@@ -129,10 +217,26 @@ private:
     static bool on_set_fullscreen_state(reshade::api::swapchain* swapchain_ptr, bool fullscreen, void* hmonitor);
     static void on_destroy_swapchain(reshade::api::swapchain* swapchain_ptr, bool is_resize);
 
-    // Data storage
-    std::unordered_map<SwapchainNativeHandle, std::unique_ptr<SwapchainData>> swapchain_data_;
+    // Data storage, everything below up to swapchain_generation_ is guarded by swapchain_mutex_
     mutable std::mutex swapchain_mutex_;
-
-    std::unordered_map<WindowHandle, PendingSwapchainInfo> pending_swapchains_;
-    mutable std::mutex pending_mutex_;
+    std::unordered_map<SwapchainNativeHandle, std::unique_ptr<SwapchainData>> swapchain_data_;
+    std::array<PendingSwapchainInfo, MAX_PENDING_SWAPCHAINS> pending_swapchains_ = {};
+    std::unordered_map<WindowHandle, uint32_t> forced_size_halvings_;  // lower-size fallbacks per window, until its swapchain is released
+    uint64_t next_generation_ = 0;  // Last generation handed out by create_swapchain
+    std::atomic<uint64_t> swapchain_generation_ = 0;  // Note: Only advanced while holding swapchain_mutex_
+    std::atomic<uint32_t> scale_pass_gpu_ns_ = 0;
+    std::atomic<uint64_t> debounced_resizes_ = 0;
+    std::atomic<uint64_t> debounced_rebuilds_ = 0;
+    std::atomic<bool> resize_rebuild_pending_ = false;  // Some swapchain may wait for its ResizeDebounce quiet period
+    std::atomic<uint32_t> active_overrides_ = 0;  // Swapchains in the Active state. Note: Only changed while holding swapchain_mutex_
+    std::atomic<uint64_t> avoided_rebuilds_ = 0;
+
+    std::array<std::atomic<uint64_t>, PROXY_FALLBACK_STEP_COUNT> proxy_fallback_counts_ = {};
+
+    // Handler instantiation the callbacks forward to, switched by apply_config_change
+    std::atomic<HookPolicyIndex> policy_ = HookPolicyIndex::Unchanged;
+
+    // Events registered by install(), until uninstall()
+    uint32_t registered_events_ = 0;
+    std::mutex registration_mutex_;
 };
@@ -0,0 +1,315 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "trace_recorder.h"
+#include "config.h"
+#include <cstring>
+#include <filesystem>
+
+namespace
+{
+    // Per-thread pointer into TraceRecorder::blocks_, tagged with the recording session it belongs to
+    thread_local void* t_trace_block = nullptr;
+    thread_local uint32_t t_trace_session = 0;
+
+    std::atomic<uint32_t> g_trace_session = 0;
+}
+
+uint64_t TraceRecorder::timestamp()
+{
+    LARGE_INTEGER counter;
+    QueryPerformanceCounter(&counter);
+    return static_cast<uint64_t>(counter.QuadPart);
+}
+
+TraceRecorder& TraceRecorder::get_instance()
+{
+    static TraceRecorder instance;
+    return instance;
+}
+
+void TraceRecorder::install()
+{
+    const std::string& trace_file = Config::get_instance().snapshot().get_trace_file();
+    if (trace_file.empty())
+        return;
+
+    std::lock_guard<std::mutex> lock(file_mutex_);
+
+    // Relative paths are resolved against the executable directory, like ProfileDatabase
+    std::filesystem::path path(reinterpret_cast<const char8_t*>(trace_file.c_str()));
+    if (path.is_relative())
+    {
+        wchar_t module_path[MAX_PATH] = {};
+        const DWORD length = GetModuleFileNameW(nullptr, module_path, MAX_PATH);
+        if (length == 0 || length == MAX_PATH)
+            return;
+        path = std::filesystem::path(module_path).parent_path() / path;
+    }
+
+    file_ = CreateFileW(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file_ == INVALID_HANDLE_VALUE)
+    {
+        reshade::log::message(reshade::log::level::warning, ("Failed to open trace file " + path.string()).c_str());
+        return;
+    }
+
+    LARGE_INTEGER frequency;
+    QueryPerformanceFrequency(&frequency);
+
+    trace_format::Header header = {};
+    header.magic = trace_format::MAGIC;
+    header.version = trace_format::VERSION;
+    header.record_size = sizeof(trace_format::Record);
+    header.process_id = GetCurrentProcessId();
+    header.ticks_per_second = static_cast<uint64_t>(frequency.QuadPart);
+    header.start_timestamp = timestamp();
+
+    DWORD bytes_written = 0;
+    if (!WriteFile(file_, &header, sizeof(header), &bytes_written, nullptr) || bytes_written != sizeof(header))
+    {
+        CloseHandle(file_);
+        file_ = INVALID_HANDLE_VALUE;
+        reshade::log::message(reshade::log::level::warning, ("Failed to write trace file " + path.string()).c_str());
+        return;
+    }
+
+    // Full blocks are written on the thread pool, hook threads only queue them
+    blocks_event_ = CreateEventW(nullptr, FALSE, FALSE, nullptr);
+    if (blocks_event_ == nullptr ||
+        !RegisterWaitForSingleObject(&wait_handle_, blocks_event_, on_blocks_available, this, INFINITE, WT_EXECUTEDEFAULT))
+    {
+        if (blocks_event_ != nullptr)
+            CloseHandle(blocks_event_);
+        blocks_event_ = nullptr;
+        wait_handle_ = nullptr;
+        CloseHandle(file_);
+        file_ = INVALID_HANDLE_VALUE;
+        reshade::log::message(reshade::log::level::warning, "Failed to start the trace writer");
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> block_lock(block_mutex_);
+        for (size_t i = 0; i < INITIAL_BLOCKS; ++i)
+        {
+            blocks_.push_back(std::make_unique<Block>());
+            free_blocks_.push_back(blocks_.back().get());
+        }
+    }
+
+    records_written_ = 0;
+    dropped_records_.store(0, std::memory_order_relaxed);
+    signal_pending_.store(false, std::memory_order_relaxed);
+    g_trace_session.fetch_add(1, std::memory_order_relaxed);
+    recording_.store(true, std::memory_order_release);
+
+    reshade::log::message(reshade::log::level::info, ("Recording event trace to " + path.string()).c_str());
+}
+
+void TraceRecorder::uninstall(bool process_terminating)
+{
+    if (!recording_.exchange(false, std::memory_order_acq_rel))
+        return;
+
+    if (process_terminating)
+    {
+        // The writer thread is gone and the loader lock is held, nothing may wait for the thread pool.
+        // A write cut off at process exit keeps file_mutex_ locked, the file then ends with what it wrote.
+        std::unique_lock<std::mutex> lock(file_mutex_, std::try_to_lock);
+        if (lock.owns_lock())
+            close_file();
+        return;
+    }
+
+    if (wait_handle_ != nullptr)
+    {
+        // Blocks until a running write has finished
+        UnregisterWaitEx(wait_handle_, INVALID_HANDLE_VALUE);
+        wait_handle_ = nullptr;
+    }
+
+    if (blocks_event_ != nullptr)
+    {
+        CloseHandle(blocks_event_);
+        blocks_event_ = nullptr;
+    }
+
+    // Note: Hooks and callbacks are removed before this runs, no thread appends anymore
+    write_blocks();
+
+    std::lock_guard<std::mutex> lock(file_mutex_);
+    close_file();
+}
+
+void TraceRecorder::close_file()
+{
+    // Note: Caller must hold file_mutex_
+    {
+        // Only held by a hook thread that was terminated in a pointer swap at process exit, its blocks are lost then
+        std::unique_lock<std::mutex> block_lock(block_mutex_, std::try_to_lock);
+        if (block_lock.owns_lock())
+        {
+            // Queued blocks the writer did not take before the process exit, then the partially filled
+            // blocks the threads were appending to
+            for (Block* block : full_blocks_)
+                write_block(*block);
+            for (const std::unique_ptr<Block>& block : blocks_)
+                write_block(*block);
+
+            blocks_.clear();
+            free_blocks_.clear();
+            full_blocks_.clear();
+        }
+    }
+
+    CloseHandle(file_);
+    file_ = INVALID_HANDLE_VALUE;
+
+    std::string message = "Event trace closed (" + std::to_string(records_written_) + " records";
+    const uint64_t dropped = dropped_records_.load(std::memory_order_relaxed);
+    if (dropped != 0)
+        message += ", " + std::to_string(dropped) + " dropped because the writer fell behind";
+    reshade::log::message(reshade::log::level::info, (message + ")").c_str());
+}
+
+void TraceRecorder::record(trace_format::EventId event, uint16_t result, HookOutcome outcome, uint64_t start_timestamp, const uint64_t (&args)[4])
+{
+    if (!recording_.load(std::memory_order_relaxed))
+        return;
+
+    const uint64_t duration = timestamp() - start_timestamp;
+
+    Block* block = get_thread_block();
+    if (block == nullptr)
+    {
+        dropped_records_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    trace_format::Record& record = block->records[block->count];
+    record.timestamp = start_timestamp;
+    record.duration = static_cast<uint32_t>(std::min<uint64_t>(duration, UINT32_MAX));
+    record.thread_id = block->thread_id;
+    record.event = event;
+    record.result = result;
+    record.outcome = static_cast<uint8_t>(outcome);
+    std::memset(record.reserved, 0, sizeof(record.reserved));
+    std::memcpy(record.args, args, sizeof(record.args));
+
+    if (++block->count == RECORDS_PER_BLOCK)
+    {
+        // The next record takes a fresh block
+        submit_block(block);
+        t_trace_block = nullptr;
+    }
+}
+
+TraceRecorder::Block* TraceRecorder::get_thread_block()
+{
+    const uint32_t session = g_trace_session.load(std::memory_order_relaxed);
+    if (t_trace_block != nullptr && t_trace_session == session)
+        return static_cast<Block*>(t_trace_block);
+
+    Block* block = acquire_block();
+    if (block == nullptr)
+        return nullptr;
+
+    block->thread_id = GetCurrentThreadId();
+    t_trace_block = block;
+    t_trace_session = session;
+    return block;
+}
+
+TraceRecorder::Block* TraceRecorder::acquire_block()
+{
+    {
+        std::lock_guard<std::mutex> lock(block_mutex_);
+        if (!recording_.load(std::memory_order_relaxed))
+            return nullptr;
+
+        if (!free_blocks_.empty())
+        {
+            Block* block = free_blocks_.back();
+            free_blocks_.pop_back();
+            return block;
+        }
+
+        if (blocks_.size() >= MAX_BLOCKS)
+            return nullptr;
+    }
+
+    // The writer is behind, add a block (allocated outside the lock)
+    auto block = std::make_unique<Block>();
+
+    std::lock_guard<std::mutex> lock(block_mutex_);
+    if (!recording_.load(std::memory_order_relaxed) || blocks_.size() >= MAX_BLOCKS)
+        return nullptr;
+
+    blocks_.push_back(std::move(block));
+    return blocks_.back().get();
+}
+
+void TraceRecorder::submit_block(Block* block)
+{
+    {
+        std::lock_guard<std::mutex> lock(block_mutex_);
+        full_blocks_.push_back(block);
+    }
+
+    // One SetEvent per burst, the writer clears the flag before it writes
+    if (!signal_pending_.exchange(true, std::memory_order_acq_rel))
+        SetEvent(blocks_event_);
+}
+
+void TraceRecorder::write_blocks()
+{
+    std::lock_guard<std::mutex> lock(file_mutex_);
+
+    std::vector<Block*> batch;
+    for (;;)
+    {
+        {
+            std::lock_guard<std::mutex> block_lock(block_mutex_);
+
+            // Blocks written by the previous pass go back to the free list
+            free_blocks_.insert(free_blocks_.end(), batch.begin(), batch.end());
+            batch.clear();
+            batch.swap(full_blocks_);
+        }
+
+        if (batch.empty())
+            break;
+
+        // File I/O happens without block_mutex_, hook threads keep swapping blocks meanwhile
+        for (Block* block : batch)
+            write_block(*block);
+    }
+}
+
+void TraceRecorder::write_block(Block& block)
+{
+    // Note: Caller must hold file_mutex_
+    if (block.count == 0 || file_ == INVALID_HANDLE_VALUE)
+        return;
+
+    const DWORD size = static_cast<DWORD>(block.count * sizeof(trace_format::Record));
+    DWORD bytes_written = 0;
+    if (WriteFile(file_, block.records.data(), size, &bytes_written, nullptr) && bytes_written == size)
+        records_written_ += block.count;
+
+    block.count = 0;
+}
+
+void CALLBACK TraceRecorder::on_blocks_available(PVOID context, BOOLEAN timed_out)
+{
+    auto* recorder = static_cast<TraceRecorder*>(context);
+
+    // Clear first, a block queued during the write signals again
+    recorder->signal_pending_.store(false, std::memory_order_release);
+    if (!timed_out)
+        recorder->write_blocks();
+}
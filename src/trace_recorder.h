@@ -0,0 +1,141 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include "common.h"
+#include "core/trace_format.h"
+#include "flight_recorder.h"
+#include "hook_probe.h"
+#include <array>
+
+// Records every hook the addon sees into a binary trace file (see core/trace_format.h).
+// Each thread appends to its own block without locking. A full block is handed to a thread pool
+// writer and swapped for an empty one from the free list, so the hook thread never waits on the
+// file: the cost per event is two timestamps and a 56-byte copy, plus a pointer swap per block.
+class TraceRecorder
+{
+public:
+    // Singleton access
+    static TraceRecorder& get_instance();
+
+    // Open the trace file configured by TraceFile (does nothing when it is empty)
+    void install();
+
+    // Write all pending records and close the file. At process exit (process_terminating) the
+    // writer is not waited for, what it has not taken yet is written directly.
+    void uninstall(bool process_terminating = false);
+
+    // Append an event that started at start_timestamp and ends now to the calling thread's buffer
+    void record(trace_format::EventId event, uint16_t result, HookOutcome outcome, uint64_t start_timestamp, const uint64_t (&args)[4]);
+
+    bool is_recording() const { return recording_.load(std::memory_order_relaxed); }
+
+    // Records dropped because no free block was left, since install
+    uint64_t get_dropped_records() const { return dropped_records_.load(std::memory_order_relaxed); }
+
+    // High-resolution timestamp in trace ticks
+    static uint64_t timestamp();
+
+    static constexpr size_t RECORDS_PER_BLOCK = 2048;
+    static constexpr size_t INITIAL_BLOCKS = 8;
+    static constexpr size_t MAX_BLOCKS = 64;  // 7 MB, records are dropped when the writer falls further behind
+
+private:
+    TraceRecorder() = default;
+    ~TraceRecorder() = default;
+
+    // Delete copy/move constructors
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+    TraceRecorder(TraceRecorder&&) = delete;
+    TraceRecorder& operator=(TraceRecorder&&) = delete;
+
+    struct Block
+    {
+        uint32_t thread_id = 0;
+        uint32_t count = 0;
+        std::array<trace_format::Record, RECORDS_PER_BLOCK> records;
+    };
+
+    // Block the calling thread appends to, nullptr if none is free
+    Block* get_thread_block();
+
+    // Take a block from the free list, allocating one while below MAX_BLOCKS
+    Block* acquire_block();
+
+    // Queue a full block for the writer
+    void submit_block(Block* block);
+
+    // Write the queued blocks and return them to the free list
+    void write_blocks();
+    void write_block(Block& block);
+
+    // Write every block still holding records and close the file
+    void close_file();
+
+    // Thread pool callback, signaled when blocks were queued
+    static void CALLBACK on_blocks_available(PVOID context, BOOLEAN timed_out);
+
+    std::atomic<bool> recording_ = false;
+    HANDLE file_ = INVALID_HANDLE_VALUE;
+    std::mutex file_mutex_;  // Protects file_, held by the writer only
+    uint64_t records_written_ = 0;
+
+    std::vector<std::unique_ptr<Block>> blocks_;  // Every block of the session, freed on uninstall
+    std::vector<Block*> free_blocks_;
+    std::vector<Block*> full_blocks_;             // In submission order
+    std::mutex block_mutex_;                      // Protects the three lists above, only held for pointer swaps
+
+    std::atomic<uint64_t> dropped_records_ = 0;
+    std::atomic<bool> signal_pending_ = false;
+    HANDLE blocks_event_ = nullptr;
+    HANDLE wait_handle_ = nullptr;
+};
+
+// Records one hook invocation, from construction to destruction: always into the HookProbe
+// counters and the crash flight recorder, and into the trace file if tracing is enabled
+class TraceScope
+{
+public:
+    explicit TraceScope(trace_format::EventId event, uint64_t arg0 = 0, uint64_t arg1 = 0, uint64_t arg2 = 0, uint64_t arg3 = 0)
+        : active_(TraceRecorder::get_instance().is_recording()), event_(event), args_{ arg0, arg1, arg2, arg3 }
+    {
+        if (active_)
+            start_timestamp_ = TraceRecorder::timestamp();
+        start_ticks_ = HookProbe::ticks();
+    }
+
+    ~TraceScope()
+    {
+        const uint64_t end_ticks = HookProbe::ticks();
+        HookProbe::get_instance().record(event_, outcome_, end_ticks - start_ticks_);
+        FlightRecorder::get_instance().record(event_, result_, outcome_, start_ticks_, end_ticks, args_);
+        if (active_)
+            TraceRecorder::get_instance().record(event_, result_, outcome_, start_timestamp_, args_);
+    }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+    bool is_active() const { return active_; }
+
+    // Event specific outcome, see trace_format::EventId
+    void set_result(uint16_t result) { result_ = result; }
+    void set_arg(size_t index, uint64_t value) { args_[index] = value; }
+
+    // Counted in the hook statistics, Passed unless set
+    void set_outcome(HookOutcome outcome) { outcome_ = outcome; }
+
+private:
+    bool active_;
+    trace_format::EventId event_;
+    HookOutcome outcome_ = HookOutcome::Passed;
+    uint16_t result_ = 0;
+    uint64_t start_ticks_ = 0;
+    uint64_t start_timestamp_ = 0;
+    uint64_t args_[4];
+};
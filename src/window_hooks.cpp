@@ -6,6 +6,227 @@
 
 #include "window_hooks.h"
 #include "debug_logger.h"
+#include "hook_policy.h"
+#include "trace_recorder.h"
+#include <cstdio>
+
+namespace
+{
+    // The window hooks only act in borderless mode, so the resolution override is irrelevant here
+    using BorderlessHookPolicy = HookPolicy<false, false, FullscreenMode::Borderless>;
+    using PassthroughHookPolicy = HookPolicy<false, false, FullscreenMode::Unchanged>;
+
+    using trace_format::EventId;
+    using trace_format::pack;
+
+    uint64_t trace_handle(HWND hwnd)
+    {
+        return static_cast<uint64_t>(reinterpret_cast<uintptr_t>(hwnd));
+    }
+
+    // Debug mode details. The hooks only copy their arguments into these, the text is built on the log consumer.
+
+    void append_hex(std::string& out, uint64_t value)
+    {
+        char text[24];
+        snprintf(text, sizeof(text), "0x%llX", static_cast<unsigned long long>(value));
+        out += text;
+    }
+
+    void append_rect(std::string& out, const RECT& rect)
+    {
+        char text[64];
+        snprintf(text, sizeof(text), "(%ld, %ld)-(%ld, %ld)", static_cast<long>(rect.left), static_cast<long>(rect.top),
+            static_cast<long>(rect.right), static_cast<long>(rect.bottom));
+        out += text;
+    }
+
+    template <typename Char>
+    struct CreateWindowArgs
+    {
+        static constexpr size_t TITLE_LENGTH = 96;
+
+        Char title[TITLE_LENGTH];  // Cut at TITLE_LENGTH - 1 characters
+        bool has_title;
+        DWORD style;
+        DWORD ex_style;
+        int x;
+        int y;
+        int width;
+        int height;
+
+        CreateWindowArgs() = default;
+        CreateWindowArgs(const Char* window_name, DWORD style_, DWORD ex_style_, int x_, int y_, int width_, int height_)
+            : title(), has_title(window_name != nullptr), style(style_), ex_style(ex_style_), x(x_), y(y_), width(width_), height(height_)
+        {
+            for (size_t i = 0; has_title && i < TITLE_LENGTH - 1 && window_name[i] != 0; ++i)
+                title[i] = window_name[i];
+        }
+
+        static void format(const CreateWindowArgs& args, std::string& out)
+        {
+            const DebugLogger& logger = DebugLogger::get_instance();
+
+            out += "  Window Title: ";
+            if (!args.has_title)
+            {
+                out += "(null)";
+            }
+            else if constexpr (std::is_same_v<Char, wchar_t>)
+            {
+                char utf8_title[TITLE_LENGTH * 4] = {};
+                WideCharToMultiByte(CP_UTF8, 0, args.title, -1, utf8_title, sizeof(utf8_title), nullptr, nullptr);
+                out += utf8_title;
+            }
+            else
+            {
+                out += args.title;
+            }
+
+            char flags_text[decode::TEXT_BUFFER_SIZE];
+            out += "\n  Style: ";
+            out += logger.decode_window_style(args.style, flags_text);
+            out += "\n  Ex Style: ";
+            out += logger.decode_window_ex_style(args.ex_style, flags_text);
+            out += "\n  Position: (" + std::to_string(args.x) + ", " + std::to_string(args.y) + ")";
+            out += "\n  Size: " + std::to_string(args.width) + "x" + std::to_string(args.height);
+        }
+    };
+
+    struct WindowResultArgs
+    {
+        uint64_t hwnd;
+
+        static void format(const WindowResultArgs& args, std::string& out)
+        {
+            out += "  Result HWND: ";
+            append_hex(out, args.hwnd);
+        }
+    };
+
+    struct SetWindowLongArgs
+    {
+        uint64_t hwnd;
+        int index;
+        uint64_t value;  // Bits of the LONG or LONG_PTR argument
+
+        static void format(const SetWindowLongArgs& args, std::string& out)
+        {
+            const DebugLogger& logger = DebugLogger::get_instance();
+            char flags_text[decode::TEXT_BUFFER_SIZE];
+
+            out += "  HWND: ";
+            append_hex(out, args.hwnd);
+            out += "\n  Index: " + std::to_string(args.index);
+            if (args.index == GWL_STYLE)
+            {
+                out += " (GWL_STYLE)\n  New Style: ";
+                out += logger.decode_window_style(static_cast<DWORD>(args.value), flags_text);
+            }
+            else if (args.index == GWL_EXSTYLE)
+            {
+                out += " (GWL_EXSTYLE)\n  New Ex Style: ";
+                out += logger.decode_window_ex_style(static_cast<DWORD>(args.value), flags_text);
+            }
+            else
+            {
+                out += "\n  New Value: ";
+                append_hex(out, args.value);
+            }
+        }
+    };
+
+    struct PreviousValueArgs
+    {
+        uint64_t value;
+
+        static void format(const PreviousValueArgs& args, std::string& out)
+        {
+            out += "  Previous Value: ";
+            append_hex(out, args.value);
+        }
+    };
+
+    // Bits of a LONG or LONG_PTR as printed in hex
+    template <typename T>
+    uint64_t value_bits(T value)
+    {
+        return static_cast<uint64_t>(static_cast<std::make_unsigned_t<T>>(value));
+    }
+
+    struct SetWindowPosArgs
+    {
+        uint64_t hwnd;
+        int x;
+        int y;
+        int cx;
+        int cy;
+        UINT flags;
+
+        static void format(const SetWindowPosArgs& args, std::string& out)
+        {
+            char flags_text[decode::TEXT_BUFFER_SIZE];
+            out += "  HWND: ";
+            append_hex(out, args.hwnd);
+            out += "\n  Position: (" + std::to_string(args.x) + ", " + std::to_string(args.y) + ")";
+            out += "\n  Size: " + std::to_string(args.cx) + "x" + std::to_string(args.cy);
+            out += "\n  Flags: ";
+            out += DebugLogger::get_instance().decode_set_window_pos_flags(args.flags, flags_text);
+        }
+    };
+
+    struct AdjustWindowRectArgs
+    {
+        RECT rect;
+        bool has_rect;
+        bool has_ex_style;  // AdjustWindowRectEx
+        DWORD style;
+        DWORD ex_style;
+        BOOL menu;
+
+        static void format(const AdjustWindowRectArgs& args, std::string& out)
+        {
+            const DebugLogger& logger = DebugLogger::get_instance();
+            char flags_text[decode::TEXT_BUFFER_SIZE];
+
+            out += "  Input Rect: ";
+            if (args.has_rect)
+                append_rect(out, args.rect);
+            else
+                out += "(null)";
+            out += "\n  Style: ";
+            out += logger.decode_window_style(args.style, flags_text);
+            if (args.has_ex_style)
+            {
+                out += "\n  Ex Style: ";
+                out += logger.decode_window_ex_style(args.ex_style, flags_text);
+            }
+            out += args.menu ? "\n  Has Menu: Yes" : "\n  Has Menu: No";
+        }
+    };
+
+    struct AdjustWindowRectResultArgs
+    {
+        RECT rect;
+        bool has_rect;
+        BOOL result;
+
+        static void format(const AdjustWindowRectResultArgs& args, std::string& out)
+        {
+            out += args.result ? "  Result: TRUE" : "  Result: FALSE";
+            if (args.has_rect && args.result)
+            {
+                out += "\n  Output Rect: ";
+                append_rect(out, args.rect);
+            }
+        }
+    };
+
+    SafetyHookInline create_disabled_hook(void* target, void* destination)
+    {
+        return safetyhook::create_inline(target, destination, SafetyHookInline::StartDisabled);
+    }
+}
 
 WindowHooks& WindowHooks::get_instance()
 {
@@ -28,8 +249,46 @@ bool WindowHooks::install()
         return true;
     }
 
+    return apply_config(Config::get_instance().snapshot());
+}
+
+void WindowHooks::refresh()
+{
+    std::lock_guard<std::mutex> lock(hook_state_mutex_);
+
+    // Nothing to do until the addon installed the hooks at least once
+    if (addon_instance_count_ == 0)
+        return;
+
+    apply_config(Config::get_instance().snapshot());
+}
+
+WindowHooks::HookMode WindowHooks::mode_for_config(const ConfigSnapshot& config)
+{
+    if (!config.is_borderless_fullscreen_enabled())
+        return HookMode::Passthrough;
+
+    // Debug mode only observes window changes
+    return config.is_debug_mode_enabled() ? HookMode::Debug : HookMode::Borderless;
+}
+
+bool WindowHooks::apply_config(const ConfigSnapshot& config)
+{
+    // Note: Caller must hold hook_state_mutex_
+
+    const HookMode mode = mode_for_config(config);
+    mode_.store(mode, std::memory_order_release);
+
+    // Once installed the hooks stay, a mode without overrides just forwards every call
+    if (hooks_installed_)
+    {
+        reshade::log::message(reshade::log::level::info,
+            mode == HookMode::Passthrough ? "WinAPI hooks switched to pass-through" : "WinAPI hooks switched to borderless fullscreen mode");
+        return true;
+    }
+
     // Only install hooks if borderless mode is enabled
-    if (!Config::get_instance().is_borderless_fullscreen_enabled())
+    if (mode == HookMode::Passthrough)
     {
         reshade::log::message(reshade::log::level::info, "Borderless mode not enabled, skipping WinAPI hooks");
         return true; // No hooks needed if not in borderless mode
@@ -37,28 +296,7 @@ bool WindowHooks::install()
 
     reshade::log::message(reshade::log::level::info, "Installing WinAPI hooks for borderless fullscreen mode...");
 
-    create_window_ex_a_hook_ = safetyhook::create_inline(reinterpret_cast<void*>(CreateWindowExA), reinterpret_cast<void*>(hooked_CreateWindowExA));
-    create_window_ex_w_hook_ = safetyhook::create_inline(reinterpret_cast<void*>(CreateWindowExW), reinterpret_cast<void*>(hooked_CreateWindowExW));
-    set_window_long_a_hook_ = safetyhook::create_inline(reinterpret_cast<void*>(SetWindowLongA), reinterpret_cast<void*>(hooked_SetWindowLongA));
-    set_window_long_w_hook_ = safetyhook::create_inline(reinterpret_cast<void*>(SetWindowLongW), reinterpret_cast<void*>(hooked_SetWindowLongW));
-#ifdef _WIN64
-    set_window_long_ptr_a_hook_ = safetyhook::create_inline(reinterpret_cast<void*>(SetWindowLongPtrA), reinterpret_cast<void*>(hooked_SetWindowLongPtrA));
-    set_window_long_ptr_w_hook_ = safetyhook::create_inline(reinterpret_cast<void*>(SetWindowLongPtrW), reinterpret_cast<void*>(hooked_SetWindowLongPtrW));
-#endif
-    set_window_pos_hook_ = safetyhook::create_inline(reinterpret_cast<void*>(SetWindowPos), reinterpret_cast<void*>(hooked_SetWindowPos));
-    adjust_window_rect_hook_ = safetyhook::create_inline(reinterpret_cast<void*>(AdjustWindowRect), reinterpret_cast<void*>(hooked_AdjustWindowRect));
-    adjust_window_rect_ex_hook_ = safetyhook::create_inline(reinterpret_cast<void*>(AdjustWindowRectEx), reinterpret_cast<void*>(hooked_AdjustWindowRectEx));
-
-    bool all_hooks_valid = create_window_ex_a_hook_ && create_window_ex_w_hook_ &&
-                           set_window_long_a_hook_ && set_window_long_w_hook_ &&
-                           set_window_pos_hook_ &&
-                           adjust_window_rect_hook_ && adjust_window_rect_ex_hook_;
-
-#ifdef _WIN64
-    all_hooks_valid = all_hooks_valid && set_window_long_ptr_a_hook_ && set_window_long_ptr_w_hook_;
-#endif
-
-    if (all_hooks_valid)
+    if (install_hooks())
     {
         hooks_installed_ = true;
         reshade::log::message(reshade::log::level::info, "WinAPI hooks installed successfully");
@@ -71,6 +309,115 @@ bool WindowHooks::install()
     }
 }
 
+bool WindowHooks::install_hooks()
+{
+    // Note: Caller must hold hook_state_mutex_
+
+    // Created disabled: a detour that runs before its trampoline is stored in the member would call through an empty hook
+    create_window_ex_a_hook_ = create_disabled_hook(reinterpret_cast<void*>(CreateWindowExA), reinterpret_cast<void*>(detour_CreateWindowExA));
+    create_window_ex_w_hook_ = create_disabled_hook(reinterpret_cast<void*>(CreateWindowExW), reinterpret_cast<void*>(detour_CreateWindowExW));
+    set_window_long_a_hook_ = create_disabled_hook(reinterpret_cast<void*>(SetWindowLongA), reinterpret_cast<void*>(detour_SetWindowLongA));
+    set_window_long_w_hook_ = create_disabled_hook(reinterpret_cast<void*>(SetWindowLongW), reinterpret_cast<void*>(detour_SetWindowLongW));
+#ifdef _WIN64
+    set_window_long_ptr_a_hook_ = create_disabled_hook(reinterpret_cast<void*>(SetWindowLongPtrA), reinterpret_cast<void*>(detour_SetWindowLongPtrA));
+    set_window_long_ptr_w_hook_ = create_disabled_hook(reinterpret_cast<void*>(SetWindowLongPtrW), reinterpret_cast<void*>(detour_SetWindowLongPtrW));
+#endif
+    set_window_pos_hook_ = create_disabled_hook(reinterpret_cast<void*>(SetWindowPos), reinterpret_cast<void*>(detour_SetWindowPos));
+    adjust_window_rect_hook_ = create_disabled_hook(reinterpret_cast<void*>(AdjustWindowRect), reinterpret_cast<void*>(detour_AdjustWindowRect));
+    adjust_window_rect_ex_hook_ = create_disabled_hook(reinterpret_cast<void*>(AdjustWindowRectEx), reinterpret_cast<void*>(detour_AdjustWindowRectEx));
+
+    SafetyHookInline* const hooks[] = {
+        &create_window_ex_a_hook_, &create_window_ex_w_hook_,
+        &set_window_long_a_hook_, &set_window_long_w_hook_,
+#ifdef _WIN64
+        &set_window_long_ptr_a_hook_, &set_window_long_ptr_w_hook_,
+#endif
+        &set_window_pos_hook_, &adjust_window_rect_hook_, &adjust_window_rect_ex_hook_
+    };
+
+    bool all_hooks_valid = true;
+    for (SafetyHookInline* hook : hooks)
+        all_hooks_valid = all_hooks_valid && *hook;
+
+    for (SafetyHookInline* hook : hooks)
+    {
+        if (!all_hooks_valid || !hook->enable())
+        {
+            // All or nothing, a partial set would rewrite some window calls and not others
+            remove_hooks();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <typename Func>
+decltype(auto) WindowHooks::dispatch_mode(Func&& func)
+{
+    switch (get_instance().mode_.load(std::memory_order_acquire))
+    {
+    case HookMode::Debug:
+        return func.template operator()<DebugHookPolicy>();
+    case HookMode::Borderless:
+        return func.template operator()<BorderlessHookPolicy>();
+    case HookMode::Passthrough:
+    default:
+        return func.template operator()<PassthroughHookPolicy>();
+    }
+}
+
+HWND WINAPI WindowHooks::detour_CreateWindowExA(DWORD dwExStyle, LPCSTR lpClassName, LPCSTR lpWindowName, DWORD dwStyle, int X, int Y, int nWidth, int nHeight, HWND hWndParent, HMENU hMenu, HINSTANCE hInstance, LPVOID lpParam)
+{
+    return dispatch_mode([&]<typename Policy>() {
+        return hooked_CreateWindowExA<Policy>(dwExStyle, lpClassName, lpWindowName, dwStyle, X, Y, nWidth, nHeight, hWndParent, hMenu, hInstance, lpParam);
+    });
+}
+
+HWND WINAPI WindowHooks::detour_CreateWindowExW(DWORD dwExStyle, LPCWSTR lpClassName, LPCWSTR lpWindowName, DWORD dwStyle, int X, int Y, int nWidth, int nHeight, HWND hWndParent, HMENU hMenu, HINSTANCE hInstance, LPVOID lpParam)
+{
+    return dispatch_mode([&]<typename Policy>() {
+        return hooked_CreateWindowExW<Policy>(dwExStyle, lpClassName, lpWindowName, dwStyle, X, Y, nWidth, nHeight, hWndParent, hMenu, hInstance, lpParam);
+    });
+}
+
+LONG WINAPI WindowHooks::detour_SetWindowLongA(HWND hWnd, int nIndex, LONG dwNewLong)
+{
+    return dispatch_mode([&]<typename Policy>() { return hooked_SetWindowLongA<Policy>(hWnd, nIndex, dwNewLong); });
+}
+
+LONG WINAPI WindowHooks::detour_SetWindowLongW(HWND hWnd, int nIndex, LONG dwNewLong)
+{
+    return dispatch_mode([&]<typename Policy>() { return hooked_SetWindowLongW<Policy>(hWnd, nIndex, dwNewLong); });
+}
+
+#ifdef _WIN64
+LONG_PTR WINAPI WindowHooks::detour_SetWindowLongPtrA(HWND hWnd, int nIndex, LONG_PTR dwNewLong)
+{
+    return dispatch_mode([&]<typename Policy>() { return hooked_SetWindowLongPtrA<Policy>(hWnd, nIndex, dwNewLong); });
+}
+
+LONG_PTR WINAPI WindowHooks::detour_SetWindowLongPtrW(HWND hWnd, int nIndex, LONG_PTR dwNewLong)
+{
+    return dispatch_mode([&]<typename Policy>() { return hooked_SetWindowLongPtrW<Policy>(hWnd, nIndex, dwNewLong); });
+}
+#endif
+
+BOOL WINAPI WindowHooks::detour_SetWindowPos(HWND hWnd, HWND hWndInsertAfter, int X, int Y, int cx, int cy, UINT uFlags)
+{
+    return dispatch_mode([&]<typename Policy>() { return hooked_SetWindowPos<Policy>(hWnd, hWndInsertAfter, X, Y, cx, cy, uFlags); });
+}
+
+BOOL WINAPI WindowHooks::detour_AdjustWindowRect(LPRECT lpRect, DWORD dwStyle, BOOL bMenu)
+{
+    return dispatch_mode([&]<typename Policy>() { return hooked_AdjustWindowRect<Policy>(lpRect, dwStyle, bMenu); });
+}
+
+BOOL WINAPI WindowHooks::detour_AdjustWindowRectEx(LPRECT lpRect, DWORD dwStyle, BOOL bMenu, DWORD dwExStyle)
+{
+    return dispatch_mode([&]<typename Policy>() { return hooked_AdjustWindowRectEx<Policy>(lpRect, dwStyle, bMenu, dwExStyle); });
+}
+
 void WindowHooks::uninstall()
 {
     std::lock_guard<std::mutex> lock(hook_state_mutex_);
@@ -89,6 +436,8 @@ void WindowHooks::uninstall()
         return;
     }
 
+    mode_.store(HookMode::Passthrough, std::memory_order_release);
+
     // No more instances, uninstall hooks if they were installed
     if (!hooks_installed_)
     {
@@ -98,6 +447,16 @@ void WindowHooks::uninstall()
 
     reshade::log::message(reshade::log::level::info, "Uninstalling WinAPI hooks (last instance destroyed)...");
 
+    remove_hooks();
+
+    reshade::log::message(reshade::log::level::info, "WinAPI hooks uninstalled");
+}
+
+void WindowHooks::remove_hooks()
+{
+    // Note: Caller must hold hook_state_mutex_
+    // Only called when the last instance uninstalls (the addon is unloading) or a failed install is rolled back
+
     // SafetyHook uses RAII, just reset the hooks
     create_window_ex_a_hook_ = {};
     create_window_ex_w_hook_ = {};
@@ -112,8 +471,6 @@ void WindowHooks::uninstall()
     adjust_window_rect_ex_hook_ = {};
 
     hooks_installed_ = false;
-
-    reshade::log::message(reshade::log::level::info, "WinAPI hooks uninstalled");
 }
 
 BOOL CALLBACK WindowHooks::MonitorEnumProc(HMONITOR hMonitor, HDC hdcMonitor, LPRECT lprcMonitor, LPARAM dwData)
@@ -131,7 +488,7 @@ BOOL CALLBACK WindowHooks::MonitorEnumProc(HMONITOR hMonitor, HDC hdcMonitor, LP
 bool WindowHooks::get_target_monitor_rect(RECT* out_rect)
 {
     HMONITOR target_monitor = nullptr;
-    const Config& config = Config::get_instance();
+    const ConfigSnapshot& config = Config::get_instance().snapshot();
 
     if (config.get_target_monitor() == 0)
     {
@@ -174,27 +531,27 @@ bool WindowHooks::get_target_monitor_rect(RECT* out_rect)
     return false;
 }
 
+template <typename Policy>
 HWND WINAPI WindowHooks::hooked_CreateWindowExA(DWORD dwExStyle, LPCSTR lpClassName, LPCSTR lpWindowName, DWORD dwStyle, int X, int Y, int nWidth, int nHeight, HWND hWndParent, HMENU hMenu, HINSTANCE hInstance, LPVOID lpParam)
 {
     auto& hooks = WindowHooks::get_instance();
-    const Config& config = Config::get_instance();
-    DebugLogger& logger = DebugLogger::get_instance();
+    TraceScope trace(EventId::CreateWindowExA, dwStyle, dwExStyle, pack(X, Y), pack(nWidth, nHeight));
+    [[maybe_unused]] const bool log_call = Policy::debug && DebugLogger::get_instance().admit(EventId::CreateWindowExA);
 
-    if (config.is_debug_mode_enabled())
+    if constexpr (Policy::debug)
     {
-        logger.get_next_sequence();
-        reshade::log::message(reshade::log::level::info, logger.format_event_header("CreateWindowExA (Debug Mode: No Override)").c_str());
+        if (log_call)
+        {
+            DebugLogger& logger = DebugLogger::get_instance();
+            logger.log_event("CreateWindowExA (Debug Mode: No Override)");
 
-        std::ostringstream info;
-        info << "  Window Title: " << (lpWindowName ? lpWindowName : "(null)") << "\n";
-        info << "  Style: " << logger.decode_window_style(dwStyle) << "\n";
-        info << "  Ex Style: " << logger.decode_window_ex_style(dwExStyle) << "\n";
-        info << "  Position: (" << X << ", " << Y << ")\n";
-        info << "  Size: " << nWidth << "x" << nHeight;
-        reshade::log::message(reshade::log::level::info, info.str().c_str());
+            logger.log_deferred(CreateWindowArgs<char>(lpWindowName, dwStyle, dwExStyle, X, Y, nWidth, nHeight));
+        }
     }
-    else if (config.is_borderless_fullscreen_enabled())
+    else if constexpr (Policy::borderless)
     {
+        trace.set_outcome(HookOutcome::Rewritten);
+
         // Modify to borderless fullscreen
         dwStyle = (dwStyle & ~WS_OVERLAPPEDWINDOW) | WS_POPUP | WS_VISIBLE;
         dwExStyle = dwExStyle & ~(WS_EX_WINDOWEDGE | WS_EX_CLIENTEDGE | WS_EX_DLGMODALFRAME);
@@ -215,44 +572,38 @@ HWND WINAPI WindowHooks::hooked_CreateWindowExA(DWORD dwExStyle, LPCSTR lpClassN
 
     HWND result = hooks.create_window_ex_a_hook_.call<HWND>(dwExStyle, lpClassName, lpWindowName, dwStyle, X, Y, nWidth, nHeight, hWndParent, hMenu, hInstance, lpParam);
 
-    if (config.is_debug_mode_enabled())
+    if constexpr (Policy::debug)
     {
-        std::ostringstream result_info;
-        result_info << "  Result HWND: 0x" << std::hex << std::uppercase << reinterpret_cast<uintptr_t>(result);
-        reshade::log::message(reshade::log::level::info, result_info.str().c_str());
+        if (log_call)
+        {
+            DebugLogger::get_instance().log_deferred(WindowResultArgs { trace_handle(result) });
+        }
     }
 
     return result;
 }
 
+template <typename Policy>
 HWND WINAPI WindowHooks::hooked_CreateWindowExW(DWORD dwExStyle, LPCWSTR lpClassName, LPCWSTR lpWindowName, DWORD dwStyle, int X, int Y, int nWidth, int nHeight, HWND hWndParent, HMENU hMenu, HINSTANCE hInstance, LPVOID lpParam)
 {
     auto& hooks = WindowHooks::get_instance();
-    const Config& config = Config::get_instance();
-    DebugLogger& logger = DebugLogger::get_instance();
+    TraceScope trace(EventId::CreateWindowExW, dwStyle, dwExStyle, pack(X, Y), pack(nWidth, nHeight));
+    [[maybe_unused]] const bool log_call = Policy::debug && DebugLogger::get_instance().admit(EventId::CreateWindowExW);
 
-    if (config.is_debug_mode_enabled())
+    if constexpr (Policy::debug)
     {
-        logger.get_next_sequence();
-        reshade::log::message(reshade::log::level::info, logger.format_event_header("CreateWindowExW (Debug Mode: No Override)").c_str());
-
-        // Convert wide string to narrow string
-        char window_title[256] = "(null)";
-        if (lpWindowName != nullptr)
+        if (log_call)
         {
-            WideCharToMultiByte(CP_UTF8, 0, lpWindowName, -1, window_title, sizeof(window_title), nullptr, nullptr);
-        }
+            DebugLogger& logger = DebugLogger::get_instance();
+            logger.log_event("CreateWindowExW (Debug Mode: No Override)");
 
-        std::ostringstream info;
-        info << "  Window Title: " << window_title << "\n";
-        info << "  Style: " << logger.decode_window_style(dwStyle) << "\n";
-        info << "  Ex Style: " << logger.decode_window_ex_style(dwExStyle) << "\n";
-        info << "  Position: (" << X << ", " << Y << ")\n";
-        info << "  Size: " << nWidth << "x" << nHeight;
-        reshade::log::message(reshade::log::level::info, info.str().c_str());
+            logger.log_deferred(CreateWindowArgs<wchar_t>(lpWindowName, dwStyle, dwExStyle, X, Y, nWidth, nHeight));
+        }
     }
-    else if (config.is_borderless_fullscreen_enabled())
+    else if constexpr (Policy::borderless)
     {
+        trace.set_outcome(HookOutcome::Rewritten);
+
         // Modify to borderless fullscreen
         dwStyle = (dwStyle & ~WS_OVERLAPPEDWINDOW) | WS_POPUP | WS_VISIBLE;
         dwExStyle = dwExStyle & ~(WS_EX_WINDOWEDGE | WS_EX_CLIENTEDGE | WS_EX_DLGMODALFRAME);
@@ -273,254 +624,206 @@ HWND WINAPI WindowHooks::hooked_CreateWindowExW(DWORD dwExStyle, LPCWSTR lpClass
 
     HWND result = hooks.create_window_ex_w_hook_.call<HWND>(dwExStyle, lpClassName, lpWindowName, dwStyle, X, Y, nWidth, nHeight, hWndParent, hMenu, hInstance, lpParam);
 
-    if (config.is_debug_mode_enabled())
+    if constexpr (Policy::debug)
     {
-        std::ostringstream result_info;
-        result_info << "  Result HWND: 0x" << std::hex << std::uppercase << reinterpret_cast<uintptr_t>(result);
-        reshade::log::message(reshade::log::level::info, result_info.str().c_str());
+        if (log_call)
+        {
+            DebugLogger::get_instance().log_deferred(WindowResultArgs { trace_handle(result) });
+        }
     }
 
     return result;
 }
 
+template <typename Policy>
 LONG WINAPI WindowHooks::hooked_SetWindowLongA(HWND hWnd, int nIndex, LONG dwNewLong)
 {
     auto& hooks = WindowHooks::get_instance();
-    const Config& config = Config::get_instance();
-    DebugLogger& logger = DebugLogger::get_instance();
+    TraceScope trace(EventId::SetWindowLongA, trace_handle(hWnd), static_cast<uint32_t>(nIndex), static_cast<uint32_t>(dwNewLong));
+    [[maybe_unused]] const bool log_call = Policy::debug && DebugLogger::get_instance().admit(EventId::SetWindowLongA);
 
-    if (config.is_debug_mode_enabled())
+    if constexpr (Policy::debug)
     {
-        logger.get_next_sequence();
-        reshade::log::message(reshade::log::level::info, logger.format_event_header("SetWindowLongA (Debug Mode: No Override)").c_str());
-
-        std::ostringstream info;
-        info << "  HWND: 0x" << std::hex << std::uppercase << reinterpret_cast<uintptr_t>(hWnd) << std::dec << "\n";
-        info << "  Index: " << nIndex;
-        if (nIndex == GWL_STYLE)
+        if (log_call)
         {
-            info << " (GWL_STYLE)\n";
-            info << "  New Style: " << logger.decode_window_style(static_cast<DWORD>(dwNewLong));
-        }
-        else if (nIndex == GWL_EXSTYLE)
-        {
-            info << " (GWL_EXSTYLE)\n";
-            info << "  New Ex Style: " << logger.decode_window_ex_style(static_cast<DWORD>(dwNewLong));
-        }
-        else
-        {
-            info << "\n";
-            info << "  New Value: 0x" << std::hex << std::uppercase << dwNewLong;
+            DebugLogger& logger = DebugLogger::get_instance();
+            logger.log_event("SetWindowLongA (Debug Mode: No Override)");
+
+            logger.log_deferred(SetWindowLongArgs { trace_handle(hWnd), nIndex, value_bits(dwNewLong) });
         }
-        reshade::log::message(reshade::log::level::info, info.str().c_str());
     }
-    else if (config.is_borderless_fullscreen_enabled() && nIndex == GWL_STYLE)
+    else if constexpr (Policy::borderless)
     {
-        // Force popup style, remove borders (cast to unsigned for bit operations)
-        dwNewLong = static_cast<LONG>((static_cast<DWORD>(dwNewLong) & ~WS_OVERLAPPEDWINDOW) | WS_POPUP | WS_VISIBLE);
+        if (nIndex == GWL_STYLE)
+        {
+            trace.set_outcome(HookOutcome::Rewritten);
+
+            // Force popup style, remove borders (cast to unsigned for bit operations)
+            dwNewLong = static_cast<LONG>((static_cast<DWORD>(dwNewLong) & ~WS_OVERLAPPEDWINDOW) | WS_POPUP | WS_VISIBLE);
+        }
     }
 
     LONG result = hooks.set_window_long_a_hook_.call<LONG>(hWnd, nIndex, dwNewLong);
 
-    if (config.is_debug_mode_enabled())
+    if constexpr (Policy::debug)
     {
-        std::ostringstream result_info;
-        result_info << "  Previous Value: 0x" << std::hex << std::uppercase << result;
-        reshade::log::message(reshade::log::level::info, result_info.str().c_str());
+        if (log_call)
+        {
+            DebugLogger::get_instance().log_deferred(PreviousValueArgs { value_bits(result) });
+        }
     }
 
     return result;
 }
 
+template <typename Policy>
 LONG WINAPI WindowHooks::hooked_SetWindowLongW(HWND hWnd, int nIndex, LONG dwNewLong)
 {
     auto& hooks = WindowHooks::get_instance();
-    const Config& config = Config::get_instance();
-    DebugLogger& logger = DebugLogger::get_instance();
+    TraceScope trace(EventId::SetWindowLongW, trace_handle(hWnd), static_cast<uint32_t>(nIndex), static_cast<uint32_t>(dwNewLong));
+    [[maybe_unused]] const bool log_call = Policy::debug && DebugLogger::get_instance().admit(EventId::SetWindowLongW);
 
-    if (config.is_debug_mode_enabled())
+    if constexpr (Policy::debug)
     {
-        logger.get_next_sequence();
-        reshade::log::message(reshade::log::level::info, logger.format_event_header("SetWindowLongW (Debug Mode: No Override)").c_str());
-
-        std::ostringstream info;
-        info << "  HWND: 0x" << std::hex << std::uppercase << reinterpret_cast<uintptr_t>(hWnd) << std::dec << "\n";
-        info << "  Index: " << nIndex;
-        if (nIndex == GWL_STYLE)
+        if (log_call)
         {
-            info << " (GWL_STYLE)\n";
-            info << "  New Style: " << logger.decode_window_style(static_cast<DWORD>(dwNewLong));
-        }
-        else if (nIndex == GWL_EXSTYLE)
-        {
-            info << " (GWL_EXSTYLE)\n";
-            info << "  New Ex Style: " << logger.decode_window_ex_style(static_cast<DWORD>(dwNewLong));
-        }
-        else
-        {
-            info << "\n";
-            info << "  New Value: 0x" << std::hex << std::uppercase << dwNewLong;
+            DebugLogger& logger = DebugLogger::get_instance();
+            logger.log_event("SetWindowLongW (Debug Mode: No Override)");
+
+            logger.log_deferred(SetWindowLongArgs { trace_handle(hWnd), nIndex, value_bits(dwNewLong) });
         }
-        reshade::log::message(reshade::log::level::info, info.str().c_str());
     }
-    else if (config.is_borderless_fullscreen_enabled() && nIndex == GWL_STYLE)
+    else if constexpr (Policy::borderless)
     {
-        // Force popup style, remove borders (cast to unsigned for bit operations)
-        dwNewLong = static_cast<LONG>((static_cast<DWORD>(dwNewLong) & ~WS_OVERLAPPEDWINDOW) | WS_POPUP | WS_VISIBLE);
+        if (nIndex == GWL_STYLE)
+        {
+            trace.set_outcome(HookOutcome::Rewritten);
+
+            // Force popup style, remove borders (cast to unsigned for bit operations)
+            dwNewLong = static_cast<LONG>((static_cast<DWORD>(dwNewLong) & ~WS_OVERLAPPEDWINDOW) | WS_POPUP | WS_VISIBLE);
+        }
     }
 
     LONG result = hooks.set_window_long_w_hook_.call<LONG>(hWnd, nIndex, dwNewLong);
 
-    if (config.is_debug_mode_enabled())
+    if constexpr (Policy::debug)
     {
-        std::ostringstream result_info;
-        result_info << "  Previous Value: 0x" << std::hex << std::uppercase << result;
-        reshade::log::message(reshade::log::level::info, result_info.str().c_str());
+        if (log_call)
+        {
+            DebugLogger::get_instance().log_deferred(PreviousValueArgs { value_bits(result) });
+        }
     }
 
     return result;
 }
 
 #ifdef _WIN64
+template <typename Policy>
 LONG_PTR WINAPI WindowHooks::hooked_SetWindowLongPtrA(HWND hWnd, int nIndex, LONG_PTR dwNewLong)
 {
     auto& hooks = WindowHooks::get_instance();
-    const Config& config = Config::get_instance();
-    DebugLogger& logger = DebugLogger::get_instance();
+    TraceScope trace(EventId::SetWindowLongPtrA, trace_handle(hWnd), static_cast<uint32_t>(nIndex), static_cast<uint64_t>(dwNewLong));
+    [[maybe_unused]] const bool log_call = Policy::debug && DebugLogger::get_instance().admit(EventId::SetWindowLongPtrA);
 
-    if (config.is_debug_mode_enabled())
+    if constexpr (Policy::debug)
     {
-        logger.get_next_sequence();
-        reshade::log::message(reshade::log::level::info, logger.format_event_header("SetWindowLongPtrA (Debug Mode: No Override)").c_str());
-
-        std::ostringstream info;
-        info << "  HWND: 0x" << std::hex << std::uppercase << reinterpret_cast<uintptr_t>(hWnd) << std::dec << "\n";
-        info << "  Index: " << nIndex;
-        if (nIndex == GWL_STYLE)
+        if (log_call)
         {
-            info << " (GWL_STYLE)\n";
-            info << "  New Style: " << logger.decode_window_style(static_cast<DWORD>(dwNewLong));
-        }
-        else if (nIndex == GWL_EXSTYLE)
-        {
-            info << " (GWL_EXSTYLE)\n";
-            info << "  New Ex Style: " << logger.decode_window_ex_style(static_cast<DWORD>(dwNewLong));
-        }
-        else
-        {
-            info << "\n";
-            info << "  New Value: 0x" << std::hex << std::uppercase << dwNewLong;
+            DebugLogger& logger = DebugLogger::get_instance();
+            logger.log_event("SetWindowLongPtrA (Debug Mode: No Override)");
+
+            logger.log_deferred(SetWindowLongArgs { trace_handle(hWnd), nIndex, value_bits(dwNewLong) });
         }
-        reshade::log::message(reshade::log::level::info, info.str().c_str());
     }
-    else if (config.is_borderless_fullscreen_enabled() && nIndex == GWL_STYLE)
+    else if constexpr (Policy::borderless)
     {
-        // Force popup style, remove borders (cast to unsigned for bit operations)
-        dwNewLong = static_cast<LONG_PTR>((static_cast<ULONG_PTR>(dwNewLong) & ~WS_OVERLAPPEDWINDOW) | WS_POPUP | WS_VISIBLE);
+        if (nIndex == GWL_STYLE)
+        {
+            trace.set_outcome(HookOutcome::Rewritten);
+
+            // Force popup style, remove borders (cast to unsigned for bit operations)
+            dwNewLong = static_cast<LONG_PTR>((static_cast<ULONG_PTR>(dwNewLong) & ~WS_OVERLAPPEDWINDOW) | WS_POPUP | WS_VISIBLE);
+        }
     }
 
     LONG_PTR result = hooks.set_window_long_ptr_a_hook_.call<LONG_PTR>(hWnd, nIndex, dwNewLong);
 
-    if (config.is_debug_mode_enabled())
+    if constexpr (Policy::debug)
     {
-        std::ostringstream result_info;
-        result_info << "  Previous Value: 0x" << std::hex << std::uppercase << result;
-        reshade::log::message(reshade::log::level::info, result_info.str().c_str());
+        if (log_call)
+        {
+            DebugLogger::get_instance().log_deferred(PreviousValueArgs { value_bits(result) });
+        }
     }
 
     return result;
 }
 
+template <typename Policy>
 LONG_PTR WINAPI WindowHooks::hooked_SetWindowLongPtrW(HWND hWnd, int nIndex, LONG_PTR dwNewLong)
 {
     auto& hooks = WindowHooks::get_instance();
-    const Config& config = Config::get_instance();
-    DebugLogger& logger = DebugLogger::get_instance();
+    TraceScope trace(EventId::SetWindowLongPtrW, trace_handle(hWnd), static_cast<uint32_t>(nIndex), static_cast<uint64_t>(dwNewLong));
+    [[maybe_unused]] const bool log_call = Policy::debug && DebugLogger::get_instance().admit(EventId::SetWindowLongPtrW);
 
-    if (config.is_debug_mode_enabled())
+    if constexpr (Policy::debug)
     {
-        logger.get_next_sequence();
-        reshade::log::message(reshade::log::level::info, logger.format_event_header("SetWindowLongPtrW (Debug Mode: No Override)").c_str());
-
-        std::ostringstream info;
-        info << "  HWND: 0x" << std::hex << std::uppercase << reinterpret_cast<uintptr_t>(hWnd) << std::dec << "\n";
-        info << "  Index: " << nIndex;
-        if (nIndex == GWL_STYLE)
+        if (log_call)
         {
-            info << " (GWL_STYLE)\n";
-            info << "  New Style: " << logger.decode_window_style(static_cast<DWORD>(dwNewLong));
-        }
-        else if (nIndex == GWL_EXSTYLE)
-        {
-            info << " (GWL_EXSTYLE)\n";
-            info << "  New Ex Style: " << logger.decode_window_ex_style(static_cast<DWORD>(dwNewLong));
-        }
-        else
-        {
-            info << "\n";
-            info << "  New Value: 0x" << std::hex << std::uppercase << dwNewLong;
+            DebugLogger& logger = DebugLogger::get_instance();
+            logger.log_event("SetWindowLongPtrW (Debug Mode: No Override)");
+
+            logger.log_deferred(SetWindowLongArgs { trace_handle(hWnd), nIndex, value_bits(dwNewLong) });
         }
-        reshade::log::message(reshade::log::level::info, info.str().c_str());
     }
-    else if (config.is_borderless_fullscreen_enabled() && nIndex == GWL_STYLE)
+    else if constexpr (Policy::borderless)
     {
-        // Force popup style, remove borders (cast to unsigned for bit operations)
-        dwNewLong = static_cast<LONG_PTR>((static_cast<ULONG_PTR>(dwNewLong) & ~WS_OVERLAPPEDWINDOW) | WS_POPUP | WS_VISIBLE);
+        if (nIndex == GWL_STYLE)
+        {
+            trace.set_outcome(HookOutcome::Rewritten);
+
+            // Force popup style, remove borders (cast to unsigned for bit operations)
+            dwNewLong = static_cast<LONG_PTR>((static_cast<ULONG_PTR>(dwNewLong) & ~WS_OVERLAPPEDWINDOW) | WS_POPUP | WS_VISIBLE);
+        }
     }
 
     LONG_PTR result = hooks.set_window_long_ptr_w_hook_.call<LONG_PTR>(hWnd, nIndex, dwNewLong);
 
-    if (config.is_debug_mode_enabled())
+    if constexpr (Policy::debug)
     {
-        std::ostringstream result_info;
-        result_info << "  Previous Value: 0x" << std::hex << std::uppercase << result;
-        reshade::log::message(reshade::log::level::info, result_info.str().c_str());
+        if (log_call)
+        {
+            DebugLogger::get_instance().log_deferred(PreviousValueArgs { value_bits(result) });
+        }
     }
 
     return result;
 }
 #endif
 
+template <typename Policy>
 BOOL WINAPI WindowHooks::hooked_SetWindowPos(HWND hWnd, HWND hWndInsertAfter, int X, int Y, int cx, int cy, UINT uFlags)
 {
     auto& hooks = WindowHooks::get_instance();
-    const Config& config = Config::get_instance();
-    DebugLogger& logger = DebugLogger::get_instance();
+    TraceScope trace(EventId::SetWindowPos, trace_handle(hWnd), pack(X, Y), pack(cx, cy), uFlags);
+    [[maybe_unused]] const bool log_call = Policy::debug && DebugLogger::get_instance().admit(EventId::SetWindowPos);
 
-    if (config.is_debug_mode_enabled())
+    if constexpr (Policy::debug)
     {
-        logger.get_next_sequence();
-        reshade::log::message(reshade::log::level::info, logger.format_event_header("SetWindowPos (Debug Mode: No Override)").c_str());
-
-        std::ostringstream info;
-        info << "  HWND: 0x" << std::hex << std::uppercase << reinterpret_cast<uintptr_t>(hWnd) << std::dec << "\n";
-        info << "  Position: (" << X << ", " << Y << ")\n";
-        info << "  Size: " << cx << "x" << cy << "\n";
-        info << "  Flags: 0x" << std::hex << std::uppercase << uFlags << std::dec;
-
-        // Decode common flags
-        std::ostringstream flags_str;
-        bool first = true;
-        if (uFlags & SWP_NOMOVE) { if (!first) flags_str << " | "; flags_str << "SWP_NOMOVE"; first = false; }
-        if (uFlags & SWP_NOSIZE) { if (!first) flags_str << " | "; flags_str << "SWP_NOSIZE"; first = false; }
-        if (uFlags & SWP_NOZORDER) { if (!first) flags_str << " | "; flags_str << "SWP_NOZORDER"; first = false; }
-        if (uFlags & SWP_NOACTIVATE) { if (!first) flags_str << " | "; flags_str << "SWP_NOACTIVATE"; first = false; }
-        if (uFlags & SWP_FRAMECHANGED) { if (!first) flags_str << " | "; flags_str << "SWP_FRAMECHANGED"; first = false; }
-        if (uFlags & SWP_SHOWWINDOW) { if (!first) flags_str << " | "; flags_str << "SWP_SHOWWINDOW"; first = false; }
-        if (uFlags & SWP_HIDEWINDOW) { if (!first) flags_str << " | "; flags_str << "SWP_HIDEWINDOW"; first = false; }
-
-        if (!flags_str.str().empty())
+        if (log_call)
         {
-            info << " (" << flags_str.str() << ")";
-        }
+            DebugLogger& logger = DebugLogger::get_instance();
+            logger.log_event("SetWindowPos (Debug Mode: No Override)");
 
-        reshade::log::message(reshade::log::level::info, info.str().c_str());
+            logger.log_deferred(SetWindowPosArgs { trace_handle(hWnd), X, Y, cx, cy, uFlags });
+        }
     }
-    else if (config.is_borderless_fullscreen_enabled())
+    else if constexpr (Policy::borderless)
     {
         // Don't modify if both SWP_NOSIZE and SWP_NOMOVE are set
         if ((uFlags & SWP_NOSIZE) && (uFlags & SWP_NOMOVE))
         {
+            trace.set_outcome(HookOutcome::EarlyOut);
             return hooks.set_window_pos_hook_.call<BOOL>(hWnd, hWndInsertAfter, X, Y, cx, cy, uFlags);
         }
 
@@ -535,123 +838,100 @@ BOOL WINAPI WindowHooks::hooked_SetWindowPos(HWND hWnd, HWND hWndInsertAfter, in
 
             // Remove flags that would prevent our changes
             uFlags &= ~(SWP_NOMOVE | SWP_NOSIZE);
+            trace.set_outcome(HookOutcome::Rewritten);
         }
     }
 
     BOOL result = hooks.set_window_pos_hook_.call<BOOL>(hWnd, hWndInsertAfter, X, Y, cx, cy, uFlags);
 
-    if (config.is_debug_mode_enabled())
+    if constexpr (Policy::debug)
     {
-        std::ostringstream result_info;
-        result_info << "  Result: " << (result ? "TRUE" : "FALSE");
-        reshade::log::message(reshade::log::level::info, result_info.str().c_str());
+        if (log_call)
+        {
+            DebugLogger::get_instance().log(result ? "  Result: TRUE" : "  Result: FALSE");
+        }
     }
 
     return result;
 }
 
+template <typename Policy>
 BOOL WINAPI WindowHooks::hooked_AdjustWindowRect(LPRECT lpRect, DWORD dwStyle, BOOL bMenu)
 {
     auto& hooks = WindowHooks::get_instance();
-    const Config& config = Config::get_instance();
-    DebugLogger& logger = DebugLogger::get_instance();
+    TraceScope trace(EventId::AdjustWindowRect, dwStyle, bMenu);
+    [[maybe_unused]] const bool log_call = Policy::debug && DebugLogger::get_instance().admit(EventId::AdjustWindowRect);
 
-    if (config.is_debug_mode_enabled())
+    if constexpr (Policy::debug)
     {
-        logger.get_next_sequence();
-        reshade::log::message(reshade::log::level::info, logger.format_event_header("AdjustWindowRect (Debug Mode: No Override)").c_str());
-
-        std::ostringstream info;
-        if (lpRect != nullptr)
-        {
-            info << "  Input Rect: (" << lpRect->left << ", " << lpRect->top << ")-("
-                 << lpRect->right << ", " << lpRect->bottom << ")\n";
-        }
-        else
+        if (log_call)
         {
-            info << "  Input Rect: (null)\n";
+            DebugLogger& logger = DebugLogger::get_instance();
+            logger.log_event("AdjustWindowRect (Debug Mode: No Override)");
+
+            logger.log_deferred(AdjustWindowRectArgs { lpRect != nullptr ? *lpRect : RECT {}, lpRect != nullptr, false, dwStyle, 0, bMenu });
         }
-        info << "  Style: " << logger.decode_window_style(dwStyle) << "\n";
-        info << "  Has Menu: " << (bMenu ? "Yes" : "No");
-        reshade::log::message(reshade::log::level::info, info.str().c_str());
     }
 
     BOOL result;
-    if (config.is_borderless_fullscreen_enabled())
+    if constexpr (Policy::borderless)
     {
         // Return the rect unchanged (pretend no window decoration)
         result = TRUE;
+        trace.set_outcome(HookOutcome::Rewritten);
     }
     else
     {
         result = hooks.adjust_window_rect_hook_.call<BOOL>(lpRect, dwStyle, bMenu);
     }
 
-    if (config.is_debug_mode_enabled())
+    if constexpr (Policy::debug)
     {
-        std::ostringstream result_info;
-        result_info << "  Result: " << (result ? "TRUE" : "FALSE");
-        if (lpRect != nullptr && result)
+        if (log_call)
         {
-            result_info << "\n";
-            result_info << "  Output Rect: (" << lpRect->left << ", " << lpRect->top << ")-("
-                        << lpRect->right << ", " << lpRect->bottom << ")";
+            DebugLogger::get_instance().log_deferred(AdjustWindowRectResultArgs { lpRect != nullptr ? *lpRect : RECT {}, lpRect != nullptr, result });
         }
-        reshade::log::message(reshade::log::level::info, result_info.str().c_str());
     }
 
     return result;
 }
 
+template <typename Policy>
 BOOL WINAPI WindowHooks::hooked_AdjustWindowRectEx(LPRECT lpRect, DWORD dwStyle, BOOL bMenu, DWORD dwExStyle)
 {
     auto& hooks = WindowHooks::get_instance();
-    const Config& config = Config::get_instance();
-    DebugLogger& logger = DebugLogger::get_instance();
+    TraceScope trace(EventId::AdjustWindowRectEx, dwStyle, dwExStyle, bMenu);
+    [[maybe_unused]] const bool log_call = Policy::debug && DebugLogger::get_instance().admit(EventId::AdjustWindowRectEx);
 
-    if (config.is_debug_mode_enabled())
+    if constexpr (Policy::debug)
     {
-        logger.get_next_sequence();
-        reshade::log::message(reshade::log::level::info, logger.format_event_header("AdjustWindowRectEx (Debug Mode: No Override)").c_str());
-
-        std::ostringstream info;
-        if (lpRect != nullptr)
+        if (log_call)
         {
-            info << "  Input Rect: (" << lpRect->left << ", " << lpRect->top << ")-("
-                 << lpRect->right << ", " << lpRect->bottom << ")\n";
-        }
-        else
-        {
-            info << "  Input Rect: (null)\n";
+            DebugLogger& logger = DebugLogger::get_instance();
+            logger.log_event("AdjustWindowRectEx (Debug Mode: No Override)");
+
+            logger.log_deferred(AdjustWindowRectArgs { lpRect != nullptr ? *lpRect : RECT {}, lpRect != nullptr, true, dwStyle, dwExStyle, bMenu });
         }
-        info << "  Style: " << logger.decode_window_style(dwStyle) << "\n";
-        info << "  Ex Style: " << logger.decode_window_ex_style(dwExStyle) << "\n";
-        info << "  Has Menu: " << (bMenu ? "Yes" : "No");
-        reshade::log::message(reshade::log::level::info, info.str().c_str());
     }
 
     BOOL result;
-    if (config.is_borderless_fullscreen_enabled())
+    if constexpr (Policy::borderless)
     {
         // Return the rect unchanged (pretend no window decoration)
         result = TRUE;
+        trace.set_outcome(HookOutcome::Rewritten);
     }
     else
     {
         result = hooks.adjust_window_rect_ex_hook_.call<BOOL>(lpRect, dwStyle, bMenu, dwExStyle);
     }
 
-    if (config.is_debug_mode_enabled())
+    if constexpr (Policy::debug)
     {
-        std::ostringstream result_info;
-        result_info << "  Result: " << (result ? "TRUE" : "FALSE");
-        if (lpRect != nullptr && result)
+        if (log_call)
         {
-            result_info << "\n";
-            result_info << "  Output Rect: (" << lpRect->left << ", " << lpRect->top << ")-("
-                        << lpRect->right << ", " << lpRect->bottom << ")";
+            DebugLogger::get_instance().log_deferred(AdjustWindowRectResultArgs { lpRect != nullptr ? *lpRect : RECT {}, lpRect != nullptr, result });
         }
-        reshade::log::message(reshade::log::level::info, result_info.str().c_str());
     }
 
     return result;
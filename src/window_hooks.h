@@ -20,6 +20,15 @@ public:
     bool install();
     void uninstall();
 
+    // Switch the hooks to the current config (after a reload changed fullscreen or debug mode).
+    // Only publishes the mode the detours forward to, installed hooks are never replaced at runtime
+    // because game threads may be inside a trampoline. Hooks are installed here if this is the first
+    // config that needs them.
+    void refresh();
+
+    // Rect of the monitor selected by TargetMonitor (falls back to the primary monitor)
+    static bool get_target_monitor_rect(RECT* out_rect);
+
 private:
     WindowHooks() = default;
     ~WindowHooks() = default;
@@ -30,7 +39,8 @@ private:
     WindowHooks(WindowHooks&&) = delete;
     WindowHooks& operator=(WindowHooks&&) = delete;
 
-    // SafetyHook inline hook objects
+    // SafetyHook inline hook objects. Set once with the detours below and kept until the last
+    // instance uninstalls, so their trampolines stay valid for calls in flight.
     SafetyHookInline create_window_ex_a_hook_;
     SafetyHookInline create_window_ex_w_hook_;
     SafetyHookInline set_window_long_a_hook_;
@@ -43,22 +53,68 @@ private:
     SafetyHookInline adjust_window_rect_hook_;
     SafetyHookInline adjust_window_rect_ex_hook_;
 
+    // Handler instantiation the detours forward to
+    enum class HookMode : uint8_t
+    {
+        Passthrough = 0,  // Borderless mode off, calls go straight to user32
+        Borderless = 1,
+        Debug = 2         // Borderless mode with debug mode, only observes
+    };
+
     // Hook state tracking
     bool hooks_installed_ = false;
     int addon_instance_count_ = 0;
+    std::atomic<HookMode> mode_ = HookMode::Passthrough;
     std::mutex hook_state_mutex_;
 
-    // Hook function implementations
+    static HookMode mode_for_config(const ConfigSnapshot& config);
+
+    // Publish the mode for config, installing the hooks the first time a mode needs them
+    // (caller must hold hook_state_mutex_)
+    bool apply_config(const ConfigSnapshot& config);
+
+    // Create all inline hooks disabled, then enable them once every trampoline is stored
+    // (caller must hold hook_state_mutex_)
+    bool install_hooks();
+    void remove_hooks();
+
+    // Call func.template operator()<Policy>() with the policy of the published mode
+    template <typename Func>
+    static decltype(auto) dispatch_mode(Func&& func);
+
+    // Detours, one per hooked function for the lifetime of the hooks. They only select the handler.
+    static HWND WINAPI detour_CreateWindowExA(DWORD dwExStyle, LPCSTR lpClassName, LPCSTR lpWindowName, DWORD dwStyle, int X, int Y, int nWidth, int nHeight, HWND hWndParent, HMENU hMenu, HINSTANCE hInstance, LPVOID lpParam);
+    static HWND WINAPI detour_CreateWindowExW(DWORD dwExStyle, LPCWSTR lpClassName, LPCWSTR lpWindowName, DWORD dwStyle, int X, int Y, int nWidth, int nHeight, HWND hWndParent, HMENU hMenu, HINSTANCE hInstance, LPVOID lpParam);
+    static LONG WINAPI detour_SetWindowLongA(HWND hWnd, int nIndex, LONG dwNewLong);
+    static LONG WINAPI detour_SetWindowLongW(HWND hWnd, int nIndex, LONG dwNewLong);
+#ifdef _WIN64
+    static LONG_PTR WINAPI detour_SetWindowLongPtrA(HWND hWnd, int nIndex, LONG_PTR dwNewLong);
+    static LONG_PTR WINAPI detour_SetWindowLongPtrW(HWND hWnd, int nIndex, LONG_PTR dwNewLong);
+#endif
+    static BOOL WINAPI detour_SetWindowPos(HWND hWnd, HWND hWndInsertAfter, int X, int Y, int cx, int cy, UINT uFlags);
+    static BOOL WINAPI detour_AdjustWindowRect(LPRECT lpRect, DWORD dwStyle, BOOL bMenu);
+    static BOOL WINAPI detour_AdjustWindowRectEx(LPRECT lpRect, DWORD dwStyle, BOOL bMenu, DWORD dwExStyle);
+
+    // Hook function implementations (instantiated per HookPolicy, see hook_policy.h)
+    template <typename Policy>
     static HWND WINAPI hooked_CreateWindowExA(DWORD dwExStyle, LPCSTR lpClassName, LPCSTR lpWindowName, DWORD dwStyle, int X, int Y, int nWidth, int nHeight, HWND hWndParent, HMENU hMenu, HINSTANCE hInstance, LPVOID lpParam);
+    template <typename Policy>
     static HWND WINAPI hooked_CreateWindowExW(DWORD dwExStyle, LPCWSTR lpClassName, LPCWSTR lpWindowName, DWORD dwStyle, int X, int Y, int nWidth, int nHeight, HWND hWndParent, HMENU hMenu, HINSTANCE hInstance, LPVOID lpParam);
+    template <typename Policy>
     static LONG WINAPI hooked_SetWindowLongA(HWND hWnd, int nIndex, LONG dwNewLong);
+    template <typename Policy>
     static LONG WINAPI hooked_SetWindowLongW(HWND hWnd, int nIndex, LONG dwNewLong);
 #ifdef _WIN64
+    template <typename Policy>
     static LONG_PTR WINAPI hooked_SetWindowLongPtrA(HWND hWnd, int nIndex, LONG_PTR dwNewLong);
+    template <typename Policy>
     static LONG_PTR WINAPI hooked_SetWindowLongPtrW(HWND hWnd, int nIndex, LONG_PTR dwNewLong);
 #endif
+    template <typename Policy>
     static BOOL WINAPI hooked_SetWindowPos(HWND hWnd, HWND hWndInsertAfter, int X, int Y, int cx, int cy, UINT uFlags);
+    template <typename Policy>
     static BOOL WINAPI hooked_AdjustWindowRect(LPRECT lpRect, DWORD dwStyle, BOOL bMenu);
+    template <typename Policy>
     static BOOL WINAPI hooked_AdjustWindowRectEx(LPRECT lpRect, DWORD dwStyle, BOOL bMenu, DWORD dwExStyle);
 
     // Helper structures and functions
@@ -70,5 +126,4 @@ private:
     };
 
     static BOOL CALLBACK MonitorEnumProc(HMONITOR hMonitor, HDC hdcMonitor, LPRECT lprcMonitor, LPARAM dwData);
-    static bool get_target_monitor_rect(RECT* out_rect);
 };
@@ -0,0 +1,69 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include "config.h"
+#include "swapchain_manager.h"
+#include "mock_game.h"
+#include <gtest/gtest.h>
+
+// Loads a configuration from the mock ReShade.ini and installs the addon's event callbacks.
+// Every test starts from the defaults and leaves no swapchains or callbacks behind.
+class AddonTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        reset();
+    }
+
+    void TearDown() override
+    {
+        reset();
+    }
+
+    // Set a [SWAPCHAIN_OVERRIDE] key, takes effect with the next install()
+    static void configure(const char* key, const char* value)
+    {
+        reshade_mock::set_config("SWAPCHAIN_OVERRIDE", key, value);
+    }
+
+    static void install()
+    {
+        Config::get_instance().load();
+        SwapchainManager::get_instance().install();
+    }
+
+    // State of the only tracked swapchain
+    static SwapchainState swapchain_state()
+    {
+        SwapchainState state = SwapchainState::Destroyed;
+        SwapchainManager::get_instance().for_each_swapchain([&](SwapchainNativeHandle, const SwapchainData& data) { state = data.state; });
+        return state;
+    }
+
+    static size_t swapchain_count()
+    {
+        size_t count = 0;
+        SwapchainManager::get_instance().for_each_swapchain([&](SwapchainNativeHandle, const SwapchainData&) { ++count; });
+        return count;
+    }
+
+private:
+    static void reset()
+    {
+        SwapchainManager& manager = SwapchainManager::get_instance();
+        manager.uninstall();
+        manager.cleanup_all();
+
+        reshade_mock::clear_config();
+        reshade_mock::clear_log();
+        reshade_mock::reset_registrations();
+        win32_mock::use_real_tick_count();
+        Config::get_instance().load();
+    }
+};
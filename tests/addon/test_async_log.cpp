@@ -0,0 +1,183 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "addon_fixture.h"
+#include "async_log.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    std::thread::id g_format_thread;
+
+    struct ProbeArgs
+    {
+        int value;
+
+        static void format(const ProbeArgs& args, std::string& out)
+        {
+            g_format_thread = std::this_thread::get_id();
+            out += "probe " + std::to_string(args.value);
+        }
+    };
+
+    std::atomic<bool> g_consumer_blocked = false;
+    std::atomic<bool> g_release_consumer = false;
+
+    // Keeps the consumer inside drain() until released, like a pool thread cut off at process exit
+    struct BlockingArgs
+    {
+        static void format(const BlockingArgs&, std::string& out)
+        {
+            g_consumer_blocked = true;
+            while (!g_release_consumer)
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            out += "Bunblocked";
+        }
+    };
+
+    std::vector<std::string> logged_lines_starting_with(char c)
+    {
+        std::vector<std::string> lines;
+        for (const reshade_mock::LogEntry& entry : reshade_mock::log_entries())
+        {
+            if (!entry.text.empty() && entry.text.front() == c)
+                lines.push_back(entry.text);
+        }
+        return lines;
+    }
+}
+
+class AsyncLogTest : public AddonTest
+{
+protected:
+    void SetUp() override
+    {
+        AddonTest::SetUp();
+        AsyncLog::get_instance().install();
+    }
+
+    void TearDown() override
+    {
+        AsyncLog::get_instance().uninstall();
+        AddonTest::TearDown();
+    }
+
+    // Stop the consumer, which flushes every queued record
+    static void flush()
+    {
+        AsyncLog::get_instance().uninstall();
+        AsyncLog::get_instance().install();
+    }
+};
+
+TEST_F(AsyncLogTest, LongLinesAreReassembledWhole)
+{
+    const std::string line = "L" + std::string(AsyncLog::MAX_TEXT_LENGTH * 3 + 17, 'x');
+    AsyncLog::get_instance().write(reshade::log::level::info, line);
+    AsyncLog::get_instance().write(reshade::log::level::info, "Lshort");
+    flush();
+
+    const std::vector<std::string> lines = logged_lines_starting_with('L');
+    ASSERT_EQ(lines.size(), 2u);
+    EXPECT_EQ(lines[0], line);
+    EXPECT_EQ(lines[1], "Lshort");
+}
+
+TEST_F(AsyncLogTest, OverlongLinesEndWithTheTruncationMarker)
+{
+    const std::string line = "T" + std::string(AsyncLog::MAX_LINE_LENGTH * 2, 'y');
+    AsyncLog::get_instance().write(reshade::log::level::info, line);
+    flush();
+
+    const std::vector<std::string> lines = logged_lines_starting_with('T');
+    ASSERT_EQ(lines.size(), 1u);
+    EXPECT_EQ(lines[0].size(), AsyncLog::MAX_LINE_LENGTH);
+    EXPECT_TRUE(lines[0].ends_with(AsyncLog::TRUNCATION_MARKER));
+    EXPECT_EQ(lines[0].substr(0, 100), line.substr(0, 100));
+}
+
+TEST_F(AsyncLogTest, LineOfExactlyOneRecordIsNotSplit)
+{
+    const std::string line = "E" + std::string(AsyncLog::MAX_TEXT_LENGTH - 1, 'z');
+    AsyncLog::get_instance().write(reshade::log::level::info, line);
+    flush();
+
+    const std::vector<std::string> lines = logged_lines_starting_with('E');
+    ASSERT_EQ(lines.size(), 1u);
+    EXPECT_EQ(lines[0], line);
+}
+
+TEST_F(AsyncLogTest, DeferredArgumentsAreFormattedOnTheConsumer)
+{
+    g_format_thread = {};
+    AsyncLog::get_instance().write_deferred(reshade::log::level::info, ProbeArgs { 42 });
+
+    // Wait for the consumer instead of flushing, which would format on this thread
+    for (int attempt = 0; attempt < 2000 && !reshade_mock::has_logged("probe 42"); ++attempt)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    ASSERT_TRUE(reshade_mock::has_logged("probe 42"));
+    EXPECT_NE(g_format_thread, std::thread::id());
+    EXPECT_NE(g_format_thread, std::this_thread::get_id());
+}
+
+TEST_F(AsyncLogTest, ConcurrentLongLinesAreNeverInterleaved)
+{
+    constexpr int THREADS = 4;
+    constexpr int LINES = 200;
+
+    std::vector<std::thread> producers;
+    for (int thread = 0; thread < THREADS; ++thread)
+    {
+        producers.emplace_back([thread] {
+            // Every line is one character repeated, a torn line would mix two of them
+            const std::string line(AsyncLog::MAX_TEXT_LENGTH * 2 + 5, static_cast<char>('a' + thread));
+            for (int i = 0; i < LINES; ++i)
+                AsyncLog::get_instance().write(reshade::log::level::info, line);
+        });
+    }
+    for (std::thread& producer : producers)
+        producer.join();
+    flush();
+
+    size_t lines = 0;
+    for (int thread = 0; thread < THREADS; ++thread)
+    {
+        const char c = static_cast<char>('a' + thread);
+        for (const std::string& text : logged_lines_starting_with(c))
+        {
+            ++lines;
+            EXPECT_EQ(text, std::string(AsyncLog::MAX_TEXT_LENGTH * 2 + 5, c));
+        }
+    }
+
+    // Lines only go missing as a whole when the ring was full
+    EXPECT_GT(lines, 0u);
+    EXPECT_LE(lines, static_cast<size_t>(THREADS * LINES));
+}
+
+TEST_F(AsyncLogTest, ProcessExitDoesNotWaitForTheConsumer)
+{
+    g_consumer_blocked = false;
+    g_release_consumer = false;
+    AsyncLog::get_instance().write_deferred(reshade::log::level::info, BlockingArgs {});
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!g_consumer_blocked && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    ASSERT_TRUE(g_consumer_blocked);
+
+    // Returns with the consumer still inside drain(), later lines are logged directly
+    AsyncLog::get_instance().uninstall(true);
+    AsyncLog::get_instance().write(reshade::log::level::info, "Bdirect");
+    EXPECT_EQ(logged_lines_starting_with('B'), std::vector<std::string>({ "Bdirect" }));
+
+    // TearDown unregisters the wait, which joins the released consumer
+    g_release_consumer = true;
+}
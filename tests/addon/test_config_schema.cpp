@@ -0,0 +1,127 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "addon_fixture.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+    std::string stored_value(const char* key)
+    {
+        char value[MAX_PATH] = {};
+        size_t value_size = sizeof(value);
+        if (!reshade::get_config_value(nullptr, "SWAPCHAIN_OVERRIDE", key, value, &value_size))
+            return {};
+        return value;
+    }
+}
+
+TEST_F(AddonTest, EveryKeyHasAParsableDefault)
+{
+    for (const ConfigKey& key : Config::get_schema())
+    {
+        SCOPED_TRACE(key.name);
+        ASSERT_NE(key.parse, nullptr);
+        ASSERT_NE(key.format, nullptr);
+        ASSERT_NE(key.syntax, nullptr);
+
+        ConfigSnapshot snapshot;
+        EXPECT_TRUE(key.parse(key, key.default_value, snapshot));
+    }
+}
+
+TEST_F(AddonTest, MissingKeysAreWrittenBackWithTheirDefault)
+{
+    reshade_mock::clear_config();
+    Config::get_instance().load();
+
+    for (const ConfigKey& key : Config::get_schema())
+        EXPECT_EQ(stored_value(key.name), key.default_value) << key.name;
+}
+
+TEST_F(AddonTest, ValidValuesAreApplied)
+{
+    configure("ForceSwapchainResolution", "2560x1440");
+    configure("FullscreenMode", "2");
+    configure("BlockFullscreenChanges", "true");
+    configure("TargetMonitor", "3");
+    configure("ResizeDebounce", "5frames");
+    Config::get_instance().load();
+
+    const ConfigSnapshot& config = Config::get_instance().snapshot();
+    EXPECT_EQ(config.get_forced_resolution().width, 2560u);
+    EXPECT_EQ(config.get_forced_resolution().height, 1440u);
+    EXPECT_EQ(config.get_fullscreen_mode(), FullscreenMode::Exclusive);
+    EXPECT_TRUE(config.get_block_fullscreen_changes());
+    EXPECT_EQ(config.get_target_monitor(), 3);
+    EXPECT_EQ(config.get_resize_debounce().unit, ResizeDebounceUnit::Frames);
+    EXPECT_EQ(config.get_resize_debounce().amount, 5u);
+}
+
+TEST_F(AddonTest, InvalidValuesKeepTheDefaultAndAreReported)
+{
+    configure("FullscreenMode", "3");
+    configure("TargetMonitor", "abc");
+    configure("DebugMode", "yes");
+    Config::get_instance().load();
+
+    const ConfigSnapshot& config = Config::get_instance().snapshot();
+    EXPECT_EQ(config.get_fullscreen_mode(), FullscreenMode::Unchanged);
+    EXPECT_EQ(config.get_target_monitor(), 0);
+    EXPECT_FALSE(config.is_debug_mode_enabled());
+
+    EXPECT_TRUE(reshade_mock::has_logged("Ignoring invalid value '3' for FullscreenMode"));
+    EXPECT_TRUE(reshade_mock::has_logged("Ignoring invalid value 'abc' for TargetMonitor"));
+    EXPECT_TRUE(reshade_mock::has_logged("Ignoring invalid value 'yes' for DebugMode"));
+
+    // The user's value is left in the ini for them to fix
+    EXPECT_EQ(stored_value("FullscreenMode"), "3");
+}
+
+TEST_F(AddonTest, FormattersDescribeTheLoadedValues)
+{
+    configure("ForceSwapchainResolution", "150%");
+    Config::get_instance().load();
+
+    for (const ConfigKey& key : Config::get_schema())
+    {
+        if (std::strcmp(key.name, "ForceSwapchainResolution") != 0)
+            continue;
+
+        char buffer[64] = {};
+        key.format(Config::get_instance().snapshot(), buffer, sizeof(buffer));
+        EXPECT_STREQ(buffer, "150% of requested");
+    }
+}
+
+TEST_F(AddonTest, ProfileOfTheRunningExecutableOverridesTheIni)
+{
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "swapchain_override_profile_config";
+    std::filesystem::create_directories(directory);
+    std::filesystem::remove(directory / "profiles.ini.idx");
+    {
+        std::ofstream source(directory / "profiles.ini", std::ios::trunc);
+        source << "[Game.exe]\nFullscreenMode=1\nTargetMonitor=9\nProfileDatabase=other.ini\n";
+    }
+
+    win32_mock::set_module_path((directory / "game.exe").wstring());
+    configure("ProfileDatabase", "profiles.ini");
+    configure("FullscreenMode", "2");
+    configure("TargetMonitor", "1");
+    Config::get_instance().load();
+
+    const ConfigSnapshot& config = Config::get_instance().snapshot();
+    EXPECT_EQ(config.get_fullscreen_mode(), FullscreenMode::Borderless);
+    EXPECT_EQ(config.get_target_monitor(), 9);
+    EXPECT_EQ(config.get_profile_database(), "profiles.ini");
+    EXPECT_EQ(config.get_active_profile(), "game.exe");
+    EXPECT_TRUE(reshade_mock::has_logged("Ignoring unsupported profile key ProfileDatabase"));
+
+    win32_mock::set_module_path(L"");
+    std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,109 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "addon_fixture.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // Two configurations that differ in two keys, so a reader can tell a torn snapshot apart
+    void configure_variant(bool second)
+    {
+        reshade_mock::set_config("SWAPCHAIN_OVERRIDE", "ForceSwapchainResolution", second ? "2560x1440" : "1280x720");
+        reshade_mock::set_config("SWAPCHAIN_OVERRIDE", "ResizeDebounce", second ? "200ms" : "100ms");
+    }
+
+    bool is_consistent(const ConfigSnapshot& snapshot)
+    {
+        const uint32_t width = snapshot.get_forced_resolution().width;
+        const uint32_t debounce = snapshot.get_resize_debounce().amount;
+        return (width == 1280 && debounce == 100) || (width == 2560 && debounce == 200);
+    }
+}
+
+TEST_F(AddonTest, UnchangedReloadKeepsTheSnapshot)
+{
+    Config& config = Config::get_instance();
+    const ConfigSnapshot* before = &config.snapshot();
+    const size_t retained = config.get_retained_snapshot_count();
+
+    config.load();
+    EXPECT_EQ(&config.snapshot(), before);
+    EXPECT_EQ(config.get_retained_snapshot_count(), retained);
+}
+
+TEST_F(AddonTest, RetiredSnapshotsStayReadableAndAreReused)
+{
+    Config& config = Config::get_instance();
+    configure_variant(false);
+    config.load();
+    const ConfigSnapshot& first = config.snapshot();
+
+    configure_variant(true);
+    config.load();
+    const ConfigSnapshot& second = config.snapshot();
+    ASSERT_NE(&second, &first);
+
+    // A hook that read the first snapshot before the reload can still use it
+    EXPECT_TRUE(is_consistent(first));
+    EXPECT_EQ(first.get_forced_resolution().width, 1280u);
+
+    // Reloads back and forth publish the same two snapshots again
+    const size_t retained = config.get_retained_snapshot_count();
+    for (int reload = 0; reload < 8; ++reload)
+    {
+        configure_variant(reload % 2 == 0);
+        config.load();
+        EXPECT_EQ(&config.snapshot(), reload % 2 == 0 ? &second : &first);
+    }
+    EXPECT_EQ(config.get_retained_snapshot_count(), retained);
+}
+
+// Readers on several threads while reloads publish new snapshots. Build with
+// -DSWAPCHAIN_OVERRIDE_SANITIZER=thread to have ThreadSanitizer check the publish/read path.
+TEST_F(AddonTest, SnapshotsReadDuringReloadsAreNeverTorn)
+{
+    Config& config = Config::get_instance();
+    configure_variant(false);
+    config.load();
+    const size_t retained = config.get_retained_snapshot_count();
+
+    std::atomic<bool> stop = false;
+    std::atomic<uint64_t> torn = 0;
+    std::atomic<uint64_t> reads = 0;
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i)
+    {
+        readers.emplace_back([&] {
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                // Like a hook: one snapshot for the whole call
+                const ConfigSnapshot& snapshot = config.snapshot();
+                if (!is_consistent(snapshot))
+                    torn.fetch_add(1, std::memory_order_relaxed);
+                reads.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    for (int reload = 0; reload < 2000; ++reload)
+    {
+        configure_variant(reload % 2 == 0);
+        config.load();
+    }
+
+    stop = true;
+    for (std::thread& reader : readers)
+        reader.join();
+
+    EXPECT_EQ(torn.load(), 0u);
+    EXPECT_GT(reads.load(), 0u);
+
+    // Only the two configurations were ever published
+    EXPECT_LE(config.get_retained_snapshot_count(), retained + 1);
+}
@@ -0,0 +1,76 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "addon_fixture.h"
+#include "debug_logger.h"
+#include <chrono>
+#include <thread>
+
+using namespace reshade_mock;
+
+namespace
+{
+    size_t logged_count(const std::string& substring)
+    {
+        size_t count = 0;
+        for (const LogEntry& entry : log_entries())
+        {
+            if (entry.text.find(substring) != std::string::npos)
+                ++count;
+        }
+        return count;
+    }
+}
+
+TEST_F(AddonTest, FrameSummaryIsLoggedOncePerSummaryInterval)
+{
+    configure("DebugMode", "1");
+    configure("DebugLogSummaryFrames", "10");
+    install();
+    MockGame game;
+    game.create_swapchain(1920, 1080);
+    clear_log();
+
+    // Frames are counted since load, 20 presents cross the interval exactly twice
+    for (int frame = 0; frame < 20; ++frame)
+        game.present();
+    EXPECT_EQ(logged_count("FRAME_SUMMARY"), 2u);
+    EXPECT_TRUE(has_logged("  Frames: "));
+}
+
+TEST_F(AddonTest, FrameSummaryIsOffWithoutDebugMode)
+{
+    configure("DebugLogSummaryFrames", "1");
+    install();
+    MockGame game;
+    game.create_swapchain(1920, 1080);
+    clear_log();
+
+    for (int frame = 0; frame < 5; ++frame)
+        game.present();
+    EXPECT_EQ(logged_count("FRAME_SUMMARY"), 0u);
+}
+
+TEST_F(AddonTest, HookCallsPastTheRateAreCountedInsteadOfLogged)
+{
+    configure("DebugMode", "1");
+    configure("DebugLogRate", "10");
+    install();
+    DebugLogger& logger = DebugLogger::get_instance();
+
+    // 10 calls per second with bursts of two seconds, a hundred calls at once cannot all be logged
+    uint32_t admitted = 0;
+    for (int call = 0; call < 100; ++call)
+        admitted += logger.admit(trace_format::EventId::AdjustWindowRect) ? 1 : 0;
+    EXPECT_LE(admitted, 20u);
+    EXPECT_FALSE(has_logged("calls not logged (DebugLogRate)"));
+
+    // The next call let through reports the skipped ones
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    EXPECT_TRUE(logger.admit(trace_format::EventId::AdjustWindowRect));
+    EXPECT_TRUE(has_logged("AdjustWindowRect: "));
+    EXPECT_TRUE(has_logged("calls not logged (DebugLogRate)"));
+}
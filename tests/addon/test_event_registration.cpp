@@ -0,0 +1,125 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "addon_fixture.h"
+#include <thread>
+
+using namespace reshade_mock;
+using reshade::addon_event;
+
+namespace
+{
+    // What ConfigWatcher::reload() does after the ini changed, on its own thread
+    void reload_on_watcher_thread()
+    {
+        std::thread watcher([] {
+            Config& config = Config::get_instance();
+            const ConfigSnapshot& previous = config.snapshot();
+            config.load();
+            SwapchainManager::get_instance().apply_config_change(previous, config.snapshot());
+        });
+        watcher.join();
+    }
+}
+
+TEST_F(AddonTest, DisabledOverrideRegistersNoDrawTimeHooks)
+{
+    configure("ForceSwapchainResolution", "0x0");
+    install();
+    EXPECT_EQ(registered<addon_event::create_swapchain>(), nullptr);
+    EXPECT_EQ(registered<addon_event::bind_viewports>(), nullptr);
+    EXPECT_EQ(registered<addon_event::present>(), nullptr);
+
+    // Once per frame, for the frame timer
+    EXPECT_NE(registered<addon_event::finish_present>(), nullptr);
+}
+
+TEST_F(AddonTest, ExclusiveFullscreenAloneDoesNotRegisterInitSwapchain)
+{
+    configure("ForceSwapchainResolution", "0x0");
+    configure("FullscreenMode", "2");
+    install();
+    EXPECT_NE(registered<addon_event::create_swapchain>(), nullptr);
+    EXPECT_NE(registered<addon_event::set_fullscreen_state>(), nullptr);
+    EXPECT_EQ(registered<addon_event::init_swapchain>(), nullptr);
+    EXPECT_EQ(registered<addon_event::destroy_swapchain>(), nullptr);
+}
+
+TEST_F(AddonTest, ReloadNeverChangesTheRegistration)
+{
+    install();
+    MockGame game;
+    game.create_swapchain(1920, 1080);
+    reshade_mock::reset_registrations();
+
+    configure("ForceSwapchainResolution", "0x0");
+    configure("FullscreenMode", "1");
+    reload_on_watcher_thread();
+    game.present();
+    game.destroy_swapchain();
+    dispatch<addon_event::finish_present>(&game.queue(), static_cast<swapchain*>(nullptr));
+
+    EXPECT_EQ(registration_change_count(), 0u);
+    EXPECT_NE(registered<addon_event::bind_viewports>(), nullptr);
+    EXPECT_NE(registered<addon_event::present>(), nullptr);
+}
+
+TEST_F(AddonTest, ReloadToAnotherPolicySwitchesTheRegisteredHandler)
+{
+    install();
+    MockGame game;
+    const auto create_swapchain = registered<addon_event::create_swapchain>();
+
+    swapchain_desc desc = {};
+    desc.back_buffer.texture.width = 3840;
+    desc.back_buffer.texture.height = 2160;
+    desc.fullscreen_state = true;
+    swapchain_desc copy = desc;
+    dispatch<addon_event::create_swapchain>(device_api::d3d11, copy, game.hwnd());
+    EXPECT_TRUE(copy.fullscreen_state);
+
+    // Same callback, the borderless instantiation behind it now forces windowed mode
+    configure("FullscreenMode", "1");
+    reload_on_watcher_thread();
+    EXPECT_EQ(registered<addon_event::create_swapchain>(), create_swapchain);
+
+    copy = desc;
+    EXPECT_TRUE(dispatch<addon_event::create_swapchain>(device_api::d3d11, copy, game.hwnd()));
+    EXPECT_FALSE(copy.fullscreen_state);
+}
+
+TEST_F(AddonTest, OverrideTurnedOffByReloadStopsRedirectingAtTheNextResize)
+{
+    install();
+    MockGame game;
+    game.create_swapchain(1920, 1080);
+
+    configure("ForceSwapchainResolution", "0x0");
+    reload_on_watcher_thread();
+
+    // Proxies made before the reload stay until the swapchain is recreated
+    const viewport full = { 0.0f, 0.0f, 3840.0f, 2160.0f, 0.0f, 1.0f };
+    dispatch<addon_event::bind_viewports>(&game.cmd_list(), 0u, 1u, &full);
+    EXPECT_EQ(game.device().calls().count(Call::BindViewports), 1u);
+
+    game.resize(1280, 720);
+    EXPECT_EQ(swapchain_count(), 0u);
+
+    const viewport resized = { 0.0f, 0.0f, 1280.0f, 720.0f, 0.0f, 1.0f };
+    dispatch<addon_event::bind_viewports>(&game.cmd_list(), 0u, 1u, &resized);
+    EXPECT_EQ(game.device().calls().count(Call::BindViewports), 1u);
+}
+
+TEST_F(AddonTest, FeatureEnabledByReloadAsksForARestart)
+{
+    configure("ForceSwapchainResolution", "0x0");
+    install();
+
+    configure("ForceSwapchainResolution", "3840x2160");
+    reload_on_watcher_thread();
+    EXPECT_TRUE(has_logged("restart the application"));
+    EXPECT_EQ(registered<addon_event::present>(), nullptr);
+}
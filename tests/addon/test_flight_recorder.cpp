@@ -0,0 +1,99 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "addon_fixture.h"
+#include "flight_recorder.h"
+#include "mock_win32.h"
+#include "core/trace_reader.h"
+#include <cstdlib>
+#include <filesystem>
+
+using trace_format::EventId;
+
+class FlightRecorderTest : public AddonTest
+{
+protected:
+    void SetUp() override
+    {
+        AddonTest::SetUp();
+        std::filesystem::remove_all(directory_);
+        std::filesystem::create_directories(directory_);
+        win32_mock::set_module_path((directory_ / "game.exe").wstring());
+    }
+
+    void TearDown() override
+    {
+        FlightRecorder::get_instance().uninstall();
+        win32_mock::set_module_path(L"");
+        std::filesystem::remove_all(directory_);
+        AddonTest::TearDown();
+    }
+
+    std::filesystem::path dump_path() const { return directory_ / FlightRecorder::DUMP_FILE_NAME; }
+
+    Trace load_dump() const
+    {
+        Trace trace;
+        std::string error;
+        EXPECT_TRUE(load_trace(dump_path().string().c_str(), trace, error)) << error;
+        return trace;
+    }
+
+    // Fill the ring past its capacity and dump it twice, exits with 0 if only the first dump wrote a file
+    [[noreturn]] void dump_twice() const
+    {
+        FlightRecorder& recorder = FlightRecorder::get_instance();
+        recorder.install();
+
+        const uint64_t args[4] = { 1, 2, 3, 4 };
+        for (uint64_t call = 0; call < FlightRecorder::CAPACITY + 100; ++call)
+            recorder.record(EventId::BindViewports, 0, HookOutcome::Redirected, 1000 + call, 1000 + call + 1, args);
+        recorder.dump();
+
+        std::filesystem::rename(dump_path(), dump_path().string() + ".first");
+        recorder.dump();
+        std::_Exit(std::filesystem::exists(dump_path()) ? 1 : 0);
+    }
+
+private:
+    const std::filesystem::path directory_ = std::filesystem::temp_directory_path() / "swapchain_override_flight_recorder";
+};
+
+// The abort handler writes the dump from the dying process, the test reads it back afterwards
+TEST_F(FlightRecorderTest, AbortDumpsTheLastHookCalls)
+{
+    EXPECT_DEATH({
+        install();
+        FlightRecorder::get_instance().install();
+        reshade_mock::MockGame game;
+        game.create_swapchain(1920, 1080);
+        game.present();
+        std::abort();
+    }, "");
+
+    const Trace trace = load_dump();
+    ASSERT_FALSE(trace.records.empty());
+    EXPECT_EQ(trace.header.magic, trace_format::MAGIC);
+
+    bool created = false;
+    for (const trace_format::Record& record : trace.records)
+        created = created || record.event == EventId::CreateSwapchain;
+    EXPECT_TRUE(created);
+    EXPECT_EQ(trace.records.back().event, EventId::FinishPresent);
+}
+
+// Run in a child process like the crash handlers, a dump ends the recorder for the process
+TEST_F(FlightRecorderTest, DumpKeepsTheLastCapacityCallsOnce)
+{
+    EXPECT_EXIT(dump_twice(), ::testing::ExitedWithCode(0), "");
+
+    std::filesystem::rename(dump_path().string() + ".first", dump_path());
+    const Trace trace = load_dump();
+    ASSERT_EQ(trace.records.size(), FlightRecorder::CAPACITY);
+    EXPECT_EQ(trace.records.front().timestamp, 1100u);
+    EXPECT_EQ(trace.records.back().timestamp, 1000u + FlightRecorder::CAPACITY + 99);
+    EXPECT_EQ(trace.records.back().args[3], 4u);
+}
@@ -0,0 +1,69 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "addon_fixture.h"
+#include "frame_timer.h"
+#include "hook_probe.h"
+#include <chrono>
+#include <thread>
+#include <vector>
+
+TEST_F(AddonTest, FrameSamplesAreCopiedOldestFirst)
+{
+    FrameTimer& timer = FrameTimer::get_instance();
+    timer.record_present();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    timer.record_present();
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    timer.record_present();
+
+    std::array<FrameSample, 2> samples = {};
+    ASSERT_EQ(timer.copy_samples(samples), 2u);
+    EXPECT_LT(samples[0].interval_ticks, samples[1].interval_ticks);
+
+    // The 20 ms frame, measured in HookProbe ticks
+    const double microseconds = samples[1].interval_ticks / HookProbe::get_instance().ticks_per_microsecond();
+    EXPECT_GE(microseconds, 20000.0);
+}
+
+TEST_F(AddonTest, FrameTimerRingKeepsTheMostRecentCapacityFrames)
+{
+    FrameTimer& timer = FrameTimer::get_instance();
+    for (size_t frame = 0; frame < FrameTimer::CAPACITY + 10; ++frame)
+        timer.record_present();
+
+    std::vector<FrameSample> samples(FrameTimer::CAPACITY * 2);
+    EXPECT_EQ(timer.copy_samples(samples), FrameTimer::CAPACITY);
+
+    std::array<FrameSample, 0> none = {};
+    EXPECT_EQ(timer.copy_samples(none), 0u);
+}
+
+// Presents from several threads are all counted, and none of them is lost from the ring
+TEST_F(AddonTest, ConcurrentPresentsAreAllCounted)
+{
+    constexpr int THREADS = 4;
+    constexpr int PRESENTS = 10000;
+
+    FrameTimer& timer = FrameTimer::get_instance();
+    const uint64_t presents = timer.get_present_count();
+
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < THREADS; ++thread)
+    {
+        threads.emplace_back([&] {
+            for (int present = 0; present < PRESENTS; ++present)
+                timer.record_present();
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(timer.get_present_count(), presents + THREADS * PRESENTS);
+
+    std::vector<FrameSample> samples(FrameTimer::CAPACITY);
+    ASSERT_EQ(timer.copy_samples(samples), FrameTimer::CAPACITY);
+}
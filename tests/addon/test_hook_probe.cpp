@@ -0,0 +1,70 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "hook_probe.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using trace_format::EventId;
+
+namespace
+{
+    uint64_t passed_calls(EventId event)
+    {
+        std::array<HookTotals, HOOK_COUNT> totals;
+        HookProbe::get_instance().collect(totals);
+        return totals[hook_index(event)].outcomes[static_cast<size_t>(HookOutcome::Passed)];
+    }
+}
+
+TEST(HookProbe, ExitedThreadsHandTheirBlockToTheNextThread)
+{
+    HookProbe& probe = HookProbe::get_instance();
+    const uint64_t calls = passed_calls(EventId::SetWindowPos);
+
+    // The first thread may need a new block, every later one takes over the block it left behind
+    std::thread([&] { probe.record(EventId::SetWindowPos, HookOutcome::Passed, 10); }).join();
+    const size_t blocks = probe.get_thread_block_count();
+    for (int i = 0; i < 100; ++i)
+        std::thread([&] { probe.record(EventId::SetWindowPos, HookOutcome::Passed, 10); }).join();
+
+    EXPECT_EQ(probe.get_thread_block_count(), blocks);
+
+    // The counts of the exited threads are kept
+    EXPECT_EQ(passed_calls(EventId::SetWindowPos), calls + 101);
+}
+
+TEST(HookProbe, LiveThreadsNeverShareABlock)
+{
+    HookProbe& probe = HookProbe::get_instance();
+    const uint64_t calls = passed_calls(EventId::AdjustWindowRect);
+
+    constexpr int THREADS = 8;
+    constexpr int CALLS_PER_THREAD = 10000;
+    std::atomic<int> started = 0;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < THREADS; ++i)
+    {
+        threads.emplace_back([&] {
+            // Every thread owns its block before any of them exits
+            probe.record(EventId::AdjustWindowRect, HookOutcome::Passed, 10);
+            started.fetch_add(1);
+            while (started.load() < THREADS)
+                std::this_thread::yield();
+
+            for (int call = 1; call < CALLS_PER_THREAD; ++call)
+                probe.record(EventId::AdjustWindowRect, HookOutcome::Passed, 10);
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+
+    // Increments are plain load/store pairs, a shared block would lose some of them
+    EXPECT_EQ(passed_calls(EventId::AdjustWindowRect), calls + THREADS * CALLS_PER_THREAD);
+    EXPECT_GE(probe.get_thread_block_count(), static_cast<size_t>(THREADS));
+}
@@ -0,0 +1,181 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "addon_fixture.h"
+#include "frame_timer.h"
+#include "hook_probe.h"
+#include "stats_exporter.h"
+#include <chrono>
+#include <cstdio>
+#include <fcntl.h>
+#include <string>
+#include <sys/mman.h>
+#include <thread>
+#include <unistd.h>
+
+using namespace reshade_mock;
+
+namespace
+{
+    // Opens the published block the way stats_monitor does, through a separate POSIX shared memory mapping
+    class SharedStats
+    {
+    public:
+        ~SharedStats()
+        {
+            if (view_ != nullptr)
+                munmap(view_, sizeof(stats_block::Block));
+        }
+
+        bool open()
+        {
+            const std::string name = "/" + std::string(stats_block::NAME_PREFIX) + std::to_string(getpid());
+            const int fd = shm_open(name.c_str(), O_RDONLY, 0);
+            if (fd < 0)
+                return false;
+
+            void* view = mmap(nullptr, sizeof(stats_block::Block), PROT_READ, MAP_SHARED, fd, 0);
+            close(fd);
+            view_ = view != MAP_FAILED ? view : nullptr;
+            return view_ != nullptr;
+        }
+
+        // Wait for a publish that satisfies done, the exporter publishes every PUBLISH_INTERVAL_MS
+        template <typename Done>
+        bool wait_for(stats_block::Stats& out_stats, Done done) const
+        {
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+            while (std::chrono::steady_clock::now() < deadline)
+            {
+                if (stats_block::read(*static_cast<const stats_block::Block*>(view_), out_stats) && done(out_stats))
+                    return true;
+                std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            }
+            return false;
+        }
+
+    private:
+        void* view_ = nullptr;
+    };
+}
+
+class StatsExporterTest : public AddonTest
+{
+protected:
+    void SetUp() override
+    {
+        AddonTest::SetUp();
+        configure("ExportStats", "1");
+    }
+
+    void TearDown() override
+    {
+        StatsExporter::get_instance().uninstall();
+        AddonTest::TearDown();
+    }
+
+    static void start()
+    {
+        install();
+
+        // ticks_per_microsecond() needs a millisecond of calibration
+        HookProbe::get_instance().install();
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        StatsExporter::get_instance().install();
+    }
+
+    static void present_frames(MockGame& game, size_t count)
+    {
+        for (size_t frame = 0; frame < count; ++frame)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            game.present();
+        }
+    }
+};
+
+TEST_F(StatsExporterTest, FrameTimePercentilesRoundTripThroughSharedMemory)
+{
+    start();
+    SharedStats shared;
+    ASSERT_TRUE(shared.open());
+
+    MockGame game;
+    game.create_swapchain(1920, 1080);
+    // Enough frames to replace every sample other tests left in the ring
+    const uint64_t presents = FrameTimer::get_instance().get_present_count();
+    present_frames(game, FrameTimer::CAPACITY + 1);
+
+    stats_block::Stats stats;
+    ASSERT_TRUE(shared.wait_for(stats, [&](const stats_block::Stats& published) {
+        return published.present_count >= presents + FrameTimer::CAPACITY + 1;
+    }));
+
+    const stats_block::FrameStats& frames = stats.frames;
+    EXPECT_EQ(frames.sample_count, FrameTimer::CAPACITY);
+    EXPECT_GE(frames.frame_time_p50_us, 900u);
+    EXPECT_LT(frames.frame_time_p50_us, 1000000u);
+    EXPECT_LE(frames.frame_time_p50_us, frames.frame_time_p99_us);
+    EXPECT_LE(frames.frame_time_p99_us, frames.frame_time_p999_us);
+    EXPECT_LE(frames.frame_time_p999_us, frames.frame_time_max_us);
+    EXPECT_GT(frames.addon_time_avg_ns, 0u);
+
+    ASSERT_EQ(stats.swapchain_count, 1u);
+    EXPECT_EQ(stats.swapchains[0].requested_width, 1920u);
+    EXPECT_EQ(stats.swapchains[0].actual_width, 3840u);
+    EXPECT_EQ(stats.swapchains[0].override_active, 1u);
+}
+
+TEST_F(StatsExporterTest, PresentsAreCountedWithoutThePresentHook)
+{
+    // Nothing to override, only finish_present is registered
+    configure("ForceSwapchainResolution", "0x0");
+    start();
+    ASSERT_EQ(registered<reshade::addon_event::present>(), nullptr);
+    SharedStats shared;
+    ASSERT_TRUE(shared.open());
+
+    MockGame game;
+    game.create_swapchain(1920, 1080);
+    const uint64_t presents = FrameTimer::get_instance().get_present_count();
+    present_frames(game, 10);
+
+    stats_block::Stats stats;
+    EXPECT_TRUE(shared.wait_for(stats, [&](const stats_block::Stats& published) {
+        return published.present_count >= presents + 10 && published.frames.sample_count != 0;
+    }));
+}
+
+#ifdef STATS_MONITOR_PATH
+TEST_F(StatsExporterTest, StatsMonitorReadsThePublishedFrameTimes)
+{
+    start();
+    MockGame game;
+    game.create_swapchain(1920, 1080);
+    const uint64_t presents = FrameTimer::get_instance().get_present_count();
+    present_frames(game, 10);
+
+    SharedStats shared;
+    ASSERT_TRUE(shared.open());
+    stats_block::Stats stats;
+    ASSERT_TRUE(shared.wait_for(stats, [&](const stats_block::Stats& published) {
+        return published.present_count >= presents + 10;
+    }));
+
+    // A second process opens the object by name
+    const std::string command = std::string(STATS_MONITOR_PATH) + " " + std::to_string(getpid());
+    FILE* output = popen(command.c_str(), "r");
+    ASSERT_NE(output, nullptr);
+    std::string text;
+    char buffer[256];
+    while (fgets(buffer, sizeof(buffer), output) != nullptr)
+        text += buffer;
+    EXPECT_EQ(pclose(output), 0);
+
+    EXPECT_NE(text.find("Frame time (last"), std::string::npos) << text;
+    EXPECT_NE(text.find("requested 1920x1080"), std::string::npos) << text;
+}
+#endif
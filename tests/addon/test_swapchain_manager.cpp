@@ -0,0 +1,365 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "addon_fixture.h"
+#include "mock_win32.h"
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+using namespace reshade_mock;
+using reshade::addon_event;
+
+TEST_F(AddonTest, OverrideRegistersTheRedirectHooks)
+{
+    install();
+    EXPECT_NE(registered<addon_event::create_swapchain>(), nullptr);
+    EXPECT_NE(registered<addon_event::bind_render_targets_and_depth_stencil>(), nullptr);
+    EXPECT_NE(registered<addon_event::present>(), nullptr);
+    EXPECT_EQ(registered<addon_event::init_device>(), nullptr);
+}
+
+
+TEST_F(AddonTest, CreateSwapchainForcesTheSizeAndBuildsProxies)
+{
+    install();
+    MockGame game;
+    const size_t application_resources = 2;
+
+    ASSERT_TRUE(game.create_swapchain(1920, 1080));
+    EXPECT_EQ(game.swapchain().width(), 3840u);
+    EXPECT_EQ(game.swapchain().height(), 2160u);
+    EXPECT_EQ(swapchain_state(), SwapchainState::Active);
+
+    // One proxy per back buffer at the requested size
+    EXPECT_EQ(game.device().live_resource_count(), application_resources + 2);
+    SwapchainManager::get_instance().for_each_swapchain([](SwapchainNativeHandle, const SwapchainData& data) {
+        EXPECT_EQ(data.original_width, 1920u);
+        EXPECT_EQ(data.original_height, 1080u);
+        EXPECT_EQ(data.proxy_textures.size(), 2u);
+    });
+}
+
+TEST_F(AddonTest, MatchingSizeSkipsTheProxies)
+{
+    install();
+    MockGame game;
+    EXPECT_FALSE(game.create_swapchain(3840, 2160));
+    EXPECT_EQ(swapchain_state(), SwapchainState::Passthrough);
+    EXPECT_EQ(game.device().calls().count(Call::CreateResource), 0u);
+}
+
+TEST_F(AddonTest, BackBufferBindIsRedirectedToTheProxy)
+{
+    install();
+    MockGame game;
+    game.create_swapchain(1920, 1080);
+
+    const resource_view back_buffer = game.current_back_buffer_rtv();
+    ASSERT_TRUE(dispatch<addon_event::bind_render_targets_and_depth_stencil>(&game.cmd_list(), 1u, &back_buffer, resource_view {}));
+    ASSERT_EQ(game.cmd_list().bound_render_targets().size(), 1u);
+    EXPECT_NE(game.cmd_list().bound_render_targets()[0].handle, back_buffer.handle);
+
+    // Any other render target is left alone
+    const resource_view other = game.device().create_render_target_view(game.device().create_texture(512, 512, format::r8g8b8a8_unorm));
+    const uint64_t binds = game.device().calls().count(Call::BindRenderTargets);
+    dispatch<addon_event::bind_render_targets_and_depth_stencil>(&game.cmd_list(), 1u, &other, resource_view {});
+    EXPECT_EQ(game.device().calls().count(Call::BindRenderTargets), binds);
+}
+
+TEST_F(AddonTest, FullViewportAndScissorAreScaledToTheProxies)
+{
+    install();
+    MockGame game;
+    game.create_swapchain(1920, 1080);
+
+    const viewport full = { 0.0f, 0.0f, 3840.0f, 2160.0f, 0.0f, 1.0f };
+    dispatch<addon_event::bind_viewports>(&game.cmd_list(), 0u, 1u, &full);
+    ASSERT_EQ(game.cmd_list().bound_viewports().size(), 1u);
+    EXPECT_FLOAT_EQ(game.cmd_list().bound_viewports()[0].width, 1920.0f);
+    EXPECT_FLOAT_EQ(game.cmd_list().bound_viewports()[0].height, 1080.0f);
+
+    const rect scissor = { 0, 0, 3840, 2160 };
+    dispatch<addon_event::bind_scissor_rects>(&game.cmd_list(), 0u, 1u, &scissor);
+    ASSERT_EQ(game.cmd_list().bound_scissor_rects().size(), 1u);
+    EXPECT_EQ(game.cmd_list().bound_scissor_rects()[0].right, 1920);
+    EXPECT_EQ(game.cmd_list().bound_scissor_rects()[0].bottom, 1080);
+}
+
+TEST_F(AddonTest, PresentDrawsTheProxyIntoTheBackBuffer)
+{
+    install();
+    MockGame game;
+    game.create_swapchain(1920, 1080);
+    const size_t views = game.device().live_view_count();
+
+    game.present();
+    EXPECT_EQ(game.device().calls().count(Call::Draw), 1u);
+    EXPECT_EQ(game.device().calls().count(Call::Barrier), 4u);
+    ASSERT_EQ(game.cmd_list().bound_viewports().size(), 1u);
+    EXPECT_FLOAT_EQ(game.cmd_list().bound_viewports()[0].width, 3840.0f);
+
+    // The temporary back buffer view does not outlive the present
+    EXPECT_EQ(game.device().live_view_count(), views);
+}
+
+TEST_F(AddonTest, PresentMeasuresTheScalePass)
+{
+    install();
+    MockGame game;
+    game.create_swapchain(1920, 1080);
+
+    for (int frame = 0; frame < 8; ++frame)
+        game.present();
+    EXPECT_GT(SwapchainManager::get_instance().get_scale_pass_gpu_ns(), 0u);
+}
+
+TEST_F(AddonTest, ResizeToTheSameSizeKeepsTheProxies)
+{
+    install();
+    MockGame game;
+    game.create_swapchain(1920, 1080);
+    const uint64_t created = game.device().calls().count(Call::CreateResource);
+
+    const uint64_t avoided = SwapchainManager::get_instance().get_avoided_rebuild_count();
+
+    game.resize(1920, 1080);
+    EXPECT_EQ(swapchain_state(), SwapchainState::Active);
+    EXPECT_EQ(game.device().calls().count(Call::CreateResource), created);
+    EXPECT_EQ(SwapchainManager::get_instance().get_avoided_rebuild_count(), avoided + 1);
+
+    // The new back buffers are redirected
+    const resource_view back_buffer = game.current_back_buffer_rtv();
+    dispatch<addon_event::bind_render_targets_and_depth_stencil>(&game.cmd_list(), 1u, &back_buffer, resource_view {});
+    EXPECT_NE(game.cmd_list().bound_render_targets()[0].handle, back_buffer.handle);
+}
+
+TEST_F(AddonTest, ResizeToAnotherSizeRebuildsTheProxies)
+{
+    install();
+    MockGame game;
+    game.create_swapchain(1920, 1080);
+
+    game.resize(1280, 720);
+    EXPECT_EQ(swapchain_state(), SwapchainState::Active);
+    SwapchainManager::get_instance().for_each_swapchain([](SwapchainNativeHandle, const SwapchainData& data) {
+        EXPECT_EQ(data.original_width, 1280u);
+        EXPECT_EQ(data.original_height, 720u);
+    });
+}
+
+TEST_F(AddonTest, ResizeDebounceRebuildsOnceTheSizeIsStable)
+{
+    configure("ResizeDebounce", "100ms");
+    install();
+    SwapchainManager& manager = SwapchainManager::get_instance();
+    const uint64_t rebuilds = manager.get_debounced_rebuild_count();
+
+    win32_mock::set_tick_count(1000);
+    MockGame game;
+    game.create_swapchain(1920, 1080);
+    game.resize(1280, 720);
+    EXPECT_EQ(swapchain_state(), SwapchainState::Active);
+
+    win32_mock::set_tick_count(1050);
+    game.present();
+    EXPECT_EQ(manager.get_debounced_rebuild_count(), rebuilds);
+    EXPECT_EQ(game.device().calls().count(Call::WaitIdle), 0u);
+
+    win32_mock::set_tick_count(1100);
+    game.present();
+    EXPECT_EQ(manager.get_debounced_rebuild_count(), rebuilds + 1);
+    EXPECT_EQ(game.device().calls().count(Call::WaitIdle), 1u);
+    manager.for_each_swapchain([](SwapchainNativeHandle, const SwapchainData& data) {
+        EXPECT_EQ(data.original_width, 1280u);
+        EXPECT_EQ(data.original_height, 720u);
+        EXPECT_FALSE(data.resize_debounce.is_pending());
+    });
+
+    game.present();
+    EXPECT_EQ(manager.get_debounced_rebuild_count(), rebuilds + 1);
+}
+
+TEST_F(AddonTest, BindsAtTheResizedSizeAreScaledOntoTheProxiesWhileTheRebuildIsPending)
+{
+    configure("ResizeDebounce", "100ms");
+    install();
+
+    win32_mock::set_tick_count(1000);
+    MockGame game;
+    game.create_swapchain(1920, 1080);
+    game.resize(1280, 720);
+    SwapchainManager::get_instance().for_each_swapchain([](SwapchainNativeHandle, const SwapchainData& data) {
+        EXPECT_TRUE(data.resize_debounce.is_pending());
+    });
+
+    // The application draws at its new size, the proxies still have the old one
+    const viewport resized = { 0.0f, 0.0f, 1280.0f, 720.0f, 0.0f, 1.0f };
+    dispatch<addon_event::bind_viewports>(&game.cmd_list(), 0u, 1u, &resized);
+    ASSERT_EQ(game.cmd_list().bound_viewports().size(), 1u);
+    EXPECT_FLOAT_EQ(game.cmd_list().bound_viewports()[0].width, 1920.0f);
+    EXPECT_FLOAT_EQ(game.cmd_list().bound_viewports()[0].height, 1080.0f);
+
+    const rect scissor = { 0, 0, 1280, 720 };
+    dispatch<addon_event::bind_scissor_rects>(&game.cmd_list(), 0u, 1u, &scissor);
+    ASSERT_EQ(game.cmd_list().bound_scissor_rects().size(), 1u);
+    EXPECT_EQ(game.cmd_list().bound_scissor_rects()[0].right, 1920);
+    EXPECT_EQ(game.cmd_list().bound_scissor_rects()[0].bottom, 1080);
+
+    // Once the proxies have the new size the same viewport already fits them
+    win32_mock::set_tick_count(1100);
+    game.present();
+    const uint64_t binds = game.device().calls().count(Call::BindViewports);
+    dispatch<addon_event::bind_viewports>(&game.cmd_list(), 0u, 1u, &resized);
+    EXPECT_EQ(game.device().calls().count(Call::BindViewports), binds);
+}
+
+TEST_F(AddonTest, DebouncedRebuildDoesNotBlockBindsWhileWaitingForTheGpu)
+{
+    configure("ResizeDebounce", "1frames");
+    install();
+    MockGame game;
+    game.create_swapchain(1920, 1080);
+    game.resize(1280, 720);
+
+    // A bind from another thread must get through while the render thread waits for the GPU
+    std::thread binder;
+    std::atomic<bool> bound = false;
+    bool bound_during_wait = false;
+    game.queue().set_wait_idle_callback([&] {
+        binder = std::thread([&] {
+            const viewport full = { 0.0f, 0.0f, 3840.0f, 2160.0f, 0.0f, 1.0f };
+            dispatch<addon_event::bind_viewports>(&game.cmd_list(), 0u, 1u, &full);
+            bound.store(true);
+        });
+        for (int attempt = 0; attempt < 500 && !bound.load(); ++attempt)
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        bound_during_wait = bound.load();
+    });
+
+    game.present();
+    if (binder.joinable())
+        binder.join();
+    game.queue().set_wait_idle_callback(nullptr);
+
+    EXPECT_TRUE(bound_during_wait);
+    EXPECT_EQ(game.device().calls().count(Call::WaitIdle), 1u);
+    SwapchainManager::get_instance().for_each_swapchain([](SwapchainNativeHandle, const SwapchainData& data) {
+        EXPECT_EQ(data.original_width, 1280u);
+    });
+}
+
+TEST_F(AddonTest, ResizeBackDuringTheQuietPeriodKeepsTheProxies)
+{
+    // Relative forced size, the back buffers change size with every resize
+    configure("ForceSwapchainResolution", "150%");
+    configure("ResizeDebounce", "100ms");
+    install();
+    SwapchainManager& manager = SwapchainManager::get_instance();
+    const uint64_t avoided = manager.get_avoided_rebuild_count();
+    const uint64_t rebuilds = manager.get_debounced_rebuild_count();
+
+    win32_mock::set_tick_count(1000);
+    MockGame game;
+    game.create_swapchain(1920, 1080);
+    const uint64_t created = game.device().calls().count(Call::CreateResource);
+
+    game.resize(1280, 720);
+    game.resize(1920, 1080);
+    EXPECT_EQ(game.swapchain().width(), 2880u);
+    EXPECT_EQ(manager.get_avoided_rebuild_count(), avoided + 1);
+
+    // Nothing is left to rebuild once the quiet period has passed
+    win32_mock::set_tick_count(1200);
+    game.present();
+    EXPECT_EQ(manager.get_debounced_rebuild_count(), rebuilds);
+    EXPECT_EQ(game.device().calls().count(Call::WaitIdle), 0u);
+    manager.for_each_swapchain([](SwapchainNativeHandle, const SwapchainData& data) {
+        EXPECT_EQ(data.original_width, 1920u);
+        EXPECT_EQ(data.original_height, 1080u);
+        EXPECT_FALSE(data.resize_debounce.is_pending());
+    });
+
+    // The proxies are the ones from the start
+    EXPECT_EQ(game.device().calls().count(Call::CreateResource), created);
+}
+
+TEST_F(AddonTest, SwapchainGenerationOnlyMovesWhenTheListChanges)
+{
+    install();
+    SwapchainManager& manager = SwapchainManager::get_instance();
+    MockGame game;
+
+    uint64_t generation = manager.get_swapchain_generation();
+    game.create_swapchain(1920, 1080);
+    EXPECT_GT(manager.get_swapchain_generation(), generation);
+
+    // The overlay keeps its copy of the list over frames that only render and present
+    generation = manager.get_swapchain_generation();
+    const resource_view back_buffer = game.current_back_buffer_rtv();
+    for (int frame = 0; frame < 4; ++frame)
+    {
+        dispatch<addon_event::bind_render_targets_and_depth_stencil>(&game.cmd_list(), 1u, &back_buffer, resource_view {});
+        game.present();
+    }
+    EXPECT_EQ(manager.get_swapchain_generation(), generation);
+
+    game.resize(1280, 720);
+    EXPECT_GT(manager.get_swapchain_generation(), generation);
+
+    generation = manager.get_swapchain_generation();
+    game.destroy_swapchain();
+    EXPECT_GT(manager.get_swapchain_generation(), generation);
+}
+
+TEST_F(AddonTest, DestroyReleasesEverythingTheAddonCreated)
+{
+    install();
+    MockGame game;
+    game.create_swapchain(1920, 1080);
+    game.present();
+    game.destroy_swapchain();
+
+    EXPECT_EQ(swapchain_count(), 0u);
+    EXPECT_EQ(game.device().live_resource_count(), 0u);
+    EXPECT_EQ(game.device().live_view_count(), 0u);
+    EXPECT_EQ(game.device().live_object_count(), 0u);
+}
+
+TEST_F(AddonTest, FailedProxyCreationFallsBackToFewerProxies)
+{
+    install();
+    SwapchainManager& manager = SwapchainManager::get_instance();
+    const uint64_t fallbacks = manager.get_proxy_fallback_count(ProxyFallbackStep::FewerProxies);
+
+    MockGame game;
+    game.device().fail_next_resources(1);
+    game.create_swapchain(1920, 1080, 3);
+
+    EXPECT_EQ(swapchain_state(), SwapchainState::Active);
+    EXPECT_EQ(manager.get_proxy_fallback_count(ProxyFallbackStep::FewerProxies), fallbacks + 1);
+}
+
+TEST_F(AddonTest, LowerSizeFallbackEndsWithTheSwapchain)
+{
+    configure("ProxyFallback", "lower-size");
+    install();
+    SwapchainManager& manager = SwapchainManager::get_instance();
+    const uint64_t fallbacks = manager.get_proxy_fallback_count(ProxyFallbackStep::LowerSize);
+
+    MockGame game;
+    game.device().fail_next_resources(1);
+    game.create_swapchain(1920, 1080);
+    EXPECT_EQ(swapchain_state(), SwapchainState::Passthrough);
+    EXPECT_EQ(manager.get_proxy_fallback_count(ProxyFallbackStep::LowerSize), fallbacks + 1);
+
+    // Recreated without the proxies that failed, the window gets the full forced size again
+    game.destroy_swapchain();
+    game.create_swapchain(1920, 1080);
+    EXPECT_EQ(game.swapchain().width(), 3840u);
+    EXPECT_EQ(game.swapchain().height(), 2160u);
+    EXPECT_EQ(swapchain_state(), SwapchainState::Active);
+}
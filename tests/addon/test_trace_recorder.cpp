@@ -0,0 +1,188 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "addon_fixture.h"
+#include "mock_win32.h"
+#include "trace_recorder.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <thread>
+
+namespace
+{
+    using trace_format::EventId;
+
+    struct TraceFile
+    {
+        trace_format::Header header = {};
+        std::vector<trace_format::Record> records;
+    };
+
+    TraceFile read_trace(const std::filesystem::path& path)
+    {
+        TraceFile trace;
+        FILE* file = std::fopen(path.string().c_str(), "rb");
+        if (file == nullptr)
+            return trace;
+
+        if (std::fread(&trace.header, sizeof(trace.header), 1, file) == 1)
+        {
+            trace_format::Record record;
+            while (std::fread(&record, sizeof(record), 1, file) == 1)
+                trace.records.push_back(record);
+        }
+        std::fclose(file);
+        return trace;
+    }
+
+    void record_events(size_t count, uint64_t first_arg = 0)
+    {
+        for (size_t i = 0; i < count; ++i)
+        {
+            const uint64_t args[4] = { first_arg + i, 0, 0, 0 };
+            TraceRecorder::get_instance().record(EventId::BindViewports, 0, HookOutcome::Passed, TraceRecorder::timestamp(), args);
+        }
+    }
+
+    // Run body on a separate "game" thread, returns false if it did not finish within the timeout
+    template <typename Body>
+    bool finishes_on_game_thread(Body body, std::thread::id& out_thread)
+    {
+        std::atomic<bool> done = false;
+        std::thread game([&] {
+            body();
+            done = true;
+        });
+        out_thread = game.get_id();
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!done && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        const bool finished = done;
+        win32_mock::release_file_writes();
+        game.join();
+        return finished;
+    }
+
+    // DllMain at process exit while the writer is stuck in WriteFile, exits with 0 if uninstall did not wait for it
+    [[noreturn]] void exit_with_a_stuck_writer()
+    {
+        win32_mock::hold_file_writes();
+        std::thread::id game_thread;
+        finishes_on_game_thread([] { record_events(TraceRecorder::RECORDS_PER_BLOCK * 2); }, game_thread);
+
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (win32_mock::file_write_threads().empty() && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+        TraceRecorder::get_instance().uninstall(true);
+        std::_Exit(win32_mock::file_write_threads().empty() ? 1 : 0);
+    }
+}
+
+class TraceRecorderTest : public AddonTest
+{
+protected:
+    void SetUp() override
+    {
+        AddonTest::SetUp();
+        path_ = std::filesystem::temp_directory_path() / "swapchain_override_test.trace";
+        std::filesystem::remove(path_);
+
+        configure("TraceFile", path_.string().c_str());
+        Config::get_instance().load();
+        TraceRecorder::get_instance().install();
+        ASSERT_TRUE(TraceRecorder::get_instance().is_recording());
+        win32_mock::reset_file_write_threads();
+    }
+
+    void TearDown() override
+    {
+        win32_mock::release_file_writes();
+        TraceRecorder::get_instance().uninstall();
+        std::filesystem::remove(path_);
+        AddonTest::TearDown();
+    }
+
+    std::filesystem::path path_;
+};
+
+TEST_F(TraceRecorderTest, AllRecordsReachTheFile)
+{
+    constexpr size_t COUNT = TraceRecorder::RECORDS_PER_BLOCK * 3 + 5;
+    std::thread::id game_thread;
+    ASSERT_TRUE(finishes_on_game_thread([] { record_events(COUNT); }, game_thread));
+    record_events(7, 1000000);
+    TraceRecorder::get_instance().uninstall();
+
+    const TraceFile trace = read_trace(path_);
+    EXPECT_EQ(trace.header.magic, trace_format::MAGIC);
+    EXPECT_EQ(trace.header.record_size, sizeof(trace_format::Record));
+    ASSERT_EQ(trace.records.size(), COUNT + 7);
+
+    // Blocks of one thread are written in the order they filled up
+    std::vector<uint64_t> game_args;
+    for (const trace_format::Record& record : trace.records)
+    {
+        if (record.args[0] < 1000000)
+            game_args.push_back(record.args[0]);
+    }
+    ASSERT_EQ(game_args.size(), COUNT);
+    EXPECT_TRUE(std::is_sorted(game_args.begin(), game_args.end()));
+    EXPECT_EQ(TraceRecorder::get_instance().get_dropped_records(), 0u);
+}
+
+TEST_F(TraceRecorderTest, HookThreadNeverWritesTheFile)
+{
+    // A stalled disk must not stall the game: full blocks wait for the writer, the hook thread moves on
+    win32_mock::hold_file_writes();
+
+    std::thread::id game_thread;
+    EXPECT_TRUE(finishes_on_game_thread([] { record_events(TraceRecorder::RECORDS_PER_BLOCK * 4); }, game_thread));
+    TraceRecorder::get_instance().uninstall();
+
+    const std::vector<std::thread::id> writers = win32_mock::file_write_threads();
+    EXPECT_FALSE(writers.empty());
+    EXPECT_EQ(std::count(writers.begin(), writers.end(), game_thread), 0);
+    EXPECT_EQ(read_trace(path_).records.size(), TraceRecorder::RECORDS_PER_BLOCK * 4);
+}
+
+TEST_F(TraceRecorderTest, RecordsAreDroppedWhenTheWriterFallsBehind)
+{
+    win32_mock::hold_file_writes();
+
+    constexpr size_t COUNT = TraceRecorder::RECORDS_PER_BLOCK * (TraceRecorder::MAX_BLOCKS + 2);
+    std::thread::id game_thread;
+    EXPECT_TRUE(finishes_on_game_thread([] { record_events(COUNT); }, game_thread));
+
+    const uint64_t dropped = TraceRecorder::get_instance().get_dropped_records();
+    EXPECT_GT(dropped, 0u);
+    TraceRecorder::get_instance().uninstall();
+
+    EXPECT_EQ(read_trace(path_).records.size() + dropped, COUNT);
+    EXPECT_TRUE(reshade_mock::has_logged("dropped because the writer fell behind"));
+}
+
+TEST_F(TraceRecorderTest, ProcessExitWritesThePartialBlocksItself)
+{
+    record_events(5);
+    TraceRecorder::get_instance().uninstall(true);
+    EXPECT_FALSE(TraceRecorder::get_instance().is_recording());
+    EXPECT_EQ(read_trace(path_).records.size(), 5u);
+}
+
+// In a child process, the stuck writer is never released. The writer thread already runs, so the
+// child re-executes the test instead of forking it.
+TEST_F(TraceRecorderTest, ProcessExitDoesNotWaitForTheWriter)
+{
+    ::testing::FLAGS_gtest_death_test_style = "threadsafe";
+    EXPECT_EXIT(exit_with_a_stuck_writer(), ::testing::ExitedWithCode(0), "");
+}
@@ -0,0 +1,234 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "addon_fixture.h"
+#include "trace_recorder.h"
+#include "trace_replay.h"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <tuple>
+#include <vector>
+
+using namespace reshade_mock;
+using reshade::addon_event;
+using trace_format::EventId;
+
+namespace
+{
+    // What the handlers decided, without handles and timestamps
+    using Decision = std::tuple<EventId, uint16_t, uint8_t, uint64_t, uint64_t>;
+
+    std::vector<Decision> decisions(const Trace& trace)
+    {
+        std::vector<Decision> result;
+        for (const trace_format::Record& record : trace.records)
+        {
+            switch (record.event)
+            {
+            case EventId::CreateSwapchain:
+                result.emplace_back(record.event, record.result, record.outcome, record.args[1], record.args[3]);
+                break;
+            case EventId::SetFullscreenState:
+                result.emplace_back(record.event, record.result, record.outcome, record.args[1], 0);
+                break;
+            case EventId::BindViewports:
+            case EventId::BindScissorRects:
+            case EventId::Present:
+                result.emplace_back(record.event, record.result, record.outcome, 0, 0);
+                break;
+            default:
+                break;
+            }
+        }
+        return result;
+    }
+}
+
+class TraceReplayTest : public AddonTest
+{
+protected:
+    void SetUp() override
+    {
+        AddonTest::SetUp();
+        recorded_path_ = std::filesystem::temp_directory_path() / "swapchain_override_recorded.trace";
+        replayed_path_ = std::filesystem::temp_directory_path() / "swapchain_override_replayed.trace";
+    }
+
+    void TearDown() override
+    {
+        TraceRecorder::get_instance().uninstall();
+        std::filesystem::remove(recorded_path_);
+        std::filesystem::remove(replayed_path_);
+        AddonTest::TearDown();
+    }
+
+    // Run session with the addon installed and TraceFile set to path, then read the trace back
+    template <typename Session>
+    static Trace record(const std::filesystem::path& path, Session session)
+    {
+        std::filesystem::remove(path);
+        configure("TraceFile", path.string().c_str());
+        install();
+        TraceRecorder::get_instance().install();
+
+        session();
+
+        SwapchainManager::get_instance().uninstall();
+        SwapchainManager::get_instance().cleanup_all();
+        TraceRecorder::get_instance().uninstall();
+
+        Trace trace;
+        std::string error;
+        EXPECT_TRUE(load_trace(path.string().c_str(), trace, error)) << error;
+        return trace;
+    }
+
+    // A window drag, a few frames with binds and a blocked fullscreen switch
+    static void play_session()
+    {
+        MockGame game;
+        game.create_swapchain(1920, 1080);
+        for (uint32_t frame = 0; frame < 3; ++frame)
+        {
+            const resource_view back_buffer = game.current_back_buffer_rtv();
+            const viewport full = { 0.0f, 0.0f, 3840.0f, 2160.0f, 0.0f, 1.0f };
+            const rect scissor = { 0, 0, 512, 512 };
+            dispatch<addon_event::bind_render_targets_and_depth_stencil>(&game.cmd_list(), 1u, &back_buffer, resource_view {});
+            dispatch<addon_event::bind_viewports>(&game.cmd_list(), 0u, 1u, &full);
+            dispatch<addon_event::bind_scissor_rects>(&game.cmd_list(), 0u, 1u, &scissor);
+            game.present();
+        }
+
+        game.resize(1280, 720);
+        game.present();
+        dispatch<addon_event::set_fullscreen_state>(&game.swapchain(), true, nullptr);
+        game.present();
+        game.destroy_swapchain();
+    }
+
+    std::filesystem::path recorded_path_;
+    std::filesystem::path replayed_path_;
+};
+
+TEST_F(TraceReplayTest, ReplayReachesTheSameDecisions)
+{
+    configure("BlockFullscreenChanges", "1");
+    const Trace recorded = record(recorded_path_, play_session);
+    ASSERT_FALSE(recorded.records.empty());
+
+    TraceReplay::Summary summary;
+    const Trace replayed = record(replayed_path_, [&] { summary = TraceReplay().replay(recorded); });
+    EXPECT_EQ(summary.skipped, 0u);
+    EXPECT_EQ(summary.replayed, recorded.records.size());
+
+    const std::vector<Decision> expected = decisions(recorded);
+    EXPECT_EQ(decisions(replayed), expected);
+    EXPECT_EQ(std::count_if(expected.begin(), expected.end(), [](const Decision& decision) {
+        return std::get<0>(decision) == EventId::CreateSwapchain;
+    }), 2);
+    EXPECT_NE(std::find(expected.begin(), expected.end(), Decision { EventId::SetFullscreenState, 1,
+        static_cast<uint8_t>(HookOutcome::Rewritten), 1, 0 }), expected.end());
+}
+
+TEST_F(TraceReplayTest, ReplayRunsTheHandlersOfTheCurrentConfiguration)
+{
+    const Trace recorded = record(recorded_path_, play_session);
+
+    configure("ForceSwapchainResolution", "2560x1440");
+    const Trace replayed = record(replayed_path_, [&] { TraceReplay().replay(recorded); });
+
+    std::vector<uint64_t> created;
+    for (const trace_format::Record& record : replayed.records)
+    {
+        if (record.event == EventId::CreateSwapchain)
+            created.push_back(record.args[3]);
+    }
+    EXPECT_EQ(created, (std::vector<uint64_t> { trace_format::pack(2560u, 1440u), trace_format::pack(2560u, 1440u) }));
+}
+
+TEST_F(TraceReplayTest, RecordsOfUnknownSwapchainsAreSkipped)
+{
+    Trace trace;
+    trace.header.ticks_per_second = 1000;
+    trace_format::Record present = {};
+    present.event = EventId::Present;
+    present.args[1] = 0x1234;
+    trace.records.push_back(present);
+
+    install();
+    const TraceReplay::Summary summary = TraceReplay().replay(trace);
+    EXPECT_EQ(summary.replayed, 0u);
+    EXPECT_EQ(summary.skipped, 1u);
+}
+
+#ifdef TRACE_REPORT_PATH
+namespace
+{
+    size_t count_of(const std::string& text, const std::string& substring)
+    {
+        size_t count = 0;
+        for (size_t position = text.find(substring); position != std::string::npos; position = text.find(substring, position + 1))
+            ++count;
+        return count;
+    }
+
+    // Brackets outside of strings close in order, enough to catch a broken separator or a missing end
+    bool is_balanced_json(const std::string& text)
+    {
+        std::string open;
+        bool in_string = false;
+        for (size_t i = 0; i < text.size(); ++i)
+        {
+            const char c = text[i];
+            if (in_string)
+            {
+                if (c == '\\')
+                    ++i;
+                else if (c == '"')
+                    in_string = false;
+            }
+            else if (c == '"')
+                in_string = true;
+            else if (c == '{' || c == '[')
+                open.push_back(c);
+            else if (c == '}' || c == ']')
+            {
+                if (open.empty() || open.back() != (c == '}' ? '{' : '['))
+                    return false;
+                open.pop_back();
+            }
+        }
+        return open.empty() && !in_string;
+    }
+}
+
+// The exported file is what Perfetto and chrome://tracing load, one slice per recorded hook call
+TEST_F(TraceReplayTest, ChromeExportHasASlicePerRecord)
+{
+    const Trace recorded = record(recorded_path_, play_session);
+    ASSERT_FALSE(recorded.records.empty());
+
+    const std::string command = std::string(TRACE_REPORT_PATH) + " --chrome " + recorded_path_.string();
+    FILE* output = popen(command.c_str(), "r");
+    ASSERT_NE(output, nullptr);
+    std::string json;
+    char buffer[4096];
+    while (fgets(buffer, sizeof(buffer), output) != nullptr)
+        json += buffer;
+    EXPECT_EQ(pclose(output), 0);
+
+    EXPECT_TRUE(is_balanced_json(json));
+    EXPECT_EQ(json.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0), 0u);
+    EXPECT_EQ(count_of(json, "\"ph\":\"X\""), recorded.records.size());
+    EXPECT_EQ(count_of(json, "\"name\":\"create_swapchain\""), 2u);
+
+    // Redirected binds and the proxy memory after each init and destroy become counter tracks
+    EXPECT_GT(count_of(json, "\"name\":\"overrides (thread "), 0u);
+    EXPECT_GT(count_of(json, "\"name\":\"proxy memory (MiB)\""), 0u);
+}
+#endif
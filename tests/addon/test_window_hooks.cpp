@@ -0,0 +1,193 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "addon_fixture.h"
+#include "window_hooks.h"
+#include "async_log.h"
+#include <atomic>
+#include <thread>
+
+namespace
+{
+    // What a game calling SetWindowLongW would run: the detour while it is installed, user32 otherwise
+    LONG game_set_window_long(HWND hwnd, int index, LONG value)
+    {
+        void* const detour = safetyhook_mock::detour_for(reinterpret_cast<void*>(SetWindowLongW));
+        if (detour == nullptr)
+            return SetWindowLongW(hwnd, index, value);
+        return reinterpret_cast<decltype(&SetWindowLongW)>(detour)(hwnd, index, value);
+    }
+
+    constexpr LONG WINDOWED_STYLE = static_cast<LONG>(WS_OVERLAPPEDWINDOW | WS_VISIBLE);
+}
+
+class WindowHooksTest : public AddonTest
+{
+protected:
+    void TearDown() override
+    {
+        while (installed_ > 0)
+            uninstall_hooks();
+        win32_mock::destroy_all_windows();
+        AddonTest::TearDown();
+    }
+
+    void install_hooks()
+    {
+        Config::get_instance().load();
+        ASSERT_TRUE(WindowHooks::get_instance().install());
+        ++installed_;
+    }
+
+    void uninstall_hooks()
+    {
+        WindowHooks::get_instance().uninstall();
+        --installed_;
+    }
+
+    static void reload(const char* fullscreen_mode)
+    {
+        configure("FullscreenMode", fullscreen_mode);
+        Config::get_instance().load();
+        WindowHooks::get_instance().refresh();
+    }
+
+    static LONG style_after_set(HWND hwnd)
+    {
+        game_set_window_long(hwnd, GWL_STYLE, WINDOWED_STYLE);
+        return GetWindowLongW(hwnd, GWL_STYLE);
+    }
+
+private:
+    int installed_ = 0;
+};
+
+TEST_F(WindowHooksTest, NoHooksWithoutBorderlessMode)
+{
+    install_hooks();
+    EXPECT_EQ(safetyhook_mock::detour_for(reinterpret_cast<void*>(SetWindowLongW)), nullptr);
+}
+
+TEST_F(WindowHooksTest, BorderlessRewritesTheWindowStyle)
+{
+    configure("FullscreenMode", "1");
+    install_hooks();
+
+    const HWND hwnd = win32_mock::create_window(WS_OVERLAPPEDWINDOW, 0, { 0, 0, 1280, 720 });
+    const auto before = win32_mock::user32_calls();
+    const LONG style = style_after_set(hwnd);
+
+    EXPECT_EQ(static_cast<DWORD>(style) & WS_OVERLAPPEDWINDOW, 0u);
+    EXPECT_NE(static_cast<DWORD>(style) & WS_POPUP, 0u);
+    EXPECT_EQ(win32_mock::user32_calls().set_window_long, before.set_window_long + 1);
+}
+
+TEST_F(WindowHooksTest, ReloadSwitchesModeWithoutReplacingTheHooks)
+{
+    configure("FullscreenMode", "1");
+    install_hooks();
+
+    void* const detour = safetyhook_mock::detour_for(reinterpret_cast<void*>(SetWindowLongW));
+    const auto installed = safetyhook_mock::installed_count();
+    const HWND hwnd = win32_mock::create_window(WS_OVERLAPPEDWINDOW, 0, { 0, 0, 1280, 720 });
+
+    // Borderless off: the detour stays and forwards the call untouched
+    reload("0");
+    EXPECT_EQ(safetyhook_mock::detour_for(reinterpret_cast<void*>(SetWindowLongW)), detour);
+    EXPECT_EQ(style_after_set(hwnd), WINDOWED_STYLE);
+
+    // And back on
+    reload("1");
+    EXPECT_EQ(safetyhook_mock::detour_for(reinterpret_cast<void*>(SetWindowLongW)), detour);
+    EXPECT_EQ(static_cast<DWORD>(style_after_set(hwnd)) & WS_OVERLAPPEDWINDOW, 0u);
+
+    EXPECT_EQ(safetyhook_mock::installed_count(), installed);
+}
+
+TEST_F(WindowHooksTest, ReloadInstallsTheHooksWhenFirstNeeded)
+{
+    install_hooks();
+    ASSERT_EQ(safetyhook_mock::detour_for(reinterpret_cast<void*>(SetWindowLongW)), nullptr);
+
+    reload("1");
+    EXPECT_NE(safetyhook_mock::detour_for(reinterpret_cast<void*>(SetWindowLongW)), nullptr);
+}
+
+TEST_F(WindowHooksTest, LastUninstallRemovesTheHooks)
+{
+    configure("FullscreenMode", "1");
+    install_hooks();
+    install_hooks();
+
+    uninstall_hooks();
+    EXPECT_NE(safetyhook_mock::detour_for(reinterpret_cast<void*>(SetWindowLongW)), nullptr);
+
+    uninstall_hooks();
+    EXPECT_EQ(safetyhook_mock::detour_for(reinterpret_cast<void*>(SetWindowLongW)), nullptr);
+}
+
+TEST_F(WindowHooksTest, GameThreadsKeepCallingWhileTheConfigIsReloaded)
+{
+    configure("FullscreenMode", "1");
+    install_hooks();
+
+    const HWND hwnd = win32_mock::create_window(WS_OVERLAPPEDWINDOW, 0, { 0, 0, 1280, 720 });
+    std::atomic<bool> stop = false;
+    std::atomic<uint64_t> calls = 0;
+
+    std::vector<std::thread> game_threads;
+    for (int thread = 0; thread < 4; ++thread)
+    {
+        game_threads.emplace_back([&] {
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                game_set_window_long(hwnd, GWL_STYLE, WINDOWED_STYLE);
+                calls.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    // The watcher thread flips the mode while the game threads are inside the detour
+    std::thread watcher([] {
+        for (int reload_index = 0; reload_index < 200; ++reload_index)
+            reload(reload_index % 2 == 0 ? "0" : "1");
+    });
+    watcher.join();
+
+    stop = true;
+    for (std::thread& thread : game_threads)
+        thread.join();
+
+    EXPECT_GT(calls.load(), 0u);
+    EXPECT_NE(safetyhook_mock::detour_for(reinterpret_cast<void*>(SetWindowLongW)), nullptr);
+}
+
+TEST_F(WindowHooksTest, DebugModeLogsTheCallsFromTheirRawArguments)
+{
+    configure("FullscreenMode", "1");
+    configure("DebugMode", "1");
+    install_hooks();
+    AsyncLog::get_instance().install();
+
+    const HWND hwnd = win32_mock::create_window(WS_OVERLAPPEDWINDOW, 0, { 0, 0, 1280, 720 });
+    EXPECT_EQ(style_after_set(hwnd), WINDOWED_STYLE);
+
+    const auto create_window = reinterpret_cast<decltype(&CreateWindowExW)>(
+        safetyhook_mock::detour_for(reinterpret_cast<void*>(CreateWindowExW)));
+    ASSERT_NE(create_window, nullptr);
+    create_window(0, L"Class", L"Game Window", WS_OVERLAPPEDWINDOW, 10, 20, 800, 600, nullptr, nullptr, nullptr, nullptr);
+
+    // Stopping the consumer flushes the queue
+    AsyncLog::get_instance().uninstall();
+
+    EXPECT_TRUE(reshade_mock::has_logged("=== SetWindowLongW (Debug Mode: No Override) ==="));
+    EXPECT_TRUE(reshade_mock::has_logged("  Index: -16 (GWL_STYLE)"));
+    EXPECT_TRUE(reshade_mock::has_logged("  Previous Value: 0x"));
+    EXPECT_TRUE(reshade_mock::has_logged("  Window Title: Game Window"));
+    EXPECT_TRUE(reshade_mock::has_logged("  Position: (10, 20)"));
+    EXPECT_TRUE(reshade_mock::has_logged("  Size: 800x600"));
+    EXPECT_TRUE(reshade_mock::has_logged("  Result HWND: 0x"));
+}
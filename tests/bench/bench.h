@@ -0,0 +1,47 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+// Minimal timing harness shared by the benchmarks. Results go to stdout, one line per case:
+//   <name> <iterations> iterations <ns> ns/op
+namespace bench
+{
+    // Iteration count from the first command line argument, so ctest can run a short smoke pass
+    inline uint64_t iterations_from_args(int argc, char* argv[], uint64_t default_iterations)
+    {
+        if (argc > 1)
+        {
+            const unsigned long long value = std::strtoull(argv[1], nullptr, 10);
+            if (value != 0)
+                return value;
+        }
+        return default_iterations;
+    }
+
+    // Run body() iterations times after a short warm-up and print the average time per call
+    template <typename Body>
+    double run(const char* name, uint64_t iterations, Body body)
+    {
+        for (uint64_t i = 0; i < iterations / 10 + 1; ++i)
+            body();
+
+        const auto start = std::chrono::steady_clock::now();
+        for (uint64_t i = 0; i < iterations; ++i)
+            body();
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+
+        const double ns_per_op = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+            static_cast<double>(iterations);
+        std::printf("%-48s %10llu iterations %10.1f ns/op\n", name, static_cast<unsigned long long>(iterations), ns_per_op);
+        return ns_per_op;
+    }
+}
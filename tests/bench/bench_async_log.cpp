@@ -0,0 +1,110 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+// Producer side cost of AsyncLog, what a debug mode hook pays per line while the thread pool
+// consumer drains into the (mock) ReShade log.
+//   bench_async_log [iterations]
+
+#include "bench.h"
+#include "async_log.h"
+#include "debug_logger.h"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // Shaped like the window hook arguments: a few integers and a short string
+    struct WindowArgs
+    {
+        char title[64];
+        DWORD style;
+        int x;
+        int y;
+        int width;
+        int height;
+
+        static void format(const WindowArgs& args, std::string& out)
+        {
+            char flags_text[decode::TEXT_BUFFER_SIZE];
+            out += "  Window Title: ";
+            out += args.title;
+            out += "\n  Style: ";
+            out += DebugLogger::get_instance().decode_window_style(args.style, flags_text);
+            out += "\n  Size: " + std::to_string(args.width) + "x" + std::to_string(args.height);
+        }
+    };
+
+    // Total producer throughput of several threads writing at once
+    template <typename Body>
+    void run_producers(const char* name, unsigned threads, uint64_t iterations, Body body)
+    {
+        std::atomic<bool> start = false;
+        std::vector<std::thread> producers;
+        for (unsigned thread = 0; thread < threads; ++thread)
+        {
+            producers.emplace_back([&] {
+                while (!start.load(std::memory_order_acquire))
+                    std::this_thread::yield();
+                for (uint64_t i = 0; i < iterations; ++i)
+                    body();
+            });
+        }
+
+        const auto begin = std::chrono::steady_clock::now();
+        start.store(true, std::memory_order_release);
+        for (std::thread& producer : producers)
+            producer.join();
+        const auto elapsed = std::chrono::steady_clock::now() - begin;
+
+        const uint64_t total = iterations * threads;
+        const double ns_per_op = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()) /
+            static_cast<double>(total);
+        std::printf("%-48s %10llu iterations %10.1f ns/op\n", name, static_cast<unsigned long long>(total), ns_per_op);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const uint64_t iterations = bench::iterations_from_args(argc, argv, 200000);
+
+    AsyncLog& log = AsyncLog::get_instance();
+    log.install();
+
+    const std::string short_line = "  Result: TRUE";
+    bench::run("write (short line)", iterations, [&] {
+        log.write(reshade::log::level::info, short_line);
+    });
+
+    const std::string long_line(1500, 'x');
+    bench::run("write (1500 chars, continuation records)", iterations, [&] {
+        log.write(reshade::log::level::info, long_line);
+    });
+
+    const WindowArgs args = { "Game Window", WS_OVERLAPPEDWINDOW, 0, 0, 1920, 1080 };
+    bench::run("write_deferred (window arguments)", iterations, [&] {
+        log.write_deferred(reshade::log::level::info, args);
+    });
+
+    bench::run("write_event", iterations, [&] {
+        log.write_event("SetWindowPos", 1, 0.0);
+    });
+
+    const unsigned threads = std::max(2u, std::min(8u, std::thread::hardware_concurrency()));
+    const std::string producers_name = "write (short line, " + std::to_string(threads) + " producers)";
+    run_producers(producers_name.c_str(), threads, iterations, [&] {
+        log.write(reshade::log::level::info, short_line);
+    });
+
+    const std::string deferred_name = "write_deferred (" + std::to_string(threads) + " producers)";
+    run_producers(deferred_name.c_str(), threads, iterations, [&] {
+        log.write_deferred(reshade::log::level::info, args);
+    });
+
+    log.uninstall();
+    return 0;
+}
@@ -0,0 +1,90 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+// Cost of the debug log decoders in core/decode_tables.h, with the ostringstream formatting
+// they replaced as a baseline.
+//   bench_decode [iterations]
+
+#include "bench.h"
+#include "core/decode_tables.h"
+#include <iomanip>
+#include <sstream>
+#include <string>
+
+namespace
+{
+    // Keeps the optimizer from dropping the formatted text
+    size_t g_sink = 0;
+
+    // Formatting before the tables: hex through a stream, names appended one by one
+    std::string stream_flags(uint32_t value, std::span<const decode::FlagName> flags)
+    {
+        std::ostringstream stream;
+        stream << "0x" << std::hex << std::uppercase << value << " (";
+        uint32_t remaining = value;
+        bool first = true;
+        for (const decode::FlagName& flag : flags)
+        {
+            if ((remaining & flag.mask) != flag.mask)
+                continue;
+            stream << (first ? "" : " | ") << flag.name;
+            remaining &= ~flag.mask;
+            first = false;
+        }
+        if (remaining != 0)
+            stream << (first ? "" : " | ") << "0x" << remaining;
+        stream << ")";
+        return stream.str();
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const uint64_t iterations = bench::iterations_from_args(argc, argv, 2000000);
+    char buffer[decode::TEXT_BUFFER_SIZE];
+
+    // WS_OVERLAPPEDWINDOW | WS_VISIBLE, the most common style a game window is created with
+    constexpr uint32_t STYLE = 0x10CF0000;
+    bench::run("window style (table)", iterations, [&] {
+        decode::TextWriter writer(buffer);
+        g_sink += decode::write_flags(writer, STYLE, decode::WINDOW_STYLES)[0];
+    });
+    bench::run("window style (ostringstream baseline)", iterations, [&] {
+        g_sink += stream_flags(STYLE, decode::WINDOW_STYLES).size();
+    });
+
+    // SWP_NOZORDER | SWP_NOACTIVATE | SWP_FRAMECHANGED
+    bench::run("SetWindowPos flags (table)", iterations, [&] {
+        decode::TextWriter writer(buffer);
+        g_sink += decode::write_flags(writer, 0x0034, decode::SET_WINDOW_POS_FLAGS)[0];
+    });
+
+    // Binary search over the sorted HRESULTs, a hit near the end and a miss
+    bench::run("HRESULT (known)", iterations, [&] {
+        decode::TextWriter writer(buffer);
+        g_sink += decode::write_hresult(writer, 0x887A0005)[0];
+    });
+    bench::run("HRESULT (unknown)", iterations, [&] {
+        decode::TextWriter writer(buffer);
+        g_sink += decode::write_hresult(writer, 0x80071234)[0];
+    });
+
+    // Direct index, and the short list after the dense range. The value changes every call
+    // so the lookup cannot be folded into a constant.
+    uint32_t format = 0;
+    bench::run("DXGI format (indexed)", iterations, [&] {
+        decode::TextWriter writer(buffer);
+        format = (format + 29) % 116;
+        g_sink += decode::write_dxgi_format(writer, format)[0];
+    });
+    bench::run("DXGI format (extended)", iterations, [&] {
+        decode::TextWriter writer(buffer);
+        format = 189 + (format + 1) % 3;
+        g_sink += decode::write_dxgi_format(writer, format)[0];
+    });
+
+    return g_sink == 0 ? 1 : 0;
+}
@@ -0,0 +1,70 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+// Cost of the event handlers on the application's render thread, measured through the callbacks
+// the addon registers, against the recording mock device.
+//   bench_handlers [iterations]
+
+#include "bench.h"
+#include "config.h"
+#include "swapchain_manager.h"
+#include "mock_game.h"
+
+using namespace reshade_mock;
+using reshade::addon_event;
+
+int main(int argc, char* argv[])
+{
+    const uint64_t iterations = bench::iterations_from_args(argc, argv, 200000);
+
+    // Defaults: 3840x2160 forced, the game asks for 1920x1080
+    Config::get_instance().load();
+    SwapchainManager& manager = SwapchainManager::get_instance();
+    manager.install();
+
+    MockGame game;
+    game.create_swapchain(1920, 1080);
+
+    const resource_view back_buffer = game.current_back_buffer_rtv();
+    bench::run("bind_render_targets (back buffer, redirected)", iterations, [&] {
+        dispatch<addon_event::bind_render_targets_and_depth_stencil>(&game.cmd_list(), 1u, &back_buffer, resource_view {});
+    });
+
+    const resource_view offscreen = game.device().create_render_target_view(game.device().create_texture(1024, 1024, format::r16g16b16a16_float));
+    bench::run("bind_render_targets (offscreen, passed)", iterations, [&] {
+        dispatch<addon_event::bind_render_targets_and_depth_stencil>(&game.cmd_list(), 1u, &offscreen, resource_view {});
+    });
+
+    const viewport full_viewport = { 0.0f, 0.0f, 3840.0f, 2160.0f, 0.0f, 1.0f };
+    bench::run("bind_viewports (full, redirected)", iterations, [&] {
+        dispatch<addon_event::bind_viewports>(&game.cmd_list(), 0u, 1u, &full_viewport);
+    });
+
+    const rect full_scissor = { 0, 0, 3840, 2160 };
+    bench::run("bind_scissor_rects (full, redirected)", iterations, [&] {
+        dispatch<addon_event::bind_scissor_rects>(&game.cmd_list(), 0u, 1u, &full_scissor);
+    });
+
+    bench::run("present + finish_present (scale pass)", iterations, [&] {
+        game.present();
+    });
+
+    // Every resize to a new size goes through initialize_swapchain and rebuilds the proxies
+    bool small = false;
+    bench::run("initialize_swapchain (resize, rebuild)", iterations / 100 + 1, [&] {
+        small = !small;
+        game.resize(small ? 1280 : 1920, small ? 720 : 1080);
+    });
+
+    bench::run("initialize_swapchain (resize, same size kept)", iterations / 100 + 1, [&] {
+        game.resize(small ? 1280 : 1920, small ? 720 : 1080);
+    });
+
+    game.destroy_swapchain();
+    manager.uninstall();
+    manager.cleanup_all();
+    return 0;
+}
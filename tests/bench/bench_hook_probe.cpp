@@ -0,0 +1,49 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+// Cost of the always-on hook counters: one record() per hook call on the calling thread,
+// the first record() of a new thread, and the collect() the overlay and the stats export run.
+//   bench_hook_probe [iterations]
+
+#include "bench.h"
+#include "hook_probe.h"
+#include <thread>
+
+using trace_format::EventId;
+
+int main(int argc, char* argv[])
+{
+    const uint64_t iterations = bench::iterations_from_args(argc, argv, 10000000);
+    HookProbe& probe = HookProbe::get_instance();
+    probe.install();
+
+    uint64_t elapsed = 1;
+    bench::run("record (thread block exists)", iterations, [&] {
+        probe.record(EventId::BindViewports, HookOutcome::Redirected, elapsed);
+        elapsed = elapsed * 3 % 100000;
+    });
+
+    bench::run("ticks (time stamp counter)", iterations, [&] {
+        elapsed += HookProbe::ticks() & 1;
+    });
+
+    // Includes the thread start and join, compare with the empty thread below
+    bench::run("new thread + first record (block reused)", iterations / 10000 + 1, [&] {
+        std::thread([&] { probe.record(EventId::SetWindowPos, HookOutcome::Passed, 10); }).join();
+    });
+
+    bench::run("new thread without record", iterations / 10000 + 1, [&] {
+        std::thread([] {}).join();
+    });
+
+    std::array<HookTotals, HOOK_COUNT> totals;
+    bench::run("collect", iterations / 1000 + 1, [&] {
+        probe.collect(totals);
+    });
+
+    std::printf("%zu thread blocks\n", probe.get_thread_block_count());
+    return 0;
+}
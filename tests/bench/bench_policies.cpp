@@ -0,0 +1,102 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+// Per-call cost of the hooks under each HookPolicy instantiation. Events a policy does not
+// register cost nothing, ReShade never calls into the addon for them.
+//   bench_policies [iterations]
+
+#include "bench.h"
+#include "config.h"
+#include "swapchain_manager.h"
+#include "mock_game.h"
+#include <string>
+
+using namespace reshade_mock;
+using reshade::addon_event;
+
+namespace
+{
+    struct PolicySetup
+    {
+        const char* name;
+        const char* resolution;
+        const char* fullscreen_mode;
+        const char* debug_mode;
+    };
+
+    constexpr PolicySetup POLICIES[] = {
+        { "disabled", "0x0", "0", "0" },
+        { "override", "3840x2160", "0", "0" },
+        { "override+borderless", "3840x2160", "1", "0" },
+        { "override+exclusive", "3840x2160", "2", "0" },
+        { "borderless", "0x0", "1", "0" },
+        { "exclusive", "0x0", "2", "0" },
+        { "debug", "3840x2160", "0", "1" },
+    };
+
+    template <addon_event ev, typename Body>
+    void run_event(const PolicySetup& policy, const char* event_name, uint64_t iterations, Body body)
+    {
+        const std::string name = std::string(policy.name) + " " + event_name;
+        if (registered<ev>() == nullptr)
+        {
+            std::printf("%-48s %10s\n", name.c_str(), "not registered");
+            return;
+        }
+        bench::run(name.c_str(), iterations, body);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    const uint64_t iterations = bench::iterations_from_args(argc, argv, 200000);
+    SwapchainManager& manager = SwapchainManager::get_instance();
+
+    for (const PolicySetup& policy : POLICIES)
+    {
+        clear_config();
+        set_config("SWAPCHAIN_OVERRIDE", "ForceSwapchainResolution", policy.resolution);
+        set_config("SWAPCHAIN_OVERRIDE", "FullscreenMode", policy.fullscreen_mode);
+        set_config("SWAPCHAIN_OVERRIDE", "DebugMode", policy.debug_mode);
+        set_config("SWAPCHAIN_OVERRIDE", "DebugLogRate", "0");
+        Config::get_instance().load();
+        manager.install();
+
+        {
+            MockGame game;
+            game.create_swapchain(1920, 1080);
+
+            swapchain_desc desc = {};
+            desc.back_buffer.texture.width = 1920;
+            desc.back_buffer.texture.height = 1080;
+            desc.back_buffer.texture.format = format::r8g8b8a8_unorm;
+            desc.back_buffer_count = 2;
+            // Only one window at a time, no create_swapchain here may leave a pending entry behind for long
+            run_event<addon_event::create_swapchain>(policy, "create_swapchain", iterations / 10 + 1, [&] {
+                swapchain_desc copy = desc;
+                registered<addon_event::create_swapchain>()(device_api::d3d11, copy, game.hwnd());
+            });
+
+            run_event<addon_event::set_fullscreen_state>(policy, "set_fullscreen_state", iterations, [&] {
+                registered<addon_event::set_fullscreen_state>()(&game.swapchain(), false, nullptr);
+            });
+
+            const viewport full_viewport = { 0.0f, 0.0f, static_cast<float>(game.swapchain().width()),
+                                             static_cast<float>(game.swapchain().height()), 0.0f, 1.0f };
+            run_event<addon_event::bind_viewports>(policy, "bind_viewports", iterations, [&] {
+                registered<addon_event::bind_viewports>()(&game.cmd_list(), 0u, 1u, &full_viewport);
+            });
+
+            run_event<addon_event::finish_present>(policy, "finish_present", iterations, [&] {
+                registered<addon_event::finish_present>()(&game.queue(), &game.swapchain());
+            });
+        }
+
+        manager.uninstall();
+        manager.cleanup_all();
+    }
+    return 0;
+}
@@ -0,0 +1,78 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "core/config_parse.h"
+#include <gtest/gtest.h>
+#include <limits>
+#include <string>
+
+TEST(ConfigParse, IntegerMustBeConsumedWhole)
+{
+    long value = 0;
+    EXPECT_TRUE(parse_integer("42", value));
+    EXPECT_EQ(value, 42);
+    EXPECT_TRUE(parse_integer("-7", value));
+    EXPECT_EQ(value, -7);
+
+    EXPECT_FALSE(parse_integer("", value));
+    EXPECT_FALSE(parse_integer(nullptr, value));
+    EXPECT_FALSE(parse_integer("12abc", value));
+    EXPECT_FALSE(parse_integer("1.5", value));
+    EXPECT_FALSE(parse_integer(" 5", value));
+    EXPECT_FALSE(parse_integer("5 ", value));
+    EXPECT_FALSE(parse_integer("+5", value));
+    EXPECT_FALSE(parse_integer("-", value));
+}
+
+TEST(ConfigParse, IntegerOverflowIsRejected)
+{
+    long value = 3;
+    const std::string max = std::to_string(std::numeric_limits<long>::max());
+    EXPECT_TRUE(parse_integer(max.c_str(), value));
+    EXPECT_EQ(value, std::numeric_limits<long>::max());
+
+    value = 3;
+    EXPECT_FALSE(parse_integer("99999999999999999999999", value));
+    EXPECT_FALSE(parse_integer("-99999999999999999999999", value));
+    EXPECT_EQ(value, 3);
+
+    // Rejected as unparsable instead of being clamped to the largest long
+    int ranged = -1;
+    EXPECT_FALSE(parse_ranged_integer("99999999999999999999999", 0, 2, ranged));
+    EXPECT_EQ(ranged, -1);
+}
+
+TEST(ConfigParse, RangedIntegerIncludesBothBounds)
+{
+    int value = -1;
+    EXPECT_TRUE(parse_ranged_integer("0", 0, 2, value));
+    EXPECT_EQ(value, 0);
+    EXPECT_TRUE(parse_ranged_integer("2", 0, 2, value));
+    EXPECT_EQ(value, 2);
+
+    value = 1;
+    EXPECT_FALSE(parse_ranged_integer("3", 0, 2, value));
+    EXPECT_FALSE(parse_ranged_integer("-1", 0, 2, value));
+    EXPECT_EQ(value, 1);
+}
+
+TEST(ConfigParse, BooleanAcceptsDigitsAndWords)
+{
+    bool value = false;
+    EXPECT_TRUE(parse_boolean("1", value));
+    EXPECT_TRUE(value);
+    EXPECT_TRUE(parse_boolean("false", value));
+    EXPECT_FALSE(value);
+    EXPECT_TRUE(parse_boolean("true", value));
+    EXPECT_TRUE(value);
+    EXPECT_TRUE(parse_boolean("0", value));
+    EXPECT_FALSE(value);
+
+    EXPECT_FALSE(parse_boolean("yes", value));
+    EXPECT_FALSE(parse_boolean("2", value));
+    EXPECT_FALSE(parse_boolean("", value));
+    EXPECT_FALSE(parse_boolean(nullptr, value));
+}
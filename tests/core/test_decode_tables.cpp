@@ -0,0 +1,87 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "core/decode_tables.h"
+#include <gtest/gtest.h>
+#include <string>
+
+namespace
+{
+    std::string flags(uint32_t value, std::span<const decode::FlagName> table)
+    {
+        char buffer[decode::TEXT_BUFFER_SIZE];
+        decode::TextWriter writer(buffer);
+        return decode::write_flags(writer, value, table);
+    }
+
+    std::string hresult(uint32_t hr)
+    {
+        char buffer[decode::TEXT_BUFFER_SIZE];
+        decode::TextWriter writer(buffer);
+        return decode::write_hresult(writer, hr);
+    }
+
+    std::string dxgi_format(uint32_t format)
+    {
+        char buffer[decode::TEXT_BUFFER_SIZE];
+        decode::TextWriter writer(buffer);
+        return decode::write_dxgi_format(writer, format);
+    }
+}
+
+TEST(DecodeTables, CombinedStylesHideTheirParts)
+{
+    EXPECT_EQ(flags(0x10CF0000, decode::WINDOW_STYLES),
+        "0x10CF0000 (WS_VISIBLE | WS_CAPTION | WS_SYSMENU | WS_THICKFRAME | WS_MINIMIZEBOX | WS_MAXIMIZEBOX)");
+    EXPECT_EQ(flags(0x00800000, decode::WINDOW_STYLES), "0x800000 (WS_BORDER)");
+}
+
+TEST(DecodeTables, UnknownBitsAreKeptAsARemainder)
+{
+    EXPECT_EQ(flags(0x80000005, decode::WINDOW_STYLES), "0x80000005 (WS_POPUP | 0x5)");
+    EXPECT_EQ(flags(0x0800, decode::SET_WINDOW_POS_FLAGS), "0x800 (0x800)");
+    EXPECT_EQ(flags(0, decode::WINDOW_EX_STYLES), "0x0 (none)");
+}
+
+TEST(DecodeTables, EveryHResultIsFoundByTheSearch)
+{
+    for (const decode::ValueName& entry : decode::HRESULTS)
+        EXPECT_STREQ(decode::hresult_name(entry.value), entry.name);
+
+    EXPECT_EQ(hresult(0x887A0005), "0x887A0005 (DXGI_ERROR_DEVICE_REMOVED)");
+    EXPECT_EQ(hresult(0x80071234), "0x80071234");
+    EXPECT_EQ(decode::hresult_name(0xFFFFFFFF), nullptr);
+}
+
+TEST(DecodeTables, DxgiFormatsAreIndexedByValue)
+{
+    EXPECT_EQ(dxgi_format(0), "UNKNOWN");
+    EXPECT_EQ(dxgi_format(28), "R8G8B8A8_UNORM");
+    EXPECT_EQ(dxgi_format(87), "B8G8R8A8_UNORM");
+    EXPECT_EQ(dxgi_format(115), "B4G4R4A4_UNORM");
+    EXPECT_EQ(dxgi_format(130), "P208");
+    EXPECT_EQ(dxgi_format(191), "A4B4G4R4_UNORM");
+
+    // Unassigned values inside and after the dense range
+    EXPECT_EQ(dxgi_format(116), "0x74");
+    EXPECT_EQ(dxgi_format(200), "0xC8");
+}
+
+TEST(DecodeTables, TextIsCutOffAtTheBufferSize)
+{
+    char buffer[12];
+    decode::TextWriter writer(buffer);
+    writer.append("0123456789ABCDEF");
+    EXPECT_EQ(writer.length(), sizeof(buffer) - 1);
+    EXPECT_STREQ(writer.c_str(), "0123456789A");
+}
+
+TEST(DecodeTables, EveryFlagCombinationFitsTheTextBuffer)
+{
+    EXPECT_LT(flags(0xFFFFFFFF, decode::WINDOW_STYLES).size(), decode::TEXT_BUFFER_SIZE - 1);
+    EXPECT_LT(flags(0xFFFFFFFF, decode::WINDOW_EX_STYLES).size(), decode::TEXT_BUFFER_SIZE - 1);
+    EXPECT_LT(flags(0xFFFFFFFF, decode::SET_WINDOW_POS_FLAGS).size(), decode::TEXT_BUFFER_SIZE - 1);
+}
@@ -0,0 +1,40 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "core/fullscreen_policy.h"
+#include <gtest/gtest.h>
+
+TEST(FullscreenPolicy, UnchangedModeAllowsEverything)
+{
+    EXPECT_EQ(decide_fullscreen_change(FullscreenMode::Unchanged, false, true), FullscreenDecision::Allow);
+    EXPECT_EQ(decide_fullscreen_change(FullscreenMode::Unchanged, false, false), FullscreenDecision::Allow);
+}
+
+TEST(FullscreenPolicy, BlockFullscreenChangesBlocksBothDirections)
+{
+    EXPECT_EQ(decide_fullscreen_change(FullscreenMode::Unchanged, true, true), FullscreenDecision::BlockByConfig);
+    EXPECT_EQ(decide_fullscreen_change(FullscreenMode::Unchanged, true, false), FullscreenDecision::BlockByConfig);
+}
+
+TEST(FullscreenPolicy, BorderlessKeepsTheWindowWindowed)
+{
+    EXPECT_EQ(decide_fullscreen_change(FullscreenMode::Borderless, false, true), FullscreenDecision::BlockFullscreen);
+    EXPECT_EQ(decide_fullscreen_change(FullscreenMode::Borderless, false, false), FullscreenDecision::Allow);
+}
+
+TEST(FullscreenPolicy, ExclusiveKeepsTheWindowFullscreen)
+{
+    EXPECT_EQ(decide_fullscreen_change(FullscreenMode::Exclusive, false, false), FullscreenDecision::BlockWindowed);
+
+    // The addon's own transition to fullscreen must go through
+    EXPECT_EQ(decide_fullscreen_change(FullscreenMode::Exclusive, false, true), FullscreenDecision::Allow);
+}
+
+TEST(FullscreenPolicy, ForcedModeTakesPrecedenceOverBlockFullscreenChanges)
+{
+    EXPECT_EQ(decide_fullscreen_change(FullscreenMode::Borderless, true, false), FullscreenDecision::Allow);
+    EXPECT_EQ(decide_fullscreen_change(FullscreenMode::Exclusive, true, true), FullscreenDecision::Allow);
+}
@@ -0,0 +1,108 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "core/gpu_timer_ring.h"
+#include <gtest/gtest.h>
+
+namespace
+{
+    // Synthetic query heap: query i holds timestamp 100 * i + i % 2, queries below completed_queries have finished
+    struct FakeQueries
+    {
+        uint32_t completed_queries = 0;
+
+        bool operator()(uint32_t first, uint32_t count, uint64_t* out) const
+        {
+            if (first + count > completed_queries)
+                return false;
+            for (uint32_t i = 0; i < count; ++i)
+                out[i] = 100 * (first + i) + (first + i) % 2;
+            return true;
+        }
+    };
+
+    void fill_ring(GpuTimerRing& ring)
+    {
+        for (uint32_t frame = 0; frame < GpuTimerRing::FRAMES_IN_FLIGHT; ++frame)
+        {
+            uint32_t first_query = 0;
+            ASSERT_TRUE(ring.begin_frame(first_query));
+            EXPECT_EQ(first_query, frame * GpuTimerRing::QUERIES_PER_FRAME);
+            ring.end_frame();
+        }
+    }
+}
+
+TEST(GpuTimerRing, FramesAreSkippedWhileEverySlotIsPending)
+{
+    GpuTimerRing ring;
+    fill_ring(ring);
+
+    uint32_t first_query = 0;
+    EXPECT_FALSE(ring.begin_frame(first_query));
+    EXPECT_EQ(ring.skipped_frames(), 1u);
+    EXPECT_EQ(ring.timed_frames(), 0u);
+}
+
+TEST(GpuTimerRing, CollectStopsAtTheFirstUnfinishedFrame)
+{
+    GpuTimerRing ring;
+    fill_ring(ring);
+
+    FakeQueries queries { 4 };
+    EXPECT_EQ(ring.collect(queries), 2u);
+    EXPECT_EQ(ring.last_ticks(), 101u);
+    EXPECT_EQ(ring.timed_frames(), 2u);
+
+    // Nothing new has finished
+    EXPECT_EQ(ring.collect(queries), 0u);
+}
+
+TEST(GpuTimerRing, FreedSlotsAreReusedAndTheRingWraps)
+{
+    GpuTimerRing ring;
+    fill_ring(ring);
+    FakeQueries queries { 4 };
+    ring.collect(queries);
+
+    uint32_t first_query = 0;
+    ASSERT_TRUE(ring.begin_frame(first_query));
+    EXPECT_EQ(first_query, 0u);
+    ring.end_frame();
+
+    queries.completed_queries = GpuTimerRing::QUERY_COUNT;
+    EXPECT_EQ(ring.collect(queries), 3u);
+    EXPECT_EQ(ring.timed_frames(), 5u);
+}
+
+TEST(GpuTimerRing, BackwardsTimestampsLeaveTheFrameUntimed)
+{
+    GpuTimerRing ring;
+    uint32_t first_query = 0;
+    ASSERT_TRUE(ring.begin_frame(first_query));
+    ring.end_frame();
+
+    const auto disjoint = [](uint32_t, uint32_t, uint64_t* out) {
+        out[0] = 500;
+        out[1] = 200;
+        return true;
+    };
+    EXPECT_EQ(ring.collect(disjoint), 1u);
+    EXPECT_EQ(ring.timed_frames(), 0u);
+    EXPECT_EQ(ring.last_ticks(), 0u);
+}
+
+TEST(GpuTimerRing, ResetForgetsThePendingSlots)
+{
+    GpuTimerRing ring;
+    fill_ring(ring);
+    ring.reset();
+
+    uint32_t first_query = 0;
+    ASSERT_TRUE(ring.begin_frame(first_query));
+    EXPECT_EQ(first_query, 0u);
+    EXPECT_EQ(ring.collect(FakeQueries { GpuTimerRing::QUERY_COUNT }), 0u);
+}
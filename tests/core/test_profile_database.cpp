@@ -0,0 +1,248 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "core/profile_database.h"
+#include <gtest/gtest.h>
+#include <cstring>
+#include <fstream>
+
+namespace
+{
+    // Scratch directory removed after each test
+    class ProfileDatabaseTest : public ::testing::Test
+    {
+    protected:
+        void SetUp() override
+        {
+            directory_ = std::filesystem::temp_directory_path() /
+                ("swapchain_override_profiles_" + std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+            std::filesystem::remove_all(directory_);
+            std::filesystem::create_directories(directory_);
+        }
+
+        void TearDown() override
+        {
+            std::error_code ec;
+            std::filesystem::remove_all(directory_, ec);
+        }
+
+        std::filesystem::path write_file(const char* name, std::string_view text) const
+        {
+            const std::filesystem::path path = directory_ / name;
+            std::ofstream file(path, std::ios::binary | std::ios::trunc);
+            file.write(text.data(), static_cast<std::streamsize>(text.size()));
+            return path;
+        }
+
+        std::filesystem::path write_index(std::string_view source_text) const
+        {
+            std::vector<uint8_t> index;
+            std::string error;
+            EXPECT_TRUE(ProfileDatabase::build_index(source_text, index, error)) << error;
+            return write_file("profiles.ini.idx", std::string_view(reinterpret_cast<const char*>(index.data()), index.size()));
+        }
+
+        std::filesystem::path directory_;
+    };
+
+    profile_index::Header header_of(const std::vector<uint8_t>& index)
+    {
+        profile_index::Header header = {};
+        std::memcpy(&header, index.data(), sizeof(header));
+        return header;
+    }
+}
+
+TEST(ProfileHash, IsFnv1aOfTheLowercaseName)
+{
+    EXPECT_EQ(ProfileDatabase::hash_name(""), 0xCBF29CE484222325ull);
+    EXPECT_EQ(ProfileDatabase::hash_name("a"), 0xAF63DC4C8601EC8Cull);
+    EXPECT_EQ(ProfileDatabase::hash_name("Game.EXE"), ProfileDatabase::hash_name("game.exe"));
+    EXPECT_NE(ProfileDatabase::hash_name("game.exe"), ProfileDatabase::hash_name("game2.exe"));
+}
+
+TEST(ProfileIndex, MalformedSourcesReportTheLine)
+{
+    std::vector<uint8_t> index;
+    std::string error;
+
+    EXPECT_FALSE(ProfileDatabase::build_index("[game.exe\nFullscreenMode=1\n", index, error));
+    EXPECT_NE(error.find("line 1"), std::string::npos) << error;
+
+    EXPECT_FALSE(ProfileDatabase::build_index("[game.exe]\n; comment\nFullscreenMode\n", index, error));
+    EXPECT_NE(error.find("line 3"), std::string::npos) << error;
+
+    EXPECT_FALSE(ProfileDatabase::build_index("FullscreenMode=1\n", index, error));
+    EXPECT_NE(error.find("outside"), std::string::npos) << error;
+}
+
+TEST(ProfileIndex, TableIsAtMostHalfFull)
+{
+    for (const int profiles : { 0, 1, 2, 3, 100, 1000 })
+    {
+        std::string source;
+        for (int i = 0; i < profiles; ++i)
+            source += "[game" + std::to_string(i) + ".exe]\nTargetMonitor=1\n";
+
+        std::vector<uint8_t> index;
+        std::string error;
+        ASSERT_TRUE(ProfileDatabase::build_index(source, index, error)) << error;
+
+        const profile_index::Header header = header_of(index);
+        EXPECT_EQ(header.magic, profile_index::MAGIC);
+        EXPECT_EQ(header.profile_count, static_cast<uint32_t>(profiles));
+        EXPECT_EQ(header.bucket_count & (header.bucket_count - 1), 0u);
+        EXPECT_GE(header.bucket_count, header.profile_count * 2);
+        EXPECT_EQ(index.size(), header.strings_offset + header.strings_size);
+    }
+}
+
+TEST_F(ProfileDatabaseTest, LookupIsCaseInsensitive)
+{
+    const std::filesystem::path index_path = write_index(
+        "[Game.exe]\n"
+        "ForceSwapchainResolution = 2560x1440\n"
+        "FullscreenMode=1\n"
+        "\n"
+        "[other.exe]\n"
+        "TargetMonitor=2\n");
+
+    std::vector<ProfileSetting> settings;
+    ASSERT_TRUE(ProfileDatabase::find_profile(index_path, "GAME.EXE", settings));
+    ASSERT_EQ(settings.size(), 2u);
+    EXPECT_EQ(settings[0].key, "ForceSwapchainResolution");
+    EXPECT_EQ(settings[0].value, "2560x1440");
+    EXPECT_EQ(settings[1].key, "FullscreenMode");
+    EXPECT_EQ(settings[1].value, "1");
+
+    EXPECT_FALSE(ProfileDatabase::find_profile(index_path, "missing.exe", settings));
+}
+
+TEST_F(ProfileDatabaseTest, LaterSectionsAndKeysOverrideEarlierOnes)
+{
+    const std::filesystem::path index_path = write_index(
+        "[game.exe]\nFullscreenMode=1\nTargetMonitor=1\n"
+        "[GAME.exe]\nFullscreenMode=2\n");
+
+    std::vector<ProfileSetting> settings;
+    ASSERT_TRUE(ProfileDatabase::find_profile(index_path, "game.exe", settings));
+    ASSERT_EQ(settings.size(), 2u);
+    EXPECT_EQ(settings[0].key, "FullscreenMode");
+    EXPECT_EQ(settings[0].value, "2");
+}
+
+TEST_F(ProfileDatabaseTest, EveryProfileOfALargeDatabaseIsFound)
+{
+    std::string source;
+    for (int i = 0; i < 2000; ++i)
+        source += "[title" + std::to_string(i) + ".exe]\nTargetMonitor=" + std::to_string(i % 64) + "\n";
+    const std::filesystem::path index_path = write_index(source);
+
+    std::vector<ProfileSetting> settings;
+    for (int i = 0; i < 2000; ++i)
+    {
+        ASSERT_TRUE(ProfileDatabase::find_profile(index_path, "title" + std::to_string(i) + ".exe", settings)) << i;
+        ASSERT_EQ(settings.size(), 1u);
+        EXPECT_EQ(settings[0].value, std::to_string(i % 64));
+    }
+    EXPECT_FALSE(ProfileDatabase::find_profile(index_path, "title2000.exe", settings));
+}
+
+TEST_F(ProfileDatabaseTest, CorruptIndexIsRejected)
+{
+    std::vector<uint8_t> index;
+    std::string error;
+    ASSERT_TRUE(ProfileDatabase::build_index("[game.exe]\nFullscreenMode=1\n", index, error));
+
+    index[0] ^= 0xFF;
+    const std::filesystem::path index_path = write_file("broken.idx", std::string_view(reinterpret_cast<const char*>(index.data()), index.size()));
+
+    std::vector<ProfileSetting> settings;
+    EXPECT_FALSE(ProfileDatabase::find_profile(index_path, "game.exe", settings));
+    EXPECT_FALSE(ProfileDatabase::find_profile(directory_ / "missing.idx", "game.exe", settings));
+}
+
+TEST_F(ProfileDatabaseTest, IndexIsRebuiltOnlyWhenTheSourceChanges)
+{
+    const std::filesystem::path source_path = write_file("profiles.ini", "[game.exe]\nFullscreenMode=1\n");
+    const std::filesystem::path index_path = ProfileDatabase::index_path_for(source_path);
+    EXPECT_EQ(index_path.filename(), "profiles.ini.idx");
+
+    std::string error;
+    ASSERT_TRUE(ProfileDatabase::update_index(source_path, 1234, error)) << error;
+    ASSERT_TRUE(std::filesystem::exists(index_path));
+    EXPECT_FALSE(std::filesystem::exists(directory_ / "profiles.ini.idx.1234.tmp"));
+
+    // Up to date: the index is left alone
+    const auto index_time = std::filesystem::last_write_time(index_path) - std::chrono::seconds(10);
+    std::filesystem::last_write_time(index_path, index_time);
+    ASSERT_TRUE(ProfileDatabase::update_index(source_path, 1234, error)) << error;
+    EXPECT_EQ(std::filesystem::last_write_time(index_path), index_time);
+
+    // Source edited: rebuilt
+    const auto source_time = std::filesystem::last_write_time(source_path);
+    write_file("profiles.ini", "[game.exe]\nFullscreenMode=2\n");
+    std::filesystem::last_write_time(source_path, source_time + std::chrono::seconds(10));
+    ASSERT_TRUE(ProfileDatabase::update_index(source_path, 1234, error)) << error;
+
+    std::vector<ProfileSetting> settings;
+    ASSERT_TRUE(ProfileDatabase::find_profile(index_path, "game.exe", settings));
+    EXPECT_EQ(settings[0].value, "2");
+}
+
+TEST_F(ProfileDatabaseTest, IndexIsRebuiltWhenTheSourceDiffersFromTheStamp)
+{
+    const std::filesystem::path source_path = write_file("profiles.ini", "[game.exe]\nFullscreenMode=1\n");
+    const std::filesystem::path index_path = ProfileDatabase::index_path_for(source_path);
+    std::string error;
+    ASSERT_TRUE(ProfileDatabase::update_index(source_path, 1234, error)) << error;
+    const auto source_time = std::filesystem::last_write_time(source_path);
+
+    // An older copy restored over the source, the index is newer than it
+    write_file("profiles.ini", "[game.exe]\nFullscreenMode=3\n");
+    std::filesystem::last_write_time(source_path, source_time - std::chrono::hours(24));
+    ASSERT_TRUE(ProfileDatabase::update_index(source_path, 1234, error)) << error;
+
+    std::vector<ProfileSetting> settings;
+    ASSERT_TRUE(ProfileDatabase::find_profile(index_path, "game.exe", settings));
+    EXPECT_EQ(settings[0].value, "3");
+
+    // Edited within the time resolution of the file system, only the size changed
+    write_file("profiles.ini", "[game.exe]\nFullscreenMode=10\n");
+    std::filesystem::last_write_time(source_path, source_time - std::chrono::hours(24));
+    ASSERT_TRUE(ProfileDatabase::update_index(source_path, 1234, error)) << error;
+    ASSERT_TRUE(ProfileDatabase::find_profile(index_path, "game.exe", settings));
+    EXPECT_EQ(settings[0].value, "10");
+
+    // An index without a stamp (or a foreign file) is replaced
+    write_file("profiles.ini.idx", "stale");
+    ASSERT_TRUE(ProfileDatabase::update_index(source_path, 1234, error)) << error;
+    ASSERT_TRUE(ProfileDatabase::find_profile(index_path, "game.exe", settings));
+    EXPECT_EQ(settings[0].value, "10");
+}
+
+TEST_F(ProfileDatabaseTest, EachProcessWritesItsOwnTemporaryIndex)
+{
+    const std::filesystem::path source_path = write_file("profiles.ini", "[game.exe]\nFullscreenMode=1\n");
+
+    // Another instance is half way through writing its index
+    const std::filesystem::path other_temp = write_file("profiles.ini.idx.99.tmp", "partial");
+
+    std::string error;
+    ASSERT_TRUE(ProfileDatabase::update_index(source_path, 1234, error)) << error;
+    EXPECT_EQ(std::filesystem::file_size(other_temp), 7u);
+    EXPECT_FALSE(std::filesystem::exists(directory_ / "profiles.ini.idx.1234.tmp"));
+
+    std::vector<ProfileSetting> settings;
+    EXPECT_TRUE(ProfileDatabase::find_profile(ProfileDatabase::index_path_for(source_path), "game.exe", settings));
+}
+
+TEST_F(ProfileDatabaseTest, MissingSourceIsReported)
+{
+    std::string error;
+    EXPECT_FALSE(ProfileDatabase::update_index(directory_ / "missing.ini", 1234, error));
+    EXPECT_NE(error.find("not found"), std::string::npos) << error;
+}
@@ -0,0 +1,86 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "core/proxy_fallback.h"
+#include <gtest/gtest.h>
+#include <string>
+
+namespace
+{
+    std::string format(uint32_t steps)
+    {
+        char buffer[64];
+        format_proxy_fallback_steps(steps, buffer, sizeof(buffer));
+        return buffer;
+    }
+}
+
+TEST(ProxyFallback, ParsesStepsInAnyOrder)
+{
+    uint32_t steps = 0;
+    ASSERT_TRUE(parse_proxy_fallback_steps("lower-size,fewer-proxies", steps));
+    EXPECT_EQ(steps, proxy_fallback_bit(ProxyFallbackStep::FewerProxies) | proxy_fallback_bit(ProxyFallbackStep::LowerSize));
+
+    ASSERT_TRUE(parse_proxy_fallback_steps("fewer-proxies,lower-precision,lower-size", steps));
+    EXPECT_EQ(steps, PROXY_FALLBACK_DEFAULT);
+
+    ASSERT_TRUE(parse_proxy_fallback_steps("none", steps));
+    EXPECT_EQ(steps, 0u);
+}
+
+TEST(ProxyFallback, RejectsUnknownAndUnlistableSteps)
+{
+    uint32_t steps = PROXY_FALLBACK_DEFAULT;
+    EXPECT_FALSE(parse_proxy_fallback_steps("lower", steps));
+    EXPECT_FALSE(parse_proxy_fallback_steps("fewer-proxies,", steps));
+    EXPECT_FALSE(parse_proxy_fallback_steps("", steps));
+
+    // Disabling the override is always the last step and cannot be listed
+    EXPECT_FALSE(parse_proxy_fallback_steps("disable", steps));
+    EXPECT_EQ(steps, PROXY_FALLBACK_DEFAULT);
+}
+
+TEST(ProxyFallback, FormatsInLadderOrder)
+{
+    EXPECT_EQ(format(PROXY_FALLBACK_DEFAULT), "fewer-proxies,lower-precision,lower-size");
+    EXPECT_EQ(format(proxy_fallback_bit(ProxyFallbackStep::LowerSize)), "lower-size");
+    EXPECT_EQ(format(0), "none");
+
+    // Parsing what was formatted gives the same steps
+    uint32_t steps = 0;
+    ASSERT_TRUE(parse_proxy_fallback_steps(format(PROXY_FALLBACK_DEFAULT).c_str(), steps));
+    EXPECT_EQ(steps, PROXY_FALLBACK_DEFAULT);
+}
+
+TEST(ProxyFallback, LowerSizeHalvesDownToTheRequestedSize)
+{
+    uint32_t width = 7680;
+    uint32_t height = 4320;
+    lower_forced_size(1920, 1080, 1, width, height);
+    EXPECT_EQ(width, 3840u);
+    EXPECT_EQ(height, 2160u);
+
+    lower_forced_size(1920, 1080, 3, width, height);
+    EXPECT_EQ(width, 1920u);
+    EXPECT_EQ(height, 1080u);
+}
+
+TEST(ProxyFallback, LowerSizeNeverGrowsADownscale)
+{
+    // Forced below the requested size, halving keeps the forced size
+    uint32_t width = 1280;
+    uint32_t height = 720;
+    lower_forced_size(1920, 1080, 1, width, height);
+    EXPECT_EQ(width, 1280u);
+    EXPECT_EQ(height, 720u);
+
+    // Shifts past the width of the value are clamped
+    width = 3840;
+    height = 2160;
+    lower_forced_size(1920, 1080, 64, width, height);
+    EXPECT_EQ(width, 1920u);
+    EXPECT_EQ(height, 1080u);
+}
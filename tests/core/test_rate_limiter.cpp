@@ -0,0 +1,84 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "core/rate_limiter.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST(RateLimiter, BurstIsAdmittedAtOnceThenOneEventPerInterval)
+{
+    uint64_t full_at = 0;
+    uint64_t next = 0;
+
+    // Two events at once fit a burst of two, the third has to wait one interval
+    ASSERT_TRUE(rate_limit_admit(full_at, 1000, 100, 2, next));
+    full_at = next;
+    ASSERT_TRUE(rate_limit_admit(full_at, 1000, 100, 2, next));
+    full_at = next;
+    EXPECT_FALSE(rate_limit_admit(full_at, 1000, 100, 2, next));
+    EXPECT_FALSE(rate_limit_admit(full_at, 1099, 100, 2, next));
+    EXPECT_TRUE(rate_limit_admit(full_at, 1100, 100, 2, next));
+}
+
+TEST(RateLimiter, IdleBucketRefillsToTheBurst)
+{
+    RateLimiter limiter;
+    for (int event = 0; event < 3; ++event)
+        EXPECT_TRUE(limiter.try_acquire(0, 10, 3));
+    EXPECT_FALSE(limiter.try_acquire(0, 10, 3));
+
+    // Ten seconds later the bucket is full again, and not fuller than the burst
+    for (int event = 0; event < 3; ++event)
+        EXPECT_TRUE(limiter.try_acquire(10000000, 10, 3));
+    EXPECT_FALSE(limiter.try_acquire(10000000, 10, 3));
+}
+
+TEST(RateLimiter, ZeroRateAdmitsEverything)
+{
+    RateLimiter limiter;
+    for (int event = 0; event < 1000; ++event)
+        EXPECT_TRUE(limiter.try_acquire(0, 0, 1));
+    EXPECT_EQ(limiter.take_rejected(), 0u);
+}
+
+TEST(RateLimiter, RejectedEventsAreCountedUntilTaken)
+{
+    RateLimiter limiter;
+    limiter.try_acquire(0, 1, 1);
+    limiter.try_acquire(0, 1, 1);
+    limiter.try_acquire(0, 1, 1);
+    EXPECT_EQ(limiter.take_rejected(), 2u);
+    EXPECT_EQ(limiter.take_rejected(), 0u);
+}
+
+// Threads sharing one bucket at the same instant get exactly the burst between them
+TEST(RateLimiter, ConcurrentCallersShareOneBurst)
+{
+    constexpr uint32_t BURST = 100;
+    constexpr int THREADS = 8;
+    constexpr int ATTEMPTS = 1000;
+
+    RateLimiter limiter;
+    std::atomic<uint32_t> admitted = 0;
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < THREADS; ++thread)
+    {
+        threads.emplace_back([&] {
+            for (int attempt = 0; attempt < ATTEMPTS; ++attempt)
+            {
+                if (limiter.try_acquire(0, 1, BURST))
+                    admitted.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+    for (std::thread& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(admitted.load(), BURST);
+    EXPECT_EQ(limiter.take_rejected(), uint64_t(THREADS) * ATTEMPTS - BURST);
+}
@@ -0,0 +1,116 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "core/resize_debounce.h"
+#include <gtest/gtest.h>
+#include <string>
+
+namespace
+{
+    std::string format(const ResizeDebounceSpec& spec)
+    {
+        char buffer[32];
+        format_resize_debounce(spec, buffer, sizeof(buffer));
+        return buffer;
+    }
+}
+
+TEST(ResizeDebounce, ParsesOffMillisecondsAndFrames)
+{
+    ResizeDebounceSpec spec = { ResizeDebounceUnit::Frames, 5 };
+    ASSERT_TRUE(parse_resize_debounce("off", spec));
+    EXPECT_EQ(spec, ResizeDebounceSpec{});
+
+    ASSERT_TRUE(parse_resize_debounce("100ms", spec));
+    EXPECT_EQ(spec, (ResizeDebounceSpec{ ResizeDebounceUnit::Milliseconds, 100 }));
+
+    ASSERT_TRUE(parse_resize_debounce("3frames", spec));
+    EXPECT_EQ(spec, (ResizeDebounceSpec{ ResizeDebounceUnit::Frames, 3 }));
+}
+
+TEST(ResizeDebounce, RejectsMissingUnitsAndOutOfRangeAmounts)
+{
+    ResizeDebounceSpec spec;
+    EXPECT_FALSE(parse_resize_debounce("100", spec));
+    EXPECT_FALSE(parse_resize_debounce("0ms", spec));
+    EXPECT_FALSE(parse_resize_debounce("10001ms", spec));
+    EXPECT_FALSE(parse_resize_debounce("5 frames", spec));
+    EXPECT_FALSE(parse_resize_debounce(nullptr, spec));
+}
+
+TEST(ResizeDebounce, FormatsForTheOverlay)
+{
+    EXPECT_EQ(format({}), "Off");
+    EXPECT_EQ(format({ ResizeDebounceUnit::Milliseconds, 100 }), "100 ms");
+    EXPECT_EQ(format({ ResizeDebounceUnit::Frames, 3 }), "3 frames");
+}
+
+// Simulated window drag: a resize every 16 ms for half a second, one present between each,
+// then presents without resizes. Only one rebuild may happen, after the size was stable.
+TEST(ResizeDebounce, DragRebuildsOnceAfterTheQuietPeriod)
+{
+    constexpr ResizeDebounceSpec spec = { ResizeDebounceUnit::Milliseconds, 100 };
+    ResizeDebouncer debouncer;
+    uint64_t now = 1000;
+    for (uint32_t resize = 0; resize < 32; ++resize, now += 16)
+    {
+        debouncer.note_resize(now);
+        EXPECT_FALSE(debouncer.note_present(spec, now + 8)) << "resize " << resize;
+    }
+
+    const uint64_t last_resize = now - 16;
+    uint32_t rebuilds = 0;
+    uint64_t rebuilt_at = 0;
+    for (uint32_t frame = 0; frame < 20; ++frame, now += 16)
+    {
+        if (debouncer.note_present(spec, now))
+        {
+            ++rebuilds;
+            rebuilt_at = now;
+        }
+    }
+
+    EXPECT_EQ(rebuilds, 1u);
+    EXPECT_GE(rebuilt_at, last_resize + 100);
+    EXPECT_LT(rebuilt_at, last_resize + 100 + 16);
+    EXPECT_FALSE(debouncer.is_pending());
+}
+
+TEST(ResizeDebounce, FrameCountStartsOverOnEveryResize)
+{
+    constexpr ResizeDebounceSpec spec = { ResizeDebounceUnit::Frames, 3 };
+    ResizeDebouncer debouncer;
+    for (uint64_t resize = 0; resize < 32; ++resize)
+    {
+        debouncer.note_resize(resize);
+        EXPECT_FALSE(debouncer.note_present(spec, resize));
+        EXPECT_FALSE(debouncer.note_present(spec, resize));
+    }
+
+    EXPECT_TRUE(debouncer.note_present(spec, 0));
+    EXPECT_FALSE(debouncer.note_present(spec, 0));
+}
+
+TEST(ResizeDebounce, DisabledSpecRebuildsOnTheFirstPresent)
+{
+    ResizeDebouncer debouncer;
+    EXPECT_FALSE(debouncer.note_present({}, 0));
+
+    debouncer.note_resize(0);
+    EXPECT_TRUE(debouncer.is_pending());
+    EXPECT_TRUE(debouncer.note_present({}, 0));
+    EXPECT_FALSE(debouncer.is_pending());
+}
+
+TEST(ResizeDebounce, ResetDropsThePendingRebuild)
+{
+    constexpr ResizeDebounceSpec spec = { ResizeDebounceUnit::Frames, 1 };
+    ResizeDebouncer debouncer;
+    debouncer.note_resize(0);
+    debouncer.reset();
+    EXPECT_FALSE(debouncer.is_pending());
+    EXPECT_FALSE(debouncer.note_present(spec, 0));
+}
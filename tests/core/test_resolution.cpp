@@ -0,0 +1,127 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "core/resolution.h"
+#include <gtest/gtest.h>
+
+namespace
+{
+    ResolutionSpec parse(const char* text)
+    {
+        ResolutionSpec spec;
+        EXPECT_TRUE(parse_resolution_spec(text, spec)) << text;
+        return spec;
+    }
+}
+
+TEST(Resolution, AbsoluteSize)
+{
+    const ResolutionSpec spec = parse("2560x1440");
+    EXPECT_EQ(spec.mode, ResolutionMode::Absolute);
+    EXPECT_EQ(spec.width, 2560u);
+    EXPECT_EQ(spec.height, 1440u);
+
+    EXPECT_EQ(parse("16384x16384").width, MAX_FORCED_DIMENSION);
+}
+
+TEST(Resolution, ZeroDimensionDisablesTheOverride)
+{
+    EXPECT_EQ(parse("0x0").mode, ResolutionMode::Disabled);
+    EXPECT_EQ(parse("0x1080").mode, ResolutionMode::Disabled);
+    EXPECT_EQ(parse("1920x0").mode, ResolutionMode::Disabled);
+}
+
+TEST(Resolution, ScaleFactorAndPercent)
+{
+    ResolutionSpec spec = parse("2x");
+    EXPECT_EQ(spec.mode, ResolutionMode::Scale);
+    EXPECT_EQ(spec.scale_percent, 200u);
+
+    EXPECT_EQ(parse("1.5x").scale_percent, 150u);
+    EXPECT_EQ(parse("0.25x").scale_percent, MIN_SCALE_PERCENT);
+    EXPECT_EQ(parse("8x").scale_percent, MAX_SCALE_PERCENT);
+    EXPECT_EQ(parse("150%").scale_percent, 150u);
+    EXPECT_EQ(parse("66.6%").scale_percent, 67u);
+}
+
+TEST(Resolution, FitMonitorIgnoresCase)
+{
+    EXPECT_EQ(parse("fit-monitor").mode, ResolutionMode::FitMonitor);
+    EXPECT_EQ(parse("Fit-Monitor").mode, ResolutionMode::FitMonitor);
+}
+
+TEST(Resolution, MalformedValuesAreRejected)
+{
+    const ResolutionSpec previous = { ResolutionMode::Absolute, 1, 2, 0 };
+    for (const char* text : {
+        "", "x", "1920", "1920x", "x1080", "1920x1080x", "1920 x1080", "1920x 1080", "1920x1080 ", "19.5x1080", "1920x-1080",
+        "1920x+1080", "16385x100", "4294967296x100", "2", "2xx", "150%%", "24%", "801%", "0.2x", "9x", "fit-monitors" })
+    {
+        ResolutionSpec spec = previous;
+        EXPECT_FALSE(parse_resolution_spec(text, spec)) << text;
+        EXPECT_EQ(spec, previous) << text;
+    }
+
+    ResolutionSpec spec;
+    EXPECT_FALSE(parse_resolution_spec(nullptr, spec));
+}
+
+TEST(Resolution, NumberSyntaxBeyondDecimalDigitsIsRejected)
+{
+    // Leading whitespace, signs, hex and inf/nan were accepted through strtod
+    for (const char* text : { " 2x", "\t150%", " 1920x1080", "+2x", "-2x", "0x2p1x", "0x1.8p1%", "inf%", "INFx", "nan%", "NaNx",
+                              "1e2%", "2e0x1080" })
+    {
+        ResolutionSpec spec;
+        EXPECT_FALSE(parse_resolution_spec(text, spec)) << text;
+    }
+}
+
+TEST(Resolution, FormatDescribesEveryMode)
+{
+    char buffer[64] = {};
+    format_resolution_spec(parse("2560x1440"), buffer, sizeof(buffer));
+    EXPECT_STREQ(buffer, "2560x1440");
+    format_resolution_spec(parse("150%"), buffer, sizeof(buffer));
+    EXPECT_STREQ(buffer, "150% of requested");
+    format_resolution_spec(parse("fit-monitor"), buffer, sizeof(buffer));
+    EXPECT_STREQ(buffer, "Fit monitor");
+    format_resolution_spec(parse("0x0"), buffer, sizeof(buffer));
+    EXPECT_STREQ(buffer, "Disabled");
+}
+
+TEST(Resolution, ScaleIsResolvedAgainstTheRequestedSize)
+{
+    uint32_t width = 0, height = 0;
+    EXPECT_EQ(resolve_forced_size(parse("150%"), 1920, 1080, 0, 0, width, height), ResolveStatus::Resolved);
+    EXPECT_EQ(width, 2880u);
+    EXPECT_EQ(height, 1620u);
+
+    // Rounded to the nearest pixel
+    EXPECT_EQ(resolve_forced_size(parse("33%"), 1001, 3, 0, 0, width, height), ResolveStatus::Resolved);
+    EXPECT_EQ(width, 330u);
+    EXPECT_EQ(height, 1u);
+
+    EXPECT_EQ(resolve_forced_size(parse("2x"), 0, 0, 0, 0, width, height), ResolveStatus::RequestedSizeUnknown);
+}
+
+TEST(Resolution, OversizedResultsAreClamped)
+{
+    uint32_t width = 0, height = 0;
+    EXPECT_EQ(resolve_forced_size(parse("8x"), 7680, 4320, 0, 0, width, height), ResolveStatus::Clamped);
+    EXPECT_EQ(width, MAX_FORCED_DIMENSION);
+    EXPECT_EQ(height, MAX_FORCED_DIMENSION);
+}
+
+TEST(Resolution, FitMonitorNeedsAMonitorSize)
+{
+    uint32_t width = 0, height = 0;
+    EXPECT_EQ(resolve_forced_size(parse("fit-monitor"), 1280, 720, 3440, 1440, width, height), ResolveStatus::Resolved);
+    EXPECT_EQ(width, 3440u);
+    EXPECT_EQ(height, 1440u);
+    EXPECT_EQ(resolve_forced_size(parse("fit-monitor"), 1280, 720, 0, 0, width, height), ResolveStatus::MonitorSizeUnknown);
+    EXPECT_EQ(resolve_forced_size(ResolutionSpec{}, 1280, 720, 0, 0, width, height), ResolveStatus::Disabled);
+}
@@ -0,0 +1,78 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "core/surface_scaling.h"
+#include <gtest/gtest.h>
+
+namespace
+{
+    // Application asked for 1920x1080, the back buffer was forced to 3840x2160
+    constexpr SurfaceScale DOWNSCALE = { 1920, 1080, 3840, 2160 };
+}
+
+TEST(SurfaceScaling, FullViewportIsScaledToTheOriginalSize)
+{
+    float x = 0.0f, y = 0.0f, width = 3840.0f, height = 2160.0f;
+    ASSERT_TRUE(redirect_viewport(DOWNSCALE, x, y, width, height));
+    EXPECT_FLOAT_EQ(x, 0.0f);
+    EXPECT_FLOAT_EQ(y, 0.0f);
+    EXPECT_FLOAT_EQ(width, 1920.0f);
+    EXPECT_FLOAT_EQ(height, 1080.0f);
+}
+
+TEST(SurfaceScaling, ViewportAtTheCoverageThresholdIsRedirected)
+{
+    float x = 100.0f, y = 50.0f;
+    float width = 3840.0f * REDIRECT_COVERAGE_THRESHOLD;
+    float height = 2160.0f * REDIRECT_COVERAGE_THRESHOLD;
+    ASSERT_TRUE(redirect_viewport(DOWNSCALE, x, y, width, height));
+    EXPECT_FLOAT_EQ(x, 50.0f);
+    EXPECT_FLOAT_EQ(y, 25.0f);
+}
+
+TEST(SurfaceScaling, SmallViewportIsLeftAlone)
+{
+    // Shadow map or UI sub-region
+    float x = 0.0f, y = 0.0f, width = 2048.0f, height = 2048.0f;
+    EXPECT_FALSE(redirect_viewport(DOWNSCALE, x, y, width, height));
+    EXPECT_FLOAT_EQ(width, 2048.0f);
+    EXPECT_FLOAT_EQ(height, 2048.0f);
+}
+
+TEST(SurfaceScaling, UpscaleStretchesTheViewport)
+{
+    constexpr SurfaceScale upscale = { 3840, 2160, 1920, 1080 };
+    float x = 0.0f, y = 0.0f, width = 1920.0f, height = 1080.0f;
+    ASSERT_TRUE(redirect_viewport(upscale, x, y, width, height));
+    EXPECT_FLOAT_EQ(width, 3840.0f);
+    EXPECT_FLOAT_EQ(height, 2160.0f);
+}
+
+TEST(SurfaceScaling, FullScissorRectIsScaled)
+{
+    int32_t left = 0, top = 0, right = 3840, bottom = 2160;
+    ASSERT_TRUE(redirect_scissor_rect(DOWNSCALE, left, top, right, bottom));
+    EXPECT_EQ(left, 0);
+    EXPECT_EQ(top, 0);
+    EXPECT_EQ(right, 1920);
+    EXPECT_EQ(bottom, 1080);
+}
+
+TEST(SurfaceScaling, OffsetScissorRectKeepsItsOffsetRatio)
+{
+    int32_t left = 200, top = 100, right = 3840, bottom = 2160;
+    ASSERT_TRUE(redirect_scissor_rect(DOWNSCALE, left, top, right, bottom));
+    EXPECT_EQ(left, 100);
+    EXPECT_EQ(top, 50);
+}
+
+TEST(SurfaceScaling, SmallScissorRectIsLeftAlone)
+{
+    int32_t left = 0, top = 0, right = 512, bottom = 512;
+    EXPECT_FALSE(redirect_scissor_rect(DOWNSCALE, left, top, right, bottom));
+    EXPECT_EQ(right, 512);
+    EXPECT_EQ(bottom, 512);
+}
@@ -0,0 +1,73 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "core/swapchain_lifecycle.h"
+#include <gtest/gtest.h>
+#include <optional>
+
+namespace
+{
+    using S = SwapchainState;
+    constexpr std::optional<S> X = std::nullopt;
+
+    // Expected state after each event, X = rejected
+    constexpr std::optional<S> TRANSITIONS[SWAPCHAIN_STATE_COUNT][SWAPCHAIN_EVENT_COUNT] = {
+        //                 Init            EnableProxies  Bypass           BeginResize   Destroy
+        /* Pending     */ { S::Initialized, X,             X,               X,            S::Destroyed },
+        /* Initialized */ { X,              S::Active,     S::Passthrough,  X,            S::Destroyed },
+        /* Active      */ { S::Initialized, X,             X,               S::Resizing,  S::Destroyed },
+        /* Passthrough */ { S::Initialized, X,             X,               S::Resizing,  S::Destroyed },
+        /* Resizing    */ { S::Initialized, X,             X,               X,            S::Destroyed },
+        /* Destroyed   */ { X,              X,             X,               X,            X },
+    };
+
+    std::optional<S> transition(S state, SwapchainEvent event)
+    {
+        S next = S::Pending;
+        if (!next_swapchain_state(state, event, next))
+            return std::nullopt;
+        return next;
+    }
+}
+
+TEST(SwapchainLifecycle, EveryTransitionMatchesTheTable)
+{
+    for (size_t state = 0; state < SWAPCHAIN_STATE_COUNT; ++state)
+    {
+        for (size_t event = 0; event < SWAPCHAIN_EVENT_COUNT; ++event)
+        {
+            const S from = static_cast<S>(state);
+            const SwapchainEvent on = static_cast<SwapchainEvent>(event);
+            EXPECT_EQ(transition(from, on), TRANSITIONS[state][event])
+                << swapchain_event_name(on) << " in " << swapchain_state_name(from);
+        }
+    }
+}
+
+TEST(SwapchainLifecycle, RejectedEventsLeaveTheOutputAlone)
+{
+    S next = S::Passthrough;
+    EXPECT_FALSE(next_swapchain_state(S::Pending, SwapchainEvent::EnableProxies, next));
+    EXPECT_EQ(next, S::Passthrough);
+}
+
+TEST(SwapchainLifecycle, CreateResizeAndDestroyFollowTheEvents)
+{
+    S state = S::Pending;
+    const SwapchainEvent path[] = { SwapchainEvent::Init, SwapchainEvent::EnableProxies, SwapchainEvent::BeginResize,
+                                    SwapchainEvent::Init, SwapchainEvent::Bypass, SwapchainEvent::Destroy };
+    for (SwapchainEvent event : path)
+        ASSERT_TRUE(next_swapchain_state(state, event, state)) << swapchain_event_name(event) << " in " << swapchain_state_name(state);
+    EXPECT_EQ(state, S::Destroyed);
+}
+
+TEST(SwapchainLifecycle, NamesCoverEveryValue)
+{
+    EXPECT_STREQ(swapchain_state_name(S::Resizing), "Resizing");
+    EXPECT_STREQ(swapchain_state_name(static_cast<S>(SWAPCHAIN_STATE_COUNT)), "Unknown");
+    EXPECT_STREQ(swapchain_event_name(SwapchainEvent::BeginResize), "BeginResize");
+    EXPECT_STREQ(swapchain_event_name(static_cast<SwapchainEvent>(SWAPCHAIN_EVENT_COUNT)), "Unknown");
+}
@@ -0,0 +1,35 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+// Stand-in for <dxgi.h>, only the members the addon calls. The native handle of a
+// reshade_mock::MockSwapchain is a MockDxgiSwapChain implementing IDXGISwapChain.
+
+#include <Windows.h>
+
+#define DXGI_ERROR_INVALID_CALL (static_cast<HRESULT>(0x887A0001L))
+
+typedef struct DXGI_OUTPUT_DESC
+{
+    wchar_t DeviceName[32];
+    RECT DesktopCoordinates;
+    BOOL AttachedToDesktop;
+    UINT Rotation;
+    HMONITOR Monitor;
+} DXGI_OUTPUT_DESC;
+
+struct IDXGIOutput
+{
+    virtual HRESULT GetDesc(DXGI_OUTPUT_DESC* pDesc) = 0;
+    virtual unsigned long Release() = 0;
+};
+
+struct IDXGISwapChain
+{
+    virtual HRESULT SetFullscreenState(BOOL Fullscreen, IDXGIOutput* pTarget) = 0;
+    virtual HRESULT GetFullscreenState(BOOL* pFullscreen, IDXGIOutput** ppTarget) = 0;
+};
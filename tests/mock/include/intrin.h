@@ -0,0 +1,10 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+// Stand-in for the MSVC <intrin.h>, GCC and Clang declare __rdtsc in <x86intrin.h>
+#include <x86intrin.h>
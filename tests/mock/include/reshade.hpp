@@ -0,0 +1,313 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+// Stand-in for the ReShade addon API headers, covering only what the addon uses.
+// Types, enum values and virtual signatures follow include/reshade_api*.hpp, so the
+// addon sources compile unchanged. The objects are implemented by the recording mocks
+// in mock_reshade.h, the free functions by mock_reshade.cpp.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace reshade
+{
+    namespace api
+    {
+        enum class device_api
+        {
+            d3d9 = 0x9000,
+            d3d10 = 0xa000,
+            d3d11 = 0xb000,
+            d3d12 = 0xc000,
+            opengl = 0x10000,
+            vulkan = 0x20000
+        };
+
+        // Same values as DXGI_FORMAT
+        enum class format : uint32_t
+        {
+            unknown = 0,
+            r32g32b32a32_float = 2,
+            r16g16b16a16_float = 10,
+            r10g10b10a2_unorm = 24,
+            r11g11b10_float = 26,
+            r8g8b8a8_unorm = 28,
+            r8g8b8a8_unorm_srgb = 29,
+            b8g8r8a8_unorm = 87,
+            b8g8r8a8_unorm_srgb = 91,
+            b10g10r10a2_unorm = 0x3131
+        };
+
+        enum class resource_usage : uint32_t
+        {
+            undefined = 0,
+            depth_stencil = 0x30,
+            render_target = 0x4,
+            shader_resource = 0xc0,
+            unordered_access = 0x8,
+            copy_dest = 0x400,
+            copy_source = 0x800,
+            general = 0x80000000,
+            present = 0x80000000 | render_target | copy_source
+        };
+        constexpr resource_usage operator&(resource_usage a, resource_usage b) { return static_cast<resource_usage>(static_cast<uint32_t>(a) & static_cast<uint32_t>(b)); }
+        constexpr resource_usage operator|(resource_usage a, resource_usage b) { return static_cast<resource_usage>(static_cast<uint32_t>(a) | static_cast<uint32_t>(b)); }
+
+        enum class filter_mode : uint32_t
+        {
+            min_mag_mip_point = 0,
+            min_mag_linear_mip_point = 0x14,
+            min_mag_mip_linear = 0x15
+        };
+
+        enum class texture_address_mode : uint32_t { wrap = 1, mirror = 2, clamp = 3, border = 4 };
+        enum class pipeline_stage : uint32_t { all_graphics = 0x7ffe };
+        enum class shader_stage : uint32_t { vertex = 0x1, pixel = 0x10, all = 0x7fffffff };
+        enum class descriptor_type : uint32_t { sampler = 0, sampler_with_resource_view = 1, shader_resource_view = 2 };
+        enum class resource_type : uint32_t { unknown, buffer, texture_1d, texture_2d, texture_3d, surface };
+        enum class resource_view_type : uint32_t { unknown, buffer, texture_1d, texture_1d_array, texture_2d, texture_2d_array };
+        enum class memory_heap : uint32_t { unknown, gpu_only };
+        enum class query_type : uint32_t { occlusion = 0, timestamp = 3 };
+        enum class pipeline_subobject_type : uint32_t { unknown, vertex_shader, hull_shader, domain_shader, geometry_shader, pixel_shader };
+
+        struct resource { uint64_t handle; };
+        struct resource_view { uint64_t handle; };
+        struct pipeline { uint64_t handle; };
+        struct pipeline_layout { uint64_t handle; };
+        struct sampler { uint64_t handle; };
+        struct query_heap { uint64_t handle; };
+        struct descriptor_table { uint64_t handle; };
+
+        struct rect { int32_t left, top, right, bottom; };
+        struct viewport { float x, y, width, height, min_depth, max_depth; };
+
+        struct resource_desc
+        {
+            resource_type type;
+            struct
+            {
+                uint32_t width;
+                uint32_t height;
+                uint16_t depth_or_layers;
+                uint16_t levels;
+                api::format format;
+                uint16_t samples;
+            } texture;
+            memory_heap heap;
+            resource_usage usage;
+            uint32_t flags;
+        };
+
+        struct swapchain_desc
+        {
+            resource_desc back_buffer;
+            uint32_t back_buffer_count;
+            uint32_t present_mode;
+            uint32_t present_flags;
+            bool fullscreen_state;
+            uint32_t fullscreen_refresh_rate;
+            uint32_t sync_interval;
+        };
+
+        struct resource_view_desc
+        {
+            resource_view_type type;
+            api::format format;
+            struct
+            {
+                uint32_t first_level;
+                uint32_t level_count;
+                uint32_t first_layer;
+                uint32_t layer_count;
+            } texture;
+        };
+
+        struct subresource_data { void* data; uint32_t row_pitch; uint32_t slice_pitch; };
+
+        struct descriptor_range
+        {
+            uint32_t binding;
+            uint32_t dx_register_index;
+            uint32_t dx_register_space;
+            uint32_t count;
+            shader_stage visibility;
+            uint32_t array_size;
+            descriptor_type type;
+        };
+
+        struct pipeline_layout_param
+        {
+            pipeline_layout_param() = default;
+            pipeline_layout_param(const descriptor_range& range) : push_descriptors(range) {}
+
+            descriptor_range push_descriptors = {};
+        };
+
+        struct shader_desc { const void* code; size_t code_size; };
+        struct pipeline_subobject { pipeline_subobject_type type; uint32_t count; void* data; };
+
+        struct sampler_desc
+        {
+            filter_mode filter;
+            texture_address_mode address_u;
+            texture_address_mode address_v;
+            texture_address_mode address_w;
+        };
+
+        struct descriptor_table_update
+        {
+            descriptor_table table;
+            uint32_t binding;
+            uint32_t array_offset;
+            uint32_t count;
+            descriptor_type type;
+            const void* descriptors;
+        };
+
+        struct api_object
+        {
+            virtual ~api_object() = default;
+            virtual uint64_t get_native() const = 0;
+        };
+
+        struct device : public api_object
+        {
+            virtual device_api get_api() const = 0;
+
+            virtual bool create_sampler(const sampler_desc& desc, sampler* out_sampler) = 0;
+            virtual void destroy_sampler(sampler sampler) = 0;
+
+            virtual bool create_resource(const resource_desc& desc, const subresource_data* initial_data, resource_usage initial_state, resource* out_resource, void** shared_handle = nullptr) = 0;
+            virtual void destroy_resource(resource resource) = 0;
+            virtual resource_desc get_resource_desc(resource resource) const = 0;
+
+            virtual bool create_resource_view(resource resource, resource_usage usage_type, const resource_view_desc& desc, resource_view* out_view) = 0;
+            virtual void destroy_resource_view(resource_view view) = 0;
+            virtual resource get_resource_from_view(resource_view view) const = 0;
+
+            virtual bool create_pipeline(pipeline_layout layout, uint32_t subobject_count, const pipeline_subobject* subobjects, pipeline* out_pipeline) = 0;
+            virtual void destroy_pipeline(pipeline pipeline) = 0;
+            virtual bool create_pipeline_layout(uint32_t param_count, const pipeline_layout_param* params, pipeline_layout* out_layout) = 0;
+            virtual void destroy_pipeline_layout(pipeline_layout layout) = 0;
+
+            virtual bool create_query_heap(query_type type, uint32_t size, query_heap* out_heap) = 0;
+            virtual void destroy_query_heap(query_heap heap) = 0;
+            virtual bool get_query_heap_results(query_heap heap, uint32_t first, uint32_t count, void* results, uint32_t stride) = 0;
+        };
+
+        struct device_object : public api_object
+        {
+            virtual device* get_device() = 0;
+        };
+
+        struct command_list : public device_object
+        {
+            virtual void barrier(uint32_t count, const resource* resources, const resource_usage* old_states, const resource_usage* new_states) = 0;
+            virtual void bind_pipeline(pipeline_stage stages, pipeline pipeline) = 0;
+            virtual void push_descriptors(shader_stage stages, pipeline_layout layout, uint32_t layout_param, const descriptor_table_update& update) = 0;
+            virtual void bind_viewports(uint32_t first, uint32_t count, const viewport* viewports) = 0;
+            virtual void bind_scissor_rects(uint32_t first, uint32_t count, const rect* rects) = 0;
+            virtual void bind_render_targets_and_depth_stencil(uint32_t count, const resource_view* rtvs, resource_view dsv = { 0 }) = 0;
+            virtual void draw(uint32_t vertex_count, uint32_t instance_count, uint32_t first_vertex, uint32_t first_instance) = 0;
+            virtual void end_query(query_heap heap, query_type type, uint32_t index) = 0;
+        };
+
+        struct command_queue : public device_object
+        {
+            virtual command_list* get_immediate_command_list() = 0;
+            virtual void wait_idle() const = 0;
+            virtual uint64_t get_timestamp_frequency() const = 0;
+        };
+
+        struct swapchain : public device_object
+        {
+            virtual void* get_hwnd() const = 0;
+            virtual resource get_back_buffer(uint32_t index) = 0;
+            virtual uint32_t get_back_buffer_count() const = 0;
+            virtual uint32_t get_current_back_buffer_index() const = 0;
+        };
+
+        struct effect_runtime : public swapchain
+        {
+        };
+
+        // Bytes per row/slice, for the formats the mock declares
+        uint32_t format_row_pitch(format format, uint32_t width);
+        uint32_t format_slice_pitch(format format, uint32_t row_pitch, uint32_t height);
+    }
+
+    enum class addon_event : uint32_t
+    {
+        init_device = 0,
+        create_swapchain = 4,
+        init_swapchain = 5,
+        destroy_swapchain = 6,
+        set_fullscreen_state = 7,
+        bind_render_targets_and_depth_stencil = 25,
+        bind_viewports = 32,
+        bind_scissor_rects = 33,
+        present = 65,
+        finish_present = 66,
+        reshade_overlay = 80,
+        max = 128
+    };
+
+    template <addon_event ev>
+    struct addon_event_traits;
+
+    template <> struct addon_event_traits<addon_event::init_device> { using decl = void (*)(api::device* device); };
+    template <> struct addon_event_traits<addon_event::create_swapchain> { using decl = bool (*)(api::device_api api, api::swapchain_desc& desc, void* hwnd); };
+    template <> struct addon_event_traits<addon_event::init_swapchain> { using decl = void (*)(api::swapchain* swapchain, bool resize); };
+    template <> struct addon_event_traits<addon_event::destroy_swapchain> { using decl = void (*)(api::swapchain* swapchain, bool resize); };
+    template <> struct addon_event_traits<addon_event::set_fullscreen_state> { using decl = bool (*)(api::swapchain* swapchain, bool fullscreen, void* hmonitor); };
+    template <> struct addon_event_traits<addon_event::bind_render_targets_and_depth_stencil> { using decl = void (*)(api::command_list* cmd_list, uint32_t count, const api::resource_view* rtvs, api::resource_view dsv); };
+    template <> struct addon_event_traits<addon_event::bind_viewports> { using decl = void (*)(api::command_list* cmd_list, uint32_t first, uint32_t count, const api::viewport* viewports); };
+    template <> struct addon_event_traits<addon_event::bind_scissor_rects> { using decl = void (*)(api::command_list* cmd_list, uint32_t first, uint32_t count, const api::rect* rects); };
+    template <> struct addon_event_traits<addon_event::present> { using decl = void (*)(api::command_queue* queue, api::swapchain* swapchain, const api::rect* source_rect, const api::rect* dest_rect, uint32_t dirty_rect_count, const api::rect* dirty_rects); };
+    template <> struct addon_event_traits<addon_event::finish_present> { using decl = void (*)(api::command_queue* queue, api::swapchain* swapchain); };
+    template <> struct addon_event_traits<addon_event::reshade_overlay> { using decl = void (*)(api::effect_runtime* runtime); };
+
+    // Registration is recorded per event, see reshade_mock::registered_callback()
+    void register_event(addon_event ev, void* callback);
+    void unregister_event(addon_event ev, void* callback);
+
+    template <addon_event ev>
+    inline void register_event(typename addon_event_traits<ev>::decl callback)
+    {
+        register_event(ev, reinterpret_cast<void*>(callback));
+    }
+
+    template <addon_event ev>
+    inline void unregister_event(typename addon_event_traits<ev>::decl callback)
+    {
+        unregister_event(ev, reinterpret_cast<void*>(callback));
+    }
+
+    void register_overlay(const char* title, void (*callback)(api::effect_runtime* runtime));
+    void unregister_overlay(const char* title, void (*callback)(api::effect_runtime* runtime));
+
+    bool register_addon(void* module);
+    void unregister_addon(void* module);
+
+    namespace log
+    {
+        enum class level
+        {
+            error = 1,
+            warning = 2,
+            info = 3,
+            debug = 4
+        };
+
+        void message(level level, const char* message);
+    }
+
+    // Values come from the in-memory ini of reshade_mock
+    bool get_config_value(api::effect_runtime* runtime, const char* section, const char* key, char* value, size_t* size);
+    void set_config_value(api::effect_runtime* runtime, const char* section, const char* key, const char* value);
+}
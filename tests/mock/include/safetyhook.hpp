@@ -0,0 +1,83 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+// Stand-in for SafetyHook. Nothing is patched: an InlineHook records its detour so
+// safetyhook_mock::detour_for() can route a call through it, and call<>() invokes the
+// original function like a trampoline would.
+
+#include <utility>
+
+namespace safetyhook
+{
+    class InlineHook
+    {
+    public:
+        enum Flags : int
+        {
+            Default = 0,
+            StartDisabled = 1 << 0
+        };
+
+        // Result of enable()/disable(), tests like the std::expected of the real library
+        struct Result
+        {
+            bool ok = true;
+            explicit operator bool() const { return ok; }
+        };
+
+        InlineHook() = default;
+        InlineHook(void* target, void* destination, Flags flags = Default);
+        ~InlineHook() { reset(); }
+
+        InlineHook(const InlineHook&) = delete;
+        InlineHook& operator=(const InlineHook&) = delete;
+        InlineHook(InlineHook&& other) noexcept { *this = std::move(other); }
+        InlineHook& operator=(InlineHook&& other) noexcept;
+
+        explicit operator bool() const { return target_ != nullptr; }
+
+        void reset();
+
+        Result enable();
+        Result disable();
+        bool enabled() const { return enabled_; }
+
+        template <typename RetT = void, typename... Args>
+        RetT call(Args... args) const
+        {
+            return reinterpret_cast<RetT (*)(Args...)>(target_)(args...);
+        }
+
+        template <typename RetT = void, typename... Args>
+        RetT stdcall(Args... args) const
+        {
+            return call<RetT>(args...);
+        }
+
+    private:
+        void* target_ = nullptr;
+        void* destination_ = nullptr;
+        bool enabled_ = false;
+    };
+
+    inline InlineHook create_inline(void* target, void* destination, InlineHook::Flags flags = InlineHook::Default)
+    {
+        return InlineHook(target, destination, flags);
+    }
+}
+
+using SafetyHookInline = safetyhook::InlineHook;
+
+namespace safetyhook_mock
+{
+    // Detour installed and enabled for a target function, nullptr if it is not hooked
+    void* detour_for(void* target);
+
+    // Number of InlineHook objects created since start, installs and reinstalls included
+    unsigned long long installed_count();
+}
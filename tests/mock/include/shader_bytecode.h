@@ -0,0 +1,18 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+// Stand-in for the header generated from the compiled shaders, the mock device never runs them
+#include <cstddef>
+
+namespace shader_bytecode
+{
+    inline constexpr unsigned char fullscreen_vs[] = { 0x44, 0x58, 0x42, 0x43 };
+    inline constexpr size_t fullscreen_vs_size = sizeof(fullscreen_vs);
+    inline constexpr unsigned char copy_ps[] = { 0x44, 0x58, 0x42, 0x43 };
+    inline constexpr size_t copy_ps_size = sizeof(copy_ps);
+}
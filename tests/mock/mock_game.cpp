@@ -0,0 +1,78 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "mock_game.h"
+
+namespace reshade_mock
+{
+    MockGame::MockGame(device_api api) :
+        device_(api),
+        queue_(device_),
+        hwnd_(win32_mock::create_window(WS_OVERLAPPEDWINDOW, 0, { 0, 0, 1920, 1080 }))
+    {
+    }
+
+    MockGame::~MockGame()
+    {
+        if (swapchain_ != nullptr)
+            destroy_swapchain();
+    }
+
+    bool MockGame::raise_create_swapchain(swapchain_desc& desc)
+    {
+        using reshade::addon_event;
+        const auto callback = registered<addon_event::create_swapchain>();
+        return callback != nullptr && callback(device_.get_api(), desc, hwnd_);
+    }
+
+    bool MockGame::create_swapchain(uint32_t width, uint32_t height, uint32_t back_buffer_count, format back_buffer_format)
+    {
+        swapchain_desc desc = {};
+        desc.back_buffer.type = resource_type::texture_2d;
+        desc.back_buffer.texture.width = width;
+        desc.back_buffer.texture.height = height;
+        desc.back_buffer.texture.format = back_buffer_format;
+        desc.back_buffer_count = back_buffer_count;
+        const bool modified = raise_create_swapchain(desc);
+
+        back_buffer_count_ = desc.back_buffer_count;
+        swapchain_ = std::make_unique<MockSwapchain>(device_, hwnd_, desc.back_buffer.texture.width, desc.back_buffer.texture.height,
+            desc.back_buffer_count, desc.back_buffer.texture.format);
+        dispatch<reshade::addon_event::init_swapchain>(swapchain_.get(), false);
+        return modified;
+    }
+
+    bool MockGame::resize(uint32_t width, uint32_t height, format back_buffer_format)
+    {
+        dispatch<reshade::addon_event::destroy_swapchain>(swapchain_.get(), true);
+
+        swapchain_desc desc = {};
+        desc.back_buffer.type = resource_type::texture_2d;
+        desc.back_buffer.texture.width = width;
+        desc.back_buffer.texture.height = height;
+        desc.back_buffer.texture.format = back_buffer_format != format::unknown ?
+            back_buffer_format : device_.get_resource_desc(swapchain_->get_back_buffer(0)).texture.format;
+        desc.back_buffer_count = back_buffer_count_;
+        const bool modified = raise_create_swapchain(desc);
+
+        swapchain_->resize(desc.back_buffer.texture.width, desc.back_buffer.texture.height, desc.back_buffer.texture.format);
+        dispatch<reshade::addon_event::init_swapchain>(swapchain_.get(), true);
+        return modified;
+    }
+
+    void MockGame::present()
+    {
+        dispatch<reshade::addon_event::present>(&queue_, swapchain_.get(), nullptr, nullptr, 0u, nullptr);
+        dispatch<reshade::addon_event::finish_present>(&queue_, swapchain_.get());
+        swapchain_->advance_back_buffer();
+    }
+
+    void MockGame::destroy_swapchain()
+    {
+        dispatch<reshade::addon_event::destroy_swapchain>(swapchain_.get(), false);
+        swapchain_.reset();
+    }
+}
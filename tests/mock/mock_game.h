@@ -0,0 +1,56 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include "mock_reshade.h"
+#include "mock_win32.h"
+#include <memory>
+
+namespace reshade_mock
+{
+    // One window, device and swapchain of an application. Raises the events ReShade would raise for
+    // CreateSwapChain, ResizeBuffers, Present and Release, through the callbacks the addon registered.
+    class MockGame
+    {
+    public:
+        explicit MockGame(device_api api = device_api::d3d11);
+        ~MockGame();
+
+        // CreateSwapChain: create_swapchain may change the description, the back buffers are created
+        // at the size it ends up with, then init_swapchain. Returns false if the addon changed the description.
+        bool create_swapchain(uint32_t width, uint32_t height, uint32_t back_buffer_count = 2,
+                              format back_buffer_format = format::r8g8b8a8_unorm);
+
+        // ResizeBuffers: destroy_swapchain(resize), create_swapchain, new back buffers, init_swapchain(resize)
+        bool resize(uint32_t width, uint32_t height, format back_buffer_format = format::unknown);
+
+        // Present: present, finish_present, flip to the next back buffer
+        void present();
+
+        // Release of the last swapchain reference
+        void destroy_swapchain();
+
+        // Render target view of the back buffer the application renders to this frame
+        resource_view current_back_buffer_rtv() const { return swapchain_->back_buffer_rtv(swapchain_->get_current_back_buffer_index()); }
+
+        MockDevice& device() { return device_; }
+        MockCommandQueue& queue() { return queue_; }
+        MockCommandList& cmd_list() { return queue_.immediate(); }
+        MockSwapchain& swapchain() { return *swapchain_; }
+        bool has_swapchain() const { return swapchain_ != nullptr; }
+        HWND hwnd() const { return hwnd_; }
+
+    private:
+        bool raise_create_swapchain(swapchain_desc& desc);
+
+        MockDevice device_;
+        MockCommandQueue queue_;
+        HWND hwnd_;
+        uint32_t back_buffer_count_ = 0;
+        std::unique_ptr<MockSwapchain> swapchain_;
+    };
+}
@@ -0,0 +1,491 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "mock_reshade.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <map>
+
+namespace reshade_mock
+{
+    void CallLog::clear()
+    {
+        for (std::atomic<uint64_t>& count : counts_)
+            count.store(0, std::memory_order_relaxed);
+    }
+
+    // MockDevice
+    bool MockDevice::create_sampler(const sampler_desc&, sampler* out_sampler)
+    {
+        calls_.record(Call::CreateSampler);
+        std::lock_guard<std::mutex> lock(mutex_);
+        out_sampler->handle = next_handle();
+        objects_[out_sampler->handle] = Call::CreateSampler;
+        return true;
+    }
+
+    void MockDevice::destroy_sampler(sampler sampler)
+    {
+        calls_.record(Call::DestroySampler);
+        std::lock_guard<std::mutex> lock(mutex_);
+        objects_.erase(sampler.handle);
+    }
+
+    bool MockDevice::create_resource(const resource_desc& desc, const subresource_data*, resource_usage, resource* out_resource, void**)
+    {
+        calls_.record(Call::CreateResource);
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        const uint64_t pixels = uint64_t(desc.texture.width) * desc.texture.height;
+        if (failing_resources_ != 0 || (max_texture_pixels_ != 0 && pixels > max_texture_pixels_))
+        {
+            if (failing_resources_ != 0)
+                --failing_resources_;
+            *out_resource = {};
+            return false;
+        }
+
+        out_resource->handle = next_handle();
+        resources_[out_resource->handle] = desc;
+        return true;
+    }
+
+    void MockDevice::destroy_resource(resource resource)
+    {
+        calls_.record(Call::DestroyResource);
+        std::lock_guard<std::mutex> lock(mutex_);
+        resources_.erase(resource.handle);
+    }
+
+    resource_desc MockDevice::get_resource_desc(resource resource) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto it = resources_.find(resource.handle);
+        return it != resources_.end() ? it->second : resource_desc {};
+    }
+
+    bool MockDevice::create_resource_view(resource resource, resource_usage, const resource_view_desc&, resource_view* out_view)
+    {
+        calls_.record(Call::CreateResourceView);
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (resources_.find(resource.handle) == resources_.end())
+        {
+            *out_view = {};
+            return false;
+        }
+
+        out_view->handle = next_handle();
+        views_[out_view->handle] = resource.handle;
+        return true;
+    }
+
+    void MockDevice::destroy_resource_view(resource_view view)
+    {
+        calls_.record(Call::DestroyResourceView);
+        std::lock_guard<std::mutex> lock(mutex_);
+        views_.erase(view.handle);
+    }
+
+    resource MockDevice::get_resource_from_view(resource_view view) const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto it = views_.find(view.handle);
+        return { it != views_.end() ? it->second : 0 };
+    }
+
+    bool MockDevice::create_pipeline(pipeline_layout, uint32_t, const pipeline_subobject*, pipeline* out_pipeline)
+    {
+        calls_.record(Call::CreatePipeline);
+        std::lock_guard<std::mutex> lock(mutex_);
+        out_pipeline->handle = next_handle();
+        objects_[out_pipeline->handle] = Call::CreatePipeline;
+        return true;
+    }
+
+    void MockDevice::destroy_pipeline(pipeline pipeline)
+    {
+        calls_.record(Call::DestroyPipeline);
+        std::lock_guard<std::mutex> lock(mutex_);
+        objects_.erase(pipeline.handle);
+    }
+
+    bool MockDevice::create_pipeline_layout(uint32_t, const pipeline_layout_param*, pipeline_layout* out_layout)
+    {
+        calls_.record(Call::CreatePipelineLayout);
+        std::lock_guard<std::mutex> lock(mutex_);
+        out_layout->handle = next_handle();
+        objects_[out_layout->handle] = Call::CreatePipelineLayout;
+        return true;
+    }
+
+    void MockDevice::destroy_pipeline_layout(pipeline_layout layout)
+    {
+        calls_.record(Call::DestroyPipelineLayout);
+        std::lock_guard<std::mutex> lock(mutex_);
+        objects_.erase(layout.handle);
+    }
+
+    bool MockDevice::create_query_heap(query_type, uint32_t size, query_heap* out_heap)
+    {
+        calls_.record(Call::CreateQueryHeap);
+        std::lock_guard<std::mutex> lock(mutex_);
+        out_heap->handle = next_handle();
+        objects_[out_heap->handle] = Call::CreateQueryHeap;
+        query_heaps_[out_heap->handle].assign(size, 0);
+        return true;
+    }
+
+    void MockDevice::destroy_query_heap(query_heap heap)
+    {
+        calls_.record(Call::DestroyQueryHeap);
+        std::lock_guard<std::mutex> lock(mutex_);
+        objects_.erase(heap.handle);
+        query_heaps_.erase(heap.handle);
+    }
+
+    bool MockDevice::get_query_heap_results(query_heap heap, uint32_t first, uint32_t count, void* results, uint32_t stride)
+    {
+        calls_.record(Call::GetQueryHeapResults);
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto it = query_heaps_.find(heap.handle);
+        if (it == query_heaps_.end() || first + count > it->second.size())
+            return false;
+
+        // Queries complete as soon as they are written, like a GPU that is never behind
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            if (it->second[first + i] == 0)
+                return false;
+            std::memcpy(static_cast<char*>(results) + size_t(i) * stride, &it->second[first + i], sizeof(uint64_t));
+        }
+        return true;
+    }
+
+    resource MockDevice::create_texture(uint32_t width, uint32_t height, format format)
+    {
+        resource_desc desc = {};
+        desc.type = resource_type::texture_2d;
+        desc.texture.width = width;
+        desc.texture.height = height;
+        desc.texture.depth_or_layers = 1;
+        desc.texture.levels = 1;
+        desc.texture.format = format;
+        desc.texture.samples = 1;
+        desc.heap = memory_heap::gpu_only;
+        desc.usage = resource_usage::render_target | resource_usage::copy_source;
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        const resource texture = { next_handle() };
+        resources_[texture.handle] = desc;
+        return texture;
+    }
+
+    resource_view MockDevice::create_render_target_view(resource resource)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const resource_view view = { next_handle() };
+        views_[view.handle] = resource.handle;
+        return view;
+    }
+
+    void MockDevice::write_timestamp(query_heap heap, uint32_t index)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const auto it = query_heaps_.find(heap.handle);
+        if (it != query_heaps_.end() && index < it->second.size())
+        {
+            // 25 us between two timestamps
+            timestamp_ += 25000;
+            it->second[index] = timestamp_;
+        }
+    }
+
+    size_t MockDevice::live_resource_count() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return resources_.size();
+    }
+
+    size_t MockDevice::live_view_count() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return views_.size();
+    }
+
+    size_t MockDevice::live_object_count() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return objects_.size();
+    }
+
+    // MockCommandList
+    void MockCommandList::barrier(uint32_t, const resource*, const resource_usage*, const resource_usage*)
+    {
+        device_.calls().record(Call::Barrier);
+    }
+
+    void MockCommandList::bind_pipeline(pipeline_stage, pipeline)
+    {
+        device_.calls().record(Call::BindPipeline);
+    }
+
+    void MockCommandList::push_descriptors(shader_stage, pipeline_layout, uint32_t, const descriptor_table_update&)
+    {
+        device_.calls().record(Call::PushDescriptors);
+    }
+
+    void MockCommandList::bind_viewports(uint32_t, uint32_t count, const viewport* viewports)
+    {
+        device_.calls().record(Call::BindViewports);
+        viewports_.assign(viewports, viewports + count);
+    }
+
+    void MockCommandList::bind_scissor_rects(uint32_t, uint32_t count, const rect* rects)
+    {
+        device_.calls().record(Call::BindScissorRects);
+        scissor_rects_.assign(rects, rects + count);
+    }
+
+    void MockCommandList::bind_render_targets_and_depth_stencil(uint32_t count, const resource_view* rtvs, resource_view)
+    {
+        device_.calls().record(Call::BindRenderTargets);
+        render_targets_.assign(rtvs, rtvs + count);
+    }
+
+    void MockCommandList::draw(uint32_t, uint32_t, uint32_t, uint32_t)
+    {
+        device_.calls().record(Call::Draw);
+    }
+
+    void MockCommandList::end_query(query_heap heap, query_type, uint32_t index)
+    {
+        device_.calls().record(Call::EndQuery);
+        device_.write_timestamp(heap, index);
+    }
+
+    // MockSwapchain
+    MockSwapchain::MockSwapchain(MockDevice& device, void* hwnd, uint32_t width, uint32_t height,
+                                 uint32_t back_buffer_count, format back_buffer_format) :
+        device_(device),
+        hwnd_(hwnd),
+        width_(width),
+        height_(height),
+        format_(back_buffer_format)
+    {
+        create_back_buffers(back_buffer_count);
+    }
+
+    MockSwapchain::~MockSwapchain()
+    {
+        destroy_back_buffers();
+    }
+
+    void MockSwapchain::resize(uint32_t width, uint32_t height, format back_buffer_format)
+    {
+        const uint32_t count = get_back_buffer_count();
+        destroy_back_buffers();
+        width_ = width;
+        height_ = height;
+        if (back_buffer_format != format::unknown)
+            format_ = back_buffer_format;
+        current_index_ = 0;
+        create_back_buffers(count);
+    }
+
+    void MockSwapchain::create_back_buffers(uint32_t count)
+    {
+        for (uint32_t i = 0; i < count; ++i)
+        {
+            back_buffers_.push_back(device_.create_texture(width_, height_, format_));
+            back_buffer_rtvs_.push_back(device_.create_render_target_view(back_buffers_.back()));
+        }
+    }
+
+    void MockSwapchain::destroy_back_buffers()
+    {
+        for (resource_view view : back_buffer_rtvs_)
+            device_.destroy_resource_view(view);
+        for (resource back_buffer : back_buffers_)
+            device_.destroy_resource(back_buffer);
+
+        back_buffers_.clear();
+        back_buffer_rtvs_.clear();
+    }
+
+    // Event registration
+    namespace
+    {
+        constexpr size_t EVENT_SLOTS = static_cast<size_t>(reshade::addon_event::max);
+
+        std::array<std::atomic<void*>, EVENT_SLOTS> g_callbacks = {};
+        std::atomic<uint64_t> g_registration_changes = 0;
+        std::mutex g_registration_mutex;
+        std::thread::id g_registration_thread;
+
+        // Benchmarks log on every redirect, only the latest messages are kept
+        constexpr size_t MAX_LOG_ENTRIES = 4096;
+        std::mutex g_log_mutex;
+        std::deque<LogEntry> g_log;
+
+        std::mutex g_config_mutex;
+        std::map<std::pair<std::string, std::string>, std::string> g_config;
+    }
+
+    void* registered_callback(reshade::addon_event ev)
+    {
+        return g_callbacks[static_cast<size_t>(ev)].load(std::memory_order_acquire);
+    }
+
+    uint64_t registration_change_count()
+    {
+        return g_registration_changes.load(std::memory_order_relaxed);
+    }
+
+    std::thread::id last_registration_thread()
+    {
+        std::lock_guard<std::mutex> lock(g_registration_mutex);
+        return g_registration_thread;
+    }
+
+    void reset_registrations()
+    {
+        g_registration_changes.store(0, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(g_registration_mutex);
+        g_registration_thread = {};
+    }
+
+    static void note_registration_change()
+    {
+        g_registration_changes.fetch_add(1, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(g_registration_mutex);
+        g_registration_thread = std::this_thread::get_id();
+    }
+
+    std::vector<LogEntry> log_entries()
+    {
+        std::lock_guard<std::mutex> lock(g_log_mutex);
+        return { g_log.begin(), g_log.end() };
+    }
+
+    bool has_logged(const std::string& substring)
+    {
+        std::lock_guard<std::mutex> lock(g_log_mutex);
+        for (const LogEntry& entry : g_log)
+        {
+            if (entry.text.find(substring) != std::string::npos)
+                return true;
+        }
+        return false;
+    }
+
+    void clear_log()
+    {
+        std::lock_guard<std::mutex> lock(g_log_mutex);
+        g_log.clear();
+    }
+
+    void set_config(const char* section, const char* key, const char* value)
+    {
+        std::lock_guard<std::mutex> lock(g_config_mutex);
+        g_config[{ section, key }] = value;
+    }
+
+    void clear_config()
+    {
+        std::lock_guard<std::mutex> lock(g_config_mutex);
+        g_config.clear();
+    }
+}
+
+// reshade:: free functions
+namespace reshade
+{
+    uint32_t api::format_row_pitch(format format, uint32_t width)
+    {
+        switch (format)
+        {
+        case format::r32g32b32a32_float:
+            return width * 16;
+        case format::r16g16b16a16_float:
+            return width * 8;
+        default:
+            return width * 4;
+        }
+    }
+
+    uint32_t api::format_slice_pitch(format, uint32_t row_pitch, uint32_t height)
+    {
+        return row_pitch * height;
+    }
+
+    void register_event(addon_event ev, void* callback)
+    {
+        reshade_mock::g_callbacks[static_cast<size_t>(ev)].store(callback, std::memory_order_release);
+        reshade_mock::note_registration_change();
+    }
+
+    void unregister_event(addon_event ev, void* callback)
+    {
+        void* expected = callback;
+        reshade_mock::g_callbacks[static_cast<size_t>(ev)].compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel);
+        reshade_mock::note_registration_change();
+    }
+
+    void register_overlay(const char*, void (*)(api::effect_runtime*))
+    {
+    }
+
+    void unregister_overlay(const char*, void (*)(api::effect_runtime*))
+    {
+    }
+
+    bool register_addon(void*)
+    {
+        return true;
+    }
+
+    void unregister_addon(void*)
+    {
+    }
+
+    void log::message(level level, const char* message)
+    {
+        // Set SWAPCHAIN_OVERRIDE_MOCK_LOG to see the addon log while debugging a test
+        static const bool echo = std::getenv("SWAPCHAIN_OVERRIDE_MOCK_LOG") != nullptr;
+        if (echo)
+            std::fprintf(stderr, "[%d] %s\n", static_cast<int>(level), message);
+
+        std::lock_guard<std::mutex> lock(reshade_mock::g_log_mutex);
+        if (reshade_mock::g_log.size() == reshade_mock::MAX_LOG_ENTRIES)
+            reshade_mock::g_log.pop_front();
+        reshade_mock::g_log.push_back({ level, message });
+    }
+
+    bool get_config_value(api::effect_runtime*, const char* section, const char* key, char* value, size_t* size)
+    {
+        std::lock_guard<std::mutex> lock(reshade_mock::g_config_mutex);
+        const auto it = reshade_mock::g_config.find({ section, key });
+        if (it == reshade_mock::g_config.end())
+            return false;
+
+        if (value != nullptr && *size != 0)
+        {
+            const size_t length = std::min(it->second.size(), *size - 1);
+            std::memcpy(value, it->second.data(), length);
+            value[length] = '\0';
+        }
+        *size = it->second.size() + 1;
+        return true;
+    }
+
+    void set_config_value(api::effect_runtime*, const char* section, const char* key, const char* value)
+    {
+        reshade_mock::set_config(section, key, value);
+    }
+}
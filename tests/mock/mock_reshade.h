@@ -0,0 +1,299 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <reshade.hpp>
+#include <dxgi.h>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Recording implementations of the reshade::api objects, for tests and benchmarks on any platform.
+// Every API call is counted, the objects a device creates are tracked until they are destroyed,
+// and the last state bound on a command list can be inspected.
+namespace reshade_mock
+{
+    using namespace reshade::api;
+
+    // API calls counted by the mocks
+    enum class Call : uint8_t
+    {
+        CreateResource,
+        DestroyResource,
+        CreateResourceView,
+        DestroyResourceView,
+        CreatePipeline,
+        DestroyPipeline,
+        CreatePipelineLayout,
+        DestroyPipelineLayout,
+        CreateSampler,
+        DestroySampler,
+        CreateQueryHeap,
+        DestroyQueryHeap,
+        GetQueryHeapResults,
+        Barrier,
+        BindPipeline,
+        PushDescriptors,
+        BindViewports,
+        BindScissorRects,
+        BindRenderTargets,
+        Draw,
+        EndQuery,
+        WaitIdle,
+        Count
+    };
+
+    constexpr size_t CALL_COUNT = static_cast<size_t>(Call::Count);
+
+    // Call counters, shared by a device and the queues, command lists and swapchains on it
+    class CallLog
+    {
+    public:
+        void record(Call call) { counts_[static_cast<size_t>(call)].fetch_add(1, std::memory_order_relaxed); }
+        uint64_t count(Call call) const { return counts_[static_cast<size_t>(call)].load(std::memory_order_relaxed); }
+        void clear();
+
+    private:
+        std::array<std::atomic<uint64_t>, CALL_COUNT> counts_ = {};
+    };
+
+    class MockDevice final : public device
+    {
+    public:
+        explicit MockDevice(device_api api = device_api::d3d11) : api_(api) {}
+
+        uint64_t get_native() const override { return reinterpret_cast<uintptr_t>(this); }
+        device_api get_api() const override { return api_; }
+
+        bool create_sampler(const sampler_desc& desc, sampler* out_sampler) override;
+        void destroy_sampler(sampler sampler) override;
+
+        bool create_resource(const resource_desc& desc, const subresource_data* initial_data, resource_usage initial_state, resource* out_resource, void** shared_handle = nullptr) override;
+        void destroy_resource(resource resource) override;
+        resource_desc get_resource_desc(resource resource) const override;
+
+        bool create_resource_view(resource resource, resource_usage usage_type, const resource_view_desc& desc, resource_view* out_view) override;
+        void destroy_resource_view(resource_view view) override;
+        resource get_resource_from_view(resource_view view) const override;
+
+        bool create_pipeline(pipeline_layout layout, uint32_t subobject_count, const pipeline_subobject* subobjects, pipeline* out_pipeline) override;
+        void destroy_pipeline(pipeline pipeline) override;
+        bool create_pipeline_layout(uint32_t param_count, const pipeline_layout_param* params, pipeline_layout* out_layout) override;
+        void destroy_pipeline_layout(pipeline_layout layout) override;
+
+        bool create_query_heap(query_type type, uint32_t size, query_heap* out_heap) override;
+        void destroy_query_heap(query_heap heap) override;
+        bool get_query_heap_results(query_heap heap, uint32_t first, uint32_t count, void* results, uint32_t stride) override;
+
+        // Resources the application owns, like back buffers (not counted as addon allocations)
+        resource create_texture(uint32_t width, uint32_t height, format format);
+        resource_view create_render_target_view(resource resource);
+
+        // Written by MockCommandList::end_query, one tick per query
+        void write_timestamp(query_heap heap, uint32_t index);
+
+        // Failure injection: textures with more pixels than this are refused (0 = no limit)
+        void set_max_texture_pixels(uint64_t pixels) { max_texture_pixels_ = pixels; }
+        // Failure injection: the next n create_resource calls fail
+        void fail_next_resources(uint32_t count) { failing_resources_ = count; }
+
+        // Objects created through the device API and not destroyed yet
+        size_t live_resource_count() const;
+        size_t live_view_count() const;
+        size_t live_object_count() const;  // Pipelines, layouts, samplers and query heaps
+
+        CallLog& calls() { return calls_; }
+        const CallLog& calls() const { return calls_; }
+
+    private:
+        uint64_t next_handle() { return next_handle_.fetch_add(1, std::memory_order_relaxed); }
+
+        const device_api api_;
+        CallLog calls_;
+        std::atomic<uint64_t> next_handle_ = 0x1000;
+        uint64_t max_texture_pixels_ = 0;
+        uint32_t failing_resources_ = 0;
+
+        mutable std::mutex mutex_;
+        std::unordered_map<uint64_t, resource_desc> resources_;
+        std::unordered_map<uint64_t, uint64_t> views_;  // View -> resource
+        std::unordered_map<uint64_t, Call> objects_;     // Handle -> creating call
+        std::unordered_map<uint64_t, std::vector<uint64_t>> query_heaps_;
+        uint64_t timestamp_ = 0;
+    };
+
+    class MockCommandList final : public command_list
+    {
+    public:
+        explicit MockCommandList(MockDevice& device) : device_(device) {}
+
+        uint64_t get_native() const override { return reinterpret_cast<uintptr_t>(this); }
+        device* get_device() override { return &device_; }
+
+        void barrier(uint32_t count, const resource* resources, const resource_usage* old_states, const resource_usage* new_states) override;
+        void bind_pipeline(pipeline_stage stages, pipeline pipeline) override;
+        void push_descriptors(shader_stage stages, pipeline_layout layout, uint32_t layout_param, const descriptor_table_update& update) override;
+        void bind_viewports(uint32_t first, uint32_t count, const viewport* viewports) override;
+        void bind_scissor_rects(uint32_t first, uint32_t count, const rect* rects) override;
+        void bind_render_targets_and_depth_stencil(uint32_t count, const resource_view* rtvs, resource_view dsv = { 0 }) override;
+        void draw(uint32_t vertex_count, uint32_t instance_count, uint32_t first_vertex, uint32_t first_instance) override;
+        void end_query(query_heap heap, query_type type, uint32_t index) override;
+
+        // State of the most recent bind calls
+        const std::vector<resource_view>& bound_render_targets() const { return render_targets_; }
+        const std::vector<viewport>& bound_viewports() const { return viewports_; }
+        const std::vector<rect>& bound_scissor_rects() const { return scissor_rects_; }
+
+    private:
+        MockDevice& device_;
+        std::vector<resource_view> render_targets_;
+        std::vector<viewport> viewports_;
+        std::vector<rect> scissor_rects_;
+    };
+
+    class MockCommandQueue final : public command_queue
+    {
+    public:
+        explicit MockCommandQueue(MockDevice& device) : device_(device), immediate_(device) {}
+
+        uint64_t get_native() const override { return reinterpret_cast<uintptr_t>(this); }
+        device* get_device() override { return &device_; }
+        command_list* get_immediate_command_list() override { return &immediate_; }
+        void wait_idle() const override
+        {
+            device_.calls().record(Call::WaitIdle);
+            if (wait_idle_callback_)
+                wait_idle_callback_();
+        }
+        uint64_t get_timestamp_frequency() const override { return 1000000000; }
+
+        MockCommandList& immediate() { return immediate_; }
+
+        // Runs inside wait_idle, to check what the addon still holds while it waits for the GPU
+        void set_wait_idle_callback(std::function<void()> callback) { wait_idle_callback_ = std::move(callback); }
+
+    private:
+        MockDevice& device_;
+        MockCommandList immediate_;
+        std::function<void()> wait_idle_callback_;
+    };
+
+    // Native swapchain behind a MockSwapchain, for the DXGI calls the addon makes itself
+    class MockDxgiSwapChain final : public IDXGISwapChain
+    {
+    public:
+        HRESULT SetFullscreenState(BOOL fullscreen, IDXGIOutput*) override
+        {
+            fullscreen_ = fullscreen != FALSE;
+            set_fullscreen_state_calls_.fetch_add(1, std::memory_order_relaxed);
+            return S_OK;
+        }
+
+        HRESULT GetFullscreenState(BOOL* fullscreen, IDXGIOutput** target) override
+        {
+            if (fullscreen != nullptr)
+                *fullscreen = fullscreen_ ? TRUE : FALSE;
+            if (target != nullptr)
+                *target = nullptr;
+            return S_OK;
+        }
+
+        bool is_fullscreen() const { return fullscreen_; }
+        uint64_t set_fullscreen_state_calls() const { return set_fullscreen_state_calls_.load(std::memory_order_relaxed); }
+
+    private:
+        bool fullscreen_ = false;
+        std::atomic<uint64_t> set_fullscreen_state_calls_ = 0;
+    };
+
+    class MockSwapchain final : public swapchain
+    {
+    public:
+        MockSwapchain(MockDevice& device, void* hwnd, uint32_t width, uint32_t height,
+                      uint32_t back_buffer_count = 2, format back_buffer_format = format::r8g8b8a8_unorm);
+        ~MockSwapchain() override;
+
+        uint64_t get_native() const override { return reinterpret_cast<uintptr_t>(&dxgi_); }
+        device* get_device() override { return &device_; }
+        void* get_hwnd() const override { return hwnd_; }
+        resource get_back_buffer(uint32_t index) override { return back_buffers_[index]; }
+        uint32_t get_back_buffer_count() const override { return static_cast<uint32_t>(back_buffers_.size()); }
+        uint32_t get_current_back_buffer_index() const override { return current_index_; }
+
+        // ResizeBuffers: the back buffers are replaced, even when the size stays the same
+        void resize(uint32_t width, uint32_t height, format back_buffer_format = format::unknown);
+
+        // Present flips to the next back buffer
+        void advance_back_buffer() { current_index_ = (current_index_ + 1) % get_back_buffer_count(); }
+
+        // Render target view of a back buffer, as the application would create it
+        resource_view back_buffer_rtv(uint32_t index) const { return back_buffer_rtvs_[index]; }
+
+        uint32_t width() const { return width_; }
+        uint32_t height() const { return height_; }
+        MockDxgiSwapChain& dxgi() { return dxgi_; }
+
+    private:
+        void create_back_buffers(uint32_t count);
+        void destroy_back_buffers();
+
+        MockDevice& device_;
+        void* const hwnd_;
+        MockDxgiSwapChain dxgi_;
+        uint32_t width_;
+        uint32_t height_;
+        format format_;
+        uint32_t current_index_ = 0;
+        std::vector<resource> back_buffers_;
+        std::vector<resource_view> back_buffer_rtvs_;
+    };
+
+    // Callback registered for an event, nullptr if there is none
+    void* registered_callback(reshade::addon_event ev);
+
+    template <reshade::addon_event ev>
+    typename reshade::addon_event_traits<ev>::decl registered()
+    {
+        return reinterpret_cast<typename reshade::addon_event_traits<ev>::decl>(registered_callback(ev));
+    }
+
+    // Call the callback registered for an event like ReShade would, returns false if none is registered
+    template <reshade::addon_event ev, typename... Args>
+    bool dispatch(Args&&... args)
+    {
+        const auto callback = registered<ev>();
+        if (callback == nullptr)
+            return false;
+        callback(std::forward<Args>(args)...);
+        return true;
+    }
+
+    // register_event/unregister_event calls since the last reset, and the thread of the latest one
+    uint64_t registration_change_count();
+    std::thread::id last_registration_thread();
+    void reset_registrations();
+
+    // Messages passed to reshade::log::message
+    struct LogEntry
+    {
+        reshade::log::level level;
+        std::string text;
+    };
+    std::vector<LogEntry> log_entries();
+    bool has_logged(const std::string& substring);
+    void clear_log();
+
+    // In-memory [section] key=value store behind get_config_value/set_config_value
+    void set_config(const char* section, const char* key, const char* value);
+    void clear_config();
+}
@@ -0,0 +1,89 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include <safetyhook.hpp>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+
+namespace
+{
+    std::mutex g_hook_mutex;
+    std::unordered_map<void*, void*> g_detours;  // Target -> destination
+    std::atomic<unsigned long long> g_installed = 0;
+}
+
+namespace safetyhook
+{
+    InlineHook::InlineHook(void* target, void* destination, Flags flags)
+        : target_(target), destination_(destination)
+    {
+        g_installed.fetch_add(1, std::memory_order_relaxed);
+        if ((flags & StartDisabled) == 0)
+            enable();
+    }
+
+    InlineHook& InlineHook::operator=(InlineHook&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            target_ = std::exchange(other.target_, nullptr);
+            destination_ = std::exchange(other.destination_, nullptr);
+            enabled_ = std::exchange(other.enabled_, false);
+        }
+        return *this;
+    }
+
+    void InlineHook::reset()
+    {
+        if (target_ == nullptr)
+            return;
+
+        disable();
+        target_ = nullptr;
+        destination_ = nullptr;
+    }
+
+    InlineHook::Result InlineHook::enable()
+    {
+        if (target_ == nullptr)
+            return { false };
+
+        std::lock_guard<std::mutex> lock(g_hook_mutex);
+        g_detours[target_] = destination_;
+        enabled_ = true;
+        return {};
+    }
+
+    InlineHook::Result InlineHook::disable()
+    {
+        if (target_ == nullptr)
+            return { false };
+
+        std::lock_guard<std::mutex> lock(g_hook_mutex);
+        const auto it = g_detours.find(target_);
+        if (it != g_detours.end() && it->second == destination_)
+            g_detours.erase(it);
+        enabled_ = false;
+        return {};
+    }
+}
+
+namespace safetyhook_mock
+{
+    void* detour_for(void* target)
+    {
+        std::lock_guard<std::mutex> lock(g_hook_mutex);
+        const auto it = g_detours.find(target);
+        return it != g_detours.end() ? it->second : nullptr;
+    }
+
+    unsigned long long installed_count()
+    {
+        return g_installed.load(std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,773 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "mock_win32.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <mutex>
+#include <string>
+#include <strings.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+
+namespace
+{
+    // Every HANDLE handed out by the mock points to one of these
+    struct MockObject
+    {
+        virtual ~MockObject() = default;
+    };
+
+    struct Event : MockObject
+    {
+        std::mutex mutex;
+        std::condition_variable changed;
+        bool manual_reset = false;
+        bool signaled = false;
+        bool closing = false;  // Wakes the thread pool waits when they are unregistered
+    };
+
+    struct File : MockObject
+    {
+        FILE* stream = nullptr;
+        ~File() override
+        {
+            if (stream != nullptr)
+                std::fclose(stream);
+        }
+    };
+
+    // Named mappings are POSIX shared memory objects "/<name without Local\\>", so tools in another
+    // process (stats_monitor) can open them. Closing the handle unlinks the object, like the last
+    // handle to a Windows mapping.
+    struct Mapping : MockObject
+    {
+        std::vector<unsigned char> memory;
+        std::string shm_name;
+        void* shared_view = nullptr;
+        size_t size = 0;
+
+        ~Mapping() override
+        {
+            if (shared_view != nullptr)
+                munmap(shared_view, size);
+            if (!shm_name.empty())
+                shm_unlink(shm_name.c_str());
+        }
+    };
+
+    // Thread pool wait or timer queue timer, one thread each
+    struct Worker : MockObject
+    {
+        std::thread thread;
+        std::mutex mutex;
+        std::condition_variable changed;
+        bool stop = false;
+        Event* event = nullptr;  // Waits only
+    };
+
+    std::string narrow(const wchar_t* text)
+    {
+        std::string result;
+        for (; *text != L'\0'; ++text)
+            result.push_back(*text < 0x80 ? static_cast<char>(*text) : '?');
+        return result;
+    }
+
+    // Clock
+    std::mutex g_clock_mutex;
+    bool g_frozen_clock = false;
+    uint64_t g_tick_count = 0;
+
+    std::wstring g_module_path;
+
+    // Windows and monitors
+    struct Window
+    {
+        LONG style;
+        LONG ex_style;
+        RECT rect;
+    };
+
+    std::mutex g_window_mutex;
+    std::unordered_map<HWND, Window> g_windows;
+    uintptr_t g_next_window = 0x10000;
+    std::vector<RECT> g_monitors = { { 0, 0, 1920, 1080 } };
+    win32_mock::User32Calls g_user32_calls;
+    win32_mock::SetWindowPosCall g_last_set_window_pos = {};
+
+    LPTOP_LEVEL_EXCEPTION_FILTER g_exception_filter = nullptr;
+
+    // Files
+    std::mutex g_file_write_mutex;
+    std::condition_variable g_file_write_released;
+    bool g_file_writes_held = false;
+    std::vector<std::thread::id> g_file_write_threads;
+
+    HWND add_window(DWORD style, DWORD ex_style, const RECT& rect)
+    {
+        // Note: Caller must hold g_window_mutex
+        const HWND hwnd = reinterpret_cast<HWND>(g_next_window);
+        g_next_window += 0x10;
+        g_windows[hwnd] = { static_cast<LONG>(style), static_cast<LONG>(ex_style), rect };
+        return hwnd;
+    }
+
+    LONG_PTR set_window_long(HWND hwnd, int index, LONG_PTR value)
+    {
+        std::lock_guard<std::mutex> lock(g_window_mutex);
+        ++g_user32_calls.set_window_long;
+        const auto it = g_windows.find(hwnd);
+        if (it == g_windows.end())
+            return 0;
+
+        LONG& field = index == GWL_EXSTYLE ? it->second.ex_style : it->second.style;
+        const LONG previous = field;
+        field = static_cast<LONG>(value);
+        return previous;
+    }
+
+    LONG get_window_long(HWND hwnd, int index)
+    {
+        std::lock_guard<std::mutex> lock(g_window_mutex);
+        const auto it = g_windows.find(hwnd);
+        if (it == g_windows.end())
+            return 0;
+        return index == GWL_EXSTYLE ? it->second.ex_style : it->second.style;
+    }
+
+    HMONITOR monitor_handle(size_t index)
+    {
+        return reinterpret_cast<HMONITOR>(static_cast<uintptr_t>(index + 1));
+    }
+
+    HMONITOR monitor_from_point(LONG x, LONG y, DWORD flags)
+    {
+        // Note: Caller must hold g_window_mutex
+        for (size_t i = 0; i < g_monitors.size(); ++i)
+        {
+            const RECT& m = g_monitors[i];
+            if (x >= m.left && x < m.right && y >= m.top && y < m.bottom)
+                return monitor_handle(i);
+        }
+        return flags == MONITOR_DEFAULTTONULL || g_monitors.empty() ? nullptr : monitor_handle(0);
+    }
+
+    BOOL get_monitor_info(HMONITOR monitor, MONITORINFO* info)
+    {
+        std::lock_guard<std::mutex> lock(g_window_mutex);
+        const size_t index = reinterpret_cast<uintptr_t>(monitor) - 1;
+        if (monitor == nullptr || index >= g_monitors.size() || info == nullptr)
+            return FALSE;
+
+        info->rcMonitor = g_monitors[index];
+        info->rcWork = g_monitors[index];
+        info->dwFlags = index == 0 ? 1 : 0;  // MONITORINFOF_PRIMARY
+        return TRUE;
+    }
+}
+
+namespace win32_mock
+{
+    void set_tick_count(uint64_t milliseconds)
+    {
+        std::lock_guard<std::mutex> lock(g_clock_mutex);
+        g_frozen_clock = true;
+        g_tick_count = milliseconds;
+    }
+
+    void advance_tick_count(uint64_t milliseconds)
+    {
+        std::lock_guard<std::mutex> lock(g_clock_mutex);
+        g_tick_count += milliseconds;
+    }
+
+    void use_real_tick_count()
+    {
+        std::lock_guard<std::mutex> lock(g_clock_mutex);
+        g_frozen_clock = false;
+    }
+
+    void hold_file_writes()
+    {
+        std::lock_guard<std::mutex> lock(g_file_write_mutex);
+        g_file_writes_held = true;
+    }
+
+    void release_file_writes()
+    {
+        {
+            std::lock_guard<std::mutex> lock(g_file_write_mutex);
+            g_file_writes_held = false;
+        }
+        g_file_write_released.notify_all();
+    }
+
+    std::vector<std::thread::id> file_write_threads()
+    {
+        std::lock_guard<std::mutex> lock(g_file_write_mutex);
+        return g_file_write_threads;
+    }
+
+    void reset_file_write_threads()
+    {
+        std::lock_guard<std::mutex> lock(g_file_write_mutex);
+        g_file_write_threads.clear();
+    }
+
+    void set_module_path(const std::wstring& path)
+    {
+        g_module_path = path;
+    }
+
+    void set_monitors(const std::vector<RECT>& monitors)
+    {
+        std::lock_guard<std::mutex> lock(g_window_mutex);
+        g_monitors = monitors;
+    }
+
+    HWND create_window(DWORD style, DWORD ex_style, const RECT& rect)
+    {
+        std::lock_guard<std::mutex> lock(g_window_mutex);
+        return add_window(style, ex_style, rect);
+    }
+
+    void destroy_all_windows()
+    {
+        std::lock_guard<std::mutex> lock(g_window_mutex);
+        g_windows.clear();
+    }
+
+    User32Calls user32_calls()
+    {
+        std::lock_guard<std::mutex> lock(g_window_mutex);
+        return g_user32_calls;
+    }
+
+    void reset_user32_calls()
+    {
+        std::lock_guard<std::mutex> lock(g_window_mutex);
+        g_user32_calls = {};
+        g_last_set_window_pos = {};
+    }
+
+    SetWindowPosCall last_set_window_pos()
+    {
+        std::lock_guard<std::mutex> lock(g_window_mutex);
+        return g_last_set_window_pos;
+    }
+}
+
+// Windows
+HWND WINAPI CreateWindowExA(DWORD dwExStyle, LPCSTR, LPCSTR, DWORD dwStyle, int X, int Y, int nWidth, int nHeight, HWND, HMENU, HINSTANCE, LPVOID)
+{
+    std::lock_guard<std::mutex> lock(g_window_mutex);
+    ++g_user32_calls.create_window;
+    return add_window(dwStyle, dwExStyle, { X, Y, X + nWidth, Y + nHeight });
+}
+
+HWND WINAPI CreateWindowExW(DWORD dwExStyle, LPCWSTR, LPCWSTR, DWORD dwStyle, int X, int Y, int nWidth, int nHeight, HWND, HMENU, HINSTANCE, LPVOID)
+{
+    std::lock_guard<std::mutex> lock(g_window_mutex);
+    ++g_user32_calls.create_window;
+    return add_window(dwStyle, dwExStyle, { X, Y, X + nWidth, Y + nHeight });
+}
+
+LONG WINAPI SetWindowLongA(HWND hWnd, int nIndex, LONG dwNewLong)
+{
+    return static_cast<LONG>(set_window_long(hWnd, nIndex, dwNewLong));
+}
+
+LONG WINAPI SetWindowLongW(HWND hWnd, int nIndex, LONG dwNewLong)
+{
+    return static_cast<LONG>(set_window_long(hWnd, nIndex, dwNewLong));
+}
+
+LONG_PTR WINAPI SetWindowLongPtrA(HWND hWnd, int nIndex, LONG_PTR dwNewLong)
+{
+    return set_window_long(hWnd, nIndex, dwNewLong);
+}
+
+LONG_PTR WINAPI SetWindowLongPtrW(HWND hWnd, int nIndex, LONG_PTR dwNewLong)
+{
+    return set_window_long(hWnd, nIndex, dwNewLong);
+}
+
+LONG WINAPI GetWindowLongA(HWND hWnd, int nIndex)
+{
+    return get_window_long(hWnd, nIndex);
+}
+
+LONG WINAPI GetWindowLongW(HWND hWnd, int nIndex)
+{
+    return get_window_long(hWnd, nIndex);
+}
+
+BOOL WINAPI SetWindowPos(HWND hWnd, HWND, int X, int Y, int cx, int cy, UINT uFlags)
+{
+    std::lock_guard<std::mutex> lock(g_window_mutex);
+    ++g_user32_calls.set_window_pos;
+    g_last_set_window_pos = { hWnd, X, Y, cx, cy, uFlags };
+
+    const auto it = g_windows.find(hWnd);
+    if (it == g_windows.end())
+        return FALSE;
+
+    RECT& rect = it->second.rect;
+    if ((uFlags & SWP_NOMOVE) == 0)
+    {
+        rect = { X, Y, X + (rect.right - rect.left), Y + (rect.bottom - rect.top) };
+    }
+    if ((uFlags & SWP_NOSIZE) == 0)
+    {
+        rect.right = rect.left + cx;
+        rect.bottom = rect.top + cy;
+    }
+    return TRUE;
+}
+
+BOOL WINAPI AdjustWindowRect(LPRECT lpRect, DWORD dwStyle, BOOL bMenu)
+{
+    return AdjustWindowRectEx(lpRect, dwStyle, bMenu, 0);
+}
+
+BOOL WINAPI AdjustWindowRectEx(LPRECT lpRect, DWORD dwStyle, BOOL, DWORD)
+{
+    {
+        std::lock_guard<std::mutex> lock(g_window_mutex);
+        ++g_user32_calls.adjust_window_rect;
+    }
+
+    if (lpRect == nullptr)
+        return FALSE;
+
+    // A caption and sizing border like the default theme at 100% scaling
+    if ((dwStyle & WS_CAPTION) == WS_CAPTION)
+    {
+        lpRect->left -= 8;
+        lpRect->right += 8;
+        lpRect->top -= 31;
+        lpRect->bottom += 8;
+    }
+    return TRUE;
+}
+
+BOOL WINAPI IsWindow(HWND hWnd)
+{
+    std::lock_guard<std::mutex> lock(g_window_mutex);
+    return g_windows.find(hWnd) != g_windows.end() ? TRUE : FALSE;
+}
+
+BOOL WINAPI GetWindowRect(HWND hWnd, LPRECT lpRect)
+{
+    std::lock_guard<std::mutex> lock(g_window_mutex);
+    const auto it = g_windows.find(hWnd);
+    if (it == g_windows.end() || lpRect == nullptr)
+        return FALSE;
+    *lpRect = it->second.rect;
+    return TRUE;
+}
+
+BOOL WINAPI GetClientRect(HWND hWnd, LPRECT lpRect)
+{
+    RECT rect = {};
+    if (!GetWindowRect(hWnd, &rect))
+        return FALSE;
+    *lpRect = { 0, 0, rect.right - rect.left, rect.bottom - rect.top };
+    return TRUE;
+}
+
+// Monitors
+HMONITOR WINAPI MonitorFromWindow(HWND hwnd, DWORD dwFlags)
+{
+    std::lock_guard<std::mutex> lock(g_window_mutex);
+    const auto it = g_windows.find(hwnd);
+    if (it == g_windows.end())
+        return dwFlags == MONITOR_DEFAULTTONULL || g_monitors.empty() ? nullptr : monitor_handle(0);
+
+    const RECT& rect = it->second.rect;
+    return monitor_from_point((rect.left + rect.right) / 2, (rect.top + rect.bottom) / 2, dwFlags);
+}
+
+HMONITOR WINAPI MonitorFromPoint(POINT pt, DWORD dwFlags)
+{
+    std::lock_guard<std::mutex> lock(g_window_mutex);
+    return monitor_from_point(pt.x, pt.y, dwFlags);
+}
+
+BOOL WINAPI GetMonitorInfoA(HMONITOR hMonitor, MONITORINFO* lpmi)
+{
+    if (!get_monitor_info(hMonitor, lpmi))
+        return FALSE;
+    if (lpmi->cbSize == sizeof(MONITORINFOEXA))
+        std::snprintf(static_cast<MONITORINFOEXA*>(lpmi)->szDevice, 32, "\\\\.\\DISPLAY%u", static_cast<unsigned>(reinterpret_cast<uintptr_t>(hMonitor)));
+    return TRUE;
+}
+
+BOOL WINAPI GetMonitorInfoW(HMONITOR hMonitor, MONITORINFO* lpmi)
+{
+    return get_monitor_info(hMonitor, lpmi);
+}
+
+BOOL WINAPI EnumDisplayMonitors(HDC hdc, const RECT*, MONITORENUMPROC lpfnEnum, LPARAM dwData)
+{
+    std::vector<RECT> monitors;
+    {
+        std::lock_guard<std::mutex> lock(g_window_mutex);
+        monitors = g_monitors;
+    }
+
+    for (size_t i = 0; i < monitors.size(); ++i)
+    {
+        if (!lpfnEnum(monitor_handle(i), hdc, &monitors[i], dwData))
+            break;
+    }
+    return TRUE;
+}
+
+// Synchronization and thread pool
+HANDLE WINAPI CreateEventW(void*, BOOL bManualReset, BOOL bInitialState, LPCWSTR)
+{
+    Event* event = new Event();
+    event->manual_reset = bManualReset != FALSE;
+    event->signaled = bInitialState != FALSE;
+    return static_cast<MockObject*>(event);
+}
+
+BOOL WINAPI SetEvent(HANDLE hEvent)
+{
+    Event* event = dynamic_cast<Event*>(static_cast<MockObject*>(hEvent));
+    if (event == nullptr)
+        return FALSE;
+
+    std::lock_guard<std::mutex> lock(event->mutex);
+    event->signaled = true;
+    event->changed.notify_all();
+    return TRUE;
+}
+
+BOOL WINAPI ResetEvent(HANDLE hEvent)
+{
+    Event* event = dynamic_cast<Event*>(static_cast<MockObject*>(hEvent));
+    if (event == nullptr)
+        return FALSE;
+
+    std::lock_guard<std::mutex> lock(event->mutex);
+    event->signaled = false;
+    return TRUE;
+}
+
+namespace
+{
+    // Wait for an event, consuming the signal of an auto-reset event. Returns WAIT_OBJECT_0, WAIT_TIMEOUT,
+    // or WAIT_ABANDONED-like 0x80 when the wait was cancelled.
+    DWORD wait_for_event(Event* event, DWORD milliseconds, const bool* cancelled)
+    {
+        std::unique_lock<std::mutex> lock(event->mutex);
+        const auto ready = [&] { return event->signaled || (cancelled != nullptr && *cancelled); };
+        if (milliseconds == INFINITE)
+        {
+            // Timed waits only, condition_variable::wait(lock) needs a newer libstdc++ than some toolchains ship
+            while (!ready())
+                event->changed.wait_for(lock, std::chrono::seconds(1));
+        }
+        else if (!event->changed.wait_for(lock, std::chrono::milliseconds(milliseconds), ready))
+            return WAIT_TIMEOUT;
+
+        if (cancelled != nullptr && *cancelled)
+            return 0x80;
+
+        if (!event->manual_reset)
+            event->signaled = false;
+        return WAIT_OBJECT_0;
+    }
+}
+
+DWORD WINAPI WaitForSingleObject(HANDLE hHandle, DWORD dwMilliseconds)
+{
+    Event* event = dynamic_cast<Event*>(static_cast<MockObject*>(hHandle));
+    if (event == nullptr)
+        return 0xFFFFFFFF;  // WAIT_FAILED
+    return wait_for_event(event, dwMilliseconds, nullptr);
+}
+
+BOOL WINAPI RegisterWaitForSingleObject(HANDLE* phNewWaitObject, HANDLE hObject, WAITORTIMERCALLBACK Callback, PVOID Context, DWORD dwMilliseconds, DWORD dwFlags)
+{
+    Event* event = dynamic_cast<Event*>(static_cast<MockObject*>(hObject));
+    if (event == nullptr)
+        return FALSE;
+
+    Worker* wait = new Worker();
+    wait->event = event;
+    wait->thread = std::thread([wait, event, Callback, Context, dwMilliseconds, dwFlags] {
+        for (;;)
+        {
+            // The stop flag is guarded by the event mutex, so unregistering can wake the wait
+            const DWORD result = wait_for_event(event, dwMilliseconds, &wait->stop);
+            if (result == 0x80)
+                return;
+
+            Callback(Context, result == WAIT_TIMEOUT ? TRUE : FALSE);
+            if ((dwFlags & WT_EXECUTEONLYONCE) != 0)
+                return;
+        }
+    });
+
+    *phNewWaitObject = static_cast<MockObject*>(wait);
+    return TRUE;
+}
+
+BOOL WINAPI UnregisterWaitEx(HANDLE WaitHandle, HANDLE)
+{
+    Worker* wait = dynamic_cast<Worker*>(static_cast<MockObject*>(WaitHandle));
+    if (wait == nullptr)
+        return FALSE;
+
+    {
+        std::lock_guard<std::mutex> lock(wait->event->mutex);
+        wait->stop = true;
+        wait->event->changed.notify_all();
+    }
+
+    // Blocks until a running callback returned, like INVALID_HANDLE_VALUE as completion event
+    if (wait->thread.get_id() == std::this_thread::get_id())
+        wait->thread.detach();
+    else
+        wait->thread.join();
+
+    delete wait;
+    return TRUE;
+}
+
+BOOL WINAPI CreateTimerQueueTimer(HANDLE* phNewTimer, HANDLE, WAITORTIMERCALLBACK Callback, PVOID Parameter, DWORD DueTime, DWORD Period, ULONG_PTR)
+{
+    Worker* timer = new Worker();
+    timer->thread = std::thread([timer, Callback, Parameter, DueTime, Period] {
+        DWORD delay = DueTime;
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(timer->mutex);
+                if (timer->changed.wait_for(lock, std::chrono::milliseconds(delay), [timer] { return timer->stop; }))
+                    return;
+            }
+
+            Callback(Parameter, TRUE);
+            if (Period == 0)
+                return;
+            delay = Period;
+        }
+    });
+
+    *phNewTimer = static_cast<MockObject*>(timer);
+    return TRUE;
+}
+
+BOOL WINAPI DeleteTimerQueueTimer(HANDLE, HANDLE Timer, HANDLE)
+{
+    Worker* timer = dynamic_cast<Worker*>(static_cast<MockObject*>(Timer));
+    if (timer == nullptr)
+        return FALSE;
+
+    {
+        std::lock_guard<std::mutex> lock(timer->mutex);
+        timer->stop = true;
+        timer->changed.notify_all();
+    }
+    timer->thread.join();
+
+    delete timer;
+    return TRUE;
+}
+
+BOOL WINAPI CloseHandle(HANDLE hObject)
+{
+    if (hObject == nullptr || hObject == INVALID_HANDLE_VALUE)
+        return FALSE;
+
+    delete static_cast<MockObject*>(hObject);
+    return TRUE;
+}
+
+// Files
+HANDLE WINAPI CreateFileW(LPCWSTR lpFileName, DWORD dwDesiredAccess, DWORD dwShareMode, void* lpSecurityAttributes, DWORD dwCreationDisposition, DWORD dwFlagsAndAttributes, HANDLE hTemplateFile)
+{
+    return CreateFileW(narrow(lpFileName).c_str(), dwDesiredAccess, dwShareMode, lpSecurityAttributes, dwCreationDisposition, dwFlagsAndAttributes, hTemplateFile);
+}
+
+HANDLE WINAPI CreateFileW(const char* lpFileName, DWORD dwDesiredAccess, DWORD, void*, DWORD dwCreationDisposition, DWORD, HANDLE)
+{
+    const char* mode = dwCreationDisposition == CREATE_ALWAYS ? "wb" : ((dwDesiredAccess & GENERIC_WRITE) != 0 ? "r+b" : "rb");
+    FILE* stream = std::fopen(lpFileName, mode);
+    if (stream == nullptr)
+        return INVALID_HANDLE_VALUE;
+
+    File* file = new File();
+    file->stream = stream;
+    return static_cast<MockObject*>(file);
+}
+
+BOOL WINAPI WriteFile(HANDLE hFile, const void* lpBuffer, DWORD nNumberOfBytesToWrite, DWORD* lpNumberOfBytesWritten, void*)
+{
+    File* file = dynamic_cast<File*>(static_cast<MockObject*>(hFile));
+    if (file == nullptr)
+        return FALSE;
+
+    {
+        std::unique_lock<std::mutex> lock(g_file_write_mutex);
+        g_file_write_threads.push_back(std::this_thread::get_id());
+        while (g_file_writes_held)
+            g_file_write_released.wait_for(lock, std::chrono::milliseconds(10));
+    }
+
+    const size_t written = std::fwrite(lpBuffer, 1, nNumberOfBytesToWrite, file->stream);
+    if (lpNumberOfBytesWritten != nullptr)
+        *lpNumberOfBytesWritten = static_cast<DWORD>(written);
+    return written == nNumberOfBytesToWrite ? TRUE : FALSE;
+}
+
+BOOL WINAPI FlushFileBuffers(HANDLE hFile)
+{
+    File* file = dynamic_cast<File*>(static_cast<MockObject*>(hFile));
+    return file != nullptr && std::fflush(file->stream) == 0 ? TRUE : FALSE;
+}
+
+DWORD WINAPI GetModuleFileNameW(HMODULE, wchar_t* lpFilename, DWORD nSize)
+{
+    if (g_module_path.empty() || nSize == 0)
+        return 0;
+
+    const DWORD length = static_cast<DWORD>(std::min<size_t>(g_module_path.size(), nSize - 1));
+    std::wmemcpy(lpFilename, g_module_path.c_str(), length);
+    lpFilename[length] = L'\0';
+    return g_module_path.size() >= nSize ? nSize : length;
+}
+
+// File mappings
+HANDLE WINAPI CreateFileMappingA(HANDLE, void*, DWORD, DWORD dwMaximumSizeHigh, DWORD dwMaximumSizeLow, LPCSTR lpName)
+{
+    const size_t size = static_cast<size_t>((uint64_t(dwMaximumSizeHigh) << 32) | dwMaximumSizeLow);
+    Mapping* mapping = new Mapping();
+    mapping->size = size;
+    if (lpName == nullptr)
+    {
+        mapping->memory.assign(size, 0);
+        return static_cast<MockObject*>(mapping);
+    }
+
+    std::string name = lpName;
+    if (name.starts_with("Local\\") || name.starts_with("Global\\"))
+        name.erase(0, name.find('\\') + 1);
+    name.insert(0, "/");
+
+    const int fd = shm_open(name.c_str(), O_CREAT | O_RDWR, 0600);
+    if (fd < 0)
+    {
+        delete mapping;
+        return nullptr;
+    }
+    mapping->shm_name = name;
+
+    // A new object is zero-filled by ftruncate, like a new Windows mapping
+    void* view = ftruncate(fd, static_cast<off_t>(size)) == 0 ? mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0) : MAP_FAILED;
+    close(fd);
+    if (view == MAP_FAILED)
+    {
+        delete mapping;
+        return nullptr;
+    }
+    mapping->shared_view = view;
+    return static_cast<MockObject*>(mapping);
+}
+
+LPVOID WINAPI MapViewOfFile(HANDLE hFileMappingObject, DWORD, DWORD, DWORD, size_t)
+{
+    Mapping* mapping = dynamic_cast<Mapping*>(static_cast<MockObject*>(hFileMappingObject));
+    if (mapping == nullptr)
+        return nullptr;
+    return mapping->shared_view != nullptr ? mapping->shared_view : mapping->memory.data();
+}
+
+BOOL WINAPI UnmapViewOfFile(const void*)
+{
+    // The memory belongs to the mapping object and is released by CloseHandle
+    return TRUE;
+}
+
+// Time and process
+BOOL WINAPI QueryPerformanceCounter(LARGE_INTEGER* lpPerformanceCount)
+{
+    lpPerformanceCount->QuadPart = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    return TRUE;
+}
+
+BOOL WINAPI QueryPerformanceFrequency(LARGE_INTEGER* lpFrequency)
+{
+    lpFrequency->QuadPart = 1000000000;
+    return TRUE;
+}
+
+ULONGLONG WINAPI GetTickCount64()
+{
+    std::lock_guard<std::mutex> lock(g_clock_mutex);
+    if (g_frozen_clock)
+        return g_tick_count;
+
+    return static_cast<ULONGLONG>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count()) + g_tick_count;
+}
+
+DWORD WINAPI GetCurrentProcessId()
+{
+    return static_cast<DWORD>(getpid());
+}
+
+DWORD WINAPI GetCurrentThreadId()
+{
+    return static_cast<DWORD>(syscall(SYS_gettid));
+}
+
+// Crash handling
+LPTOP_LEVEL_EXCEPTION_FILTER WINAPI SetUnhandledExceptionFilter(LPTOP_LEVEL_EXCEPTION_FILTER lpTopLevelExceptionFilter)
+{
+    LPTOP_LEVEL_EXCEPTION_FILTER previous = g_exception_filter;
+    g_exception_filter = lpTopLevelExceptionFilter;
+    return previous;
+}
+
+// Strings
+int WINAPI WideCharToMultiByte(UINT, DWORD, LPCWSTR lpWideCharStr, int cchWideChar, char* lpMultiByteStr, int cbMultiByte, LPCSTR, BOOL*)
+{
+    const size_t length = cchWideChar < 0 ? std::wcslen(lpWideCharStr) + 1 : static_cast<size_t>(cchWideChar);
+    if (cbMultiByte == 0)
+        return static_cast<int>(length);
+
+    const size_t count = std::min(length, static_cast<size_t>(cbMultiByte));
+    for (size_t i = 0; i < count; ++i)
+        lpMultiByteStr[i] = lpWideCharStr[i] < 0x80 ? static_cast<char>(lpWideCharStr[i]) : '?';
+    return static_cast<int>(count);
+}
+
+int _stricmp(const char* string1, const char* string2)
+{
+    return strcasecmp(string1, string2);
+}
+
+int wcscpy_s(wchar_t* dest, size_t dest_size, const wchar_t* src)
+{
+    if (dest == nullptr || dest_size == 0 || std::wcslen(src) >= dest_size)
+        return 22;  // EINVAL
+    std::wcscpy(dest, src);
+    return 0;
+}
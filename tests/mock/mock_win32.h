@@ -0,0 +1,63 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include <Windows.h>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Controls for the Win32 stand-in (include/Windows.h)
+namespace win32_mock
+{
+    // GetTickCount64 follows a steady clock until a test freezes it
+    void set_tick_count(uint64_t milliseconds);
+    void advance_tick_count(uint64_t milliseconds);
+    void use_real_tick_count();
+
+    // Path returned by GetModuleFileNameW (empty = the call fails)
+    void set_module_path(const std::wstring& path);
+
+    // Fake monitors for MonitorFromWindow/Point, GetMonitorInfo and EnumDisplayMonitors, the first one is primary
+    void set_monitors(const std::vector<RECT>& monitors);
+
+    // A window as CreateWindowEx would create it, without going through the (hooked) function
+    HWND create_window(DWORD style, DWORD ex_style, const RECT& rect);
+    void destroy_all_windows();
+
+    // Calls that reached the original user32 functions, i.e. made it past the hooks
+    struct User32Calls
+    {
+        uint64_t create_window = 0;
+        uint64_t set_window_long = 0;
+        uint64_t set_window_pos = 0;
+        uint64_t adjust_window_rect = 0;
+    };
+    User32Calls user32_calls();
+    void reset_user32_calls();
+
+    // Arguments of the most recent SetWindowPos that reached user32
+    struct SetWindowPosCall
+    {
+        HWND hwnd;
+        int x;
+        int y;
+        int cx;
+        int cy;
+        UINT flags;
+    };
+    SetWindowPosCall last_set_window_pos();
+
+    // While held, WriteFile blocks its caller until release_file_writes(), like a stalled disk
+    void hold_file_writes();
+    void release_file_writes();
+
+    // Threads that called WriteFile since the last reset
+    std::vector<std::thread::id> file_write_threads();
+    void reset_file_write_threads();
+}
@@ -0,0 +1,187 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "trace_replay.h"
+#include "core/hook_stats.h"
+#include <bit>
+
+namespace reshade_mock
+{
+    using reshade::addon_event;
+    using trace_format::EventId;
+    using trace_format::unpack_high;
+    using trace_format::unpack_low;
+
+    TraceReplay::Summary TraceReplay::replay(const Trace& trace)
+    {
+        Summary summary;
+        const trace_format::Header& header = trace.header;
+        for (const trace_format::Record& record : trace.records)
+        {
+            const uint64_t elapsed = record.timestamp > header.start_timestamp ? record.timestamp - header.start_timestamp : 0;
+            win32_mock::set_tick_count(elapsed * 1000 / header.ticks_per_second);
+
+            if (replay_record(record))
+                ++summary.replayed;
+            else
+                ++summary.skipped;
+        }
+        return summary;
+    }
+
+    bool TraceReplay::replay_record(const trace_format::Record& record)
+    {
+        switch (record.event)
+        {
+        case EventId::CreateSwapchain:
+        {
+            const uint64_t hwnd = record.args[2];
+            const uint32_t width = unpack_high(record.args[1]);
+            const uint32_t height = unpack_low(record.args[1]);
+            Window& window = windows_[hwnd];
+            last_hwnd_ = hwnd;
+            current_hwnd_ = hwnd;
+
+            // ResizeBuffers raised destroy_swapchain(resize) first, MockGame::resize raises both
+            if (window.game != nullptr && window.game->has_swapchain() && window.resize_pending)
+            {
+                window.resize_pending = false;
+                window.game->resize(width, height);
+                return true;
+            }
+
+            if (window.game == nullptr)
+            {
+                window.game = std::make_unique<MockGame>(static_cast<device_api>(record.args[0]));
+            }
+            else if (window.game->has_swapchain())
+            {
+                // A second swapchain for the same window, the trace lost the release of the first one
+                window.game->destroy_swapchain();
+                std::erase_if(swapchains_, [hwnd](const auto& entry) { return entry.second == hwnd; });
+            }
+
+            window.resize_pending = false;
+            window.game->create_swapchain(width, height);
+            return true;
+        }
+        case EventId::InitSwapchain:
+            // Raised by MockGame with the create_swapchain above, only the handle is new
+            if (last_hwnd_ == 0)
+                return false;
+            swapchains_[record.args[0]] = last_hwnd_;
+            last_hwnd_ = 0;
+            return true;
+        case EventId::DestroySwapchain:
+        {
+            Window* window = find_swapchain(record.args[0]);
+            if (window == nullptr)
+                return false;
+
+            if (record.args[1] != 0)
+            {
+                window->resize_pending = true;
+                return true;
+            }
+            window->game->destroy_swapchain();
+            swapchains_.erase(record.args[0]);
+            return true;
+        }
+        case EventId::Present:
+        {
+            Window* window = find_swapchain(record.args[1]);
+            if (window == nullptr)
+                return false;
+
+            current_hwnd_ = swapchains_[record.args[1]];
+            window->game->present();
+            return true;
+        }
+        case EventId::FinishPresent:
+            // Raised by MockGame with the present above
+            return find_swapchain(record.args[1]) != nullptr;
+        case EventId::SetFullscreenState:
+        {
+            Window* window = find_swapchain(record.args[0]);
+            if (window == nullptr)
+                return false;
+
+            dispatch<addon_event::set_fullscreen_state>(&window->game->swapchain(), record.args[1] != 0, nullptr);
+            return true;
+        }
+        case EventId::BindRenderTargets:
+        {
+            Window* window = current_window();
+            if (window == nullptr)
+                return false;
+
+            MockGame& game = *window->game;
+            if (record.args[1] == 0)
+            {
+                dispatch<addon_event::bind_render_targets_and_depth_stencil>(&game.cmd_list(), 0u, nullptr, resource_view {});
+                return true;
+            }
+
+            if (window->offscreen_rtv.handle == 0)
+            {
+                window->offscreen_rtv = game.device().create_render_target_view(
+                    game.device().create_texture(game.swapchain().width(), game.swapchain().height(), format::r8g8b8a8_unorm));
+            }
+            const resource_view rtv = record.outcome == static_cast<uint8_t>(HookOutcome::Redirected) ?
+                game.current_back_buffer_rtv() : window->offscreen_rtv;
+            dispatch<addon_event::bind_render_targets_and_depth_stencil>(&game.cmd_list(), 1u, &rtv, resource_view {});
+            return true;
+        }
+        case EventId::BindViewports:
+        {
+            Window* window = current_window();
+            if (window == nullptr || unpack_low(record.args[1]) == 0)
+                return false;
+
+            const viewport first = {
+                std::bit_cast<float>(unpack_high(record.args[2])), std::bit_cast<float>(unpack_low(record.args[2])),
+                std::bit_cast<float>(unpack_high(record.args[3])), std::bit_cast<float>(unpack_low(record.args[3])),
+                0.0f, 1.0f
+            };
+            dispatch<addon_event::bind_viewports>(&window->game->cmd_list(), unpack_high(record.args[1]), 1u, &first);
+            return true;
+        }
+        case EventId::BindScissorRects:
+        {
+            Window* window = current_window();
+            if (window == nullptr || unpack_low(record.args[1]) == 0)
+                return false;
+
+            const rect first = {
+                static_cast<int32_t>(unpack_high(record.args[2])), static_cast<int32_t>(unpack_low(record.args[2])),
+                static_cast<int32_t>(unpack_high(record.args[3])), static_cast<int32_t>(unpack_low(record.args[3]))
+            };
+            dispatch<addon_event::bind_scissor_rects>(&window->game->cmd_list(), unpack_high(record.args[1]), 1u, &first);
+            return true;
+        }
+        default:
+            return false;
+        }
+    }
+
+    TraceReplay::Window* TraceReplay::find_swapchain(uint64_t native)
+    {
+        const auto it = swapchains_.find(native);
+        if (it == swapchains_.end())
+            return nullptr;
+
+        Window& window = windows_[it->second];
+        return window.game != nullptr && window.game->has_swapchain() ? &window : nullptr;
+    }
+
+    TraceReplay::Window* TraceReplay::current_window()
+    {
+        const auto it = windows_.find(current_hwnd_);
+        if (it == windows_.end() || it->second.game == nullptr || !it->second.game->has_swapchain())
+            return nullptr;
+        return &it->second;
+    }
+}
@@ -0,0 +1,59 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+#pragma once
+
+#include "core/trace_reader.h"
+#include "mock_game.h"
+#include <map>
+#include <memory>
+
+namespace reshade_mock
+{
+    // Re-executes the ReShade events of a recorded trace through the callbacks the addon registered,
+    // with one MockGame per recorded swapchain window. The handlers run for real against the mock, so with
+    // TraceFile set the replay records a new trace whose decisions can be diffed against the original
+    // (trace_report --decisions) and whose latencies show the handler cost without the game.
+    //
+    // Not replayed: the WinAPI hooks (the window styles are not recorded) and init_device. Render target
+    // binds use the current back buffer when the recorded bind was redirected and an offscreen target
+    // otherwise, the trace does not say which views belong to the swapchain. Only the first viewport and
+    // scissor rect of a bind are recorded, so only those are bound. GetTickCount64 follows the recorded
+    // timestamps, so millisecond debouncing sees the recorded pacing.
+    class TraceReplay
+    {
+    public:
+        struct Summary
+        {
+            uint64_t replayed = 0;  // Records raised as events
+            uint64_t skipped = 0;   // Records without a replayable event or without a live swapchain
+        };
+
+        // Replay records sorted by timestamp (see load_trace)
+        Summary replay(const Trace& trace);
+
+    private:
+        struct Window
+        {
+            std::unique_ptr<MockGame> game;
+            resource_view offscreen_rtv = {};
+            bool resize_pending = false;
+        };
+
+        bool replay_record(const trace_format::Record& record);
+
+        // Window of a recorded native swapchain, nullptr if it was destroyed or never created
+        Window* find_swapchain(uint64_t native);
+
+        // Window the bind and present records without a swapchain handle go to
+        Window* current_window();
+
+        std::map<uint64_t, Window> windows_;       // Recorded HWND -> replayed window
+        std::map<uint64_t, uint64_t> swapchains_;  // Recorded native swapchain -> recorded HWND
+        uint64_t last_hwnd_ = 0;                   // HWND of the latest create_swapchain, waiting for its init_swapchain
+        uint64_t current_hwnd_ = 0;                // HWND of the latest swapchain event
+    };
+}
@@ -0,0 +1,103 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+// Replays a trace recorded with TraceFile through the addon's event handlers, built against the mock
+// (see tests/mock/trace_replay.h for what is and is not replayed).
+//
+//   trace_replay [--set Key=Value]... <trace file> [<replayed trace file>]
+//
+// The handlers run with the defaults plus the --set keys of [SWAPCHAIN_OVERRIDE]. With a second file the
+// replay is recorded again, then
+//   trace_report --decisions <trace file> > recorded.txt
+//   trace_report --decisions <replayed trace file> > replayed.txt
+// shows where this build decides differently from the one that recorded the trace.
+
+#include "config.h"
+#include "swapchain_manager.h"
+#include "trace_recorder.h"
+#include "trace_replay.h"
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+
+int main(int argc, char* argv[])
+{
+    const char* input_path = nullptr;
+    const char* output_path = nullptr;
+    bool valid = true;
+
+    for (int i = 1; i < argc && valid; ++i)
+    {
+        if (std::strcmp(argv[i], "--set") == 0 && i + 1 < argc)
+        {
+            const std::string setting = argv[++i];
+            const size_t separator = setting.find('=');
+            valid = separator != std::string::npos && separator != 0;
+            if (valid)
+                reshade_mock::set_config("SWAPCHAIN_OVERRIDE", setting.substr(0, separator).c_str(), setting.substr(separator + 1).c_str());
+        }
+        else if (input_path == nullptr)
+        {
+            input_path = argv[i];
+        }
+        else if (output_path == nullptr)
+        {
+            output_path = argv[i];
+        }
+        else
+        {
+            valid = false;
+        }
+    }
+
+    if (!valid || input_path == nullptr)
+    {
+        fprintf(stderr, "Usage: trace_replay [--set Key=Value]... <trace file> [<replayed trace file>]\n");
+        return 2;
+    }
+
+    Trace trace;
+    std::string error;
+    const bool loaded = load_trace(input_path, trace, error);
+    if (!error.empty())
+        fprintf(stderr, "%s: %s\n", loaded ? "warning" : "error", error.c_str());
+    if (!loaded)
+        return 1;
+
+    if (output_path != nullptr)
+        reshade_mock::set_config("SWAPCHAIN_OVERRIDE", "TraceFile", std::filesystem::absolute(output_path).string().c_str());
+
+    Config::get_instance().load();
+    TraceRecorder::get_instance().install();
+    SwapchainManager::get_instance().install();
+    if (output_path != nullptr && !TraceRecorder::get_instance().is_recording())
+    {
+        fprintf(stderr, "error: cannot write %s\n", output_path);
+        return 1;
+    }
+
+    reshade_mock::TraceReplay::Summary summary;
+    {
+        // Swapchains still alive at the end of the trace are released before the handlers go away
+        reshade_mock::TraceReplay replay;
+        summary = replay.replay(trace);
+    }
+
+    SwapchainManager::get_instance().uninstall();
+    SwapchainManager::get_instance().cleanup_all();
+    TraceRecorder::get_instance().uninstall();
+
+    for (const reshade_mock::LogEntry& entry : reshade_mock::log_entries())
+    {
+        if (entry.level == reshade::log::level::error || entry.level == reshade::log::level::warning)
+            fprintf(stderr, "%s\n", entry.text.c_str());
+    }
+
+    printf("Replayed %" PRIu64 " of %zu records, %" PRIu64 " skipped\n", summary.replayed, trace.records.size(), summary.skipped);
+    return 0;
+}
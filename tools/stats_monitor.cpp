@@ -0,0 +1,207 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+// Reader for the live statistics published with ExportStats=1 (see src/core/stats_block.h).
+//
+//   stats_monitor <process id>                    Print the current statistics once
+//   stats_monitor --watch [interval ms] <pid>     Print them again every interval (default 1000 ms)
+//
+// Opens "Local\SwapchainOverrideStats.<pid>" on Windows and the POSIX shared memory
+// object "/SwapchainOverrideStats.<pid>" elsewhere.
+
+#include "core/stats_block.h"
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+    // Read-only view of a published stats block
+    class StatsMapping
+    {
+    public:
+        ~StatsMapping() { close(); }
+
+        bool open(uint32_t process_id)
+        {
+            const std::string name = std::string(stats_block::NAME_PREFIX) + std::to_string(process_id);
+#ifdef _WIN32
+            const std::string mapping_name = "Local\\" + name;
+            mapping_ = OpenFileMappingA(FILE_MAP_READ, FALSE, mapping_name.c_str());
+            if (mapping_ == nullptr)
+                return false;
+
+            view_ = MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, sizeof(stats_block::Block));
+#else
+            const std::string mapping_name = "/" + name;
+            const int fd = shm_open(mapping_name.c_str(), O_RDONLY, 0);
+            if (fd < 0)
+                return false;
+
+            void* view = mmap(nullptr, sizeof(stats_block::Block), PROT_READ, MAP_SHARED, fd, 0);
+            ::close(fd);
+            view_ = view != MAP_FAILED ? view : nullptr;
+#endif
+            return view_ != nullptr;
+        }
+
+        void close()
+        {
+#ifdef _WIN32
+            if (view_ != nullptr)
+                UnmapViewOfFile(view_);
+            if (mapping_ != nullptr)
+                CloseHandle(mapping_);
+            mapping_ = nullptr;
+#else
+            if (view_ != nullptr)
+                munmap(view_, sizeof(stats_block::Block));
+#endif
+            view_ = nullptr;
+        }
+
+        const stats_block::Block& block() const { return *static_cast<const stats_block::Block*>(view_); }
+
+    private:
+#ifdef _WIN32
+        HANDLE mapping_ = nullptr;
+#endif
+        void* view_ = nullptr;
+    };
+
+    double megabytes(uint64_t bytes)
+    {
+        return static_cast<double>(bytes) / (1024.0 * 1024.0);
+    }
+
+    void print_stats(const stats_block::Block& block, const stats_block::Stats& stats)
+    {
+        printf("Process %u, update %" PRIu64 ", uptime %.1f s\n", block.process_id, stats.publish_count,
+            static_cast<double>(stats.uptime_ms) / 1000.0);
+        printf("Presents: %" PRIu64 " (%.1f per second)\n", stats.present_count,
+            static_cast<double>(stats.present_rate_mhz) / 1000.0);
+
+        const stats_block::FrameStats& frames = stats.frames;
+        if (frames.sample_count != 0)
+        {
+            printf("Frame time (last %u frames): avg %.2f ms, p50 %.2f ms, p99 %.2f ms, p99.9 %.2f ms, max %.2f ms\n",
+                frames.sample_count, frames.frame_time_avg_us / 1000.0, frames.frame_time_p50_us / 1000.0,
+                frames.frame_time_p99_us / 1000.0, frames.frame_time_p999_us / 1000.0, frames.frame_time_max_us / 1000.0);
+            printf("Addon CPU per frame: avg %.1f us, p99 %.1f us\n",
+                frames.addon_time_avg_ns / 1000.0, frames.addon_time_p99_ns / 1000.0);
+        }
+
+        printf("\nSwapchains: %u\n", stats.swapchain_count);
+        uint64_t total_proxy_memory = 0;
+        for (uint32_t i = 0; i < stats.swapchain_count && i < stats_block::MAX_SWAPCHAINS; ++i)
+        {
+            const stats_block::SwapchainStats& swapchain = stats.swapchains[i];
+            printf("  0x%" PRIX64 "  requested %ux%u  actual %ux%u  override %s  proxies %.1f MiB  scale pass %.1f us\n",
+                swapchain.handle, swapchain.requested_width, swapchain.requested_height,
+                swapchain.actual_width, swapchain.actual_height, swapchain.override_active ? "yes" : "no",
+                megabytes(swapchain.proxy_memory), static_cast<double>(swapchain.scale_pass_gpu_ns) / 1000.0);
+            total_proxy_memory += swapchain.proxy_memory;
+        }
+        printf("  Proxy memory total: %.1f MiB\n", megabytes(total_proxy_memory));
+
+        printf("\n%-22s %12s %12s %12s %12s %10s %10s\n", "hook", "calls", "redirected", "rewritten", "early-out", "p50 ns", "p99 ns");
+        for (size_t hook = 0; hook < HOOK_COUNT; ++hook)
+        {
+            const stats_block::HookStats& hook_stats = stats.hooks[hook];
+
+            uint64_t calls = 0;
+            for (uint64_t count : hook_stats.outcomes)
+                calls += count;
+            if (calls == 0)
+                continue;
+
+            printf("%-22s %12" PRIu64 " %12" PRIu64 " %12" PRIu64 " %12" PRIu64 " %10u %10u\n",
+                trace_format::event_name(HOOK_EVENTS[hook]), calls,
+                hook_stats.outcomes[static_cast<size_t>(HookOutcome::Redirected)],
+                hook_stats.outcomes[static_cast<size_t>(HookOutcome::Rewritten)],
+                hook_stats.outcomes[static_cast<size_t>(HookOutcome::EarlyOut)],
+                hook_stats.latency_p50_ns, hook_stats.latency_p99_ns);
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    bool watch = false;
+    unsigned long interval_ms = 1000;
+    const char* pid_text = nullptr;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--watch") == 0)
+        {
+            watch = true;
+
+            // Optional interval, followed by the process id
+            if (i + 2 < argc)
+                interval_ms = std::strtoul(argv[++i], nullptr, 10);
+        }
+        else if (pid_text == nullptr)
+        {
+            pid_text = argv[i];
+        }
+        else
+        {
+            pid_text = nullptr; // More than one process id
+            break;
+        }
+    }
+
+    char* end = nullptr;
+    const unsigned long process_id = pid_text != nullptr ? std::strtoul(pid_text, &end, 10) : 0;
+    if (pid_text == nullptr || *end != '\0' || process_id == 0 || interval_ms == 0)
+    {
+        fprintf(stderr, "Usage: stats_monitor [--watch [interval ms]] <process id>\n");
+        return 2;
+    }
+
+    StatsMapping mapping;
+    if (!mapping.open(static_cast<uint32_t>(process_id)))
+    {
+        fprintf(stderr, "error: no statistics published by process %lu (is ExportStats=1 set?)\n", process_id);
+        return 1;
+    }
+
+    do
+    {
+        stats_block::Stats stats;
+        if (!stats_block::read(mapping.block(), stats))
+        {
+            fprintf(stderr, "error: statistics block has an unsupported version or is not readable\n");
+            return 1;
+        }
+
+        print_stats(mapping.block(), stats);
+
+        if (watch)
+        {
+            printf("\n");
+            fflush(stdout);
+            std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+        }
+    } while (watch);
+
+    return 0;
+}
@@ -0,0 +1,317 @@
+/*
+ * Swapchain Override Addon for ReShade
+ * Copyright (C) 2025
+ * SPDX-License-Identifier: MIT
+ */
+
+// Offline report for event traces recorded with TraceFile (see src/core/trace_format.h).
+//
+//   trace_report <trace file>              Hook latency, frame pacing and decisions
+//   trace_report --decisions <trace file>  Only the override decisions, in a stable
+//                                          format meant for diffing two versions
+//   trace_report --chrome <trace file>     Chrome trace-event JSON on stdout, for
+//                                          Perfetto or chrome://tracing
+//   trace_report --events <trace file>     Every record as one line in global order,
+//                                          e.g. to read a flight recorder crash dump
+
+#include "core/hook_stats.h"
+#include "core/trace_format.h"
+#include "core/trace_reader.h"
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using trace_format::EventId;
+    using trace_format::Record;
+
+    constexpr const char* OUTCOME_NAMES[HOOK_OUTCOME_COUNT] = { "passed", "early-out", "redirected", "rewritten" };
+
+    // Nearest-rank percentile of a sorted list
+    uint64_t percentile(const std::vector<uint64_t>& sorted_values, double fraction)
+    {
+        if (sorted_values.empty())
+            return 0;
+
+        const size_t rank = static_cast<size_t>(fraction * static_cast<double>(sorted_values.size() - 1) + 0.5);
+        return sorted_values[rank];
+    }
+
+    // Chrome trace-event JSON, written while reading so memory stays flat for any session length.
+    // Every record becomes a complete slice ("X") on its thread's track. Perfetto sorts events,
+    // so the interleaved file order needs no sorting here.
+    bool export_chrome_trace(const char* path)
+    {
+        TraceReader reader;
+        if (!reader.open(path))
+        {
+            fprintf(stderr, "error: %s\n", reader.error().c_str());
+            return false;
+        }
+
+        const trace_format::Header& header = reader.header();
+        const double ticks_per_us = static_cast<double>(header.ticks_per_second) / 1000000.0;
+
+        // Redirect counters are emitted per thread, where records are in order,
+        // and at most once per millisecond to keep the file small
+        struct ThreadState
+        {
+            uint64_t redirects = 0;
+            uint64_t rewrites = 0;
+            uint64_t last_counter_timestamp = 0;
+            bool counter_pending = false;
+        };
+        std::map<uint32_t, ThreadState> threads;
+        const uint64_t counter_interval = header.ticks_per_second / 1000;
+
+        auto to_us = [&](uint64_t timestamp) {
+            return static_cast<double>(timestamp - header.start_timestamp) / ticks_per_us;
+        };
+        auto write_counters = [&](uint32_t thread_id, const ThreadState& state, uint64_t timestamp) {
+            printf(",\n{\"name\":\"overrides (thread %u)\",\"ph\":\"C\",\"pid\":%u,\"ts\":%.3f,"
+                "\"args\":{\"redirected\":%" PRIu64 ",\"rewritten\":%" PRIu64 "}}",
+                thread_id, header.process_id, to_us(timestamp), state.redirects, state.rewrites);
+        };
+
+        printf("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n");
+        printf("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%u,\"args\":{\"name\":\"Swapchain Override (pid %u)\"}}",
+            header.process_id, header.process_id);
+
+        Record record;
+        uint64_t last_timestamp = header.start_timestamp;
+        while (reader.next(record))
+        {
+            auto [it, inserted] = threads.try_emplace(record.thread_id);
+            ThreadState& state = it->second;
+            if (inserted)
+            {
+                printf(",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":\"thread %u\"}}",
+                    header.process_id, record.thread_id, record.thread_id);
+            }
+
+            const uint8_t outcome = record.outcome < HOOK_OUTCOME_COUNT ? record.outcome : 0;
+            printf(",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":%u,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f,"
+                "\"args\":{\"outcome\":\"%s\",\"result\":%u,\"args\":[%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 "]}}",
+                trace_format::event_name(record.event), static_cast<uint16_t>(record.event) >= 32 ? "winapi" : "reshade",
+                header.process_id, record.thread_id, to_us(record.timestamp), static_cast<double>(record.duration) / ticks_per_us,
+                OUTCOME_NAMES[outcome], record.result, record.args[0], record.args[1], record.args[2], record.args[3]);
+
+            if (outcome == static_cast<uint8_t>(HookOutcome::Redirected))
+            {
+                ++state.redirects;
+                state.counter_pending = true;
+            }
+            else if (outcome == static_cast<uint8_t>(HookOutcome::Rewritten))
+            {
+                ++state.rewrites;
+                state.counter_pending = true;
+            }
+            if (state.counter_pending && record.timestamp - state.last_counter_timestamp >= counter_interval)
+            {
+                write_counters(record.thread_id, state, record.timestamp);
+                state.last_counter_timestamp = record.timestamp;
+                state.counter_pending = false;
+            }
+
+            // Proxy memory is a process-wide total, sampled after each swapchain init and destroy
+            if ((record.event == EventId::InitSwapchain || record.event == EventId::DestroySwapchain) && header.version >= 3)
+            {
+                printf(",\n{\"name\":\"proxy memory (MiB)\",\"ph\":\"C\",\"pid\":%u,\"ts\":%.3f,\"args\":{\"proxy\":%.1f}}",
+                    header.process_id, to_us(record.timestamp + record.duration),
+                    static_cast<double>(record.args[2]) / (1024.0 * 1024.0));
+            }
+
+            last_timestamp = std::max(last_timestamp, record.timestamp);
+        }
+
+        for (const auto& [thread_id, state] : threads)
+        {
+            if (state.counter_pending)
+                write_counters(thread_id, state, last_timestamp);
+        }
+
+        printf("\n]}\n");
+        if (reader.truncated())
+            fprintf(stderr, "warning: ignoring truncated record at the end of the trace\n");
+        return true;
+    }
+
+    // One line per record, the last lines of a crash dump show what the hooks did right before it
+    void print_events(const Trace& trace)
+    {
+        const trace_format::Header& header = trace.header;
+        const double ticks_per_us = static_cast<double>(header.ticks_per_second) / 1000000.0;
+
+        printf("%14s %14s %8s  %-22s %-10s %6s  %s\n", "time (ms)", "duration (us)", "thread", "event", "outcome", "result", "args");
+        for (const Record& record : trace.records)
+        {
+            const uint8_t outcome = record.outcome < HOOK_OUTCOME_COUNT ? record.outcome : 0;
+            printf("%14.3f %14.2f %8u  %-22s %-10s %6u  %016" PRIx64 " %016" PRIx64 " %016" PRIx64 " %016" PRIx64 "\n",
+                static_cast<double>(record.timestamp - header.start_timestamp) / ticks_per_us / 1000.0,
+                static_cast<double>(record.duration) / ticks_per_us, record.thread_id,
+                trace_format::event_name(record.event), OUTCOME_NAMES[outcome], record.result,
+                record.args[0], record.args[1], record.args[2], record.args[3]);
+        }
+    }
+
+    // Override decisions, without handles or timestamps so two runs can be diffed
+    void print_decisions(const Trace& trace)
+    {
+        using trace_format::unpack_high;
+        using trace_format::unpack_low;
+
+        size_t index = 0;
+        for (const Record& record : trace.records)
+        {
+            switch (record.event)
+            {
+            case EventId::CreateSwapchain:
+                printf("%zu create_swapchain api=0x%" PRIx64 " requested=%ux%u result=%ux%u %s\n", index++,
+                    record.args[0], unpack_high(record.args[1]), unpack_low(record.args[1]),
+                    unpack_high(record.args[3]), unpack_low(record.args[3]), record.result ? "overridden" : "unchanged");
+                break;
+            case EventId::SetFullscreenState:
+                printf("%zu set_fullscreen_state fullscreen=%" PRIu64 " %s\n", index++,
+                    record.args[1], record.result ? "blocked" : "allowed");
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    void print_report(const Trace& trace)
+    {
+        const trace_format::Header& header = trace.header;
+        const double ticks_per_us = static_cast<double>(header.ticks_per_second) / 1000000.0;
+
+        std::set<uint32_t> threads;
+        std::map<EventId, std::vector<uint64_t>> durations;
+        std::vector<uint64_t> frame_intervals;
+        std::map<EventId, uint64_t> events_between_presents;
+        uint64_t previous_present = 0;
+        uint64_t frame_count = 0;
+
+        for (const Record& record : trace.records)
+        {
+            threads.insert(record.thread_id);
+            durations[record.event].push_back(record.duration);
+
+            if (record.event == EventId::Present)
+            {
+                if (previous_present != 0)
+                {
+                    frame_intervals.push_back(record.timestamp - previous_present);
+                    ++frame_count;
+                }
+                previous_present = record.timestamp;
+            }
+            else if (previous_present != 0)
+            {
+                ++events_between_presents[record.event];
+            }
+        }
+
+        const uint64_t span = trace.records.empty() ? 0 : trace.records.back().timestamp - header.start_timestamp;
+        const double seconds = static_cast<double>(span) / static_cast<double>(header.ticks_per_second);
+
+        printf("Process %u, %zu records from %zu threads over %.3f s\n\n",
+            header.process_id, trace.records.size(), threads.size(), seconds);
+
+        printf("%-22s %10s %10s %10s %10s %10s %10s\n", "Hook latency (us)", "count", "rate/s", "p50", "p95", "p99", "max");
+        for (auto& [event, values] : durations)
+        {
+            std::sort(values.begin(), values.end());
+            printf("%-22s %10zu %10.1f %10.2f %10.2f %10.2f %10.2f\n", trace_format::event_name(event), values.size(),
+                seconds > 0.0 ? static_cast<double>(values.size()) / seconds : 0.0,
+                static_cast<double>(percentile(values, 0.50)) / ticks_per_us,
+                static_cast<double>(percentile(values, 0.95)) / ticks_per_us,
+                static_cast<double>(percentile(values, 0.99)) / ticks_per_us,
+                static_cast<double>(values.back()) / ticks_per_us);
+        }
+
+        if (!frame_intervals.empty())
+        {
+            std::sort(frame_intervals.begin(), frame_intervals.end());
+            printf("\nFrames: %" PRIu64 ", interval p50 %.2f ms, p95 %.2f ms, p99 %.2f ms, max %.2f ms\n", frame_count,
+                static_cast<double>(percentile(frame_intervals, 0.50)) / ticks_per_us / 1000.0,
+                static_cast<double>(percentile(frame_intervals, 0.95)) / ticks_per_us / 1000.0,
+                static_cast<double>(percentile(frame_intervals, 0.99)) / ticks_per_us / 1000.0,
+                static_cast<double>(frame_intervals.back()) / ticks_per_us / 1000.0);
+
+            for (const auto& [event, count] : events_between_presents)
+            {
+                printf("  %-20s %10.1f per frame\n", trace_format::event_name(event),
+                    static_cast<double>(count) / static_cast<double>(frame_count));
+            }
+        }
+
+        printf("\nDecisions:\n");
+        print_decisions(trace);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    bool decisions_only = false;
+    bool chrome_trace = false;
+    bool events = false;
+    const char* path = nullptr;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--decisions") == 0)
+        {
+            decisions_only = true;
+        }
+        else if (std::strcmp(argv[i], "--chrome") == 0)
+        {
+            chrome_trace = true;
+        }
+        else if (std::strcmp(argv[i], "--events") == 0)
+        {
+            events = true;
+        }
+        else if (path == nullptr)
+        {
+            path = argv[i];
+        }
+        else
+        {
+            path = nullptr; // More than one file
+            break;
+        }
+    }
+
+    if (path == nullptr || decisions_only + chrome_trace + events > 1)
+    {
+        fprintf(stderr, "Usage: trace_report [--decisions | --chrome | --events] <trace file>\n");
+        return 2;
+    }
+
+    if (chrome_trace)
+        return export_chrome_trace(path) ? 0 : 1;
+
+    Trace trace;
+    std::string error;
+    const bool loaded = load_trace(path, trace, error);
+    if (!error.empty())
+        fprintf(stderr, "%s: %s\n", loaded ? "warning" : "error", error.c_str());
+    if (!loaded)
+        return 1;
+
+    if (decisions_only)
+        print_decisions(trace);
+    else if (events)
+        print_events(trace);
+    else
+        print_report(trace);
+
+    return 0;
+}